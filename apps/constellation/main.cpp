@@ -261,6 +261,11 @@ int main(int argc, char **argv)
     }
     else
     {
+      if (settings.async_logging.value())
+      {
+        fetch::EnableAsyncLogging();
+      }
+
       // create and load the main certificate for the bootstrapper
       auto p2p_key = fetch::crypto::GenerateP2PKey();
 
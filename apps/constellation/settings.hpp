@@ -114,6 +114,11 @@ public:
   settings::Setting<uint64_t> aeon_period;
   /// @}
 
+  /// @name Logging
+  /// @{
+  settings::Setting<bool> async_logging;
+  /// @}
+
   /// @name Error handling
   /// @{
   settings::Setting<bool> graceful_failure;
@@ -44,6 +44,8 @@ public:
   using ComplaintAnswer  = std::pair<MuddleAddress, std::pair<Share, Share>>;
   using ExposedShare     = std::pair<MuddleAddress, std::pair<Share, Share>>;
   using SharesExposedMap = std::unordered_map<MuddleAddress, std::pair<Share, Share>>;
+  using ComplaintAnswers = std::vector<std::pair<MuddleAddress, ComplaintAnswer>>;
+  using ExposedShares    = std::vector<std::pair<MuddleAddress, ExposedShare>>;
 
   enum class AddResult
   {
@@ -74,14 +76,17 @@ public:
   void AddShares(MuddleAddress const &from, std::pair<Share, Share> const &shares);
   std::set<MuddleAddress> ComputeComplaints(std::set<MuddleAddress> const &coeff_received);
   bool VerifyComplaintAnswer(MuddleAddress const &from, ComplaintAnswer const &answer);
+  std::set<MuddleAddress> VerifyComplaintAnswers(ComplaintAnswers const &answers);
   void ComputeSecretShare();
   std::vector<Coefficient> GetQualCoefficients();
   void AddQualCoefficients(MuddleAddress const &from, std::vector<Coefficient> const &coefficients);
   SharesExposedMap ComputeQualComplaints(std::set<MuddleAddress> const &coeff_received);
   MuddleAddress    VerifyQualComplaint(MuddleAddress const &from, ComplaintAnswer const &answer);
+  std::vector<MuddleAddress> VerifyQualComplaints(ComplaintAnswers const &complaints);
   void             ComputePublicKeys();
   void             AddReconstructionShare(MuddleAddress const &address);
   void             VerifyReconstructionShare(MuddleAddress const &from, ExposedShare const &share);
+  void             VerifyReconstructionShares(ExposedShares const &shares);
   bool             RunReconstruction();
   DkgOutput        GetDkgOutput();
   void             SetDkgOutput(DkgOutput const &output);
@@ -89,14 +94,16 @@ public:
   void             NewCabinet(std::set<MuddleAddress> const &cabinet, uint32_t threshold);
   void             Reset();
 
-  AddResult     AddSignaturePart(Identity const &from, Signature const &signature);
-  bool          Verify();
-  bool          Verify(Signature const &signature);
-  static bool   Verify(byte_array::ConstByteArray const &group_public_key,
-                       MessagePayload const &message, byte_array::ConstByteArray const &signature);
-  Signature     GroupSignature() const;
-  void          SetMessage(MessagePayload next_message);
-  SignedMessage Sign();
+  AddResult              AddSignaturePart(Identity const &from, Signature const &signature);
+  std::vector<AddResult> AddSignatureParts(std::vector<SignedMessage> const &parts);
+  bool                   Verify();
+  bool                   Verify(Signature const &signature);
+  static bool            Verify(byte_array::ConstByteArray const &group_public_key,
+                                MessagePayload const &            message,
+                                byte_array::ConstByteArray const &signature);
+  Signature              GroupSignature() const;
+  void                   SetMessage(MessagePayload next_message);
+  SignedMessage          Sign();
 
   /// Property methods
   /// @{
@@ -121,9 +128,13 @@ private:
   std::set<MuddleAddress> qual_;               ///< Set of qualified members
 
 private:
-  static Generator const & GetGroupG();
-  static Generator const & GetGroupH();
-  static PrivateKey const &GetZeroFr();
+  using GeneratorTable = crypto::mcl::GeneratorTable;
+
+  static Generator const &     GetGroupG();
+  static Generator const &     GetGroupH();
+  static GeneratorTable const &GetTableG();
+  static GeneratorTable const &GetTableH();
+  static PrivateKey const &    GetZeroFr();
 
   CertificatePtr certificate_;
   uint32_t       cabinet_size_;       ///< Size of cabinet
@@ -154,6 +165,7 @@ private:
   std::unordered_map<CabinetIndex, Signature> signature_buffer_;
   MessagePayload                              current_message_;
   Signature                                   group_signature_;
+  crypto::mcl::LagrangeCoefficients           lagrange_coefficients_;
   /// }
 
   void AddReconstructionShare(MuddleAddress const &                  from,
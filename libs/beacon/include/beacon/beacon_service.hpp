@@ -145,6 +145,8 @@ protected:
 
 private:
   bool AddSignature(SignatureShare share);
+  void AddSignatures(std::vector<SignatureShare> const &shares);
+  bool HandleAddSignatureResult(SignatureShare const &share, BeaconManager::AddResult ret);
 
   Identity         identity_;
   MuddleInterface &muddle_;
@@ -20,8 +20,18 @@
 #include "core/synchronisation/protected.hpp"
 #include "crypto/ecdsa.hpp"
 #include "network/generics/milli_timer.hpp"
+#include "vectorise/threading/parallel_chunks.hpp"
+#include "vectorise/threading/pool.hpp"
 
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
 #include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -56,12 +66,26 @@ public:
     return params_->group_h_;
   }
 
+  crypto::mcl::GeneratorTable const &GetTableG()
+  {
+    EnsureInitialised();
+    return params_->table_g_;
+  }
+
+  crypto::mcl::GeneratorTable const &GetTableH()
+  {
+    EnsureInitialised();
+    return params_->table_h_;
+  }
+
   void EnsureInitialised()
   {
     if (!params_)
     {
       params_ = std::make_unique<Params>();
       crypto::mcl::SetGenerators(params_->group_g_, params_->group_h_);
+      params_->table_g_ = crypto::mcl::GeneratorTable{params_->group_g_};
+      params_->table_h_ = crypto::mcl::GeneratorTable{params_->group_h_};
     }
   }
 
@@ -76,6 +100,9 @@ private:
 
     BeaconManager::Generator group_g_{};
     BeaconManager::Generator group_h_{};
+
+    crypto::mcl::GeneratorTable table_g_{};
+    crypto::mcl::GeneratorTable table_h_{};
   };
 
   std::unique_ptr<Params> params_;
@@ -83,6 +110,40 @@ private:
 
 Protected<CurveParameters> curve_params_{};
 
+threading::Pool &DkgPool()
+{
+  static threading::Pool pool{
+      std::max(std::size_t{1}, std::size_t{std::thread::hardware_concurrency()}), "DKG"};
+  return pool;
+}
+
+/**
+ * Runs task(i) for every i in [0, count) across the DKG pool, returning once all have completed.
+ * The tasks must only touch state belonging to their own index
+ */
+template <typename Task>
+void ParallelFor(std::size_t count, Task const &task)
+{
+  std::size_t const jobs = std::min(DkgPool().concurrency(), count);
+  if (jobs <= 1)
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      task(i);
+    }
+    return;
+  }
+
+  auto const compute = [&task](std::size_t start, std::size_t end) {
+    for (std::size_t i = start; i < end; ++i)
+    {
+      task(i);
+    }
+  };
+
+  threading::ParallelChunks(DkgPool(), count, (count + jobs - 1) / jobs, compute);
+}
+
 }  // namespace
 
 constexpr char const *LOGGING_NAME = "BeaconManager";
@@ -115,16 +176,18 @@ void BeaconManager::GenerateCoefficients()
     b_i[k].setRand();
   }
 
-  for (uint32_t k = 0; k <= polynomial_degree_; k++)
-  {
+  auto const &table_g = GetTableG();
+  auto const &table_h = GetTableH();
+
+  ParallelFor(polynomial_degree_ + 1, [&](std::size_t k) {
     C_ik[cabinet_index_][k] =
-        crypto::mcl::ComputeLHS(g__a_i[k], GetGroupG(), GetGroupH(), a_i[k], b_i[k]);
-  }
+        crypto::mcl::ComputeLHS(g__a_i[k], table_g, table_h, a_i[k], b_i[k]);
+  });
 
-  for (uint32_t l = 0; l < cabinet_size_; l++)
-  {
-    crypto::mcl::ComputeShares(s_ij[cabinet_index_][l], sprime_ij[cabinet_index_][l], a_i, b_i, l);
-  }
+  ParallelFor(cabinet_size_, [&](std::size_t l) {
+    crypto::mcl::ComputeShares(s_ij[cabinet_index_][l], sprime_ij[cabinet_index_][l], a_i, b_i,
+                               static_cast<uint32_t>(l));
+  });
 }
 
 std::vector<BeaconManager::Coefficient> BeaconManager::GetCoefficients()
@@ -187,23 +250,38 @@ void BeaconManager::AddShares(MuddleAddress const &from, std::pair<Share, Share>
 std::set<BeaconManager::MuddleAddress> BeaconManager::ComputeComplaints(
     std::set<MuddleAddress> const &coeff_received)
 {
-  std::set<MuddleAddress> complaints_local;
+  std::vector<std::pair<MuddleAddress, CabinetIndex>> senders;
   for (auto &cab : coeff_received)
   {
     CabinetIndex i = identity_to_index_[cab];
     if (i != cabinet_index_)
     {
-      PublicKey rhs;
-      PublicKey lhs;
-      lhs = crypto::mcl::ComputeLHS(g__s_ij[i][cabinet_index_], GetGroupG(), GetGroupH(),
-                                    s_ij[i][cabinet_index_], sprime_ij[i][cabinet_index_]);
-      rhs = crypto::mcl::ComputeRHS(cabinet_index_, C_ik[i]);
-      if (lhs != rhs || lhs.isZero())
-      {
-        FETCH_LOG_WARN(LOGGING_NAME, "Node ", cabinet_index_,
-                       " received bad coefficients/shares from node ", i);
-        complaints_local.insert(cab);
-      }
+      senders.emplace_back(cab, i);
+    }
+  }
+
+  auto const &table_g = GetTableG();
+  auto const &table_h = GetTableH();
+
+  std::vector<uint8_t> failed(senders.size(), 0);
+  ParallelFor(senders.size(), [&](std::size_t j) {
+    CabinetIndex i = senders[j].second;
+    PublicKey    rhs;
+    PublicKey    lhs;
+    lhs       = crypto::mcl::ComputeLHS(g__s_ij[i][cabinet_index_], table_g, table_h,
+                                        s_ij[i][cabinet_index_], sprime_ij[i][cabinet_index_]);
+    rhs       = crypto::mcl::ComputeRHS(cabinet_index_, C_ik[i]);
+    failed[j] = (lhs != rhs || lhs.isZero()) ? 1 : 0;
+  });
+
+  std::set<MuddleAddress> complaints_local;
+  for (std::size_t j = 0; j < senders.size(); ++j)
+  {
+    if (failed[j])
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Node ", cabinet_index_,
+                     " received bad coefficients/shares from node ", senders[j].second);
+      complaints_local.insert(senders[j].first);
     }
   }
   return complaints_local;
@@ -222,7 +300,7 @@ bool BeaconManager::VerifyComplaintAnswer(MuddleAddress const &from, ComplaintAn
   s      = answer.second.first;
   sprime = answer.second.second;
   rhsG   = crypto::mcl::ComputeRHS(reporter_index, C_ik[from_index]);
-  lhsG   = crypto::mcl::ComputeLHS(GetGroupG(), GetGroupH(), s, sprime);
+  lhsG   = crypto::mcl::ComputeLHS(GetTableG(), GetTableH(), s, sprime);
   if (lhsG != rhsG || lhsG.isZero())
   {
     FETCH_LOG_WARN(LOGGING_NAME, "Node ", cabinet_index_, " verification for node ", from_index,
@@ -237,12 +315,69 @@ bool BeaconManager::VerifyComplaintAnswer(MuddleAddress const &from, ComplaintAn
     FETCH_LOG_INFO(LOGGING_NAME, "Node ", cabinet_index_, " reset shares for ", from_index);
     s_ij[from_index][cabinet_index_]      = s;
     sprime_ij[from_index][cabinet_index_] = sprime;
-    g__s_ij[from_index][cabinet_index_].clear();
-    bn::G2::mul(g__s_ij[from_index][cabinet_index_], GetGroupG(), s_ij[from_index][cabinet_index_]);
+    GetTableG().Mul(g__s_ij[from_index][cabinet_index_], s_ij[from_index][cabinet_index_]);
   }
   return true;
 }
 
+/**
+ * Verifies a collection of complaint answers together, see VerifyComplaintAnswer
+ *
+ * @param answers Pairs of the answering node and its answer
+ * @return The nodes which gave at least one answer failing verification
+ */
+std::set<BeaconManager::MuddleAddress> BeaconManager::VerifyComplaintAnswers(
+    ComplaintAnswers const &answers)
+{
+  std::vector<crypto::mcl::ShareVerification> checks;
+  checks.reserve(answers.size());
+
+  for (auto const &answer : answers)
+  {
+    assert(identity_to_index_.find(answer.second.first) != identity_to_index_.end());
+
+    crypto::mcl::ShareVerification check;
+    check.share1       = answer.second.second.first;
+    check.share2       = answer.second.second.second;
+    check.coefficients = &C_ik[identity_to_index_[answer.first]];
+    check.rank         = identity_to_index_[answer.second.first];
+    checks.push_back(check);
+  }
+
+  auto const invalid = crypto::mcl::BatchVerifyShares(checks, GetGroupG(), GetGroupH());
+
+  std::set<MuddleAddress> failed;
+  auto                    next_invalid = invalid.begin();
+  for (std::size_t i = 0; i < answers.size(); ++i)
+  {
+    auto const &from           = answers[i].first;
+    auto const &check          = checks[i];
+    auto const  from_index     = identity_to_index_[from];
+    auto const  reporter_index = check.rank;
+
+    if (next_invalid != invalid.end() && *next_invalid == i)
+    {
+      ++next_invalid;
+      FETCH_LOG_WARN(LOGGING_NAME, "Node ", cabinet_index_, " verification for node ", from_index,
+                     " complaint answer failed");
+      failed.insert(from);
+      continue;
+    }
+
+    FETCH_LOG_INFO(LOGGING_NAME, "Node ", cabinet_index_, " verification for node ", from_index,
+                   " complaint answer succeeded");
+    if (reporter_index == cabinet_index_)
+    {
+      FETCH_LOG_INFO(LOGGING_NAME, "Node ", cabinet_index_, " reset shares for ", from_index);
+      s_ij[from_index][cabinet_index_]      = check.share1;
+      sprime_ij[from_index][cabinet_index_] = check.share2;
+      GetTableG().Mul(g__s_ij[from_index][cabinet_index_], s_ij[from_index][cabinet_index_]);
+    }
+  }
+
+  return failed;
+}
+
 /**
  * If in qual a member computes individual share of the secret key and further computes and
  * broadcasts qual coefficients
@@ -294,7 +429,8 @@ void BeaconManager::AddQualCoefficients(MuddleAddress const &           from,
 BeaconManager::SharesExposedMap BeaconManager::ComputeQualComplaints(
     std::set<MuddleAddress> const &coeff_received)
 {
-  SharesExposedMap qual_complaints;
+  SharesExposedMap                                    qual_complaints;
+  std::vector<std::pair<MuddleAddress, CabinetIndex>> received;
 
   for (auto const &miner : qual_)
   {
@@ -303,16 +439,7 @@ BeaconManager::SharesExposedMap BeaconManager::ComputeQualComplaints(
     {
       if (coeff_received.find(miner) != coeff_received.end())
       {
-        PublicKey rhs;
-        PublicKey lhs;
-        lhs = g__s_ij[i][cabinet_index_];
-        rhs = crypto::mcl::ComputeRHS(cabinet_index_, A_ik[i]);
-        if (lhs != rhs || rhs.isZero())
-        {
-          FETCH_LOG_WARN(LOGGING_NAME, "Node ", cabinet_index_,
-                         " received qual coefficients from node ", i, " which failed verification");
-          qual_complaints.insert({miner, {s_ij[i][cabinet_index_], sprime_ij[i][cabinet_index_]}});
-        }
+        received.emplace_back(miner, i);
       }
       else
       {
@@ -322,44 +449,120 @@ BeaconManager::SharesExposedMap BeaconManager::ComputeQualComplaints(
       }
     }
   }
+
+  std::vector<uint8_t> failed(received.size(), 0);
+  ParallelFor(received.size(), [&](std::size_t j) {
+    CabinetIndex i = received[j].second;
+    PublicKey    rhs;
+    PublicKey    lhs;
+    lhs       = g__s_ij[i][cabinet_index_];
+    rhs       = crypto::mcl::ComputeRHS(cabinet_index_, A_ik[i]);
+    failed[j] = (lhs != rhs || rhs.isZero()) ? 1 : 0;
+  });
+
+  for (std::size_t j = 0; j < received.size(); ++j)
+  {
+    if (failed[j])
+    {
+      CabinetIndex i = received[j].second;
+      FETCH_LOG_WARN(LOGGING_NAME, "Node ", cabinet_index_,
+                     " received qual coefficients from node ", i, " which failed verification");
+      qual_complaints.insert(
+          {received[j].first, {s_ij[i][cabinet_index_], sprime_ij[i][cabinet_index_]}});
+    }
+  }
   return qual_complaints;
 }
 
 BeaconManager::MuddleAddress BeaconManager::VerifyQualComplaint(MuddleAddress const &  from,
                                                                 ComplaintAnswer const &answer)
 {
-  CabinetIndex from_index   = identity_to_index_[from];
-  CabinetIndex victim_index = identity_to_index_[answer.first];
+  return VerifyQualComplaints({{from, answer}}).front();
+}
 
-  PublicKey  lhs;
-  PublicKey  rhs;
-  PrivateKey s;
-  PrivateKey sprime;
-  s      = answer.second.first;
-  sprime = answer.second.second;
-  lhs    = crypto::mcl::ComputeLHS(GetGroupG(), GetGroupH(), s, sprime);
-  rhs    = crypto::mcl::ComputeRHS(from_index, C_ik[victim_index]);
-  if (lhs != rhs || lhs.isZero())
+/**
+ * Verifies a collection of qual complaints, see VerifyQualComplaint. The checks are spread across
+ * the DKG worker pool
+ *
+ * @param complaints Pairs of the complaining node and the shares it exposed
+ * @return The node found to be at fault for each of the complaints
+ */
+std::vector<BeaconManager::MuddleAddress> BeaconManager::VerifyQualComplaints(
+    ComplaintAnswers const &complaints)
+{
+  enum class Outcome : uint8_t
   {
-    FETCH_LOG_DEBUG(LOGGING_NAME, "Node ", cabinet_index_,
-                    " received shares failing initial coefficients verification from node ",
-                    from_index, " for node ", victim_index);
-    return from;
+    BAD_INITIAL_SHARES,
+    BAD_QUAL_SHARES,
+    INCORRECT_COMPLAINT
+  };
+
+  // Pairs of the complaining node and the node whose shares are exposed
+  std::vector<std::pair<CabinetIndex, CabinetIndex>> indices;
+  indices.reserve(complaints.size());
+  for (auto const &complaint : complaints)
+  {
+    indices.emplace_back(identity_to_index_[complaint.first],
+                         identity_to_index_[complaint.second.first]);
   }
 
-  bn::G2::mul(lhs, GetGroupG(), s);  // G^s
-  rhs = crypto::mcl::ComputeRHS(from_index, A_ik[victim_index]);
-  if (lhs != rhs || rhs.isZero())
+  auto const &table_g = GetTableG();
+  auto const &table_h = GetTableH();
+
+  std::vector<Outcome> outcomes(complaints.size(), Outcome::INCORRECT_COMPLAINT);
+  ParallelFor(complaints.size(), [&](std::size_t j) {
+    CabinetIndex from_index   = indices[j].first;
+    CabinetIndex victim_index = indices[j].second;
+
+    PublicKey  lhs;
+    PublicKey  rhs;
+    PrivateKey s;
+    PrivateKey sprime;
+    s      = complaints[j].second.second.first;
+    sprime = complaints[j].second.second.second;
+    lhs    = crypto::mcl::ComputeLHS(table_g, table_h, s, sprime);
+    rhs    = crypto::mcl::ComputeRHS(from_index, C_ik[victim_index]);
+    if (lhs != rhs || lhs.isZero())
+    {
+      outcomes[j] = Outcome::BAD_INITIAL_SHARES;
+      return;
+    }
+
+    table_g.Mul(lhs, s);  // G^s
+    rhs = crypto::mcl::ComputeRHS(from_index, A_ik[victim_index]);
+    if (lhs != rhs || rhs.isZero())
+    {
+      outcomes[j] = Outcome::BAD_QUAL_SHARES;
+    }
+  });
+
+  std::vector<MuddleAddress> at_fault;
+  at_fault.reserve(complaints.size());
+  for (std::size_t j = 0; j < complaints.size(); ++j)
   {
-    FETCH_LOG_DEBUG(LOGGING_NAME, "Node ", cabinet_index_,
-                    " received shares failing qual coefficients verification from node ",
-                    from_index, " for node ", victim_index);
-    return answer.first;
+    switch (outcomes[j])
+    {
+    case Outcome::BAD_INITIAL_SHARES:
+      FETCH_LOG_DEBUG(LOGGING_NAME, "Node ", cabinet_index_,
+                      " received shares failing initial coefficients verification from node ",
+                      indices[j].first, " for node ", indices[j].second);
+      at_fault.push_back(complaints[j].first);
+      break;
+    case Outcome::BAD_QUAL_SHARES:
+      FETCH_LOG_DEBUG(LOGGING_NAME, "Node ", cabinet_index_,
+                      " received shares failing qual coefficients verification from node ",
+                      indices[j].first, " for node ", indices[j].second);
+      at_fault.push_back(complaints[j].second.first);
+      break;
+    case Outcome::INCORRECT_COMPLAINT:
+      FETCH_LOG_WARN(LOGGING_NAME, "Node ", cabinet_index_, " received incorrect complaint from ",
+                     indices[j].first);
+      at_fault.push_back(complaints[j].first);
+      break;
+    }
   }
 
-  FETCH_LOG_WARN(LOGGING_NAME, "Node ", cabinet_index_, " received incorrect complaint from ",
-                 from_index);
-  return from;
+  return at_fault;
 }
 
 /**
@@ -383,18 +586,30 @@ void BeaconManager::ComputePublicKeys()
     bn::G2::add(public_key_, public_key_, y_i[it]);
   }
   // Compute public_key_shares_ $v_j = \prod_{i \in QUAL} \prod_{k=0}^t (A_{ik})^{j^k} \bmod
-  // p$
-  for (auto const &jq : qual_)
+  // p$. The products over $i$ are taken first, $A_k = \prod_{i \in QUAL} A_{ik}$, so that each
+  // share is a single evaluation $v_j = \prod_{k=0}^t A_k^{j^k}$
+  std::vector<PublicKey> qual_coefficients(polynomial_degree_ + 1);
+  for (auto const &iq : qual_)
   {
-    CabinetIndex jt = identity_to_index_[jq];
-    for (auto const &iq : qual_)
+    CabinetIndex it = identity_to_index_[iq];
+    for (uint32_t k = 0; k <= polynomial_degree_; ++k)
     {
-      CabinetIndex it = identity_to_index_[iq];
-      bn::G2::add(public_key_shares_[jt], public_key_shares_[jt], A_ik[it][0]);
-      crypto::mcl::UpdateRHS(jt, public_key_shares_[jt], A_ik[it]);
+      bn::G2::add(qual_coefficients[k], qual_coefficients[k], A_ik[it][k]);
     }
   }
 
+  std::vector<CabinetIndex> qual_indices;
+  for (auto const &jq : qual_)
+  {
+    qual_indices.push_back(identity_to_index_[jq]);
+  }
+
+  ParallelFor(qual_indices.size(), [&](std::size_t j) {
+    CabinetIndex jt = qual_indices[j];
+    bn::G2::add(public_key_shares_[jt], public_key_shares_[jt], qual_coefficients[0]);
+    crypto::mcl::UpdateRHS(jt, public_key_shares_[jt], qual_coefficients);
+  });
+
   FETCH_LOG_DEBUG(LOGGING_NAME, "Node ", cabinet_index_, " compute public keys end.");
 }
 
@@ -442,7 +657,7 @@ void BeaconManager::VerifyReconstructionShare(MuddleAddress const &from, Exposed
   PrivateKey   sprime;
   s      = share.second.first;
   sprime = share.second.second;
-  lhs    = crypto::mcl::ComputeLHS(GetGroupG(), GetGroupH(), s, sprime);
+  lhs    = crypto::mcl::ComputeLHS(GetTableG(), GetTableH(), s, sprime);
   rhs    = crypto::mcl::ComputeRHS(identity_to_index_[from], C_ik[victim_index]);
 
   if (lhs == rhs && !lhs.isZero())
@@ -456,6 +671,48 @@ void BeaconManager::VerifyReconstructionShare(MuddleAddress const &from, Exposed
   }
 }
 
+/**
+ * Verifies a collection of reconstruction shares together, adding those which are consistent with
+ * the initial coefficients of the node being reconstructed
+ *
+ * @param shares Pairs of the node exposing the share and the exposed share
+ */
+void BeaconManager::VerifyReconstructionShares(ExposedShares const &shares)
+{
+  std::vector<crypto::mcl::ShareVerification> checks;
+  checks.reserve(shares.size());
+
+  for (auto const &share : shares)
+  {
+    crypto::mcl::ShareVerification check;
+    check.share1       = share.second.second.first;
+    check.share2       = share.second.second.second;
+    check.coefficients = &C_ik[identity_to_index_[share.second.first]];
+    check.rank         = identity_to_index_[share.first];
+    checks.push_back(check);
+  }
+
+  auto const invalid = crypto::mcl::BatchVerifyShares(checks, GetGroupG(), GetGroupH());
+
+  auto next_invalid = invalid.begin();
+  for (std::size_t i = 0; i < shares.size(); ++i)
+  {
+    auto const &from  = shares[i].first;
+    auto const &share = shares[i].second;
+
+    if (next_invalid != invalid.end() && *next_invalid == i)
+    {
+      ++next_invalid;
+      FETCH_LOG_DEBUG(LOGGING_NAME, "Node ", cabinet_index_, "received bad share from node ",
+                      identity_to_index_[from], "for reconstructing node ",
+                      identity_to_index_[share.first]);
+      continue;
+    }
+
+    AddReconstructionShare(from, {share.first, share.second.first});
+  }
+}
+
 /**
  * Run polynomial interpolation on the exposed secret shares of other cabinet members to
  * recontruct their random polynomials
@@ -467,6 +724,8 @@ bool BeaconManager::RunReconstruction()
   std::vector<std::vector<PrivateKey>> a_ik;
   crypto::mcl::Init(a_ik, static_cast<uint32_t>(cabinet_size_),
                     static_cast<uint32_t>(polynomial_degree_ + 1));
+
+  auto const &table_g = GetTableG();
   for (auto const &in : reconstruction_shares)
   {
     CabinetIndex            victim_index = identity_to_index_[in.first];
@@ -495,10 +754,9 @@ bool BeaconManager::RunReconstruction()
       shares_f.push_back(shares[index]);
     }
     a_ik[victim_index] = crypto::mcl::InterpolatePolynom(points, shares_f);
-    for (std::size_t k = 0; k <= polynomial_degree_; k++)
-    {
-      bn::G2::mul(A_ik[victim_index][k], GetGroupG(), a_ik[victim_index][k]);
-    }
+    ParallelFor(polynomial_degree_ + 1, [&](std::size_t k) {
+      table_g.Mul(A_ik[victim_index][k], a_ik[victim_index][k]);
+    });
   }
   return true;
 }
@@ -565,6 +823,7 @@ void BeaconManager::Reset()
 
   qual_.clear();
   reconstruction_shares.clear();
+  lagrange_coefficients_ = crypto::mcl::LagrangeCoefficients{cabinet_size_};
 }
 
 /**
@@ -601,12 +860,102 @@ BeaconManager::AddResult BeaconManager::AddSignaturePart(Identity const & from,
   return AddResult::SUCCESS;
 }
 
+/**
+ * @brief adds a batch of signature shares, verifying them together.
+ * @param parts are the signature shares and the identities of their senders.
+ * @return the result of adding each of the shares.
+ */
+std::vector<BeaconManager::AddResult> BeaconManager::AddSignatureParts(
+    std::vector<SignedMessage> const &parts)
+{
+  std::vector<AddResult> results(parts.size(), AddResult::SUCCESS);
+
+  std::vector<std::size_t> candidates;
+  std::vector<PublicKey>   public_keys;
+  std::vector<Signature>   signatures;
+
+  std::unordered_set<MuddleAddress> batch_signers;
+  for (std::size_t i = 0; i < parts.size(); ++i)
+  {
+    auto const &from = parts[i].identity.identifier();
+    auto        it   = identity_to_index_.find(from);
+
+    if (it == identity_to_index_.end() || qual_.find(from) == qual_.end())
+    {
+      results[i] = AddResult::NOT_MEMBER;
+    }
+    else if (already_signed_.find(from) != already_signed_.end() ||
+             !batch_signers.insert(from).second)
+    {
+      results[i] = AddResult::SIGNATURE_ALREADY_ADDED;
+    }
+    else
+    {
+      candidates.push_back(i);
+      public_keys.push_back(public_key_shares_[it->second]);
+      signatures.push_back(parts[i].signature);
+    }
+  }
+
+  auto const invalid =
+      crypto::mcl::BatchVerifySign(public_keys, current_message_, signatures, GetGroupG());
+
+  auto next_invalid = invalid.begin();
+  for (std::size_t c = 0; c < candidates.size(); ++c)
+  {
+    auto const i = candidates[c];
+
+    if (next_invalid != invalid.end() && *next_invalid == c)
+    {
+      ++next_invalid;
+      results[i] = AddResult::INVALID_SIGNATURE;
+      continue;
+    }
+
+    auto const &from = parts[i].identity.identifier();
+    signature_buffer_.insert({identity_to_index_.at(from), parts[i].signature});
+    already_signed_.insert(from);
+  }
+
+  return results;
+}
+
 /**
  * @brief verifies the group signature.
+ *
+ * The group signature is interpolated from the threshold + 1 shares with the lowest cabinet
+ * indices, so that the same signer set (and its cached Lagrange coefficients) is used whenever
+ * possible.
  */
 bool BeaconManager::Verify()
 {
-  group_signature_ = crypto::mcl::LagrangeInterpolation(signature_buffer_);
+  assert(can_verify());
+
+  crypto::mcl::LagrangeCoefficients::SignerSet signers;
+  for (auto const &share : signature_buffer_)
+  {
+    signers.insert(share.first);
+  }
+
+  while (signers.size() > polynomial_degree_ + 1)
+  {
+    signers.erase(std::prev(signers.end()));
+  }
+
+  std::unordered_map<CabinetIndex, Signature> shares;
+  for (auto const index : signers)
+  {
+    shares.emplace(index, signature_buffer_.at(index));
+  }
+
+  // the coefficients are not serialised, a restored manager builds them on first use
+  if (lagrange_coefficients_.cabinet_size() != cabinet_size_)
+  {
+    lagrange_coefficients_ = crypto::mcl::LagrangeCoefficients{cabinet_size_};
+  }
+
+  group_signature_ =
+      crypto::mcl::LagrangeInterpolation(shares, lagrange_coefficients_.Get(signers));
   return Verify(group_signature_);
 }
 
@@ -733,6 +1082,16 @@ BeaconManager::Generator const &BeaconManager::GetGroupH()
   return *curve_params_.Apply([](CurveParameters &params) { return &params.GetGroupH(); });
 }
 
+BeaconManager::GeneratorTable const &BeaconManager::GetTableG()
+{
+  return *curve_params_.Apply([](CurveParameters &params) { return &params.GetTableG(); });
+}
+
+BeaconManager::GeneratorTable const &BeaconManager::GetTableH()
+{
+  return *curve_params_.Apply([](CurveParameters &params) { return &params.GetTableH(); });
+}
+
 BeaconManager::PrivateKey const &BeaconManager::GetZeroFr()
 {
   return *curve_params_.Apply([](CurveParameters &params) { return &params.GetZeroFr(); });
@@ -467,19 +467,18 @@ BeaconService::State BeaconService::OnVerifySignaturesState()
     auto &signatures_struct = signatures_being_built_[index];
     auto &all_sigs_map      = signatures_struct.threshold_signatures;
 
+    std::vector<SignatureShare> shares;
+    shares.reserve(ret.threshold_signatures.size());
+
     for (auto const &address_sig_pair : ret.threshold_signatures)
     {
       all_sigs_map[address_sig_pair.first] = address_sig_pair.second;
-      // Let the manager know
-      AddSignature(address_sig_pair.second);
-
-      // If we have collected enough signatures already then break
-      if (active_exe_unit_->manager.can_verify())
-      {
-        break;
-      }
+      shares.push_back(address_sig_pair.second);
     }
 
+    // Let the manager know, the shares are verified as a single batch
+    AddSignatures(shares);
+
     FETCH_LOG_DEBUG(LOGGING_NAME, "After adding, we have ", all_sigs_map.size(),
                     " signatures. Round: ", index);
   }  // Mutex unlocks here since verification can take some time
@@ -553,6 +552,23 @@ bool BeaconService::AddSignature(SignatureShare share)
   assert(active_exe_unit_ != nullptr);
   auto ret = active_exe_unit_->manager.AddSignaturePart(share.identity, share.signature);
 
+  return HandleAddSignatureResult(share, ret);
+}
+
+void BeaconService::AddSignatures(std::vector<SignatureShare> const &shares)
+{
+  assert(active_exe_unit_ != nullptr);
+  auto const results = active_exe_unit_->manager.AddSignatureParts(shares);
+
+  for (std::size_t i = 0; i < shares.size(); ++i)
+  {
+    HandleAddSignatureResult(shares[i], results[i]);
+  }
+}
+
+bool BeaconService::HandleAddSignatureResult(SignatureShare const &   share,
+                                             BeaconManager::AddResult ret)
+{
   // Checking that the signature is valid
   if (ret == BeaconManager::AddResult::INVALID_SIGNATURE)
   {
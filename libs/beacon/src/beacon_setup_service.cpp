@@ -684,6 +684,7 @@ BeaconSetupService::State BeaconSetupService::OnWaitForReconstructionShares()
   {
     // Process reconstruction shares. Reconstruction shares from non-qual members
     // or people in qual complaints should not be considered
+    BeaconManager::ExposedShares exposed_shares;
     for (auto const &share : reconstruction_shares_received_)
     {
       MuddleAddress from = share.first;
@@ -698,11 +699,13 @@ BeaconSetupService::State BeaconSetupService::OnWaitForReconstructionShares()
         // Check person who's shares are being exposed is a member of qual
         if (beacon_->manager.InQual(elem.first))
         {
-          beacon_->manager.VerifyReconstructionShare(from, elem);
+          exposed_shares.emplace_back(from, elem);
         }
       }
     }
 
+    beacon_->manager.VerifyReconstructionShares(exposed_shares);
+
     // Reset if reconstruction fails as this breaks the initial assumption on the
     // number of Byzantine nodes
     if (!beacon_->manager.RunReconstruction())
@@ -1364,6 +1367,8 @@ std::set<BeaconSetupService::MuddleAddress> BeaconSetupService::ComputeComplaint
 void BeaconSetupService::CheckComplaintAnswers()
 {
   auto answer_messages = complaint_answers_manager_.ComplaintAnswersReceived();
+
+  BeaconManager::ComplaintAnswers answers;
   for (auto const &sender_answers : answer_messages)
   {
     MuddleAddress from = sender_answers.first;
@@ -1375,10 +1380,7 @@ void BeaconSetupService::CheckComplaintAnswers()
       if (complaints_manager_.FindComplaint(from, share.first))
       {
         answered_complaints.insert(share.first);
-        if (!beacon_->manager.VerifyComplaintAnswer(from, share))
-        {
-          complaint_answers_manager_.AddComplaintAgainst(from);
-        }
+        answers.emplace_back(from, share);
       }
     }
 
@@ -1388,6 +1390,12 @@ void BeaconSetupService::CheckComplaintAnswers()
       complaint_answers_manager_.AddComplaintAgainst(from);
     }
   }
+
+  // Verify all of the answers together
+  for (auto const &from : beacon_->manager.VerifyComplaintAnswers(answers))
+  {
+    complaint_answers_manager_.AddComplaintAgainst(from);
+  }
 }
 
 /**
@@ -1426,7 +1434,8 @@ bool BeaconSetupService::BuildQual()
  */
 void BeaconSetupService::CheckQualComplaints()
 {
-  std::set<MuddleAddress> qual{beacon_->manager.qual()};
+  std::set<MuddleAddress>         qual{beacon_->manager.qual()};
+  BeaconManager::ComplaintAnswers complaints;
   for (const auto &complaint : qual_complaints_manager_.ComplaintsReceived())
   {
     MuddleAddress sender = complaint.first;
@@ -1435,11 +1444,15 @@ void BeaconSetupService::CheckQualComplaints()
       // Check person who's shares are being exposed is not in QUAL then don't bother with checks
       if (qual.find(share.first) != qual.end())
       {
-        qual_complaints_manager_.AddComplaintAgainst(
-            beacon_->manager.VerifyQualComplaint(sender, share));
+        complaints.emplace_back(sender, share);
       }
     }
   }
+
+  for (auto const &at_fault : beacon_->manager.VerifyQualComplaints(complaints))
+  {
+    qual_complaints_manager_.AddComplaintAgainst(at_fault);
+  }
 }
 
 /**
@@ -18,6 +18,7 @@
 
 #include "beacon/beacon_manager.hpp"
 #include "core/byte_array/const_byte_array.hpp"
+#include "core/serializers/main_serializer.hpp"
 #include "crypto/ecdsa.hpp"
 
 #include "gtest/gtest.h"
@@ -255,6 +256,11 @@ TEST(beacon_manager, dkg_and_threshold_signing)
   BeaconManager::ComplaintAnswer fail_check2 = {malicious,
                                                 beacon_managers[1]->GetReceivedShares(malicious)};
   EXPECT_EQ(malicious, beacon_managers[0]->VerifyQualComplaint(honest, fail_check2));
+  // The same qual complaints checked together
+  std::vector<MuddleAddress> at_fault{malicious, honest, malicious};
+  EXPECT_EQ(at_fault, beacon_managers[0]->VerifyQualComplaints({{malicious, incorrect_complaint},
+                                                                {honest, fail_check1},
+                                                                {honest, fail_check2}}));
 
   // Verify invalid reconstruction share
   BeaconManager::ComplaintAnswer incorrect_reconstruction_share = {honest, wrong_shares};
@@ -359,4 +365,27 @@ TEST(beacon_manager, dkg_and_threshold_signing)
       BeaconManager::AddResult::SUCCESS);
   EXPECT_TRUE(beacon_managers[2]->can_verify());
   EXPECT_TRUE(beacon_managers[2]->Verify());
+
+  // A manager restored from its serialised state signs and verifies
+  serializers::MsgPackSerializer serializer;
+  serializer << *beacon_managers[0];
+  serializer.seek(0);
+
+  BeaconManager restored{member_ptrs[0]};
+  serializer >> restored;
+  EXPECT_EQ(restored.group_public_key(), beacon_managers[0]->group_public_key());
+
+  std::string next_message = "Hello again";
+  restored.SetMessage(next_message);
+  BeaconManager::SignedMessage own_msg = restored.Sign();
+  beacon_managers[1]->SetMessage(next_message);
+  BeaconManager::SignedMessage other_msg = beacon_managers[1]->Sign();
+
+  EXPECT_EQ(restored.AddSignaturePart(member_ptrs[1]->identity(), other_msg.signature),
+            BeaconManager::AddResult::SUCCESS);
+  EXPECT_TRUE(restored.can_verify());
+  EXPECT_TRUE(restored.Verify());
+  EXPECT_TRUE(BeaconManager::Verify(restored.group_public_key(), next_message,
+                                    restored.GroupSignature().getStr()));
+  EXPECT_NE(own_msg.signature, other_msg.signature);
 }
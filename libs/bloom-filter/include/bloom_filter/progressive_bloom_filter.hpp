@@ -17,24 +17,36 @@
 //
 //------------------------------------------------------------------------------
 
-#include "bloom_filter/bloom_filter.hpp"
+#include "bloom_filter/split_block_bloom_filter.hpp"
 
 #include <cstddef>
-#include <istream>
+#include <cstdint>
 #include <memory>
-#include <ostream>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace fetch {
 
-namespace byte_array {
-class ConstByteArray;
-}
-
+class BitVector;
+
+/*
+ * A pair of overlapping split block Bloom filters covering a sliding window of element indices
+ * (block numbers). Elements are added to the filter that covers their index; once the head moves
+ * past the window, the older filter is discarded and a fresh one is started.
+ *
+ * The filters can be persisted to, and restored from, a flat file: a 64-byte header followed by the
+ * raw blocks of both filters. Because the header is exactly one cache line the blocks remain
+ * aligned when the file is memory mapped.
+ */
 class ProgressiveBloomFilter
 {
 public:
-  explicit ProgressiveBloomFilter(uint64_t overlap);
+  using Keys    = SplitBlockBloomFilter::Keys;
+  using Indices = std::vector<uint64_t>;
+
+  explicit ProgressiveBloomFilter(
+      uint64_t overlap, uint32_t log2_num_blocks = SplitBlockBloomFilter::DEFAULT_LOG2_NUM_BLOCKS);
   ProgressiveBloomFilter(ProgressiveBloomFilter const &) = delete;
   ProgressiveBloomFilter(ProgressiveBloomFilter &&)      = delete;
   ~ProgressiveBloomFilter()                              = default;
@@ -47,53 +59,23 @@ public:
   void Add(fetch::byte_array::ConstByteArray const &element, std::size_t element_index,
            std::size_t current_head_index);
 
-  void Reset();
-
-private:
-  bool IsInCurrentRange(std::size_t index) const;
-
-  uint64_t                          current_min_index_{};
-  uint64_t                          overlap_;
-  std::unique_ptr<BasicBloomFilter> filter1_{std::make_unique<BasicBloomFilter>()};
-  std::unique_ptr<BasicBloomFilter> filter2_{std::make_unique<BasicBloomFilter>()};
+  std::size_t MatchMany(Keys const &elements, Indices const &element_indices,
+                        BitVector &matches) const;
 
-  template <typename, typename>
-  friend struct fetch::serializers::MapSerializer;
-};
+  void Reset();
 
-namespace serializers {
+  void Save(std::string const &filename) const;
+  void Load(std::string const &filename);
 
-template <typename D>
-struct MapSerializer<ProgressiveBloomFilter, D>
-{
-public:
-  using Type       = ProgressiveBloomFilter;
-  using DriverType = D;
-
-  static const uint8_t MIN_INDEX = 1;
-  static const uint8_t OVERLAP   = 2;
-  static const uint8_t FILTER1   = 3;
-  static const uint8_t FILTER2   = 4;
+private:
+  using FilterPtr = std::unique_ptr<SplitBlockBloomFilter>;
 
-  template <typename T>
-  static void Serialize(T &map_constructor, Type const &filter)
-  {
-    auto map = map_constructor(4);
-    map.Append(MIN_INDEX, filter.current_min_index_);
-    map.Append(OVERLAP, filter.overlap_);
-    map.Append(FILTER1, *filter.filter1_);
-    map.Append(FILTER2, *filter.filter2_);
-  }
+  bool IsInCurrentRange(std::size_t index) const;
 
-  template <typename T>
-  static void Deserialize(T &map, Type &filter)
-  {
-    map.ExpectKeyGetValue(MIN_INDEX, filter.current_min_index_);
-    map.ExpectKeyGetValue(OVERLAP, filter.overlap_);
-    map.ExpectKeyGetValue(FILTER1, *filter.filter1_);
-    map.ExpectKeyGetValue(FILTER2, *filter.filter2_);
-  }
+  uint64_t  current_min_index_{};
+  uint64_t  overlap_;
+  FilterPtr filter1_;
+  FilterPtr filter2_;
 };
 
-}  // namespace serializers
 }  // namespace fetch
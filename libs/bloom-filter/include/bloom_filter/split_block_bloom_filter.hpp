@@ -0,0 +1,123 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace fetch {
+
+class BitVector;
+
+/*
+ * A split block (register blocked) Bloom filter. Every key maps onto a single 256-bit block, which
+ * is aligned so that it never straddles a cache line, and sets exactly one bit in each of the
+ * block's eight 32-bit words. A query is therefore a single memory access followed by one vector
+ * test.
+ *
+ * Keys are expected to be 32-byte digests, whose bytes are already uniformly distributed and are
+ * used directly: the top five bits of each digest word select the bit within the matching block
+ * word, and the XOR of all eight words selects the block. Keys of any other length are first
+ * reduced with SHA-256.
+ *
+ * The filter storage is a flat array of blocks with no indirection, so that it may be written to
+ * and restored from disk verbatim.
+ */
+class SplitBlockBloomFilter
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+  using Keys           = std::vector<ConstByteArray>;
+
+  enum
+  {
+    KEY_SIZE                = 32,
+    WORDS_PER_BLOCK         = 8,
+    BLOCK_SIZE              = WORDS_PER_BLOCK * sizeof(uint32_t),
+    BLOCK_ALIGNMENT         = 64,
+    DEFAULT_LOG2_NUM_BLOCKS = 15,
+    MAX_LOG2_NUM_BLOCKS     = 27
+  };
+
+  /*
+   * Construct an empty filter of (1 << log2_num_blocks) blocks. The default is 1 MiB.
+   */
+  explicit SplitBlockBloomFilter(uint32_t log2_num_blocks = DEFAULT_LOG2_NUM_BLOCKS);
+  SplitBlockBloomFilter(SplitBlockBloomFilter const &) = delete;
+  SplitBlockBloomFilter(SplitBlockBloomFilter &&)      = default;
+  ~SplitBlockBloomFilter()                             = default;
+
+  SplitBlockBloomFilter &operator=(SplitBlockBloomFilter const &) = delete;
+  SplitBlockBloomFilter &operator=(SplitBlockBloomFilter &&) = default;
+
+  /*
+   * Set the bits of the filter corresponding to the key
+   */
+  void Add(ConstByteArray const &key);
+
+  /*
+   * Check if the key matches the filter. Returns false if the key had never been added; true if it
+   * had been added or is a false positive.
+   */
+  bool Match(ConstByteArray const &key) const;
+
+  /*
+   * Check a batch of keys against the filter. Bit i of matches is set iff keys[i] matches. The
+   * blocks of a batch are prefetched together so that their cache misses overlap. Returns the
+   * number of matching keys.
+   */
+  std::size_t MatchMany(Keys const &keys, BitVector &matches) const;
+
+  /*
+   * Empty the filter (set all bits to zero). Preserves the filter size.
+   */
+  void Reset();
+
+  uint32_t    log2_num_blocks() const;
+  std::size_t num_blocks() const;
+
+  /*
+   * Raw access to the block array, of size_bytes() bytes
+   */
+  std::size_t    size_bytes() const;
+  uint8_t const *data() const;
+  uint8_t *      data();
+
+private:
+  struct KeyWords
+  {
+    uint32_t words[WORDS_PER_BLOCK];
+  };
+
+  static void LoadKey(ConstByteArray const &key, KeyWords &key_words);
+
+  std::size_t     BlockIndex(KeyWords const &key_words) const;
+  uint32_t *      Block(std::size_t index);
+  uint32_t const *Block(std::size_t index) const;
+
+  uint32_t                   log2_num_blocks_;
+  uint32_t                   block_mask_;
+  std::unique_ptr<uint8_t[]> storage_;
+  uint8_t *                  blocks_{nullptr};
+};
+
+}  // namespace fetch
@@ -17,19 +17,48 @@
 //------------------------------------------------------------------------------
 
 #include "bloom_filter/progressive_bloom_filter.hpp"
+#include "core/bitvector.hpp"
 #include "core/byte_array/const_byte_array.hpp"
+#include "logging/logging.hpp"
 
+#include <cassert>
 #include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
 
 namespace fetch {
 namespace {
 
 constexpr char const *LOGGING_NAME = "ProgBloom";
 
+constexpr uint64_t FILE_MAGIC   = 0x4d4f4f4c42425053;  // "SPBBLOOM"
+constexpr uint32_t FILE_VERSION = 1;
+
+/**
+ * On disk header. It is padded to a whole cache line so that the blocks which follow it keep their
+ * alignment when the file is mapped.
+ */
+struct FileHeader
+{
+  uint64_t magic;
+  uint32_t version;
+  uint32_t log2_num_blocks;
+  uint64_t current_min_index;
+  uint64_t overlap;
+  uint8_t  reserved[32];
+};
+
+static_assert(sizeof(FileHeader) == SplitBlockBloomFilter::BLOCK_ALIGNMENT,
+              "Header must preserve block alignment");
+
 }  // namespace
 
-ProgressiveBloomFilter::ProgressiveBloomFilter(uint64_t const overlap)
+ProgressiveBloomFilter::ProgressiveBloomFilter(uint64_t const overlap,
+                                               uint32_t const log2_num_blocks)
   : overlap_{overlap}
+  , filter1_{std::make_unique<SplitBlockBloomFilter>(log2_num_blocks)}
+  , filter2_{std::make_unique<SplitBlockBloomFilter>(log2_num_blocks)}
 {}
 
 std::pair<bool, std::size_t> ProgressiveBloomFilter::Match(
@@ -42,7 +71,30 @@ std::pair<bool, std::size_t> ProgressiveBloomFilter::Match(
     return {false, 0u};
   }
 
-  return filter1_->Match(element);
+  return {filter1_->Match(element), SplitBlockBloomFilter::WORDS_PER_BLOCK};
+}
+
+std::size_t ProgressiveBloomFilter::MatchMany(Keys const &elements, Indices const &element_indices,
+                                              BitVector &matches) const
+{
+  assert(elements.size() == element_indices.size());
+
+  std::size_t count = filter1_->MatchMany(elements, matches);
+
+  // elements outside of the window can never be reported as matches
+  for (std::size_t i = 0; i < element_indices.size(); ++i)
+  {
+    if (matches.bit(i) && !IsInCurrentRange(element_indices[i]))
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Match out of range: ", element_indices[i],
+                     " min: ", current_min_index_, " max: ", current_min_index_ + (overlap_ * 2u));
+
+      matches.set(i, 0);
+      --count;
+    }
+  }
+
+  return count;
 }
 
 void ProgressiveBloomFilter::Add(fetch::byte_array::ConstByteArray const &element,
@@ -83,4 +135,82 @@ void ProgressiveBloomFilter::Reset()
   current_min_index_ = 0u;
 }
 
+/**
+ * Write both filters to the specified file in the flat, mappable format
+ *
+ * @param filename The path of the file to be (over)written
+ */
+void ProgressiveBloomFilter::Save(std::string const &filename) const
+{
+  FileHeader header{};
+  header.magic             = FILE_MAGIC;
+  header.version           = FILE_VERSION;
+  header.log2_num_blocks   = filter1_->log2_num_blocks();
+  header.current_min_index = current_min_index_;
+  header.overlap           = overlap_;
+
+  auto const size = static_cast<std::streamsize>(filter1_->size_bytes());
+
+  std::ofstream out(filename, std::ios::binary | std::ios::out | std::ios::trunc);
+  out.write(reinterpret_cast<char const *>(&header), sizeof(header));
+  out.write(reinterpret_cast<char const *>(filter1_->data()), size);
+  out.write(reinterpret_cast<char const *>(filter2_->data()), size);
+
+  if (!out)
+  {
+    throw std::runtime_error("Unable to write Bloom filter file: " + filename);
+  }
+}
+
+/**
+ * Restore both filters from a file previously written by Save. The blocks are read straight into
+ * the filter storage.
+ *
+ * @param filename The path of the file to be loaded
+ */
+void ProgressiveBloomFilter::Load(std::string const &filename)
+{
+  std::ifstream in(filename, std::ios::binary | std::ios::in | std::ios::ate);
+  if (!in.is_open())
+  {
+    throw std::runtime_error("Unable to open Bloom filter file: " + filename);
+  }
+
+  auto const file_size = static_cast<std::size_t>(in.tellg());
+  in.seekg(0);
+
+  FileHeader header{};
+  if (file_size < sizeof(header) || !in.read(reinterpret_cast<char *>(&header), sizeof(header)))
+  {
+    throw std::runtime_error("Bloom filter file is truncated");
+  }
+
+  if ((header.magic != FILE_MAGIC) || (header.version != FILE_VERSION) ||
+      (header.log2_num_blocks > SplitBlockBloomFilter::MAX_LOG2_NUM_BLOCKS))
+  {
+    throw std::runtime_error("Bloom filter file has an unrecognised header");
+  }
+
+  auto filter1 = std::make_unique<SplitBlockBloomFilter>(header.log2_num_blocks);
+  auto filter2 = std::make_unique<SplitBlockBloomFilter>(header.log2_num_blocks);
+
+  std::size_t const size = filter1->size_bytes();
+  if (file_size != sizeof(header) + (2 * size))
+  {
+    throw std::runtime_error("Bloom filter file size does not match its header");
+  }
+
+  auto const stream_size = static_cast<std::streamsize>(size);
+  if (!in.read(reinterpret_cast<char *>(filter1->data()), stream_size) ||
+      !in.read(reinterpret_cast<char *>(filter2->data()), stream_size))
+  {
+    throw std::runtime_error("Unable to read Bloom filter file: " + filename);
+  }
+
+  current_min_index_ = header.current_min_index;
+  overlap_           = header.overlap;
+  filter1_           = std::move(filter1);
+  filter2_           = std::move(filter2);
+}
+
 }  // namespace fetch
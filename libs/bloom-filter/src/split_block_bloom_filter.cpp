@@ -0,0 +1,221 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "bloom_filter/split_block_bloom_filter.hpp"
+#include "core/bitvector.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/sha256.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace fetch {
+namespace {
+
+// Number of blocks prefetched ahead of being tested by MatchMany
+constexpr std::size_t BATCH_SIZE = 16;
+
+// The top bits of each key word select one of the 32 bits of the matching block word
+constexpr uint32_t BIT_SHIFT = 27;
+
+#if defined(__AVX2__)
+
+inline __m256i KeyMask(uint32_t const *words)
+{
+  __m256i const key = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(words));
+  return _mm256_sllv_epi32(_mm256_set1_epi32(1), _mm256_srli_epi32(key, BIT_SHIFT));
+}
+
+inline void SetBits(uint32_t *block, uint32_t const *words)
+{
+  auto *const   target  = reinterpret_cast<__m256i *>(block);
+  __m256i const current = _mm256_load_si256(target);
+  _mm256_store_si256(target, _mm256_or_si256(current, KeyMask(words)));
+}
+
+inline bool TestBits(uint32_t const *block, uint32_t const *words)
+{
+  __m256i const current = _mm256_load_si256(reinterpret_cast<__m256i const *>(block));
+  return _mm256_testc_si256(current, KeyMask(words)) != 0;
+}
+
+#else
+
+inline void SetBits(uint32_t *block, uint32_t const *words)
+{
+  for (std::size_t i = 0; i < SplitBlockBloomFilter::WORDS_PER_BLOCK; ++i)
+  {
+    block[i] |= 1u << (words[i] >> BIT_SHIFT);
+  }
+}
+
+inline bool TestBits(uint32_t const *block, uint32_t const *words)
+{
+  uint32_t missing{0};
+  for (std::size_t i = 0; i < SplitBlockBloomFilter::WORDS_PER_BLOCK; ++i)
+  {
+    uint32_t const bit = 1u << (words[i] >> BIT_SHIFT);
+    missing |= bit & ~block[i];
+  }
+
+  return missing == 0;
+}
+
+#endif
+
+}  // namespace
+
+SplitBlockBloomFilter::SplitBlockBloomFilter(uint32_t log2_num_blocks)
+  : log2_num_blocks_{log2_num_blocks}
+  , block_mask_{(1u << log2_num_blocks) - 1u}
+{
+  assert(log2_num_blocks <= MAX_LOG2_NUM_BLOCKS);
+
+  // over allocate so that the first block can be placed on a cache line boundary
+  std::size_t const capacity = size_bytes() + BLOCK_ALIGNMENT;
+  storage_                   = std::make_unique<uint8_t[]>(capacity);
+
+  auto const address = reinterpret_cast<std::uintptr_t>(storage_.get());
+  auto const offset  = (BLOCK_ALIGNMENT - (address % BLOCK_ALIGNMENT)) % BLOCK_ALIGNMENT;
+  blocks_            = storage_.get() + offset;
+
+  Reset();
+}
+
+void SplitBlockBloomFilter::Add(ConstByteArray const &key)
+{
+  KeyWords key_words;
+  LoadKey(key, key_words);
+
+  SetBits(Block(BlockIndex(key_words)), key_words.words);
+}
+
+bool SplitBlockBloomFilter::Match(ConstByteArray const &key) const
+{
+  KeyWords key_words;
+  LoadKey(key, key_words);
+
+  return TestBits(Block(BlockIndex(key_words)), key_words.words);
+}
+
+std::size_t SplitBlockBloomFilter::MatchMany(Keys const &keys, BitVector &matches) const
+{
+  matches = BitVector{keys.size()};
+
+  KeyWords        key_words[BATCH_SIZE];
+  uint32_t const *blocks[BATCH_SIZE];
+
+  std::size_t count{0};
+  for (std::size_t start = 0; start < keys.size(); start += BATCH_SIZE)
+  {
+    std::size_t const batch = std::min(BATCH_SIZE, keys.size() - start);
+
+    // resolve and request every block of the batch before touching any of them
+    for (std::size_t i = 0; i < batch; ++i)
+    {
+      LoadKey(keys[start + i], key_words[i]);
+      blocks[i] = Block(BlockIndex(key_words[i]));
+      __builtin_prefetch(blocks[i]);
+    }
+
+    for (std::size_t i = 0; i < batch; ++i)
+    {
+      if (TestBits(blocks[i], key_words[i].words))
+      {
+        matches.set(start + i, 1);
+        ++count;
+      }
+    }
+  }
+
+  return count;
+}
+
+void SplitBlockBloomFilter::Reset()
+{
+  std::memset(blocks_, 0, size_bytes());
+}
+
+uint32_t SplitBlockBloomFilter::log2_num_blocks() const
+{
+  return log2_num_blocks_;
+}
+
+std::size_t SplitBlockBloomFilter::num_blocks() const
+{
+  return std::size_t{1} << log2_num_blocks_;
+}
+
+std::size_t SplitBlockBloomFilter::size_bytes() const
+{
+  return num_blocks() * BLOCK_SIZE;
+}
+
+uint8_t const *SplitBlockBloomFilter::data() const
+{
+  return blocks_;
+}
+
+uint8_t *SplitBlockBloomFilter::data()
+{
+  return blocks_;
+}
+
+void SplitBlockBloomFilter::LoadKey(ConstByteArray const &key, KeyWords &key_words)
+{
+  if (key.size() == KEY_SIZE)
+  {
+    std::memcpy(key_words.words, key.pointer(), KEY_SIZE);
+  }
+  else
+  {
+    auto const digest = crypto::Hash<crypto::SHA256>(key);
+    assert(digest.size() == KEY_SIZE);
+
+    std::memcpy(key_words.words, digest.pointer(), KEY_SIZE);
+  }
+}
+
+std::size_t SplitBlockBloomFilter::BlockIndex(KeyWords const &key_words) const
+{
+  // only the low bits of the fold are used, these are independent of the bit selectors
+  uint32_t fold{0};
+  for (uint32_t word : key_words.words)
+  {
+    fold ^= word;
+  }
+
+  return fold & block_mask_;
+}
+
+uint32_t *SplitBlockBloomFilter::Block(std::size_t index)
+{
+  return reinterpret_cast<uint32_t *>(blocks_ + (index * BLOCK_SIZE));
+}
+
+uint32_t const *SplitBlockBloomFilter::Block(std::size_t index) const
+{
+  return reinterpret_cast<uint32_t const *>(blocks_ + (index * BLOCK_SIZE));
+}
+
+}  // namespace fetch
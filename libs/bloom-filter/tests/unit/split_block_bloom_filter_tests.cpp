@@ -0,0 +1,219 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "bloom_filter/progressive_bloom_filter.hpp"
+#include "bloom_filter/split_block_bloom_filter.hpp"
+#include "core/bitvector.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/sha256.hpp"
+
+#include "gmock/gmock.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+using namespace fetch;
+
+using fetch::byte_array::ConstByteArray;
+using Keys = SplitBlockBloomFilter::Keys;
+
+constexpr uint32_t LOG2_NUM_BLOCKS = 10;
+
+ConstByteArray MakeDigest(std::size_t index)
+{
+  return crypto::Hash<crypto::SHA256>(std::to_string(index));
+}
+
+Keys MakeDigests(std::size_t offset, std::size_t count)
+{
+  Keys keys;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    keys.push_back(MakeDigest(offset + i));
+  }
+
+  return keys;
+}
+
+TEST(SplitBlockBloomFilterTests, empty_filter_matches_nothing)
+{
+  SplitBlockBloomFilter filter{LOG2_NUM_BLOCKS};
+
+  for (auto const &key : MakeDigests(0, 1000))
+  {
+    EXPECT_FALSE(filter.Match(key));
+  }
+}
+
+TEST(SplitBlockBloomFilterTests, added_keys_always_match)
+{
+  SplitBlockBloomFilter filter{LOG2_NUM_BLOCKS};
+
+  auto const keys = MakeDigests(0, 1000);
+  for (auto const &key : keys)
+  {
+    filter.Add(key);
+  }
+
+  for (auto const &key : keys)
+  {
+    EXPECT_TRUE(filter.Match(key));
+  }
+
+  // keys which are not digests are reduced before use
+  filter.Add("a");
+  EXPECT_TRUE(filter.Match("a"));
+}
+
+TEST(SplitBlockBloomFilterTests, false_positive_rate_is_low)
+{
+  SplitBlockBloomFilter filter{LOG2_NUM_BLOCKS};
+
+  // roughly 8 bits per key for a 32 KiB filter
+  for (auto const &key : MakeDigests(0, 32 * 1024))
+  {
+    filter.Add(key);
+  }
+
+  std::size_t false_positives{0};
+  for (auto const &key : MakeDigests(1000000, 10000))
+  {
+    false_positives += filter.Match(key) ? 1u : 0u;
+  }
+
+  EXPECT_LT(false_positives, 500u);
+}
+
+TEST(SplitBlockBloomFilterTests, match_many_agrees_with_match)
+{
+  SplitBlockBloomFilter filter{LOG2_NUM_BLOCKS};
+
+  for (auto const &key : MakeDigests(0, 500))
+  {
+    filter.Add(key);
+  }
+
+  // straddle the added range and use a count which is not a multiple of the batch size
+  auto const keys = MakeDigests(250, 517);
+
+  BitVector         matches;
+  std::size_t const count = filter.MatchMany(keys, matches);
+
+  ASSERT_EQ(matches.size(), keys.size());
+
+  std::size_t expected_count{0};
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    bool const expected = filter.Match(keys[i]);
+    EXPECT_EQ(matches.bit(i) != 0, expected);
+    expected_count += expected ? 1u : 0u;
+  }
+
+  EXPECT_EQ(count, expected_count);
+  EXPECT_GE(count, 250u);
+}
+
+TEST(SplitBlockBloomFilterTests, reset_clears_all_keys)
+{
+  SplitBlockBloomFilter filter{LOG2_NUM_BLOCKS};
+
+  auto const keys = MakeDigests(0, 100);
+  for (auto const &key : keys)
+  {
+    filter.Add(key);
+  }
+
+  filter.Reset();
+
+  BitVector matches;
+  EXPECT_EQ(filter.MatchMany(keys, matches), 0u);
+}
+
+TEST(SplitBlockBloomFilterTests, progressive_match_many_excludes_out_of_range_elements)
+{
+  ProgressiveBloomFilter filter{100, LOG2_NUM_BLOCKS};
+
+  auto const keys = MakeDigests(0, 3);
+  filter.Add(keys[0], 10, 1);
+  filter.Add(keys[1], 150, 1);
+
+  BitVector matches;
+  EXPECT_EQ(filter.MatchMany(keys, {10, 250, 20}, matches), 1u);
+  EXPECT_TRUE(matches.bit(0));
+  EXPECT_FALSE(matches.bit(1));
+  EXPECT_FALSE(matches.bit(2));
+}
+
+TEST(SplitBlockBloomFilterTests, progressive_filter_survives_save_and_load)
+{
+  std::string const filename = "split_block_bloom_filter_tests.db";
+
+  // the first half only lives in the current generation, the second half in both
+  auto const keys = MakeDigests(0, 100);
+  {
+    ProgressiveBloomFilter filter{100, LOG2_NUM_BLOCKS};
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+      filter.Add(keys[i], (i < 50) ? 10 + i : 100 + i, 101);
+    }
+
+    filter.Save(filename);
+  }
+
+  // the geometry and window are both restored from the file
+  ProgressiveBloomFilter restored{1};
+  restored.Load(filename);
+
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    EXPECT_TRUE(restored.Match(keys[i], (i < 50) ? 10 + i : 100 + i).first);
+  }
+
+  // rolling over after loading must only retain the second generation
+  restored.Add(MakeDigest(1000), 250, 201);
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    EXPECT_EQ(restored.Match(keys[i], 150).first, i >= 50);
+  }
+
+  std::remove(filename.c_str());
+}
+
+TEST(SplitBlockBloomFilterTests, progressive_filter_rejects_corrupt_file)
+{
+  std::string const filename = "split_block_bloom_filter_corrupt.db";
+
+  {
+    std::ofstream out(filename, std::ios::binary | std::ios::out | std::ios::trunc);
+    out << "not a bloom filter";
+  }
+
+  ProgressiveBloomFilter filter{100, LOG2_NUM_BLOCKS};
+  EXPECT_THROW(filter.Load(filename), std::runtime_error);
+
+  std::remove(filename.c_str());
+}
+
+}  // namespace
@@ -23,9 +23,15 @@
 #include "crypto/identity.hpp"
 
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 namespace fetch {
+namespace crypto {
+
+class BatchVerifier;
+
+}  // namespace crypto
 namespace chain {
 
 /**
@@ -137,6 +143,9 @@ public:
   bool Verify();
   bool IsVerified() const;
   bool IsSignedByFromAddress() const;
+
+  static void Verify(std::vector<std::shared_ptr<Transaction>> const &transactions,
+                     crypto::BatchVerifier &                          verifier);
   /// @}
 
   // Operators
@@ -19,6 +19,7 @@
 #include "chain/transaction.hpp"
 #include "chain/transaction_serializer.hpp"
 #include "chain/transaction_validity_period.hpp"
+#include "crypto/batch_verifier.hpp"
 #include "crypto/verifier.hpp"
 
 #include <algorithm>
@@ -90,6 +91,71 @@ bool Transaction::Verify()
   return verified_;
 }
 
+/**
+ * Verify the contents of a series of transactions as a single batch
+ *
+ * The signatures of all the transactions are checked in one pass of the batch verifier. Only if the
+ * batch as a whole fails are the results for the individual transactions examined.
+ *
+ * @param transactions The set of transactions to be verified
+ * @param verifier The batch verifier to be used
+ */
+void Transaction::Verify(std::vector<std::shared_ptr<Transaction>> const &transactions,
+                         crypto::BatchVerifier &                          verifier)
+{
+  struct SignatoryRange
+  {
+    std::size_t first{0};
+    std::size_t count{0};
+  };
+
+  std::vector<SignatoryRange> ranges(transactions.size());
+
+  verifier.Reset();
+
+  // add all the signatures of the unverified transactions into the batch
+  for (std::size_t i = 0; i < transactions.size(); ++i)
+  {
+    auto &tx = *transactions[i];
+
+    if (tx.verification_completed_)
+    {
+      continue;
+    }
+
+    ConstByteArray const payload = TransactionSerializer::SerializePayload(tx);
+
+    ranges[i].first = verifier.size();
+    for (auto const &signatory : tx.signatories_)
+    {
+      verifier.Add(signatory.identity, payload, signatory.signature);
+    }
+    ranges[i].count = tx.signatories_.size();
+  }
+
+  bool const all_verified = verifier.Verify();
+
+  // update the status of each of the transactions
+  for (std::size_t i = 0; i < transactions.size(); ++i)
+  {
+    auto &tx = *transactions[i];
+
+    if (tx.verification_completed_)
+    {
+      continue;
+    }
+
+    // only valid when there are more that 1 signature present and that they matched the computed
+    // payload.
+    auto const &range = ranges[i];
+    tx.verified_      = (range.count != 0) &&
+                   (all_verified || verifier.IsValid(range.first, range.count));
+
+    // signal that the verification has been completed
+    tx.verification_completed_ = true;
+  }
+}
+
 bool Transaction::IsSignedByFromAddress() const
 {
   auto const it = std::find_if(
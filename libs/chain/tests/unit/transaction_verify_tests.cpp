@@ -0,0 +1,107 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/address.hpp"
+#include "chain/transaction.hpp"
+#include "chain/transaction_builder.hpp"
+#include "crypto/batch_verifier.hpp"
+#include "crypto/ecdsa.hpp"
+#include "crypto/prover.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::chain::Address;
+using fetch::chain::Transaction;
+using fetch::chain::TransactionBuilder;
+using fetch::crypto::BatchVerifier;
+using fetch::crypto::ECDSASigner;
+using fetch::crypto::Identity;
+using fetch::crypto::Prover;
+
+using TransactionPtr  = std::shared_ptr<Transaction>;
+using TransactionList = std::vector<TransactionPtr>;
+
+/**
+ * Prover whose identity has the size of a public key but is not a point on the curve
+ */
+class MalformedProver : public Prover
+{
+public:
+  Identity identity() const override
+  {
+    return Identity{ConstByteArray{std::string(64, '\x01')}};
+  }
+
+  void Load(ConstByteArray const & /*private_key*/) override
+  {}
+
+  ConstByteArray Sign(ConstByteArray const & /*message*/) const override
+  {
+    return ConstByteArray{std::string(64, '\x02')};
+  }
+};
+
+TransactionPtr BuildTransaction(Prover const &prover, uint64_t counter)
+{
+  Address const address{prover.identity()};
+
+  return TransactionBuilder()
+      .From(address)
+      .Transfer(address, 10)
+      .ValidUntil(1000)
+      .ChargeLimit(500)
+      .Counter(counter)
+      .Signer(prover.identity())
+      .Seal()
+      .Sign(prover)
+      .Build();
+}
+
+TEST(TransactionVerifyTests, MalformedSignerIsIsolatedInBatch)
+{
+  static constexpr std::size_t MALFORMED_INDEX = 3;
+
+  ECDSASigner     signer;
+  MalformedProver malformed;
+
+  TransactionList batch{};
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    auto const &prover = (i == MALFORMED_INDEX) ? static_cast<Prover const &>(malformed)
+                                                : static_cast<Prover const &>(signer);
+    batch.emplace_back(BuildTransaction(prover, i));
+  }
+
+  BatchVerifier verifier;
+  Transaction::Verify(batch, verifier);
+
+  for (std::size_t i = 0; i < batch.size(); ++i)
+  {
+    EXPECT_EQ(batch[i]->IsVerified(), i != MALFORMED_INDEX);
+  }
+}
+
+}  // namespace
@@ -505,12 +505,22 @@ bool Constellation::OnRestorePreviousData(ledger::GenesisFileCreator::ConsensusP
   dag_ = GenerateDAG(cfg_, "dag_db_", true, external_identity_);
 
   // create the chain
-  chain_ = std::make_unique<MainChain>(ledger::MainChain::Mode::LOAD_PERSISTENT_DB, true);
+  auto const chain_store_type = cfg_.features.IsEnabled("mapped-block-store")
+                                    ? MainChain::StoreType::MAPPED_LOG
+                                    : MainChain::StoreType::OBJECT_STORE;
+
+  chain_ = std::make_unique<MainChain>(ledger::MainChain::Mode::LOAD_PERSISTENT_DB, true,
+                                       chain_store_type);
 
   // necessary when doing state validity checks
+  auto const execution_mode = cfg_.features.IsEnabled("pipelined-execution")
+                                  ? ExecutionManager::Mode::PIPELINED
+                                  : ExecutionManager::Mode::SLICE_BARRIER;
+
   execution_manager_ = std::make_shared<ExecutionManager>(
       cfg_.num_executors, cfg_.log2_num_lanes, storage_,
-      [this] { return std::make_shared<Executor>(storage_); }, tx_status_cache_);
+      [this] { return std::make_shared<Executor>(storage_); }, tx_status_cache_, execution_mode,
+      cfg_.features.IsEnabled("state-prefetch"));
 
   if (!GenesisSanityChecks(genesis_status))
   {
@@ -606,6 +616,11 @@ bool Constellation::OnBringUpExternalNetwork(
       std::make_shared<MuddleStatusModule>()};
 
   http_ = std::make_unique<HttpServer>(http_network_manager_);
+  if (cfg_.features.IsEnabled("concurrent-http"))
+  {
+    http_->EnableConcurrentDispatch(HTTP_THREADS);
+  }
+
   // Display "/"
   http_->AddDefaultRootModule();
 
@@ -0,0 +1,105 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+using fetch::BitVector;
+
+constexpr std::size_t NUM_MASKS = 1024;
+
+std::vector<BitVector> GenerateMasks(std::size_t num_bits)
+{
+  std::mt19937_64 rng{42};
+
+  std::vector<BitVector> masks(NUM_MASKS, BitVector{num_bits});
+  for (auto &mask : masks)
+  {
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+      mask.set(rng() % num_bits, 1);
+    }
+  }
+
+  return masks;
+}
+
+void BitVector_Copy(benchmark::State &state)
+{
+  auto const masks = GenerateMasks(static_cast<std::size_t>(state.range(0)));
+
+  std::size_t index{0};
+  for (auto _ : state)
+  {
+    BitVector copy{masks[index++ % NUM_MASKS]};
+    benchmark::DoNotOptimize(copy);
+  }
+}
+
+void BitVector_CollisionViaAnd(benchmark::State &state)
+{
+  auto const masks = GenerateMasks(static_cast<std::size_t>(state.range(0)));
+
+  std::size_t index{0};
+  for (auto _ : state)
+  {
+    BitVector const collisions = masks[index % NUM_MASKS] & masks[(index + 1) % NUM_MASKS];
+    benchmark::DoNotOptimize(collisions.PopCount() == 0);
+    ++index;
+  }
+}
+
+void BitVector_CollisionViaIntersects(benchmark::State &state)
+{
+  auto const masks = GenerateMasks(static_cast<std::size_t>(state.range(0)));
+
+  std::size_t index{0};
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(masks[index % NUM_MASKS].Intersects(masks[(index + 1) % NUM_MASKS]));
+    ++index;
+  }
+}
+
+void BitVector_OrAssign(benchmark::State &state)
+{
+  auto const masks = GenerateMasks(static_cast<std::size_t>(state.range(0)));
+
+  BitVector   accumulator{static_cast<std::size_t>(state.range(0))};
+  std::size_t index{0};
+  for (auto _ : state)
+  {
+    accumulator |= masks[index++ % NUM_MASKS];
+    benchmark::DoNotOptimize(accumulator);
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BitVector_Copy)->Arg(16)->Arg(256)->Arg(1024);
+BENCHMARK(BitVector_CollisionViaAnd)->Arg(16)->Arg(256)->Arg(1024);
+BENCHMARK(BitVector_CollisionViaIntersects)->Arg(16)->Arg(256)->Arg(1024);
+BENCHMARK(BitVector_OrAssign)->Arg(16)->Arg(256)->Arg(1024);
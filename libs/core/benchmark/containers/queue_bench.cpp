@@ -0,0 +1,120 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/containers/lock_free_queue.hpp"
+#include "core/containers/queue.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t QUEUE_SIZE         = 1u << 10u;
+constexpr std::size_t ELEMENTS_PER_CYCLE = 1u << 16u;
+
+using Element = uint64_t;
+
+template <typename Queue>
+void ProducerConsumer(Queue &queue, std::size_t num_producers, std::size_t num_consumers)
+{
+  std::vector<std::thread> threads;
+  threads.reserve(num_producers + num_consumers);
+
+  auto const spread = [](std::size_t total, std::size_t workers, std::size_t index) {
+    return (total / workers) + ((index < (total % workers)) ? 1u : 0u);
+  };
+
+  for (std::size_t i = 0; i < num_producers; ++i)
+  {
+    std::size_t const count = spread(ELEMENTS_PER_CYCLE, num_producers, i);
+
+    threads.emplace_back([&queue, count]() {
+      for (std::size_t j = 0; j < count; ++j)
+      {
+        queue.Push(Element{j});
+      }
+    });
+  }
+
+  for (std::size_t i = 0; i < num_consumers; ++i)
+  {
+    std::size_t const count = spread(ELEMENTS_PER_CYCLE, num_consumers, i);
+
+    threads.emplace_back([&queue, count]() {
+      Element element{};
+      for (std::size_t j = 0; j < count; ++j)
+      {
+        if (!queue.Pop(element, std::chrono::seconds{10}))
+        {
+          throw std::runtime_error("Timed out waiting for queue element");
+        }
+
+        benchmark::DoNotOptimize(element);
+      }
+    });
+  }
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+}
+
+template <typename Queue>
+void QueueContention(benchmark::State &state)
+{
+  auto const num_producers = static_cast<std::size_t>(state.range(0));
+  auto const num_consumers = static_cast<std::size_t>(state.range(1));
+
+  // allocate on the heap since the padded queues can be large
+  auto queue = std::make_unique<Queue>();
+
+  for (auto _ : state)
+  {
+    ProducerConsumer(*queue, num_producers, num_consumers);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * ELEMENTS_PER_CYCLE));
+}
+
+void ContentionArguments(benchmark::internal::Benchmark *b)
+{
+  for (int64_t producers : {1, 4, 16, 64})
+  {
+    for (int64_t consumers : {1, 4, 16, 64})
+    {
+      b->Args({producers, consumers});
+    }
+  }
+
+  b->ArgNames({"producers", "consumers"})->UseRealTime()->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK_TEMPLATE(QueueContention, fetch::core::MPMCQueue<Element, QUEUE_SIZE>)
+    ->Apply(ContentionArguments);
+BENCHMARK_TEMPLATE(QueueContention, fetch::core::LockFreeQueue<Element, QUEUE_SIZE>)
+    ->Apply(ContentionArguments);
+
+}  // namespace
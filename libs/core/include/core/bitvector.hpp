@@ -18,13 +18,15 @@
 //------------------------------------------------------------------------------
 
 #include "core/serializers/group_definitions.hpp"
-#include "vectorise/memory/shared_array.hpp"
+#include "meta/log2.hpp"
 #include "vectorise/platform.hpp"
 
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
 #include <initializer_list>
+#include <iosfwd>
+#include <memory>
 #include <type_traits>
 
 namespace fetch {
@@ -32,15 +34,86 @@ namespace fetch {
 class BitVector
 {
 public:
-  using Block           = uint64_t;
-  using UnderlyingArray = memory::SharedArray<Block>;
+  using Block = uint64_t;
 
   enum
   {
     ELEMENT_BIT_SIZE = sizeof(Block) << 3u,
     LOG_BITS         = meta::Log2(ELEMENT_BIT_SIZE),
     BIT_MASK         = (1ull << LOG_BITS) - 1,
-    SIMD_SIZE        = UnderlyingArray::E_SIMD_COUNT
+    SIMD_SIZE        = 4,  ///< Number of blocks in a 256-bit register
+    INLINE_BIT_SIZE  = SIMD_SIZE * ELEMENT_BIT_SIZE
+  };
+
+  /**
+   * Block storage for the bit vector. Vectors of up to INLINE_BIT_SIZE bits (which covers all the
+   * lane masks used in practice) are stored inline, avoiding any heap allocation when they are
+   * created or copied. The storage is always padded with zeroed blocks to a whole number of SIMD
+   * registers.
+   */
+  class UnderlyingArray
+  {
+  public:
+    // Construction / Destruction
+    explicit UnderlyingArray(std::size_t n = 0);
+    UnderlyingArray(UnderlyingArray const &other);
+    UnderlyingArray(UnderlyingArray &&other) noexcept;
+    ~UnderlyingArray() = default;
+
+    void SetAllZero();
+
+    Block *pointer()
+    {
+      return heap_ ? heap_.get() : inline_;
+    }
+
+    Block const *pointer() const
+    {
+      return heap_ ? heap_.get() : inline_;
+    }
+
+    std::size_t size() const
+    {
+      return size_;
+    }
+
+    std::size_t padded_size() const
+    {
+      return (size_ + (SIMD_SIZE - 1)) & ~std::size_t{SIMD_SIZE - 1};
+    }
+
+    Block &operator[](std::size_t n)
+    {
+      assert(n < padded_size());
+      return pointer()[n];
+    }
+
+    Block const &operator[](std::size_t n) const
+    {
+      assert(n < padded_size());
+      return pointer()[n];
+    }
+
+    Block &At(std::size_t n)
+    {
+      return operator[](n);
+    }
+
+    Block const &At(std::size_t n) const
+    {
+      return operator[](n);
+    }
+
+    // Operators
+    UnderlyingArray &operator=(UnderlyingArray const &other);
+    UnderlyingArray &operator=(UnderlyingArray &&other) noexcept;
+
+  private:
+    using HeapArray = std::unique_ptr<Block[]>;
+
+    std::size_t size_{0};
+    HeapArray   heap_{};
+    Block       inline_[SIMD_SIZE]{};
   };
 
   class Iterator : public std::iterator<std::output_iterator_tag, std::size_t>
@@ -62,7 +135,8 @@ public:
 
   // Construction  / Destruction
   explicit BitVector(std::size_t n = 0);
-  BitVector(BitVector const &other);
+  BitVector(BitVector const &other) = default;
+  BitVector(BitVector &&other) noexcept;
   ~BitVector() = default;
 
   void Resize(std::size_t bit_size);
@@ -84,6 +158,8 @@ public:
   UnderlyingArray &      data();
 
   std::size_t PopCount() const;
+  bool        Intersects(BitVector const &other) const;
+  bool        IsSubsetOf(BitVector const &other) const;
 
   void conditional_flip(std::size_t block, std::size_t bit, uint64_t base);
   void conditional_flip(std::size_t bit, uint64_t base);
@@ -100,6 +176,9 @@ public:
   Block &      operator()(std::size_t n);
   Block const &operator()(std::size_t n) const;
 
+  BitVector &operator=(BitVector const &other) = default;
+  BitVector &operator=(BitVector &&other) noexcept;
+
   bool operator==(BitVector const &other) const;
   bool operator!=(BitVector const &other) const;
 
@@ -0,0 +1,513 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+#include "meta/log2.hpp"
+#include "meta/type_traits.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace fetch {
+namespace core {
+
+/**
+ * Lock-free, bounded, multi producer, multi consumer fixed-length queue
+ *
+ * The implementation follows the sequence counter design of Dmitry Vyukov. Each slot carries a
+ * sequence number that tells producers and consumers whether it is ready to be written or read,
+ * so the only contended operation is a single CAS on the respective head / tail index. Slots and
+ * indices are padded out to cache lines to avoid false sharing between adjacent slots.
+ *
+ * The interface mirrors that of `Queue` so the two can be substituted for one another. Threads
+ * only fall back to blocking on a condition variable when the queue is empty (consumers) or full
+ * (producers), and the mutex is only touched on the fast path when there is a thread waiting.
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam SIZE The max size of the queue
+ */
+template <typename T, std::size_t SIZE>
+class LockFreeQueue
+{
+public:
+  static constexpr std::size_t QUEUE_LENGTH = SIZE;
+
+  using Element = T;
+
+  // Construction / Destruction
+  LockFreeQueue();
+  LockFreeQueue(LockFreeQueue const &) = delete;
+  LockFreeQueue(LockFreeQueue &&)      = delete;
+  ~LockFreeQueue()                     = default;
+
+  /// @name Queue Interaction
+  /// @{
+  T Pop();
+  template <typename R, typename P>
+  bool Pop(T &value, std::chrono::duration<R, P> const &duration);
+  template <typename U>
+  meta::EnableIfSame<T, meta::Decay<U>> Push(U &&element);
+  template <typename U>
+  meta::EnableIfSame<T, meta::Decay<U>> Push(U &&element, std::size_t &count);
+  template <typename U, typename R, typename P>
+  meta::EnableIfSame<T, meta::Decay<U>, bool> Push(U &&element, std::size_t &count,
+                                                   std::chrono::duration<R, P> const &duration);
+  /// @}
+
+  /// @name Non-blocking Interaction
+  /// @{
+  bool TryPop(T &value);
+  template <typename U>
+  meta::EnableIfSame<T, meta::Decay<U>, bool> TryPush(U &&element);
+  std::size_t size() const;
+  /// @}
+
+  // Operators
+  LockFreeQueue &operator=(LockFreeQueue const &) = delete;
+  LockFreeQueue &operator=(LockFreeQueue &&) = delete;
+
+private:
+  using Clock     = std::chrono::steady_clock;
+  using Timepoint = Clock::time_point;
+  using Counter   = std::atomic<std::size_t>;
+
+  static constexpr std::size_t MASK            = SIZE - 1;
+  static constexpr std::size_t CACHE_LINE_SIZE = 64;
+  static constexpr std::size_t SPIN_LIMIT      = 64;
+
+  template <std::size_t USED>
+  using Padding = std::array<uint8_t, CACHE_LINE_SIZE - (USED % CACHE_LINE_SIZE)>;
+
+  struct Slot
+  {
+    Counter                              sequence{0};
+    T                                    value{};
+    Padding<sizeof(Counter) + sizeof(T)> padding{};
+  };
+
+  struct PaddedCounter
+  {
+    Counter                  value{0};
+    Padding<sizeof(Counter)> padding{};
+  };
+
+  using Array = std::array<Slot, SIZE>;
+
+  bool Dequeue(T &value);
+  template <typename U>
+  bool Enqueue(U &&element);
+  template <typename Operation>
+  bool Block(Operation &&operation, std::condition_variable &condition, Counter &waiters,
+             Timepoint const *deadline);
+  void Notify(std::condition_variable &condition, Counter &waiters);
+
+  PaddedCounter enqueue_pos_{};  ///< The write index
+  PaddedCounter dequeue_pos_{};  ///< The read index
+  Array         queue_{};        ///< The main element container
+
+  /// @name Blocking Support
+  /// @{
+  std::mutex              wait_lock_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  Counter                 waiting_consumers_{0};
+  Counter                 waiting_producers_{0};
+  /// @}
+
+  // static asserts
+  static_assert(meta::IsLog2(SIZE), "Queue size must be a valid power of 2");
+  static_assert(SIZE >= 2, "Queue size must be at least 2");
+  static_assert(std::is_default_constructible<T>::value, "T must be default constructable");
+  static_assert(std::is_move_assignable<T>::value, "T must be move assignable");
+};
+
+template <typename T, std::size_t N>
+LockFreeQueue<T, N>::LockFreeQueue()
+{
+  for (std::size_t i = 0; i < N; ++i)
+  {
+    queue_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+/**
+ * Attempt to pop an element from the queue without blocking
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam N The max size of the queue
+ * @param value The reference to the value to be populated
+ * @return true if an element was extracted, otherwise false if the queue was empty
+ */
+template <typename T, std::size_t N>
+bool LockFreeQueue<T, N>::TryPop(T &value)
+{
+  if (Dequeue(value))
+  {
+    Notify(not_full_, waiting_producers_);
+    return true;
+  }
+
+  return false;
+}
+
+/**
+ * Attempt to push an element onto the queue without blocking
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam N The max size of the queue
+ * @param element The universal reference to the element
+ * @return true if the element was added, otherwise false if the queue was full
+ */
+template <typename T, std::size_t N>
+template <typename U>
+meta::EnableIfSame<T, meta::Decay<U>, bool> LockFreeQueue<T, N>::TryPush(U &&element)
+{
+  if (Enqueue(std::forward<U>(element)))
+  {
+    Notify(not_empty_, waiting_consumers_);
+    return true;
+  }
+
+  return false;
+}
+
+/**
+ * Claim the next populated slot and move its value out
+ *
+ * @param value The reference to the value to be populated
+ * @return true if an element was extracted, otherwise false if the queue was empty
+ */
+template <typename T, std::size_t N>
+bool LockFreeQueue<T, N>::Dequeue(T &value)
+{
+  std::size_t pos = dequeue_pos_.value.load(std::memory_order_relaxed);
+
+  for (;;)
+  {
+    Slot &            slot     = queue_[pos & MASK];
+    std::size_t const sequence = slot.sequence.load(std::memory_order_acquire);
+    auto const        diff =
+        static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos + 1);
+
+    if (diff == 0)
+    {
+      // the slot has been populated, attempt to claim it
+      if (dequeue_pos_.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+      {
+        value = std::move(slot.value);
+        slot.sequence.store(pos + MASK + 1, std::memory_order_release);
+
+        return true;
+      }
+    }
+    else if (diff < 0)
+    {
+      // the producer has not yet reached this slot, i.e. the queue is empty
+      return false;
+    }
+    else
+    {
+      // another consumer has claimed the slot, reload the read index and try again
+      pos = dequeue_pos_.value.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+/**
+ * Claim the next free slot and move the element into it
+ *
+ * @param element The universal reference to the element
+ * @return true if the element was added, otherwise false if the queue was full
+ */
+template <typename T, std::size_t N>
+template <typename U>
+bool LockFreeQueue<T, N>::Enqueue(U &&element)
+{
+  std::size_t pos = enqueue_pos_.value.load(std::memory_order_relaxed);
+
+  for (;;)
+  {
+    Slot &            slot     = queue_[pos & MASK];
+    std::size_t const sequence = slot.sequence.load(std::memory_order_acquire);
+    auto const diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+
+    if (diff == 0)
+    {
+      // the slot is free, attempt to claim it
+      if (enqueue_pos_.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+      {
+        slot.value = std::forward<U>(element);
+        slot.sequence.store(pos + 1, std::memory_order_release);
+
+        return true;
+      }
+    }
+    else if (diff < 0)
+    {
+      // the consumers have not yet drained this slot, i.e. the queue is full
+      return false;
+    }
+    else
+    {
+      // another producer has claimed the slot, reload the write index and try again
+      pos = enqueue_pos_.value.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+/**
+ * Get the approximate number of elements in the queue
+ *
+ * @return The number of elements
+ */
+template <typename T, std::size_t N>
+std::size_t LockFreeQueue<T, N>::size() const
+{
+  std::size_t const tail = dequeue_pos_.value.load(std::memory_order_relaxed);
+  std::size_t const head = enqueue_pos_.value.load(std::memory_order_relaxed);
+
+  return (head > tail) ? (head - tail) : 0;
+}
+
+/**
+ * Pop an element from the queue
+ *
+ * If no element is available then the function will block until an element
+ * is available.
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam N The max size of the queue
+ * @return The element retrieved from the queue
+ */
+template <typename T, std::size_t N>
+T LockFreeQueue<T, N>::Pop()
+{
+  T value;
+  Block([this, &value]() { return Dequeue(value); }, not_empty_, waiting_consumers_, nullptr);
+  Notify(not_full_, waiting_producers_);
+
+  return value;
+}
+
+/**
+ * Pop an element from the queue with a specified maximum wait duration
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam N The max size of the queue
+ * @tparam Rep The tick representation for the duration
+ * @tparam Per The tick period for the duration
+ * @param value The reference to the value to be populated
+ * @param duration The maximum amount of time to wait for an element
+ * @return true if an element was extracted, otherwise false
+ */
+template <typename T, std::size_t N>
+template <typename Rep, typename Per>
+bool LockFreeQueue<T, N>::Pop(T &value, std::chrono::duration<Rep, Per> const &duration)
+{
+  if (TryPop(value))
+  {
+    return true;
+  }
+
+  // a zero duration is a simple poll of the queue
+  if (duration <= std::chrono::duration<Rep, Per>::zero())
+  {
+    return false;
+  }
+
+  Timepoint const deadline = Clock::now() + duration;
+  if (!Block([this, &value]() { return Dequeue(value); }, not_empty_, waiting_consumers_,
+             &deadline))
+  {
+    return false;
+  }
+
+  Notify(not_full_, waiting_producers_);
+  return true;
+}
+
+/**
+ * Push an element onto the queue
+ *
+ * If the queue is full this function will block until an element can be added
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam U Has the same meaning as @refitem(T), but is inferred from method
+ * call, rather than provided at object construction time to leverage universal
+ * reference feature, and so eliminate necessity to implement multiple method overloads.
+ * @tparam N The max size of the queue
+ * @param element The universal reference to the element
+ */
+template <typename T, std::size_t N>
+template <typename U>
+meta::EnableIfSame<T, meta::Decay<U>> LockFreeQueue<T, N>::Push(U &&element)
+{
+  Block([this, &element]() { return Enqueue(std::forward<U>(element)); }, not_full_,
+        waiting_producers_, nullptr);
+  Notify(not_empty_, waiting_consumers_);
+}
+
+/**
+ * Push an element onto the queue
+ *
+ * If the queue is full this function will block until an element can be added
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam U Has the same meaning as @refitem(T), but is inferred from method
+ * call, rather than provided at object construction time to leverage universal
+ * reference feature, and so eliminate necessity to implement multiple method overloads.
+ * @tparam N The max size of the queue
+ * @param element The universal reference to the element
+ * @param count Number of enqueued elements still waiting in the queue to be processed.
+ */
+template <typename T, std::size_t N>
+template <typename U>
+meta::EnableIfSame<T, meta::Decay<U>> LockFreeQueue<T, N>::Push(U &&element, std::size_t &count)
+{
+  Push(std::forward<U>(element));
+  count = size();
+}
+
+/**
+ * Push an element onto the queue
+ *
+ * If the queue is full this function will block until an element can be added
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam U Has the same meaning as @refitem(T), but is inferred from method
+ * call, rather than provided at object construction time to leverage universal
+ * reference feature, and so eliminate necessity to implement multiple method overloads.
+ * @tparam N The max size of the queue
+ * @param element The universal reference to the element
+ * @param count Number of enqueued elements still waiting in the queue to be processed.
+ * @param duration The maximum amount of time to wait for being able to insert the element
+ * @return true if an element was inserted in given timeout, otherwise false
+ */
+template <typename T, std::size_t N>
+template <typename U, typename Rep, typename Per>
+meta::EnableIfSame<T, meta::Decay<U>, bool> LockFreeQueue<T, N>::Push(
+    U &&element, std::size_t &count, std::chrono::duration<Rep, Per> const &duration)
+{
+  Timepoint const deadline = Clock::now() + duration;
+
+  if (!Block([this, &element]() { return Enqueue(std::forward<U>(element)); }, not_full_,
+             waiting_producers_, &deadline))
+  {
+    return false;
+  }
+
+  Notify(not_empty_, waiting_consumers_);
+  count = size();
+
+  return true;
+}
+
+/**
+ * Repeatedly attempt a non-blocking operation until it succeeds or the deadline expires
+ *
+ * The operation is first retried a small number of times (yielding in between) before the thread
+ * registers itself as a waiter and sleeps on the condition variable. The operation must not
+ * notify waiters itself since it can be invoked while the wait lock is held.
+ *
+ * @param operation The non-blocking operation to attempt
+ * @param condition The condition variable to wait on
+ * @param waiters The waiter counter associated with the condition variable
+ * @param deadline The optional deadline, nullptr to wait indefinitely
+ * @return true if the operation succeeded, otherwise false
+ */
+template <typename T, std::size_t N>
+template <typename Operation>
+bool LockFreeQueue<T, N>::Block(Operation &&operation, std::condition_variable &condition,
+                                Counter &waiters, Timepoint const *deadline)
+{
+  for (std::size_t spin = 0; spin < SPIN_LIMIT; ++spin)
+  {
+    if (operation())
+    {
+      return true;
+    }
+
+    std::this_thread::yield();
+  }
+
+  // register as a waiter before the final checks so that the notifying thread is guaranteed to
+  // either observe the waiter or have its update observed by the operation below
+  waiters.fetch_add(1);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  bool success{false};
+  {
+    std::unique_lock<std::mutex> lock(wait_lock_);
+
+    for (;;)
+    {
+      if (operation())
+      {
+        success = true;
+        break;
+      }
+
+      if (deadline == nullptr)
+      {
+        condition.wait(lock);
+      }
+      else if (std::cv_status::timeout == condition.wait_until(lock, *deadline))
+      {
+        success = operation();
+        break;
+      }
+    }
+  }
+
+  waiters.fetch_sub(1);
+
+  return success;
+}
+
+/**
+ * Wake up a thread waiting on the specified condition, if there is one
+ *
+ * @param condition The condition variable to signal
+ * @param waiters The waiter counter associated with the condition variable
+ */
+template <typename T, std::size_t N>
+void LockFreeQueue<T, N>::Notify(std::condition_variable &condition, Counter &waiters)
+{
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  if (waiters.load(std::memory_order_relaxed) != 0)
+  {
+    // acquiring the lock ensures the waiter is either about to re-check the queue or is already
+    // waiting on the condition variable
+    {
+      FETCH_LOCK(wait_lock_);
+    }
+
+    condition.notify_one();
+  }
+}
+
+}  // namespace core
+}  // namespace fetch
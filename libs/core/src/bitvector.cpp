@@ -19,18 +19,266 @@
 #include "core/bitvector.hpp"
 #include "vectorise/platform.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+#include <utility>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 namespace fetch {
+namespace {
+
+using Block = BitVector::Block;
+
+constexpr std::size_t SIMD_SIZE = BitVector::SIMD_SIZE;
+
+// The kernels below operate on the padded storage (a whole number of SIMD registers), relying on
+// the padding blocks always being zero.
+
+#if defined(__AVX2__)
+
+__m256i Load(Block const *ptr)
+{
+  return _mm256_loadu_si256(reinterpret_cast<__m256i const *>(ptr));
+}
+
+void Store(Block *ptr, __m256i value)
+{
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(ptr), value);
+}
+
+/**
+ * Count the set bits of a register using the nibble lookup table approach
+ *
+ * @param value The input register
+ * @return The per 64-bit lane bit counts
+ */
+__m256i CountBits(__m256i value)
+{
+  __m256i const lookup =
+      _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2,
+                       2, 3, 2, 3, 3, 4);
+  __m256i const low_mask = _mm256_set1_epi8(0x0f);
+
+  __m256i const low    = _mm256_and_si256(value, low_mask);
+  __m256i const high   = _mm256_and_si256(_mm256_srli_epi16(value, 4), low_mask);
+  __m256i const counts = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, low),
+                                         _mm256_shuffle_epi8(lookup, high));
+
+  return _mm256_sad_epu8(counts, _mm256_setzero_si256());
+}
+
+#endif
+
+template <typename ScalarOp>
+void Apply(Block *dst, Block const *a, Block const *b, std::size_t padded_blocks, ScalarOp &&op)
+{
+  for (std::size_t i = 0; i < padded_blocks; ++i)
+  {
+    dst[i] = op(a[i], b[i]);
+  }
+}
+
+void And(Block *dst, Block const *a, Block const *b, std::size_t padded_blocks)
+{
+#if defined(__AVX2__)
+  for (std::size_t i = 0; i < padded_blocks; i += SIMD_SIZE)
+  {
+    Store(dst + i, _mm256_and_si256(Load(a + i), Load(b + i)));
+  }
+#else
+  Apply(dst, a, b, padded_blocks, [](Block x, Block y) { return x & y; });
+#endif
+}
+
+void Or(Block *dst, Block const *a, Block const *b, std::size_t padded_blocks)
+{
+#if defined(__AVX2__)
+  for (std::size_t i = 0; i < padded_blocks; i += SIMD_SIZE)
+  {
+    Store(dst + i, _mm256_or_si256(Load(a + i), Load(b + i)));
+  }
+#else
+  Apply(dst, a, b, padded_blocks, [](Block x, Block y) { return x | y; });
+#endif
+}
+
+void Xor(Block *dst, Block const *a, Block const *b, std::size_t padded_blocks)
+{
+#if defined(__AVX2__)
+  for (std::size_t i = 0; i < padded_blocks; i += SIMD_SIZE)
+  {
+    Store(dst + i, _mm256_xor_si256(Load(a + i), Load(b + i)));
+  }
+#else
+  Apply(dst, a, b, padded_blocks, [](Block x, Block y) { return x ^ y; });
+#endif
+}
+
+std::size_t CountSetBits(Block const *a, std::size_t padded_blocks)
+{
+#if defined(__AVX2__)
+  __m256i total = _mm256_setzero_si256();
+  for (std::size_t i = 0; i < padded_blocks; i += SIMD_SIZE)
+  {
+    total = _mm256_add_epi64(total, CountBits(Load(a + i)));
+  }
+
+  Block lanes[SIMD_SIZE];
+  Store(lanes, total);
+
+  return static_cast<std::size_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+#else
+  std::size_t count{0};
+  for (std::size_t i = 0; i < padded_blocks; ++i)
+  {
+    count += static_cast<std::size_t>(platform::CountSetBits(a[i]));
+  }
+
+  return count;
+#endif
+}
+
+/// Determine if any bit is set in both a and b
+bool AnyCommonBits(Block const *a, Block const *b, std::size_t padded_blocks)
+{
+#if defined(__AVX2__)
+  for (std::size_t i = 0; i < padded_blocks; i += SIMD_SIZE)
+  {
+    __m256i const va = Load(a + i);
+    if (!_mm256_testz_si256(va, Load(b + i)))
+    {
+      return true;
+    }
+  }
+#else
+  for (std::size_t i = 0; i < padded_blocks; ++i)
+  {
+    if ((a[i] & b[i]) != 0)
+    {
+      return true;
+    }
+  }
+#endif
+
+  return false;
+}
+
+/// Determine if every bit set in a is also set in b
+bool AllBitsContained(Block const *a, Block const *b, std::size_t padded_blocks)
+{
+#if defined(__AVX2__)
+  for (std::size_t i = 0; i < padded_blocks; i += SIMD_SIZE)
+  {
+    // testc checks that (~b & a) == 0
+    if (!_mm256_testc_si256(Load(b + i), Load(a + i)))
+    {
+      return false;
+    }
+  }
+#else
+  for (std::size_t i = 0; i < padded_blocks; ++i)
+  {
+    if ((a[i] & ~b[i]) != 0)
+    {
+      return false;
+    }
+  }
+#endif
+
+  return true;
+}
+
+}  // namespace
+
+BitVector::UnderlyingArray::UnderlyingArray(std::size_t n)
+  : size_{n}
+{
+  if (n > SIMD_SIZE)
+  {
+    heap_ = HeapArray{new Block[padded_size()]()};
+  }
+}
+
+BitVector::UnderlyingArray::UnderlyingArray(UnderlyingArray const &other)
+  : UnderlyingArray(other.size_)
+{
+  std::memcpy(pointer(), other.pointer(), padded_size() * sizeof(Block));
+}
+
+BitVector::UnderlyingArray::UnderlyingArray(UnderlyingArray &&other) noexcept
+  : size_{other.size_}
+  , heap_{std::move(other.heap_)}
+{
+  std::copy(other.inline_, other.inline_ + SIMD_SIZE, inline_);
+  other.size_ = 0;
+}
+
+BitVector::UnderlyingArray &BitVector::UnderlyingArray::operator=(UnderlyingArray const &other)
+{
+  if (this != &other)
+  {
+    if (padded_size() != other.padded_size())
+    {
+      *this = UnderlyingArray(other.size_);
+    }
+
+    size_ = other.size_;
+    std::memcpy(pointer(), other.pointer(), padded_size() * sizeof(Block));
+  }
+
+  return *this;
+}
+
+BitVector::UnderlyingArray &BitVector::UnderlyingArray::operator=(UnderlyingArray &&other) noexcept
+{
+  if (this != &other)
+  {
+    size_ = other.size_;
+    heap_ = std::move(other.heap_);
+    std::copy(other.inline_, other.inline_ + SIMD_SIZE, inline_);
+    other.size_ = 0;
+  }
+
+  return *this;
+}
+
+void BitVector::UnderlyingArray::SetAllZero()
+{
+  std::fill(pointer(), pointer() + padded_size(), Block{0});
+}
 
 BitVector::BitVector(std::size_t n)
 {
   Resize(n);
 }
 
-BitVector::BitVector(BitVector const &other)
-  : data_(other.data_.Copy())
+BitVector::BitVector(BitVector &&other) noexcept
+  : data_(std::move(other.data_))
   , size_(other.size_)
   , blocks_(other.blocks_)
-{}
+{
+  other.size_   = 0;
+  other.blocks_ = 0;
+}
+
+BitVector &BitVector::operator=(BitVector &&other) noexcept
+{
+  if (this != &other)
+  {
+    data_   = std::move(other.data_);
+    size_   = other.size_;
+    blocks_ = other.blocks_;
+
+    other.size_   = 0;
+    other.blocks_ = 0;
+  }
+
+  return *this;
+}
 
 /**
  * Resize the vector to n bits
@@ -39,20 +287,14 @@ BitVector::BitVector(BitVector const &other)
  */
 void BitVector::Resize(std::size_t bit_size)
 {
-  UnderlyingArray old = data_;
-
   // calculate
   std::size_t const num_elements = (bit_size + (ELEMENT_BIT_SIZE - 1)) / ELEMENT_BIT_SIZE;
 
+  // the storage is zero initialised
   data_   = UnderlyingArray(num_elements);
   blocks_ = num_elements;
   size_   = bit_size;
 
-  if (bit_size > 0)
-  {
-    SetAllZero();  // TODO(issue 29): Only set those
-  }
-
   // TODO(issue 29): Copy data;
 }
 
@@ -65,6 +307,12 @@ void BitVector::SetAllOne()
 {
   auto *buffer = reinterpret_cast<uint8_t *>(data_.pointer());
   std::memset(buffer, 0xFF, data_.size() * sizeof(Block));
+
+  // clear the bits beyond the end of the vector in the last block
+  if ((size_ & BIT_MASK) != 0)
+  {
+    data_[blocks_ - 1] = (Block{1} << (size_ & BIT_MASK)) - 1u;
+  }
 }
 
 bool BitVector::RemapTo(BitVector &dst) const
@@ -265,10 +513,7 @@ bool BitVector::operator!=(BitVector const &other) const
 BitVector &BitVector::operator^=(BitVector const &other)
 {
   assert(size_ == other.size_);
-  for (std::size_t i = 0; i < blocks_; ++i)
-  {
-    data_[i] ^= other.data_[i];
-  }
+  Xor(data_.pointer(), data_.pointer(), other.data_.pointer(), data_.padded_size());
 
   return *this;
 }
@@ -284,10 +529,7 @@ BitVector BitVector::operator^(BitVector const &other) const
 BitVector &BitVector::operator&=(BitVector const &other)
 {
   assert(size_ == other.size_);
-  for (std::size_t i = 0; i < blocks_; ++i)
-  {
-    data_[i] &= other.data_[i];
-  }
+  And(data_.pointer(), data_.pointer(), other.data_.pointer(), data_.padded_size());
 
   return *this;
 }
@@ -302,21 +544,14 @@ BitVector BitVector::operator&(BitVector const &other) const
 
 void BitVector::InlineAndAssign(BitVector const &a, BitVector const &b)
 {
-  for (std::size_t i = 0; i < blocks_; ++i)
-  {
-    assert(i < data_.size());
-
-    data_[i] = a.data_[i] & b.data_[i];
-  }
+  assert((a.blocks_ == blocks_) && (b.blocks_ == blocks_));
+  And(data_.pointer(), a.data_.pointer(), b.data_.pointer(), data_.padded_size());
 }
 
 BitVector &BitVector::operator|=(BitVector const &other)
 {
   assert(size_ == other.size_);
-  for (std::size_t i = 0; i < blocks_; ++i)
-  {
-    data_[i] |= other.data_[i];
-  }
+  Or(data_.pointer(), data_.pointer(), other.data_.pointer(), data_.padded_size());
 
   return *this;
 }
@@ -410,14 +645,32 @@ BitVector::UnderlyingArray &BitVector::data()
 
 std::size_t BitVector::PopCount() const
 {
-  std::size_t ret = 0;
+  return std::min(CountSetBits(data_.pointer(), data_.padded_size()), size_);
+}
 
-  for (std::size_t i = 0; i < blocks_; ++i)
-  {
-    ret += static_cast<std::size_t>(platform::CountSetBits(data_[i]));
-  }
+/**
+ * Determine if this and the other bit vector have any set bits in common. Equivalent to
+ * `(a & b).PopCount() != 0` without creating the intermediate vector.
+ *
+ * @param other The other bit vector (of the same size)
+ * @return true if at least one bit is set in both vectors, otherwise false
+ */
+bool BitVector::Intersects(BitVector const &other) const
+{
+  assert(size_ == other.size_);
+  return AnyCommonBits(data_.pointer(), other.data_.pointer(), data_.padded_size());
+}
 
-  return std::min(ret, size_);
+/**
+ * Determine if all of the set bits of this bit vector are also set in the other one
+ *
+ * @param other The other bit vector (of the same size)
+ * @return true if this is a subset of other, otherwise false
+ */
+bool BitVector::IsSubsetOf(BitVector const &other) const
+{
+  assert(size_ == other.size_);
+  return AllBitsContained(data_.pointer(), other.data_.pointer(), data_.padded_size());
 }
 
 std::ostream &operator<<(std::ostream &s, BitVector const &b)
@@ -520,6 +773,12 @@ BitVector::Iterator &BitVector::Iterator::Next(bool is_begin)
     shift_mask = ~0ull;
   }
 
+  // the bit vector might not fill the last block, in which case the search can run off the end
+  if (index_ > end_)
+  {
+    index_ = end_;
+  }
+
   return *this;
 }
 
@@ -16,6 +16,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include "core/containers/lock_free_queue.hpp"
 #include "core/containers/queue.hpp"
 
 #include "gtest/gtest.h"
@@ -211,4 +212,56 @@ TEST_F(QueueTests, ProducerConsumer_1p_50c_MPMCQueue)
   ProducerConsumerTest<1, 50>(queue);
 }
 
+TEST_F(QueueTests, ProducerConsumer_50p_50c_LockFreeQueue)
+{
+  fetch::core::LockFreeQueue<Element, QUEUE_SIZE> queue;
+  ProducerConsumerTest<50, 50>(queue);
+}
+
+TEST_F(QueueTests, ProducerConsumer_50p_1c_LockFreeQueue)
+{
+  fetch::core::LockFreeQueue<Element, QUEUE_SIZE> queue;
+  ProducerConsumerTest<50, 1>(queue);
+}
+
+TEST_F(QueueTests, ProducerConsumer_1p_50c_LockFreeQueue)
+{
+  fetch::core::LockFreeQueue<Element, QUEUE_SIZE> queue;
+  ProducerConsumerTest<1, 50>(queue);
+}
+
+TEST_F(QueueTests, ProducerConsumer_1p_1c_LockFreeQueue)
+{
+  fetch::core::LockFreeQueue<Element, QUEUE_SIZE> queue;
+  ProducerConsumerTest<1, 1>(queue);
+}
+
+TEST_F(QueueTests, LockFreeQueueTimeouts)
+{
+  fetch::core::LockFreeQueue<int, 4> queue;
+
+  int value{0};
+  EXPECT_FALSE(queue.Pop(value, std::chrono::milliseconds::zero()));
+  EXPECT_FALSE(queue.Pop(value, std::chrono::milliseconds{10}));
+
+  std::size_t count{0};
+  for (int i = 0; i < 4; ++i)
+  {
+    EXPECT_TRUE(queue.Push(i, count, std::chrono::milliseconds{10}));
+    EXPECT_EQ(count, static_cast<std::size_t>(i + 1));
+  }
+
+  // the queue is full
+  EXPECT_FALSE(queue.TryPush(4));
+  EXPECT_FALSE(queue.Push(4, count, std::chrono::milliseconds{10}));
+
+  for (int i = 0; i < 4; ++i)
+  {
+    ASSERT_TRUE(queue.Pop(value, std::chrono::milliseconds::zero()));
+    EXPECT_EQ(value, i);
+  }
+
+  EXPECT_EQ(queue.size(), 0u);
+}
+
 }  // namespace
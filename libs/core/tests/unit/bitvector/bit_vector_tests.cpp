@@ -22,7 +22,12 @@
 
 #include "gtest/gtest.h"
 
+#include <cstddef>
 #include <cstdint>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
 
 using fetch::BitVector;
 
@@ -418,3 +423,139 @@ TEST(BitVectorTests, IterateSetBits)
   EXPECT_EQ(itr, end);
   EXPECT_EQ(expected_index_itr, expected_indexes.end());
 }
+
+TEST(BitVectorTests, IterateSetBitsOfPartialBlock)
+{
+  BitVector src{8};
+  src.set(1, 1);
+  src.set(6, 1);
+
+  std::vector<std::size_t> indexes{};
+  for (std::size_t const index : src)
+  {
+    indexes.push_back(index);
+  }
+
+  EXPECT_EQ(indexes, (std::vector<std::size_t>{1, 6}));
+
+  BitVector empty{8};
+  EXPECT_EQ(empty.begin(), empty.end());
+}
+
+TEST(BitVectorTests, SetOperationsMatchBitwiseReference)
+{
+  std::mt19937_64 rng{42};
+
+  // sizes either side of the inline storage limit
+  for (std::size_t const size : {1u, 16u, 63u, 64u, 200u, 256u, 257u, 512u, 1000u})
+  {
+    for (std::size_t iteration = 0; iteration < 20; ++iteration)
+    {
+      BitVector a{size};
+      BitVector b{size};
+
+      std::vector<bool> ref_a(size);
+      std::vector<bool> ref_b(size);
+
+      // use sparse vectors so that disjoint cases are common
+      for (std::size_t i = 0; i < size; ++i)
+      {
+        ref_a[i] = (rng() % 16u) == 0;
+        ref_b[i] = (rng() % 16u) == 0;
+        a.set(i, ref_a[i] ? 1u : 0u);
+        b.set(i, ref_b[i] ? 1u : 0u);
+      }
+
+      BitVector const and_result = a & b;
+      BitVector const or_result  = a | b;
+      BitVector const xor_result = a ^ b;
+
+      std::size_t expected_count{0};
+      bool        expected_intersects{false};
+      bool        expected_subset{true};
+      for (std::size_t i = 0; i < size; ++i)
+      {
+        EXPECT_EQ(and_result.bit(i), (ref_a[i] && ref_b[i]) ? 1u : 0u);
+        EXPECT_EQ(or_result.bit(i), (ref_a[i] || ref_b[i]) ? 1u : 0u);
+        EXPECT_EQ(xor_result.bit(i), (ref_a[i] != ref_b[i]) ? 1u : 0u);
+
+        expected_count += ref_a[i] ? 1u : 0u;
+        expected_intersects |= ref_a[i] && ref_b[i];
+        expected_subset &= !ref_a[i] || ref_b[i];
+      }
+
+      EXPECT_EQ(a.PopCount(), expected_count);
+      EXPECT_EQ(a.Intersects(b), expected_intersects);
+      EXPECT_EQ(a.Intersects(b), and_result.PopCount() != 0);
+      EXPECT_EQ(a.IsSubsetOf(b), expected_subset);
+      EXPECT_TRUE(and_result.IsSubsetOf(a));
+      EXPECT_TRUE(a.IsSubsetOf(or_result));
+    }
+  }
+}
+
+TEST(BitVectorTests, IntersectsAndSubsetEdgeCases)
+{
+  for (std::size_t const size : {16u, 256u, 1024u})
+  {
+    BitVector empty{size};
+    BitVector full{size};
+    full.SetAllOne();
+
+    BitVector last{size};
+    last.set(size - 1, 1);
+
+    EXPECT_FALSE(empty.Intersects(full));
+    EXPECT_FALSE(empty.Intersects(empty));
+    EXPECT_TRUE(full.Intersects(last));
+    EXPECT_TRUE(last.Intersects(last));
+
+    EXPECT_TRUE(empty.IsSubsetOf(empty));
+    EXPECT_TRUE(empty.IsSubsetOf(last));
+    EXPECT_TRUE(last.IsSubsetOf(full));
+    EXPECT_FALSE(full.IsSubsetOf(last));
+    EXPECT_TRUE(full.IsSubsetOf(full));
+  }
+}
+
+TEST(BitVectorTests, SetAllOneOfPartialBlock)
+{
+  BitVector all{10};
+  all.SetAllOne();
+
+  BitVector manual{10};
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    manual.set(i, 1);
+  }
+
+  EXPECT_EQ(all.PopCount(), 10u);
+  EXPECT_EQ(all, manual);
+  EXPECT_TRUE(all.IsSubsetOf(manual));
+}
+
+TEST(BitVectorTests, CopyAndMoveAreIndependent)
+{
+  for (std::size_t const size : {16u, 1024u})
+  {
+    BitVector original{size};
+    original.set(3, 1);
+
+    BitVector copy{original};
+    copy.set(5, 1);
+    EXPECT_EQ(original.bit(5), 0u);
+    EXPECT_EQ(copy.bit(3), 1u);
+
+    BitVector assigned{};
+    assigned = original;
+    assigned.set(7, 1);
+    EXPECT_EQ(original.bit(7), 0u);
+    EXPECT_EQ(assigned.size(), size);
+
+    BitVector moved{std::move(copy)};
+    EXPECT_EQ(moved.size(), size);
+    EXPECT_EQ(moved.bit(3), 1u);
+    EXPECT_EQ(moved.bit(5), 1u);
+    EXPECT_EQ(moved.PopCount(), 2u);
+  }
+}
@@ -22,6 +22,10 @@
 
 #include "benchmark/benchmark.h"
 
+#include <set>
+#include <unordered_map>
+#include <vector>
+
 using fetch::byte_array::ConstByteArray;
 using fetch::byte_array::ByteArray;
 using fetch::crypto::mcl::Generator;
@@ -130,8 +134,109 @@ void ComputeGroupSignature(benchmark::State &state)
     fetch::crypto::mcl::LagrangeInterpolation(threshold_signatures);
   }
 }
+
+void ComputeGroupSignatureCachedCoefficients(benchmark::State &state)
+{
+  // Create keys
+  fetch::crypto::mcl::details::MCLInitialiser();
+  auto     cabinet_size = static_cast<uint32_t>(state.range(0));
+  uint32_t threshold    = cabinet_size / 2 + 1;
+  auto     outputs      = fetch::crypto::mcl::TrustedDealerGenerateKeys(cabinet_size, threshold);
+
+  fetch::crypto::mcl::LagrangeCoefficients coefficients{cabinet_size};
+
+  // The signer set is fixed so that the coefficients are only computed once
+  std::set<uint32_t> signers;
+  while (signers.size() < threshold)
+  {
+    signers.insert(static_cast<uint32_t>(rng() % cabinet_size));
+  }
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    // Generate a random message
+    ConstByteArray msg = GenerateRandomData(256);
+    std::unordered_map<uint32_t, fetch::crypto::mcl::Signature> threshold_signatures;
+    for (auto const &sign_index : signers)
+    {
+      auto signature = fetch::crypto::mcl::SignShare(msg, outputs[sign_index].private_key_share);
+      threshold_signatures.insert({sign_index, signature});
+    }
+    state.ResumeTiming();
+
+    // Compute group signature
+    fetch::crypto::mcl::LagrangeInterpolation(threshold_signatures, coefficients.Get(signers));
+  }
+}
+
+void VerifyBLSSignatureShares(benchmark::State &state)
+{
+  fetch::crypto::mcl::details::MCLInitialiser();
+  fetch::crypto::mcl::Generator generator;
+  fetch::crypto::mcl::SetGenerator(generator);
+
+  // Create keys
+  auto     cabinet_size = static_cast<uint32_t>(state.range(0));
+  uint32_t threshold    = cabinet_size / 2 + 1;
+  auto     outputs      = fetch::crypto::mcl::TrustedDealerGenerateKeys(cabinet_size, threshold);
+
+  auto const &public_keys = outputs[0].public_key_shares;
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    // Generate a random message and have every member sign it
+    ConstByteArray                             msg = GenerateRandomData(256);
+    std::vector<fetch::crypto::mcl::Signature> signatures;
+    for (uint32_t i = 0; i < cabinet_size; ++i)
+    {
+      signatures.push_back(fetch::crypto::mcl::SignShare(msg, outputs[i].private_key_share));
+    }
+    state.ResumeTiming();
+
+    // Verify the shares one at a time
+    for (uint32_t i = 0; i < cabinet_size; ++i)
+    {
+      fetch::crypto::mcl::VerifySign(public_keys[i], msg, signatures[i], generator);
+    }
+  }
+}
+
+void BatchVerifyBLSSignatureShares(benchmark::State &state)
+{
+  fetch::crypto::mcl::details::MCLInitialiser();
+  fetch::crypto::mcl::Generator generator;
+  fetch::crypto::mcl::SetGenerator(generator);
+
+  // Create keys
+  auto     cabinet_size = static_cast<uint32_t>(state.range(0));
+  uint32_t threshold    = cabinet_size / 2 + 1;
+  auto     outputs      = fetch::crypto::mcl::TrustedDealerGenerateKeys(cabinet_size, threshold);
+
+  auto const &public_keys = outputs[0].public_key_shares;
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    // Generate a random message and have every member sign it
+    ConstByteArray                             msg = GenerateRandomData(256);
+    std::vector<fetch::crypto::mcl::Signature> signatures;
+    for (uint32_t i = 0; i < cabinet_size; ++i)
+    {
+      signatures.push_back(fetch::crypto::mcl::SignShare(msg, outputs[i].private_key_share));
+    }
+    state.ResumeTiming();
+
+    // Verify all the shares with a single pairing check
+    fetch::crypto::mcl::BatchVerifySign(public_keys, msg, signatures, generator);
+  }
+}
 }  // namespace
 
 BENCHMARK(SignBLSSignature)->RangeMultiplier(2)->Range(50, 500);
 BENCHMARK(VerifyBLSSignature)->RangeMultiplier(2)->Range(50, 500);
 BENCHMARK(ComputeGroupSignature)->RangeMultiplier(2)->Range(50, 500);
+BENCHMARK(ComputeGroupSignatureCachedCoefficients)->RangeMultiplier(2)->Range(50, 500);
+BENCHMARK(VerifyBLSSignatureShares)->RangeMultiplier(2)->Range(50, 500);
+BENCHMARK(BatchVerifyBLSSignatureShares)->RangeMultiplier(2)->Range(50, 500);
@@ -0,0 +1,149 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/random/lcg.hpp"
+#include "crypto/batch_sha256.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/merkle_tree.hpp"
+#include "crypto/sha256.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using fetch::byte_array::ConstByteArray;
+using fetch::crypto::BatchSHA256;
+using fetch::crypto::Hash;
+using fetch::crypto::MerkleTree;
+using fetch::crypto::SHA256;
+using fetch::random::LinearCongruentialGenerator;
+
+namespace {
+
+using Buffer = std::vector<uint8_t>;
+
+Buffer GenerateMessages(std::size_t count)
+{
+  LinearCongruentialGenerator rng;
+
+  Buffer messages(count * BatchSHA256::MESSAGE_SIZE_IN_BYTES);
+  for (auto &byte : messages)
+  {
+    byte = static_cast<uint8_t>(rng());
+  }
+
+  return messages;
+}
+
+void SHA256_Individual(benchmark::State &state)
+{
+  auto const count    = static_cast<std::size_t>(state.range(0));
+  auto const messages = GenerateMessages(count);
+  Buffer     digests(count * BatchSHA256::DIGEST_SIZE_IN_BYTES);
+
+  SHA256 hasher{};
+
+  for (auto _ : state)
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      hasher.Reset();
+      hasher.Update(messages.data() + (i * BatchSHA256::MESSAGE_SIZE_IN_BYTES),
+                    BatchSHA256::MESSAGE_SIZE_IN_BYTES);
+      hasher.Final(digests.data() + (i * BatchSHA256::DIGEST_SIZE_IN_BYTES));
+    }
+
+    benchmark::DoNotOptimize(digests.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+template <BatchSHA256::Implementation IMPLEMENTATION>
+void SHA256_Batch(benchmark::State &state)
+{
+  if (!BatchSHA256::IsSupported(IMPLEMENTATION))
+  {
+    state.SkipWithError("Implementation not supported on this platform");
+    return;
+  }
+
+  auto const count    = static_cast<std::size_t>(state.range(0));
+  auto const messages = GenerateMessages(count);
+  Buffer     digests(count * BatchSHA256::DIGEST_SIZE_IN_BYTES);
+
+  for (auto _ : state)
+  {
+    BatchSHA256::Hash(messages.data(), digests.data(), count, IMPLEMENTATION);
+    benchmark::DoNotOptimize(digests.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+void SHA256_ParallelBatch(benchmark::State &state)
+{
+  auto const count    = static_cast<std::size_t>(state.range(0));
+  auto const messages = GenerateMessages(count);
+  Buffer     digests(count * BatchSHA256::DIGEST_SIZE_IN_BYTES);
+
+  for (auto _ : state)
+  {
+    BatchSHA256::ParallelHash(messages.data(), digests.data(), count);
+    benchmark::DoNotOptimize(digests.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+void MerkleTree_CalculateRoot(benchmark::State &state)
+{
+  auto const count = static_cast<std::size_t>(state.range(0));
+
+  MerkleTree tree{count};
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    tree[i] = Hash<SHA256>(std::to_string(i));
+  }
+
+  for (auto _ : state)
+  {
+    tree.CalculateRoot();
+    benchmark::DoNotOptimize(tree.root());
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+}  // namespace
+
+BENCHMARK(SHA256_Individual)->RangeMultiplier(8)->Range(8, 1 << 18);
+BENCHMARK_TEMPLATE(SHA256_Batch, BatchSHA256::Implementation::SCALAR)
+    ->RangeMultiplier(8)
+    ->Range(8, 1 << 18);
+BENCHMARK_TEMPLATE(SHA256_Batch, BatchSHA256::Implementation::AVX2)
+    ->RangeMultiplier(8)
+    ->Range(8, 1 << 18);
+BENCHMARK_TEMPLATE(SHA256_Batch, BatchSHA256::Implementation::SHA_NI)
+    ->RangeMultiplier(8)
+    ->Range(8, 1 << 18);
+BENCHMARK(SHA256_ParallelBatch)->RangeMultiplier(8)->Range(4096, 1 << 18);
+BENCHMARK(MerkleTree_CalculateRoot)->RangeMultiplier(8)->Range(8, 1 << 18);
@@ -19,16 +19,21 @@
 #include "core/byte_array/byte_array.hpp"
 #include "core/byte_array/const_byte_array.hpp"
 #include "core/random/lcg.hpp"
+#include "crypto/batch_verifier.hpp"
 #include "crypto/ecdsa.hpp"
 
 #include "benchmark/benchmark.h"
 
+#include <memory>
 #include <stdexcept>
+#include <vector>
 
+using fetch::crypto::BatchVerifier;
 using fetch::crypto::ECDSASigner;
 using fetch::crypto::ECDSAVerifier;
 using fetch::byte_array::ConstByteArray;
 using fetch::byte_array::ByteArray;
+using fetch::crypto::Verifier;
 using fetch::random::LinearCongruentialGenerator;
 
 namespace {
@@ -37,6 +42,8 @@ using RNG = LinearCongruentialGenerator;
 
 RNG rng;
 
+constexpr std::size_t BATCH_SIGNERS = 8;
+
 template <std::size_t LENGTH>
 ConstByteArray GenerateRandomData()
 {
@@ -80,6 +87,76 @@ void VerifySignature(benchmark::State &state)
   }
 }
 
+struct SignedMessage
+{
+  fetch::crypto::Identity identity;
+  ConstByteArray          message;
+  ConstByteArray          signature;
+};
+
+using SignedMessages = std::vector<SignedMessage>;
+
+SignedMessages GenerateSignedMessages(std::size_t num_messages, std::size_t num_signers)
+{
+  std::vector<std::unique_ptr<ECDSASigner>> signers;
+  for (std::size_t i = 0; i < num_signers; ++i)
+  {
+    signers.emplace_back(std::make_unique<ECDSASigner>());
+  }
+
+  SignedMessages messages;
+  messages.reserve(num_messages);
+  for (std::size_t i = 0; i < num_messages; ++i)
+  {
+    auto const &signer = *signers[i % num_signers];
+    auto        msg    = GenerateRandomData<256>();
+
+    messages.emplace_back(SignedMessage{signer.identity(), msg, signer.Sign(msg)});
+  }
+
+  return messages;
+}
+
+void VerifySignaturesIndividually(benchmark::State &state)
+{
+  auto const messages =
+      GenerateSignedMessages(static_cast<std::size_t>(state.range(0)), BATCH_SIGNERS);
+
+  for (auto _ : state)
+  {
+    // every verification has to decode the public key of the signer
+    for (auto const &entry : messages)
+    {
+      auto verifier = Verifier::Build(entry.identity);
+      benchmark::DoNotOptimize(verifier->Verify(entry.message, entry.signature));
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void VerifySignaturesInBatch(benchmark::State &state)
+{
+  auto const messages =
+      GenerateSignedMessages(static_cast<std::size_t>(state.range(0)), BATCH_SIGNERS);
+
+  BatchVerifier batch;
+  for (auto _ : state)
+  {
+    batch.Reset();
+    for (auto const &entry : messages)
+    {
+      batch.Add(entry.identity, entry.message, entry.signature);
+    }
+
+    benchmark::DoNotOptimize(batch.Verify());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
 }  // namespace
 
 BENCHMARK(VerifySignature);
+BENCHMARK(VerifySignaturesIndividually)->RangeMultiplier(4)->Range(1, 256);
+BENCHMARK(VerifySignaturesInBatch)->RangeMultiplier(4)->Range(1, 256);
@@ -0,0 +1,65 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fetch {
+namespace crypto {
+
+/**
+ * Multi-buffer SHA-256 engine for hashing large numbers of independent, fixed size (64 byte)
+ * messages. This is the shape of the work when computing the internal nodes of a binary merkle
+ * tree (the concatenation of two 32 byte child digests).
+ *
+ * Depending on the platform the messages are hashed with the SHA extensions (SHA-NI), 8 at a time
+ * with AVX2 or with a portable scalar implementation. In all cases the constant padding block,
+ * which is identical for every 64 byte message, has its message schedule precomputed.
+ */
+class BatchSHA256
+{
+public:
+  static constexpr std::size_t MESSAGE_SIZE_IN_BYTES = 64u;
+  static constexpr std::size_t DIGEST_SIZE_IN_BYTES  = 32u;
+
+  enum class Implementation
+  {
+    SCALAR,
+    AVX2,
+    SHA_NI,
+  };
+
+  static Implementation ActiveImplementation();
+  static bool           IsSupported(Implementation implementation);
+  static char const *   ToString(Implementation implementation);
+
+  /// @name Hashing
+  /// @{
+  static void Hash(uint8_t const *messages, uint8_t *digests, std::size_t count);
+  static void Hash(uint8_t const *messages, uint8_t *digests, std::size_t count,
+                   Implementation implementation);
+  static void ParallelHash(uint8_t const *messages, uint8_t *digests, std::size_t count,
+                           std::size_t max_threads = 0);
+  /// @}
+
+  static constexpr std::size_t MIN_MESSAGES_PER_THREAD = 1024u;
+};
+
+}  // namespace crypto
+}  // namespace fetch
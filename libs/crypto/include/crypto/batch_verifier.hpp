@@ -0,0 +1,103 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "crypto/identity.hpp"
+#include "crypto/verifier.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace fetch {
+namespace crypto {
+
+/**
+ * Verifies a batch of signatures in a single pass
+ *
+ * Entries are accumulated with Add() and then checked together with Verify(). The verifiers built
+ * for each identity (and therefore the decoded public keys) are kept between batches so that
+ * repeated signers, which are common when a small number of clients submit many transactions, are
+ * only decoded once.
+ *
+ * Instances are not thread safe. The intended usage is one instance per verifying thread.
+ */
+class BatchVerifier
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+
+  static constexpr std::size_t DEFAULT_MAX_CACHED_KEYS = 1024;
+
+  // Construction / Destruction
+  explicit BatchVerifier(std::size_t max_cached_keys = DEFAULT_MAX_CACHED_KEYS);
+  BatchVerifier(BatchVerifier const &) = delete;
+  BatchVerifier(BatchVerifier &&)      = delete;
+  ~BatchVerifier()                     = default;
+
+  /// @name Batch Building
+  /// @{
+  std::size_t Add(Identity const &identity, ConstByteArray const &data,
+                  ConstByteArray const &signature);
+  void        Reset();
+  /// @}
+
+  /// @name Verification
+  /// @{
+  bool Verify();
+  bool IsValid(std::size_t index) const;
+  bool IsValid(std::size_t first, std::size_t count) const;
+  /// @}
+
+  /// @name Accessors
+  /// @{
+  std::size_t size() const;
+  bool        empty() const;
+  std::size_t cached_keys() const;
+  std::size_t cache_hits() const;
+  /// @}
+
+  // Operators
+  BatchVerifier &operator=(BatchVerifier const &) = delete;
+  BatchVerifier &operator=(BatchVerifier &&) = delete;
+
+private:
+  struct Entry
+  {
+    Identity       identity;
+    ConstByteArray data;
+    ConstByteArray signature;
+    bool           valid{false};
+  };
+
+  using Entries     = std::vector<Entry>;
+  using VerifierPtr = std::unique_ptr<Verifier>;
+  using Cache       = std::unordered_map<ConstByteArray, VerifierPtr>;
+
+  Verifier *LookupVerifier(Identity const &identity);
+
+  std::size_t const max_cached_keys_;
+  Entries           entries_{};
+  Cache             cache_{};
+  std::size_t       cache_hits_{0};
+};
+
+}  // namespace crypto
+}  // namespace fetch
@@ -25,9 +25,11 @@
 #include <cstddef>
 #include <cstdint>
 #include <iomanip>
+#include <map>
 #include <set>
 #include <sstream>
 #include <unordered_map>
+#include <vector>
 
 namespace bn = mcl::bn256;
 
@@ -110,6 +112,68 @@ using CabinetIndex       = uint32_t;
 using SignerRecord       = std::vector<uint8_t>;
 using AggregateSignature = std::pair<Signature, SignerRecord>;
 
+/**
+ * A check that a pair of secret shares is consistent with a set of broadcast coefficients, i.e.
+ * that G^share1 * H^share2 == prod_k coefficients[k]^((rank + 1)^k)
+ */
+struct ShareVerification
+{
+  PrivateKey                    share1;
+  PrivateKey                    share2;
+  std::vector<PublicKey> const *coefficients{nullptr};
+  CabinetIndex                  rank{0};
+};
+
+/**
+ * Lagrange coefficients for the signer sets of a cabinet. The inverses of all the index
+ * differences are computed once for the cabinet, so that the coefficients of a signer set can be
+ * derived without any field inversions. The coefficients of recently used signer sets are cached.
+ */
+class LagrangeCoefficients
+{
+public:
+  using Coefficients = std::unordered_map<CabinetIndex, PrivateKey>;
+  using SignerSet    = std::set<CabinetIndex>;
+
+  explicit LagrangeCoefficients(uint32_t cabinet_size = 0);
+
+  Coefficients const &Get(SignerSet const &signers);
+
+  uint32_t    cabinet_size() const;
+  std::size_t cached_sets() const;
+
+private:
+  static constexpr std::size_t MAX_CACHED_SETS = 16;
+
+  uint32_t                          cabinet_size_;
+  std::vector<PrivateKey>           inverse_differences_;  ///< inverse_differences_[d] = 1 / d
+  std::map<SignerSet, Coefficients> cache_;
+};
+
+/**
+ * Multiples of a fixed generator precomputed for every window of WINDOW_BITS bits of a scalar, so
+ * that multiplying the generator by a scalar takes one point addition per window and no doublings
+ */
+class GeneratorTable
+{
+public:
+  static constexpr std::size_t WINDOW_BITS = 4;
+  static constexpr std::size_t WINDOW_SIZE = 1u << WINDOW_BITS;
+
+  GeneratorTable() = default;
+  explicit GeneratorTable(Generator const &generator);
+
+  void      Mul(PublicKey &result, PrivateKey const &scalar) const;
+  PublicKey Mul(PrivateKey const &scalar) const;
+
+  bool empty() const;
+
+private:
+  /// table_[w * (WINDOW_SIZE - 1) + (d - 1)] = generator * d * 2^(w * WINDOW_BITS)
+  std::vector<PublicKey> table_;
+  std::size_t            windows_{0};
+};
+
 /**
  * Vector initialisation for mcl data structures
  *
@@ -162,18 +226,30 @@ PublicKey ComputeLHS(PublicKey &tmpG, Generator const &G, Generator const &H,
                      PrivateKey const &share1, PrivateKey const &share2);
 PublicKey ComputeLHS(Generator const &G, Generator const &H, PrivateKey const &share1,
                      PrivateKey const &share2);
+PublicKey ComputeLHS(PublicKey &tmpG, GeneratorTable const &G, GeneratorTable const &H,
+                     PrivateKey const &share1, PrivateKey const &share2);
+PublicKey ComputeLHS(GeneratorTable const &G, GeneratorTable const &H, PrivateKey const &share1,
+                     PrivateKey const &share2);
 void      UpdateRHS(uint32_t rank, PublicKey &rhsG, std::vector<PublicKey> const &input);
 PublicKey ComputeRHS(uint32_t rank, std::vector<PublicKey> const &input);
 void      ComputeShares(PrivateKey &s_i, PrivateKey &sprime_i, std::vector<PrivateKey> const &a_i,
                         std::vector<PrivateKey> const &b_i, uint32_t index);
 std::vector<PrivateKey> InterpolatePolynom(std::vector<PrivateKey> const &a,
                                            std::vector<PrivateKey> const &b);
+std::vector<std::size_t> BatchVerifyShares(std::vector<ShareVerification> const &checks,
+                                           Generator const &G, Generator const &H);
 
 // For signatures
 Signature SignShare(MessagePayload const &message, PrivateKey const &x_i);
 bool      VerifySign(PublicKey const &y, MessagePayload const &message, Signature const &sign,
                      Generator const &G);
+std::vector<std::size_t> BatchVerifySign(std::vector<PublicKey> const &public_keys,
+                                         MessagePayload const &        message,
+                                         std::vector<Signature> const &signatures,
+                                         Generator const &             G);
 Signature LagrangeInterpolation(std::unordered_map<CabinetIndex, Signature> const &shares);
+Signature LagrangeInterpolation(std::unordered_map<CabinetIndex, Signature> const &shares,
+                                LagrangeCoefficients::Coefficients const &         coefficients);
 std::vector<DkgKeyInformation> TrustedDealerGenerateKeys(uint32_t cabinet_size, uint32_t threshold);
 std::pair<PrivateKey, PublicKey> GenerateKeyPair(Generator const &generator);
 
@@ -0,0 +1,694 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "crypto/batch_sha256.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define FETCH_BATCH_SHA256_SHA_NI
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace fetch {
+namespace crypto {
+namespace {
+
+using Implementation = BatchSHA256::Implementation;
+
+constexpr std::size_t MESSAGE_SIZE = BatchSHA256::MESSAGE_SIZE_IN_BYTES;
+constexpr std::size_t DIGEST_SIZE  = BatchSHA256::DIGEST_SIZE_IN_BYTES;
+constexpr std::size_t NUM_ROUNDS   = 64;
+
+alignas(32) constexpr uint32_t K[NUM_ROUNDS] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+alignas(16) constexpr uint32_t INITIAL_STATE[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                                   0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+inline uint32_t RotateRight(uint32_t x, uint32_t n)
+{
+  return (x >> n) | (x << (32u - n));
+}
+
+inline uint32_t SmallSigma0(uint32_t x)
+{
+  return RotateRight(x, 7) ^ RotateRight(x, 18) ^ (x >> 3u);
+}
+
+inline uint32_t SmallSigma1(uint32_t x)
+{
+  return RotateRight(x, 17) ^ RotateRight(x, 19) ^ (x >> 10u);
+}
+
+inline uint32_t BigSigma0(uint32_t x)
+{
+  return RotateRight(x, 2) ^ RotateRight(x, 13) ^ RotateRight(x, 22);
+}
+
+inline uint32_t BigSigma1(uint32_t x)
+{
+  return RotateRight(x, 6) ^ RotateRight(x, 11) ^ RotateRight(x, 25);
+}
+
+inline uint32_t LoadBigEndian(uint8_t const *data)
+{
+  return (uint32_t{data[0]} << 24u) | (uint32_t{data[1]} << 16u) | (uint32_t{data[2]} << 8u) |
+         uint32_t{data[3]};
+}
+
+inline void StoreBigEndian(uint8_t *data, uint32_t value)
+{
+  data[0] = static_cast<uint8_t>(value >> 24u);
+  data[1] = static_cast<uint8_t>(value >> 16u);
+  data[2] = static_cast<uint8_t>(value >> 8u);
+  data[3] = static_cast<uint8_t>(value);
+}
+
+/**
+ * Every 64 byte message is followed by the same padding block (0x80, zeros and the 512 bit
+ * message length). Its expanded message schedule, combined with the round constants, is
+ * therefore also constant.
+ */
+struct PaddingSchedule
+{
+  PaddingSchedule()
+  {
+    uint32_t w[NUM_ROUNDS]{};
+    w[0]  = 0x80000000u;
+    w[15] = static_cast<uint32_t>(MESSAGE_SIZE * 8u);
+
+    for (std::size_t t = 16; t < NUM_ROUNDS; ++t)
+    {
+      w[t] = SmallSigma1(w[t - 2]) + w[t - 7] + SmallSigma0(w[t - 15]) + w[t - 16];
+    }
+
+    for (std::size_t t = 0; t < NUM_ROUNDS; ++t)
+    {
+      words[t] = w[t] + K[t];
+    }
+  }
+
+  alignas(32) uint32_t words[NUM_ROUNDS];
+};
+
+uint32_t const *PaddingWords()
+{
+  static PaddingSchedule const schedule{};
+  return schedule.words;
+}
+
+/**
+ * Run the 64 rounds of the compression function
+ *
+ * @param state The state to be updated
+ * @param wk The message schedule combined with the round constants
+ */
+void CompressScalar(uint32_t *state, uint32_t const *wk)
+{
+  uint32_t a = state[0];
+  uint32_t b = state[1];
+  uint32_t c = state[2];
+  uint32_t d = state[3];
+  uint32_t e = state[4];
+  uint32_t f = state[5];
+  uint32_t g = state[6];
+  uint32_t h = state[7];
+
+  for (std::size_t t = 0; t < NUM_ROUNDS; ++t)
+  {
+    uint32_t const t1 = h + BigSigma1(e) + ((e & f) ^ (~e & g)) + wk[t];
+    uint32_t const t2 = BigSigma0(a) + ((a & b) ^ (a & c) ^ (b & c));
+
+    h = g;
+    g = f;
+    f = e;
+    e = d + t1;
+    d = c;
+    c = b;
+    b = a;
+    a = t1 + t2;
+  }
+
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+  state[5] += f;
+  state[6] += g;
+  state[7] += h;
+}
+
+void HashScalar(uint8_t const *messages, uint8_t *digests, std::size_t count)
+{
+  uint32_t const *padding = PaddingWords();
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    uint8_t const *message = messages + (i * MESSAGE_SIZE);
+
+    uint32_t w[NUM_ROUNDS];
+    for (std::size_t t = 0; t < 16; ++t)
+    {
+      w[t] = LoadBigEndian(message + (t * 4));
+    }
+
+    for (std::size_t t = 16; t < NUM_ROUNDS; ++t)
+    {
+      w[t] = SmallSigma1(w[t - 2]) + w[t - 7] + SmallSigma0(w[t - 15]) + w[t - 16];
+    }
+
+    for (std::size_t t = 0; t < NUM_ROUNDS; ++t)
+    {
+      w[t] += K[t];
+    }
+
+    uint32_t state[8];
+    std::memcpy(state, INITIAL_STATE, sizeof(state));
+
+    CompressScalar(state, w);
+    CompressScalar(state, padding);
+
+    uint8_t *digest = digests + (i * DIGEST_SIZE);
+    for (std::size_t j = 0; j < 8; ++j)
+    {
+      StoreBigEndian(digest + (j * 4), state[j]);
+    }
+  }
+}
+
+#ifdef __AVX2__
+
+/**
+ * 8-way implementation, each 32-bit lane of the vectors processes a separate message
+ */
+namespace avx2 {
+
+constexpr std::size_t LANES = 8;
+
+using Vector = __m256i;
+
+inline Vector Add(Vector a, Vector b)
+{
+  return _mm256_add_epi32(a, b);
+}
+
+inline Vector Xor(Vector a, Vector b)
+{
+  return _mm256_xor_si256(a, b);
+}
+
+template <int N>
+inline Vector RotateRight(Vector x)
+{
+  return _mm256_or_si256(_mm256_srli_epi32(x, N), _mm256_slli_epi32(x, 32 - N));
+}
+
+inline Vector SmallSigma0(Vector x)
+{
+  return Xor(Xor(RotateRight<7>(x), RotateRight<18>(x)), _mm256_srli_epi32(x, 3));
+}
+
+inline Vector SmallSigma1(Vector x)
+{
+  return Xor(Xor(RotateRight<17>(x), RotateRight<19>(x)), _mm256_srli_epi32(x, 10));
+}
+
+inline Vector BigSigma0(Vector x)
+{
+  return Xor(Xor(RotateRight<2>(x), RotateRight<13>(x)), RotateRight<22>(x));
+}
+
+inline Vector BigSigma1(Vector x)
+{
+  return Xor(Xor(RotateRight<6>(x), RotateRight<11>(x)), RotateRight<25>(x));
+}
+
+template <typename WordFunction>
+inline void Compress(Vector *state, WordFunction &&word)
+{
+  Vector a = state[0];
+  Vector b = state[1];
+  Vector c = state[2];
+  Vector d = state[3];
+  Vector e = state[4];
+  Vector f = state[5];
+  Vector g = state[6];
+  Vector h = state[7];
+
+  for (std::size_t t = 0; t < NUM_ROUNDS; ++t)
+  {
+    Vector const ch  = Xor(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+    Vector const maj = _mm256_or_si256(_mm256_and_si256(a, b),
+                                       _mm256_and_si256(c, _mm256_or_si256(a, b)));
+    Vector const t1  = Add(Add(Add(h, BigSigma1(e)), ch), word(t));
+    Vector const t2  = Add(BigSigma0(a), maj);
+
+    h = g;
+    g = f;
+    f = e;
+    e = Add(d, t1);
+    d = c;
+    c = b;
+    b = a;
+    a = Add(t1, t2);
+  }
+
+  state[0] = Add(state[0], a);
+  state[1] = Add(state[1], b);
+  state[2] = Add(state[2], c);
+  state[3] = Add(state[3], d);
+  state[4] = Add(state[4], e);
+  state[5] = Add(state[5], f);
+  state[6] = Add(state[6], g);
+  state[7] = Add(state[7], h);
+}
+
+void Hash8(uint8_t const *messages, uint8_t *digests, uint32_t const *padding)
+{
+  Vector const byte_swap =
+      _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4,
+                       11, 10, 9, 8, 15, 14, 13, 12);
+  Vector const offsets = _mm256_setr_epi32(0, 64, 128, 192, 256, 320, 384, 448);
+
+  // transpose the messages so that each vector holds the same word of all the messages
+  Vector w[NUM_ROUNDS];
+  for (std::size_t t = 0; t < 16; ++t)
+  {
+    auto const *base = reinterpret_cast<int const *>(messages + (t * 4));
+    w[t]             = _mm256_shuffle_epi8(_mm256_i32gather_epi32(base, offsets, 1), byte_swap);
+  }
+
+  for (std::size_t t = 16; t < NUM_ROUNDS; ++t)
+  {
+    w[t] = Add(Add(SmallSigma1(w[t - 2]), w[t - 7]), Add(SmallSigma0(w[t - 15]), w[t - 16]));
+  }
+
+  Vector state[8];
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    state[i] = _mm256_set1_epi32(static_cast<int>(INITIAL_STATE[i]));
+  }
+
+  Compress(state, [&w](std::size_t t) {
+    return Add(w[t], _mm256_set1_epi32(static_cast<int>(K[t])));
+  });
+  Compress(state, [padding](std::size_t t) {
+    return _mm256_set1_epi32(static_cast<int>(padding[t]));
+  });
+
+  // transpose the state back into the individual digests
+  alignas(32) uint32_t words[8][LANES];
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    _mm256_store_si256(reinterpret_cast<Vector *>(words[i]),
+                       _mm256_shuffle_epi8(state[i], byte_swap));
+  }
+
+  for (std::size_t lane = 0; lane < LANES; ++lane)
+  {
+    uint8_t *digest = digests + (lane * DIGEST_SIZE);
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+      std::memcpy(digest + (i * 4), &words[i][lane], 4);
+    }
+  }
+}
+
+void Hash(uint8_t const *messages, uint8_t *digests, std::size_t count)
+{
+  uint32_t const *padding = PaddingWords();
+
+  std::size_t i = 0;
+  for (; (i + LANES) <= count; i += LANES)
+  {
+    Hash8(messages + (i * MESSAGE_SIZE), digests + (i * DIGEST_SIZE), padding);
+  }
+
+  HashScalar(messages + (i * MESSAGE_SIZE), digests + (i * DIGEST_SIZE), count - i);
+}
+
+}  // namespace avx2
+
+#endif  // __AVX2__
+
+#ifdef FETCH_BATCH_SHA256_SHA_NI
+
+#define FETCH_SHA_NI_TARGET __attribute__((target("sha,sse4.1,ssse3")))
+
+/**
+ * Implementation built on the x86 SHA extensions, selected at runtime when the CPU supports them
+ */
+namespace shani {
+
+bool IsSupported()
+{
+  unsigned int eax{0}, ebx{0}, ecx{0}, edx{0};
+
+  if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0)
+  {
+    return false;
+  }
+
+  bool const has_sse = ((ecx & bit_SSSE3) != 0) && ((ecx & bit_SSE4_1) != 0);
+
+  if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) == 0)
+  {
+    return false;
+  }
+
+  bool const has_sha = ((ebx >> 29u) & 1u) != 0;
+
+  return has_sse && has_sha;
+}
+
+FETCH_SHA_NI_TARGET inline void QuadRound(__m128i &state0, __m128i &state1, __m128i wk)
+{
+  state1 = _mm_sha256rnds2_epu32(state1, state0, wk);
+  state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(wk, 0x0E));
+}
+
+FETCH_SHA_NI_TARGET inline __m128i Load(uint32_t const *words)
+{
+  return _mm_load_si128(reinterpret_cast<__m128i const *>(words));
+}
+
+FETCH_SHA_NI_TARGET void Hash(uint8_t const *messages, uint8_t *digests, std::size_t count)
+{
+  uint32_t const *padding   = PaddingWords();
+  __m128i const   byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bll, 0x0405060700010203ll);
+
+  // the instructions expect the state to be arranged as ABEF / CDGH
+  __m128i       tmp     = _mm_shuffle_epi32(Load(INITIAL_STATE), 0xB1);
+  __m128i       initial = _mm_shuffle_epi32(Load(INITIAL_STATE + 4), 0x1B);
+  __m128i const abef    = _mm_alignr_epi8(tmp, initial, 8);
+  __m128i const cdgh    = _mm_blend_epi16(initial, tmp, 0xF0);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    auto const *message = reinterpret_cast<__m128i const *>(messages + (i * MESSAGE_SIZE));
+
+    __m128i msg[4];
+    for (std::size_t j = 0; j < 4; ++j)
+    {
+      msg[j] = _mm_shuffle_epi8(_mm_loadu_si128(message + j), byte_swap);
+    }
+
+    __m128i state0 = abef;
+    __m128i state1 = cdgh;
+
+    // message block, the schedule is computed 4 words at a time alongside the rounds
+    for (std::size_t g = 0; g < 16; ++g)
+    {
+      __m128i &current  = msg[g & 3u];
+      __m128i &next     = msg[(g + 1) & 3u];
+      __m128i &previous = msg[(g + 3) & 3u];
+
+      QuadRound(state0, state1, _mm_add_epi32(current, Load(K + (g * 4))));
+
+      if ((g >= 3) && (g <= 14))
+      {
+        next = _mm_sha256msg2_epu32(_mm_add_epi32(next, _mm_alignr_epi8(current, previous, 4)),
+                                    current);
+      }
+
+      if ((g >= 1) && (g <= 12))
+      {
+        previous = _mm_sha256msg1_epu32(previous, current);
+      }
+    }
+
+    state0 = _mm_add_epi32(state0, abef);
+    state1 = _mm_add_epi32(state1, cdgh);
+
+    // padding block
+    __m128i const saved0 = state0;
+    __m128i const saved1 = state1;
+
+    for (std::size_t g = 0; g < 16; ++g)
+    {
+      QuadRound(state0, state1, Load(padding + (g * 4)));
+    }
+
+    state0 = _mm_add_epi32(state0, saved0);
+    state1 = _mm_add_epi32(state1, saved1);
+
+    // convert back to ABCD / EFGH and store as big endian words
+    tmp    = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+
+    auto *digest = reinterpret_cast<__m128i *>(digests + (i * DIGEST_SIZE));
+    _mm_storeu_si128(digest, _mm_shuffle_epi8(state0, byte_swap));
+    _mm_storeu_si128(digest + 1, _mm_shuffle_epi8(state1, byte_swap));
+  }
+}
+
+}  // namespace shani
+
+#undef FETCH_SHA_NI_TARGET
+
+#endif  // FETCH_BATCH_SHA256_SHA_NI
+
+/**
+ * Select the implementation by timing each of the supported ones. Feature flags alone are not
+ * sufficient, since the SHA extensions are advertised but emulated on some virtualised hosts.
+ */
+Implementation DetectImplementation()
+{
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr std::size_t CALIBRATION_MESSAGES = 64;
+  static constexpr std::size_t CALIBRATION_ROUNDS   = 3;
+
+  std::vector<uint8_t> messages(CALIBRATION_MESSAGES * MESSAGE_SIZE, 0xA5);
+  std::vector<uint8_t> digests(CALIBRATION_MESSAGES * DIGEST_SIZE);
+
+  auto best          = Implementation::SCALAR;
+  auto best_duration = Clock::duration::max();
+
+  for (auto const implementation :
+       {Implementation::SCALAR, Implementation::AVX2, Implementation::SHA_NI})
+  {
+    if (!BatchSHA256::IsSupported(implementation))
+    {
+      continue;
+    }
+
+    auto duration = Clock::duration::max();
+    for (std::size_t round = 0; round < CALIBRATION_ROUNDS; ++round)
+    {
+      auto const start = Clock::now();
+      BatchSHA256::Hash(messages.data(), digests.data(), CALIBRATION_MESSAGES, implementation);
+      duration = std::min(duration, Clock::now() - start);
+    }
+
+    if (duration < best_duration)
+    {
+      best          = implementation;
+      best_duration = duration;
+    }
+  }
+
+  return best;
+}
+
+}  // namespace
+
+/**
+ * Determine the fastest implementation available on this machine, measured on first use
+ *
+ * @return The implementation used by default
+ */
+BatchSHA256::Implementation BatchSHA256::ActiveImplementation()
+{
+  static Implementation const implementation = DetectImplementation();
+  return implementation;
+}
+
+/**
+ * Determine if a specified implementation is available on this machine
+ *
+ * @param implementation The implementation to check
+ * @return true if available, otherwise false
+ */
+bool BatchSHA256::IsSupported(Implementation implementation)
+{
+  switch (implementation)
+  {
+  case Implementation::SCALAR:
+    return true;
+  case Implementation::AVX2:
+#ifdef __AVX2__
+    return true;
+#else
+    return false;
+#endif
+  case Implementation::SHA_NI:
+#ifdef FETCH_BATCH_SHA256_SHA_NI
+  {
+    static bool const supported = shani::IsSupported();
+    return supported;
+  }
+#else
+    return false;
+#endif
+  }
+
+  return false;
+}
+
+char const *BatchSHA256::ToString(Implementation implementation)
+{
+  char const *text = "Unknown";
+
+  switch (implementation)
+  {
+  case Implementation::SCALAR:
+    text = "Scalar";
+    break;
+  case Implementation::AVX2:
+    text = "AVX2";
+    break;
+  case Implementation::SHA_NI:
+    text = "SHA-NI";
+    break;
+  }
+
+  return text;
+}
+
+/**
+ * Hash a series of 64 byte messages with the fastest available implementation
+ *
+ * The digests buffer may alias the messages buffer, in which case the messages are replaced with
+ * the (packed) digests.
+ *
+ * @param messages The concatenated input messages (count * 64 bytes)
+ * @param digests The output buffer for the digests (count * 32 bytes)
+ * @param count The number of messages to hash
+ */
+void BatchSHA256::Hash(uint8_t const *messages, uint8_t *digests, std::size_t count)
+{
+  Hash(messages, digests, count, ActiveImplementation());
+}
+
+/**
+ * Hash a series of 64 byte messages with a specified implementation. If the implementation is not
+ * available on this machine the scalar implementation is used instead.
+ *
+ * @param messages The concatenated input messages (count * 64 bytes)
+ * @param digests The output buffer for the digests (count * 32 bytes)
+ * @param count The number of messages to hash
+ * @param implementation The requested implementation
+ */
+void BatchSHA256::Hash(uint8_t const *messages, uint8_t *digests, std::size_t count,
+                       Implementation implementation)
+{
+  if (!IsSupported(implementation))
+  {
+    implementation = Implementation::SCALAR;
+  }
+
+  switch (implementation)
+  {
+#ifdef FETCH_BATCH_SHA256_SHA_NI
+  case Implementation::SHA_NI:
+    shani::Hash(messages, digests, count);
+    break;
+#endif
+#ifdef __AVX2__
+  case Implementation::AVX2:
+    avx2::Hash(messages, digests, count);
+    break;
+#endif
+  default:
+    HashScalar(messages, digests, count);
+    break;
+  }
+}
+
+/**
+ * Hash a series of 64 byte messages, splitting large batches across multiple threads
+ *
+ * Unlike the single threaded version the digests buffer must not alias the messages buffer.
+ *
+ * @param messages The concatenated input messages (count * 64 bytes)
+ * @param digests The output buffer for the digests (count * 32 bytes)
+ * @param count The number of messages to hash
+ * @param max_threads The maximum number of threads to use (0 for the hardware concurrency)
+ */
+void BatchSHA256::ParallelHash(uint8_t const *messages, uint8_t *digests, std::size_t count,
+                               std::size_t max_threads)
+{
+  if (max_threads == 0)
+  {
+    static std::size_t const hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+    max_threads                               = hardware_threads;
+  }
+
+  std::size_t const num_threads = std::min(max_threads, count / MIN_MESSAGES_PER_THREAD);
+
+  if (num_threads <= 1)
+  {
+    Hash(messages, digests, count);
+    return;
+  }
+
+  std::size_t const chunk = (count + num_threads - 1) / num_threads;
+
+  auto const hash_range = [messages, digests](std::size_t begin, std::size_t end) {
+    Hash(messages + (begin * MESSAGE_SIZE), digests + (begin * DIGEST_SIZE), end - begin);
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+
+  for (std::size_t begin = chunk; begin < count; begin += chunk)
+  {
+    threads.emplace_back(hash_range, begin, std::min(begin + chunk, count));
+  }
+
+  hash_range(0, std::min(chunk, count));
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+}
+
+}  // namespace crypto
+}  // namespace fetch
@@ -0,0 +1,188 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "crypto/batch_verifier.hpp"
+
+#include <exception>
+#include <utility>
+
+namespace fetch {
+namespace crypto {
+
+/**
+ * Construct a batch verifier
+ *
+ * @param max_cached_keys The maximum number of decoded public keys retained between batches
+ */
+BatchVerifier::BatchVerifier(std::size_t max_cached_keys)
+  : max_cached_keys_{max_cached_keys}
+{}
+
+/**
+ * Add an entry to the current batch
+ *
+ * @param identity The identity of the signer
+ * @param data The payload which has been signed
+ * @param signature The signature to be verified
+ * @return The index of the entry in the batch
+ */
+std::size_t BatchVerifier::Add(Identity const &identity, ConstByteArray const &data,
+                               ConstByteArray const &signature)
+{
+  entries_.emplace_back(Entry{identity, data, signature, false});
+
+  return entries_.size() - 1;
+}
+
+/**
+ * Clear all the entries in the current batch. Cached public keys are retained
+ */
+void BatchVerifier::Reset()
+{
+  entries_.clear();
+}
+
+/**
+ * Verify all the entries in the current batch. The status of individual entries can subsequently
+ * be queried with IsValid(). An entry whose identity can not be decoded is simply invalid, it does
+ * not affect the other entries in the batch.
+ *
+ * @return true if all the entries in the batch are valid, otherwise false
+ */
+bool BatchVerifier::Verify()
+{
+  bool all_valid{true};
+
+  for (auto &entry : entries_)
+  {
+    entry.valid = false;
+
+    if (entry.identity && !entry.signature.empty())
+    {
+      try
+      {
+        Verifier *verifier = LookupVerifier(entry.identity);
+        entry.valid        = (verifier != nullptr) && verifier->Verify(entry.data, entry.signature);
+      }
+      catch (std::exception const &)
+      {
+        // the identity is not a valid public key
+        entry.valid = false;
+      }
+    }
+
+    all_valid = all_valid && entry.valid;
+  }
+
+  return all_valid;
+}
+
+/**
+ * Determine if a specified entry in the batch is valid. Only valid after a call to Verify()
+ *
+ * @param index The index of the entry
+ * @return true if the signature is valid, otherwise false
+ */
+bool BatchVerifier::IsValid(std::size_t index) const
+{
+  return (index < entries_.size()) && entries_[index].valid;
+}
+
+/**
+ * Determine if a specified range of entries in the batch are all valid. Only valid after a call to
+ * Verify()
+ *
+ * @param first The index of the first entry
+ * @param count The number of entries
+ * @return true if all the signatures in the range are valid, otherwise false
+ */
+bool BatchVerifier::IsValid(std::size_t first, std::size_t count) const
+{
+  if ((count == 0) || ((first + count) > entries_.size()))
+  {
+    return false;
+  }
+
+  for (std::size_t i = first, end = first + count; i < end; ++i)
+  {
+    if (!entries_[i].valid)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::size_t BatchVerifier::size() const
+{
+  return entries_.size();
+}
+
+bool BatchVerifier::empty() const
+{
+  return entries_.empty();
+}
+
+std::size_t BatchVerifier::cached_keys() const
+{
+  return cache_.size();
+}
+
+std::size_t BatchVerifier::cache_hits() const
+{
+  return cache_hits_;
+}
+
+/**
+ * Lookup (or build) the verifier for a specified identity
+ *
+ * @param identity The identity of the signer
+ * @return The verifier for the identity, or nullptr if one could not be built
+ * @throws std::exception if the identity is not a valid public key
+ */
+Verifier *BatchVerifier::LookupVerifier(Identity const &identity)
+{
+  auto it = cache_.find(identity.identifier());
+  if ((it != cache_.end()) && (it->second->identity() == identity))
+  {
+    ++cache_hits_;
+    return it->second.get();
+  }
+
+  // the cache is simply flushed when it is full, this keeps the lookup as cheap as possible for the
+  // common case of a small set of active signers
+  if (cache_.size() >= max_cached_keys_)
+  {
+    cache_.clear();
+  }
+
+  auto verifier = Verifier::Build(identity);
+  if (!verifier)
+  {
+    return nullptr;
+  }
+
+  auto &entry = cache_[identity.identifier()];
+  entry       = std::move(verifier);
+
+  return entry.get();
+}
+
+}  // namespace crypto
+}  // namespace fetch
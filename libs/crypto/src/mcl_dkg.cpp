@@ -20,8 +20,11 @@
 
 #include "mcl/bn256.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <numeric>
+#include <random>
 #include <stdexcept>
 #include <unordered_map>
 
@@ -34,6 +37,57 @@ namespace mcl {
 std::atomic<bool>  details::MCLInitialiser::was_initialised{false};
 constexpr uint16_t PUBLIC_KEY_BYTE_SIZE = 310;
 
+namespace {
+
+using Indices = std::vector<std::size_t>;
+
+/**
+ * Generates the random weights for a batch verification. 64-bit weights bound the probability of
+ * an invalid batch passing by 2^-63 while keeping the scalar multiplications short.
+ */
+std::vector<bn::Fr> RandomWeights(std::size_t count)
+{
+  std::random_device rd;
+
+  std::vector<bn::Fr> weights(count);
+  for (auto &weight : weights)
+  {
+    uint64_t const value = (uint64_t{rd()} << 32u) | uint64_t{rd()};
+    weight               = bn::Fr(static_cast<int64_t>((value >> 1u) | 1u));
+  }
+
+  return weights;
+}
+
+/**
+ * Runs a batch check over the candidates and, only if it fails, bisects the batch to isolate the
+ * entries which are invalid
+ *
+ * @param candidates The entries to be checked
+ * @param check Functor returning whether a (non-empty) subset of entries is valid as a whole
+ * @param invalid Output list of the invalid entries
+ */
+template <typename Check>
+void BisectBatch(Indices const &candidates, Check const &check, Indices &invalid)
+{
+  if (candidates.empty() || check(candidates))
+  {
+    return;
+  }
+
+  if (candidates.size() == 1)
+  {
+    invalid.push_back(candidates.front());
+    return;
+  }
+
+  auto const middle = candidates.begin() + static_cast<std::ptrdiff_t>(candidates.size() / 2);
+  BisectBatch(Indices(candidates.begin(), middle), check, invalid);
+  BisectBatch(Indices(middle, candidates.end()), check, invalid);
+}
+
+}  // namespace
+
 PublicKey::PublicKey()
 {
   clear();
@@ -97,6 +151,76 @@ void SetGenerators(Generator &generator_g, Generator &generator_h,
   assert(!generator_h.isZero());
 }
 
+GeneratorTable::GeneratorTable(Generator const &generator)
+  : windows_{(bn::Fr::getBitSize() + WINDOW_BITS - 1) / WINDOW_BITS}
+{
+  table_.resize(windows_ * (WINDOW_SIZE - 1));
+
+  bn::G2 base = generator;
+  for (std::size_t w = 0; w < windows_; ++w)
+  {
+    PublicKey *row = &table_[w * (WINDOW_SIZE - 1)];
+
+    static_cast<bn::G2 &>(row[0]) = base;
+    for (std::size_t d = 1; d < WINDOW_SIZE - 1; ++d)
+    {
+      bn::G2::add(row[d], row[d - 1], base);
+    }
+
+    // base * 2^WINDOW_BITS for the next window
+    bn::G2::add(base, row[WINDOW_SIZE - 2], base);
+  }
+
+  // normalised points make for cheaper additions
+  for (auto &point : table_)
+  {
+    point.normalize();
+  }
+}
+
+void GeneratorTable::Mul(PublicKey &result, PrivateKey const &scalar) const
+{
+  using Unit = ::mcl::fp::Unit;
+
+  static constexpr std::size_t UNIT_BITS = sizeof(Unit) * 8;
+  static_assert((UNIT_BITS % WINDOW_BITS) == 0, "Windows must not straddle units");
+
+  assert(!empty());
+
+  ::mcl::fp::Block block;
+  scalar.getBlock(block);
+
+  result.clear();
+  for (std::size_t w = 0; w < windows_; ++w)
+  {
+    std::size_t const bit  = w * WINDOW_BITS;
+    std::size_t const unit = bit / UNIT_BITS;
+    if (unit >= block.n)
+    {
+      break;
+    }
+
+    auto const digit =
+        static_cast<std::size_t>((block.p[unit] >> (bit % UNIT_BITS)) & (WINDOW_SIZE - 1));
+    if (digit != 0)
+    {
+      bn::G2::add(result, result, table_[w * (WINDOW_SIZE - 1) + digit - 1]);
+    }
+  }
+}
+
+PublicKey GeneratorTable::Mul(PrivateKey const &scalar) const
+{
+  PublicKey result;
+  Mul(result, scalar);
+  return result;
+}
+
+bool GeneratorTable::empty() const
+{
+  return table_.empty();
+}
+
 /**
  * LHS and RHS functions are used for checking consistency between publicly broadcasted coefficients
  * and secret shares distributed privately
@@ -119,23 +243,51 @@ PublicKey ComputeLHS(Generator const &G, Generator const &H, PrivateKey const &s
   return ComputeLHS(tmpG, G, H, share1, share2);
 }
 
+PublicKey ComputeLHS(PublicKey &tmpG, GeneratorTable const &G, GeneratorTable const &H,
+                     PrivateKey const &share1, PrivateKey const &share2)
+{
+  PublicKey tmp2G, lhsG;
+  G.Mul(tmpG, share1);
+  H.Mul(tmp2G, share2);
+  bn::G2::add(lhsG, tmpG, tmp2G);
+
+  return lhsG;
+}
+
+PublicKey ComputeLHS(GeneratorTable const &G, GeneratorTable const &H, PrivateKey const &share1,
+                     PrivateKey const &share2)
+{
+  PublicKey tmpG;
+  return ComputeLHS(tmpG, G, H, share1, share2);
+}
+
+/**
+ * Adds sum_{k >= 1} input[k] * (rank + 1)^k to rhsG. The sum is evaluated with Horner's scheme so
+ * that the points are only ever multiplied by the small scalar rank + 1, rather than by its powers
+ */
 void UpdateRHS(uint32_t rank, PublicKey &rhsG, std::vector<PublicKey> const &input)
 {
-  PrivateKey tmpF{1};
-  PublicKey  tmpG;
   assert(!input.empty());
-  for (uint32_t k = 1; k < input.size(); k++)
+  if (input.size() < 2)
   {
-    bn::Fr::pow(tmpF, rank + 1, k);  // adjust rank in computation
-    bn::G2::mul(tmpG, input[k], tmpF);
-    bn::G2::add(rhsG, rhsG, tmpG);
+    return;
   }
+
+  auto const x = static_cast<int64_t>(rank) + 1;  // adjust rank in computation
+  PublicKey  tmpG, tmp2G;
+  tmpG = input.back();
+  for (std::size_t k = input.size() - 1; k > 1; --k)
+  {
+    bn::G2::mul(tmp2G, tmpG, x);
+    bn::G2::add(tmpG, tmp2G, input[k - 1]);
+  }
+  bn::G2::mul(tmp2G, tmpG, x);
+  bn::G2::add(rhsG, rhsG, tmp2G);
 }
 
 PublicKey ComputeRHS(uint32_t rank, std::vector<PublicKey> const &input)
 {
-  PrivateKey tmpF;
-  PublicKey  tmpG, rhsG;
+  PublicKey rhsG;
   assert(!input.empty());
   // initialise rhsG
   rhsG = input[0];
@@ -156,18 +308,19 @@ PublicKey ComputeRHS(uint32_t rank, std::vector<PublicKey> const &input)
 void ComputeShares(PrivateKey &s_i, PrivateKey &sprime_i, std::vector<PrivateKey> const &a_i,
                    std::vector<PrivateKey> const &b_i, uint32_t index)
 {
-  PrivateKey pow, tmpF;
   assert(a_i.size() == b_i.size());
   assert(!a_i.empty());
-  s_i      = a_i[0];
-  sprime_i = b_i[0];
-  for (uint32_t k = 1; k < a_i.size(); k++)
+
+  // Horner's scheme, f(x) = a_0 + x * (a_1 + x * (a_2 + ...))
+  PrivateKey const x{index + 1};  // adjust index in computation
+  s_i      = a_i.back();
+  sprime_i = b_i.back();
+  for (std::size_t k = a_i.size() - 1; k > 0; --k)
   {
-    bn::Fr::pow(pow, index + 1, k);  // adjust index in computation
-    bn::Fr::mul(tmpF, pow, b_i[k]);  // j^k * b_i[k]
-    bn::Fr::add(sprime_i, sprime_i, tmpF);
-    bn::Fr::mul(tmpF, pow, a_i[k]);  // j^k * a_i[k]
-    bn::Fr::add(s_i, s_i, tmpF);
+    bn::Fr::mul(s_i, s_i, x);
+    bn::Fr::add(s_i, s_i, a_i[k - 1]);
+    bn::Fr::mul(sprime_i, sprime_i, x);
+    bn::Fr::add(sprime_i, sprime_i, b_i[k - 1]);
   }
 }
 
@@ -236,6 +389,95 @@ std::vector<PrivateKey> InterpolatePolynom(std::vector<PrivateKey> const &a,
   return res;
 }
 
+/**
+ * Verifies many share consistency checks at once. The checks are combined with random weights r_i
+ * so that the left hand sides collapse to two scalar multiplications and the right hand sides to
+ * a single multi-scalar multiplication over the distinct coefficient vectors. Only when the
+ * combination fails is the batch bisected to find the offending checks.
+ *
+ * Shares which are both zero are rejected outright, as G^0 * H^0 is the identity.
+ *
+ * @param checks The share checks to be verified
+ * @param G The first DKG generator
+ * @param H The second DKG generator
+ * @return The indices of the checks which failed, in ascending order
+ */
+std::vector<std::size_t> BatchVerifyShares(std::vector<ShareVerification> const &checks,
+                                           Generator const &G, Generator const &H)
+{
+  Indices invalid;
+  Indices candidates;
+  for (std::size_t i = 0; i < checks.size(); ++i)
+  {
+    assert(checks[i].coefficients != nullptr && !checks[i].coefficients->empty());
+
+    if (checks[i].share1.isZero() && checks[i].share2.isZero())
+    {
+      invalid.push_back(i);
+    }
+    else
+    {
+      candidates.push_back(i);
+    }
+  }
+
+  auto const weights = RandomWeights(checks.size());
+
+  auto const check = [&](Indices const &subset) {
+    bn::Fr sum1;
+    bn::Fr sum2;
+    sum1.clear();
+    sum2.clear();
+
+    // accumulate the weight of every coefficient, grouped by coefficient vector
+    std::unordered_map<std::vector<PublicKey> const *, std::vector<bn::Fr>> powers;
+    for (auto const i : subset)
+    {
+      auto const &entry = checks[i];
+      sum1 += weights[i] * entry.share1;
+      sum2 += weights[i] * entry.share2;
+
+      auto &scalars = powers[entry.coefficients];
+      if (scalars.empty())
+      {
+        Init(scalars, static_cast<uint32_t>(entry.coefficients->size()));
+      }
+
+      bn::Fr const base(static_cast<int64_t>(entry.rank) + 1);  // adjust rank in computation
+      bn::Fr       term = weights[i];
+      for (auto &scalar : scalars)
+      {
+        scalar += term;
+        term *= base;
+      }
+    }
+
+    std::vector<bn::G2> points;
+    std::vector<bn::Fr> scalars;
+    for (auto const &element : powers)
+    {
+      points.insert(points.end(), element.first->begin(), element.first->end());
+      scalars.insert(scalars.end(), element.second.begin(), element.second.end());
+    }
+
+    bn::G2 rhs;
+    bn::G2::mulVec(rhs, points.data(), scalars.data(), points.size());
+
+    bn::G2 lhs;
+    bn::G2 tmp;
+    bn::G2::mul(lhs, G, sum1);
+    bn::G2::mul(tmp, H, sum2);
+    bn::G2::add(lhs, lhs, tmp);
+
+    return lhs == rhs;
+  };
+
+  BisectBatch(candidates, check, invalid);
+  std::sort(invalid.begin(), invalid.end());
+
+  return invalid;
+}
+
 /**
  * Computes signature share of a message
  *
@@ -278,6 +520,186 @@ bool VerifySign(PublicKey const &y, MessagePayload const &message, Signature con
   return e1 == e2;
 }
 
+/**
+ * Verifies many signatures of the same message at once. With random weights r_i the individual
+ * checks e(sign_i, G) == e(H(m), y_i) are combined into
+ *
+ *   e(sum r_i sign_i, G) * e(-H(m), sum r_i y_i) == 1
+ *
+ * which costs two Miller loops and a single final exponentiation regardless of the batch size.
+ * Only when the combination fails is the batch bisected to find the offending signatures.
+ *
+ * @param public_keys The public key (share) for each signature
+ * @param message Message that was signed
+ * @param signatures Signatures to be verified
+ * @param G Generator used in DKG
+ * @return The indices of the signatures which failed verification, in ascending order
+ */
+std::vector<std::size_t> BatchVerifySign(std::vector<PublicKey> const &public_keys,
+                                         MessagePayload const &        message,
+                                         std::vector<Signature> const &signatures,
+                                         Generator const &             G)
+{
+  assert(public_keys.size() == signatures.size());
+
+  Signature PH;
+  bn::Fp    Hm;
+  Hm.setHashOf(message.pointer(), message.size());
+  bn::mapToG1(PH, Hm);
+  bn::G1::neg(PH, PH);
+
+  auto const weights = RandomWeights(signatures.size());
+
+  auto const check = [&](Indices const &subset) {
+    std::vector<bn::G1> signature_points;
+    std::vector<bn::G2> key_points;
+    std::vector<bn::Fr> scalars;
+    signature_points.reserve(subset.size());
+    key_points.reserve(subset.size());
+    scalars.reserve(subset.size());
+
+    for (auto const i : subset)
+    {
+      signature_points.push_back(signatures[i]);
+      key_points.push_back(public_keys[i]);
+      scalars.push_back(weights[i]);
+    }
+
+    bn::G1 sign;
+    bn::G2 key;
+    bn::G1::mulVec(sign, signature_points.data(), scalars.data(), subset.size());
+    bn::G2::mulVec(key, key_points.data(), scalars.data(), subset.size());
+
+    bn::Fp12 e1;
+    bn::Fp12 e2;
+    bn::millerLoop(e1, sign, G);
+    bn::millerLoop(e2, PH, key);
+    bn::Fp12::mul(e1, e1, e2);
+    bn::finalExp(e1, e1);
+
+    return e1.isOne();
+  };
+
+  Indices candidates(signatures.size());
+  std::iota(candidates.begin(), candidates.end(), 0);
+
+  Indices invalid;
+  BisectBatch(candidates, check, invalid);
+  std::sort(invalid.begin(), invalid.end());
+
+  return invalid;
+}
+
+LagrangeCoefficients::LagrangeCoefficients(uint32_t cabinet_size)
+  : cabinet_size_{cabinet_size}
+{
+  Init(inverse_differences_, std::max(cabinet_size, 1u));
+  for (uint32_t d = 1; d < cabinet_size; ++d)
+  {
+    bn::Fr::inv(inverse_differences_[d], bn::Fr(static_cast<int64_t>(d)));
+  }
+}
+
+/**
+ * Get the Lagrange coefficients for interpolating at zero from the shares of a set of signers
+ *
+ * @param signers The cabinet indices of the signers
+ * @return Map of cabinet index to its coefficient
+ */
+LagrangeCoefficients::Coefficients const &LagrangeCoefficients::Get(SignerSet const &signers)
+{
+  auto it = cache_.find(signers);
+  if (it != cache_.end())
+  {
+    return it->second;
+  }
+
+  if (!signers.empty() && (*signers.rbegin() >= cabinet_size_))
+  {
+    throw std::out_of_range("LagrangeCoefficients: signer index outside of the cabinet");
+  }
+
+  if (cache_.size() >= MAX_CACHED_SETS)
+  {
+    cache_.clear();
+  }
+
+  // lambda_i = prod_{j != i} x_j / (x_j - x_i) with x_i = i + 1
+  Coefficients coefficients;
+  for (auto const i : signers)
+  {
+    PrivateKey lambda{1};
+    bool       negative{false};
+    for (auto const j : signers)
+    {
+      if (j == i)
+      {
+        continue;
+      }
+
+      bn::Fr::mul(lambda, lambda, bn::Fr(static_cast<int64_t>(j) + 1));
+      if (j > i)
+      {
+        bn::Fr::mul(lambda, lambda, inverse_differences_[j - i]);
+      }
+      else
+      {
+        bn::Fr::mul(lambda, lambda, inverse_differences_[i - j]);
+        negative = !negative;
+      }
+    }
+
+    if (negative)
+    {
+      bn::Fr::neg(lambda, lambda);
+    }
+
+    coefficients.emplace(i, lambda);
+  }
+
+  return cache_.emplace(signers, std::move(coefficients)).first->second;
+}
+
+uint32_t LagrangeCoefficients::cabinet_size() const
+{
+  return cabinet_size_;
+}
+
+std::size_t LagrangeCoefficients::cached_sets() const
+{
+  return cache_.size();
+}
+
+/**
+ * Computes the group signature from the signature shares of threshold + 1 parties using
+ * precomputed Lagrange coefficients
+ *
+ * @param shares Unordered map of indices and their corresponding signature shares
+ * @param coefficients The Lagrange coefficients for exactly the indices of the shares
+ * @return Group signature
+ */
+Signature LagrangeInterpolation(std::unordered_map<CabinetIndex, Signature> const &shares,
+                                LagrangeCoefficients::Coefficients const &         coefficients)
+{
+  assert(!shares.empty());
+  assert(shares.size() == coefficients.size());
+
+  std::vector<bn::G1> points;
+  std::vector<bn::Fr> scalars;
+  points.reserve(shares.size());
+  scalars.reserve(shares.size());
+
+  for (auto const &share : shares)
+  {
+    points.push_back(share.second);
+    scalars.push_back(coefficients.at(share.first));
+  }
+
+  Signature res;
+  bn::G1::mulVec(res, points.data(), scalars.data(), points.size());
+  return res;
+}
+
 /**
  * Computes the group signature using the indices and signature shares of threshold_ + 1
  * parties
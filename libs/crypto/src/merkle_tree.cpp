@@ -16,14 +16,18 @@
 //
 //------------------------------------------------------------------------------
 
+#include "crypto/batch_sha256.hpp"
 #include "crypto/hash.hpp"
 #include "crypto/merkle_tree.hpp"
 #include "crypto/sha256.hpp"
-#include "vectorise/platform.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
 
 namespace fetch {
 namespace crypto {
@@ -31,6 +35,71 @@ namespace crypto {
 using HashArray = MerkleTree::Digest;
 using Container = MerkleTree::Container;
 
+namespace {
+
+using Buffer = std::vector<uint8_t>;
+
+constexpr std::size_t DIGEST_SIZE = BatchSHA256::DIGEST_SIZE_IN_BYTES;
+
+/**
+ * Compute the first level of internal nodes from the leaves of the tree
+ *
+ * In the common case all the leaves are digests themselves and the pairs can be hashed as a batch.
+ * Otherwise the leaves are of arbitrary size and each pair is hashed individually.
+ *
+ * @param leaves The leaf nodes of the tree
+ * @param output The buffer to be populated with the packed digests of the first level
+ */
+void HashLeaves(Container const &leaves, Buffer &output)
+{
+  std::size_t const count = leaves.size() / 2;
+
+  output.resize((count + 1) * DIGEST_SIZE);
+
+  bool const uniform = std::all_of(leaves.begin(), leaves.end(), [](HashArray const &leaf) {
+    return leaf.size() == DIGEST_SIZE;
+  });
+
+  if (uniform)
+  {
+    static thread_local Buffer messages;
+    messages.resize(count * BatchSHA256::MESSAGE_SIZE_IN_BYTES);
+
+    for (std::size_t i = 0; i < (count * 2); ++i)
+    {
+      std::memcpy(messages.data() + (i * DIGEST_SIZE), leaves[i].pointer(), DIGEST_SIZE);
+    }
+
+    BatchSHA256::ParallelHash(messages.data(), output.data(), count);
+  }
+  else
+  {
+    crypto::SHA256 hasher{};
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      hasher.Reset();
+      hasher.Update(leaves[2 * i]);
+      hasher.Update(leaves[(2 * i) + 1]);
+      hasher.Final(output.data() + (i * DIGEST_SIZE));
+    }
+  }
+
+  // an odd leaf is paired with an empty padding leaf
+  if ((leaves.size() & 1u) != 0)
+  {
+    crypto::SHA256 hasher{};
+    hasher.Update(leaves.back());
+    hasher.Final(output.data() + (count * DIGEST_SIZE));
+  }
+  else
+  {
+    output.resize(count * DIGEST_SIZE);
+  }
+}
+
+}  // namespace
+
 MerkleTree::MerkleTree(std::size_t count)
   : leaf_nodes_{count}
 {}
@@ -54,30 +123,58 @@ void MerkleTree::CalculateRoot() const
     return;
   }
 
-  // make a copy of the leaf nodes which are then condensed
-  std::vector<Digest> hashes = leaf_nodes_;
+  // The tree is (conceptually) padded up to a power of 2 with empty leaves. Rather than
+  // materialising these, the digest of a fully padded subtree is computed once per level.
+  static thread_local Buffer buffer;
+  static thread_local Buffer scratch;
 
-  // If necessary bump the 'leaves' up to a power of 2
-  while (!platform::IsLog2(uint64_t(hashes.size())))
-  {
-    hashes.emplace_back();
-  }
+  std::size_t count = (leaf_nodes_.size() + 1) / 2;
+
+  // pad nodes of the first level are the hash of two empty leaves
+  static Digest const empty_digest = Hash<crypto::SHA256>(Digest{});
 
-  // Now, repeatedly condense the vector by calculating the parents of each of the roots
-  while (hashes.size() > 1)
+  Buffer padding(DIGEST_SIZE);
+  std::memcpy(padding.data(), empty_digest.pointer(), DIGEST_SIZE);
+
+  HashLeaves(leaf_nodes_, buffer);
+
+  // padding every odd level up to an even number of nodes is equivalent to padding the leaves up
+  // to the next power of 2
+  while (count > 1)
   {
-    for (std::size_t i = 0, j = 0; i < hashes.size(); i += 2, ++j)
+    // the missing right hand neighbour of an odd node is always a padding node
+    if ((count & 1u) != 0)
     {
-      Digest concantenated_hash = hashes[i] + hashes[i + 1];
-      concantenated_hash        = Hash<crypto::SHA256>(concantenated_hash);
-      hashes[j]                 = concantenated_hash;
+      buffer.resize((count + 1) * DIGEST_SIZE);
+      std::memcpy(buffer.data() + (count * DIGEST_SIZE), padding.data(), DIGEST_SIZE);
+      ++count;
     }
 
-    hashes.resize(hashes.size() / 2);
+    count /= 2;
+
+    if (count >= BatchSHA256::MIN_MESSAGES_PER_THREAD)
+    {
+      scratch.resize(count * DIGEST_SIZE);
+      BatchSHA256::ParallelHash(buffer.data(), scratch.data(), count);
+      std::swap(buffer, scratch);
+    }
+    else
+    {
+      // the digests are packed over the messages they were computed from
+      BatchSHA256::Hash(buffer.data(), buffer.data(), count);
+    }
+
+    buffer.resize(count * DIGEST_SIZE);
+
+    // the padding node of the next level is the parent of two padding nodes
+    padding.resize(2 * DIGEST_SIZE);
+    std::memcpy(padding.data() + DIGEST_SIZE, padding.data(), DIGEST_SIZE);
+    BatchSHA256::Hash(padding.data(), padding.data(), 1);
+    padding.resize(DIGEST_SIZE);
   }
 
-  assert(hashes.size() == 1);
-  root_ = hashes[0];
+  assert(count == 1);
+  root_ = Digest{buffer.data(), DIGEST_SIZE};
 }
 
 MerkleTree::Digest const &MerkleTree::root() const
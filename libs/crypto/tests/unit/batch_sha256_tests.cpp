@@ -0,0 +1,131 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/random/lfg.hpp"
+#include "crypto/batch_sha256.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/sha256.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fetch {
+namespace crypto {
+
+namespace {
+
+using ConstByteArray = byte_array::ConstByteArray;
+using Implementation = BatchSHA256::Implementation;
+using Buffer         = std::vector<uint8_t>;
+
+constexpr std::size_t MESSAGE_SIZE = BatchSHA256::MESSAGE_SIZE_IN_BYTES;
+constexpr std::size_t DIGEST_SIZE  = BatchSHA256::DIGEST_SIZE_IN_BYTES;
+
+Buffer GenerateMessages(std::size_t count)
+{
+  random::LaggedFibonacciGenerator<> lfg;
+
+  Buffer messages(count * MESSAGE_SIZE);
+  for (auto &byte : messages)
+  {
+    byte = static_cast<uint8_t>(lfg());
+  }
+
+  return messages;
+}
+
+Buffer ReferenceDigests(Buffer const &messages)
+{
+  std::size_t const count = messages.size() / MESSAGE_SIZE;
+
+  Buffer digests(count * DIGEST_SIZE);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    auto const digest =
+        Hash<SHA256>(ConstByteArray{messages.data() + (i * MESSAGE_SIZE), MESSAGE_SIZE});
+    std::copy(digest.pointer(), digest.pointer() + DIGEST_SIZE, digests.data() + (i * DIGEST_SIZE));
+  }
+
+  return digests;
+}
+
+class BatchSHA256Tests : public testing::TestWithParam<Implementation>
+{
+};
+
+TEST_P(BatchSHA256Tests, MatchesReferenceImplementation)
+{
+  if (!BatchSHA256::IsSupported(GetParam()))
+  {
+    return;
+  }
+
+  // cover the vectorised path as well as the remainder
+  for (std::size_t count : {0u, 1u, 7u, 8u, 9u, 31u, 100u})
+  {
+    auto const messages = GenerateMessages(count);
+    auto const expected = ReferenceDigests(messages);
+
+    Buffer digests(count * DIGEST_SIZE);
+    BatchSHA256::Hash(messages.data(), digests.data(), count, GetParam());
+
+    EXPECT_EQ(digests, expected) << "count: " << count;
+  }
+}
+
+TEST_P(BatchSHA256Tests, InPlaceHashing)
+{
+  if (!BatchSHA256::IsSupported(GetParam()))
+  {
+    return;
+  }
+
+  std::size_t const count    = 37;
+  auto              buffer   = GenerateMessages(count);
+  auto const        expected = ReferenceDigests(buffer);
+
+  BatchSHA256::Hash(buffer.data(), buffer.data(), count, GetParam());
+  buffer.resize(count * DIGEST_SIZE);
+
+  EXPECT_EQ(buffer, expected);
+}
+
+INSTANTIATE_TEST_SUITE_P(Implementations, BatchSHA256Tests,
+                         testing::Values(Implementation::SCALAR, Implementation::AVX2,
+                                         Implementation::SHA_NI));
+
+TEST(BatchSHA256ParallelTests, MatchesReferenceImplementation)
+{
+  std::size_t const count    = (BatchSHA256::MIN_MESSAGES_PER_THREAD * 4) + 3;
+  auto const        messages = GenerateMessages(count);
+  auto const        expected = ReferenceDigests(messages);
+
+  Buffer digests(count * DIGEST_SIZE);
+  BatchSHA256::ParallelHash(messages.data(), digests.data(), count, 4);
+
+  EXPECT_EQ(digests, expected);
+}
+
+}  // namespace
+
+}  // namespace crypto
+}  // namespace fetch
@@ -0,0 +1,139 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "crypto/batch_verifier.hpp"
+#include "crypto/ecdsa.hpp"
+
+#include "gmock/gmock.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace crypto {
+
+namespace {
+
+using ConstByteArray = fetch::byte_array::ConstByteArray;
+
+class BatchVerifierTests : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+      signers_.emplace_back(std::make_unique<ECDSASigner>());
+    }
+  }
+
+  void AddEntries(BatchVerifier &verifier, std::size_t count)
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      auto const &   signer = *signers_[i % signers_.size()];
+      ConstByteArray message{"message " + std::to_string(i)};
+
+      verifier.Add(signer.identity(), message, signer.Sign(message));
+    }
+  }
+
+  std::vector<std::unique_ptr<ECDSASigner>> signers_;
+};
+
+TEST_F(BatchVerifierTests, ValidBatch)
+{
+  BatchVerifier verifier;
+  AddEntries(verifier, 10);
+
+  ASSERT_EQ(verifier.size(), 10u);
+  EXPECT_TRUE(verifier.Verify());
+  EXPECT_TRUE(verifier.IsValid(0, 10));
+
+  // the keys for each of the signers should have only been decoded once
+  EXPECT_EQ(verifier.cached_keys(), signers_.size());
+  EXPECT_EQ(verifier.cache_hits(), 10u - signers_.size());
+}
+
+TEST_F(BatchVerifierTests, InvalidEntryIsIsolated)
+{
+  BatchVerifier verifier;
+  AddEntries(verifier, 4);
+
+  // add a signature which does not match the payload
+  auto const &signer = *signers_[0];
+  auto const  index  = verifier.Add(signer.identity(), "hello", signer.Sign("world"));
+
+  AddEntries(verifier, 4);
+
+  EXPECT_FALSE(verifier.Verify());
+  EXPECT_FALSE(verifier.IsValid(index));
+  EXPECT_FALSE(verifier.IsValid(0, verifier.size()));
+  EXPECT_TRUE(verifier.IsValid(0, index));
+  EXPECT_TRUE(verifier.IsValid(index + 1, verifier.size() - index - 1));
+}
+
+TEST_F(BatchVerifierTests, InvalidIdentityAndEmptySignatureAreRejected)
+{
+  BatchVerifier verifier;
+  auto const    invalid_identity = verifier.Add(Identity{}, "hello", signers_[0]->Sign("hello"));
+  auto const    empty_signature  = verifier.Add(signers_[0]->identity(), "hello", ConstByteArray{});
+
+  EXPECT_FALSE(verifier.Verify());
+  EXPECT_FALSE(verifier.IsValid(invalid_identity));
+  EXPECT_FALSE(verifier.IsValid(empty_signature));
+}
+
+TEST_F(BatchVerifierTests, MalformedPublicKeyIsIsolated)
+{
+  BatchVerifier verifier;
+  AddEntries(verifier, 4);
+
+  // an identity of the right size which is not a point on the curve
+  Identity const malformed{ConstByteArray{std::string(64, '\x01')}};
+  auto const     index = verifier.Add(malformed, "hello", signers_[0]->Sign("hello"));
+
+  AddEntries(verifier, 4);
+
+  EXPECT_FALSE(verifier.Verify());
+  EXPECT_FALSE(verifier.IsValid(index));
+  EXPECT_TRUE(verifier.IsValid(0, index));
+  EXPECT_TRUE(verifier.IsValid(index + 1, verifier.size() - index - 1));
+}
+
+TEST_F(BatchVerifierTests, ResetRetainsCachedKeys)
+{
+  BatchVerifier verifier{2};
+  AddEntries(verifier, 2);
+  EXPECT_TRUE(verifier.Verify());
+
+  verifier.Reset();
+  EXPECT_TRUE(verifier.empty());
+  EXPECT_EQ(verifier.cached_keys(), 2u);
+
+  // exceeding the cache size flushes the cache
+  AddEntries(verifier, 3);
+  EXPECT_TRUE(verifier.Verify());
+  EXPECT_LE(verifier.cached_keys(), 2u);
+}
+
+}  // namespace
+
+}  // namespace crypto
+}  // namespace fetch
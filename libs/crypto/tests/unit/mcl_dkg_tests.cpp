@@ -20,9 +20,11 @@
 
 #include "gtest/gtest.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <ostream>
+#include <vector>
 
 using namespace fetch::crypto::mcl;
 using namespace fetch::byte_array;
@@ -141,6 +143,87 @@ TEST(MclDkgTests, ComputeLhsRhs)
   EXPECT_EQ(rhs, rhs_test);
 }
 
+TEST(MclDkgTests, GeneratorTable)
+{
+  details::MCLInitialiser();
+
+  Generator group_g, group_h;
+  SetGenerators(group_g, group_h);
+
+  GeneratorTable table_g{group_g};
+  GeneratorTable table_h{group_h};
+
+  std::vector<PrivateKey> scalars(20);
+  for (auto &scalar : scalars)
+  {
+    scalar.setRand();
+  }
+  scalars[0] = PrivateKey{0};
+  scalars[1] = PrivateKey{1};
+  bn::Fr::neg(scalars[2], scalars[1]);
+
+  for (auto const &scalar : scalars)
+  {
+    PublicKey expected;
+    bn::G2::mul(expected, group_g, scalar);
+    EXPECT_EQ(table_g.Mul(scalar), expected);
+
+    PrivateKey scalar2;
+    scalar2.setRand();
+    EXPECT_EQ(ComputeLHS(table_g, table_h, scalar, scalar2),
+              ComputeLHS(group_g, group_h, scalar, scalar2));
+  }
+}
+
+TEST(MclDkgTests, ComputeSharesAndRhs)
+{
+  details::MCLInitialiser();
+
+  uint32_t                threshold = 9;
+  std::vector<PrivateKey> vec_a(threshold + 1);
+  std::vector<PrivateKey> vec_b(threshold + 1);
+  for (uint32_t k = 0; k <= threshold; ++k)
+  {
+    vec_a[k].setRand();
+    vec_b[k].setRand();
+  }
+
+  Generator group_g, group_h;
+  SetGenerators(group_g, group_h);
+
+  std::vector<PublicKey> coefficients(threshold + 1);
+  for (uint32_t k = 0; k <= threshold; ++k)
+  {
+    coefficients[k] = ComputeLHS(group_g, group_h, vec_a[k], vec_b[k]);
+  }
+
+  for (uint32_t index = 0; index < 30; ++index)
+  {
+    // Evaluate the polynomials and the commitments directly from the powers of the index
+    PrivateKey s_test{0}, sprime_test{0};
+    PublicKey  rhs_test;
+    for (uint32_t k = 0; k <= threshold; ++k)
+    {
+      PrivateKey pow, tmpF;
+      PublicKey  tmpG;
+      bn::Fr::pow(pow, index + 1, k);
+      bn::Fr::mul(tmpF, pow, vec_a[k]);
+      bn::Fr::add(s_test, s_test, tmpF);
+      bn::Fr::mul(tmpF, pow, vec_b[k]);
+      bn::Fr::add(sprime_test, sprime_test, tmpF);
+      bn::G2::mul(tmpG, coefficients[k], pow);
+      bn::G2::add(rhs_test, rhs_test, tmpG);
+    }
+
+    PrivateKey s, sprime;
+    ComputeShares(s, sprime, vec_a, vec_b, index);
+    EXPECT_EQ(s, s_test);
+    EXPECT_EQ(sprime, sprime_test);
+    EXPECT_EQ(ComputeRHS(index, coefficients), rhs_test);
+    EXPECT_EQ(ComputeLHS(group_g, group_h, s, sprime), rhs_test);
+  }
+}
+
 TEST(MclDkgTests, Interpolation)
 {
   details::MCLInitialiser();
@@ -245,6 +328,122 @@ TEST(MclDkgTests, GenerateKeys)
   EXPECT_TRUE(VerifySign(keys.second, message, signature, generator));
 }
 
+TEST(MclDkgTests, BatchVerifySign)
+{
+  details::MCLInitialiser();
+
+  uint32_t cabinet_size = 50;
+  uint32_t threshold    = 26;
+
+  auto outputs = TrustedDealerGenerateKeys(cabinet_size, threshold);
+
+  Generator group_g;
+  SetGenerator(group_g);
+
+  MessagePayload         message = "Hello";
+  std::vector<PublicKey> public_keys;
+  std::vector<Signature> signatures;
+  for (uint32_t i = 0; i < cabinet_size; ++i)
+  {
+    public_keys.push_back(outputs[i].public_key_shares[i]);
+    signatures.push_back(SignShare(message, outputs[i].private_key_share));
+  }
+
+  EXPECT_TRUE(BatchVerifySign(public_keys, message, signatures, group_g).empty());
+
+  // Corrupt some of the shares: one signed by the wrong key and one for the wrong message
+  signatures[3]  = SignShare(message, outputs[4].private_key_share);
+  signatures[41] = SignShare("Goodbye", outputs[41].private_key_share);
+
+  EXPECT_EQ(BatchVerifySign(public_keys, message, signatures, group_g),
+            (std::vector<std::size_t>{3, 41}));
+}
+
+TEST(MclDkgTests, BatchVerifyShares)
+{
+  details::MCLInitialiser();
+
+  uint32_t cabinet_size = 20;
+  uint32_t degree       = 6;
+
+  Generator group_g, group_h;
+  SetGenerators(group_g, group_h);
+
+  // Two dealers with their own polynomials and broadcast coefficients
+  std::vector<std::vector<PublicKey>>  coefficients(2);
+  std::vector<std::vector<PrivateKey>> a(2), b(2);
+  for (std::size_t dealer = 0; dealer < 2; ++dealer)
+  {
+    Init(a[dealer], degree + 1);
+    Init(b[dealer], degree + 1);
+    Init(coefficients[dealer], degree + 1);
+    for (uint32_t k = 0; k <= degree; ++k)
+    {
+      a[dealer][k].setRand();
+      b[dealer][k].setRand();
+      coefficients[dealer][k] = ComputeLHS(group_g, group_h, a[dealer][k], b[dealer][k]);
+    }
+  }
+
+  std::vector<ShareVerification> checks;
+  for (uint32_t rank = 0; rank < cabinet_size; ++rank)
+  {
+    ShareVerification check;
+    ComputeShares(check.share1, check.share2, a[rank % 2], b[rank % 2], rank);
+    check.coefficients = &coefficients[rank % 2];
+    check.rank         = rank;
+    checks.push_back(check);
+  }
+
+  EXPECT_TRUE(BatchVerifyShares(checks, group_g, group_h).empty());
+
+  // Tamper with a share, swap the coefficients of another and zero a third
+  checks[5].share1 += PrivateKey{1};
+  checks[12].coefficients = &coefficients[1];
+  checks[17].share1.clear();
+  checks[17].share2.clear();
+
+  EXPECT_EQ(BatchVerifyShares(checks, group_g, group_h), (std::vector<std::size_t>{5, 12, 17}));
+}
+
+TEST(MclDkgTests, LagrangeCoefficients)
+{
+  details::MCLInitialiser();
+
+  uint32_t cabinet_size = 60;
+  uint32_t threshold    = 16;
+
+  auto outputs = TrustedDealerGenerateKeys(cabinet_size, threshold);
+
+  Generator group_g;
+  SetGenerator(group_g);
+
+  MessagePayload       message = "Hello";
+  LagrangeCoefficients lagrange{cabinet_size};
+
+  for (uint32_t offset = 0; offset < 3; ++offset)
+  {
+    std::unordered_map<CabinetIndex, Signature> shares;
+    LagrangeCoefficients::SignerSet             signers;
+    for (uint32_t i = offset; i < cabinet_size && signers.size() < threshold; i += 1 + offset)
+    {
+      shares.insert({i, SignShare(message, outputs[i].private_key_share)});
+      signers.insert(i);
+    }
+
+    auto const &coefficients    = lagrange.Get(signers);
+    Signature   group_signature = LagrangeInterpolation(shares, coefficients);
+
+    EXPECT_EQ(group_signature, LagrangeInterpolation(shares));
+    EXPECT_TRUE(VerifySign(outputs[0].group_public_key, message, group_signature, group_g));
+
+    // The coefficients of the signer set are now cached
+    EXPECT_EQ(&coefficients, &lagrange.Get(signers));
+  }
+
+  EXPECT_EQ(lagrange.cached_sets(), 3u);
+}
+
 TEST(MclNotarisationTests, AggregateSigningVerification)
 {
   details::MCLInitialiser();
@@ -198,3 +198,44 @@ TEST(crypto_merkle_tree, same_result_after_move)
   EXPECT_EQ(tree.root().size(), 256 / 8);
   EXPECT_EQ(tree.root(), root_before);
 }
+
+TEST(crypto_merkle_tree, matches_naive_calculation)
+{
+  // reference implementation which pads the leaves with empty nodes up to a power of 2
+  auto const naive_root = [](MerkleTree const &tree) {
+    std::vector<ConstByteArray> hashes = tree.leaf_nodes();
+    while ((hashes.size() & (hashes.size() - 1)) != 0)
+    {
+      hashes.emplace_back();
+    }
+
+    while (hashes.size() > 1)
+    {
+      for (std::size_t i = 0; i < hashes.size(); i += 2)
+      {
+        hashes[i / 2] = CalculateHash(hashes[i], hashes[i + 1]);
+      }
+      hashes.resize(hashes.size() / 2);
+    }
+
+    return hashes[0];
+  };
+
+  for (std::size_t size : {2u, 3u, 7u, 33u, 1000u, 2049u, 4100u})
+  {
+    MerkleTree digest_tree{size};
+    MerkleTree string_tree{size};
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      digest_tree[i] = Hash<crypto::SHA256>(std::to_string(i));
+      string_tree[i] = ByteArray{std::to_string(i)};
+    }
+
+    digest_tree.CalculateRoot();
+    string_tree.CalculateRoot();
+
+    EXPECT_EQ(digest_tree.root(), naive_root(digest_tree)) << "size: " << size;
+    EXPECT_EQ(string_tree.root(), naive_root(string_tree)) << "size: " << size;
+  }
+}
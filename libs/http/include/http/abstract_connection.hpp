@@ -21,6 +21,7 @@
 #include "http/response.hpp"
 #include "network/fetch_asio.hpp"
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -35,9 +36,9 @@ public:
   AbstractHTTPConnection()          = default;
   virtual ~AbstractHTTPConnection() = default;
 
-  virtual void        Send(HTTPResponse const &) = 0;
-  virtual void        CloseConnnection()         = 0;
-  virtual std::string Address()                  = 0;
+  virtual void        Send(uint64_t sequence, HTTPResponse const &) = 0;
+  virtual void        CloseConnnection()                            = 0;
+  virtual std::string Address()                                     = 0;
 };
 
 }  // namespace http
@@ -28,7 +28,10 @@
 #include "logging/logging.hpp"
 #include "network/fetch_asio.hpp"
 
+#include <cstdint>
 #include <deque>
+#include <limits>
+#include <map>
 #include <memory>
 
 namespace fetch {
@@ -39,6 +42,7 @@ class HTTPConnection : public AbstractHTTPConnection,
 {
 public:
   using ResponseQueueType = std::deque<HTTPResponse>;
+  using PendingResponses  = std::map<uint64_t, HTTPResponse>;
   using ConnectionType    = typename AbstractHTTPConnection::SharedType;
   using HandleType        = HTTPConnectionManager::HandleType;
   using SharedRequestType = std::shared_ptr<HTTPRequest>;
@@ -46,6 +50,9 @@ public:
 
   static constexpr char const *LOGGING_NAME = "HTTPConnection";
 
+  /// The number of requests that can be awaiting a response before reading is paused
+  static constexpr uint64_t MAX_PIPELINED_REQUESTS = 32;
+
   HTTPConnection(asio::ip::tcp::tcp::socket socket, HTTPConnectionManager &manager)
     : socket_(std::move(socket))
     , manager_(manager)
@@ -62,19 +69,55 @@ public:
     ReadHeader();
   }
 
-  void Send(HTTPResponse const &response) override
+  /**
+   * Send the response to a request. Requests can be evaluated concurrently, so responses are held
+   * back until those to all earlier requests on the connection have been sent.
+   *
+   * @param sequence The sequence number of the request
+   * @param response The response
+   */
+  void Send(uint64_t sequence, HTTPResponse const &response) override
   {
-    bool write_in_progress = false;
+    bool              start_write = false;
+    BufferPointerType resume_buffer{};
     {
       FETCH_LOCK(write_mutex_);
-      write_in_progress = !write_queue_.empty();
-      write_queue_.push_back(response);
+      pending_responses_.emplace(sequence, response);
+
+      for (auto it = pending_responses_.find(next_response_); it != pending_responses_.end();
+           it      = pending_responses_.find(next_response_))
+      {
+        if (it->first == close_after_)
+        {
+          it->second.AddHeader("connection", "close");
+          close_when_written_ = true;
+        }
+
+        write_queue_.push_back(std::move(it->second));
+        pending_responses_.erase(it);
+        ++next_response_;
+      }
+
+      start_write = !writing_ && !write_queue_.empty();
+      writing_    = writing_ || start_write;
+
+      // resume reading once the client is no longer too far ahead of us
+      if (paused_buffer_ && ((next_request_ - next_response_) < MAX_PIPELINED_REQUESTS))
+      {
+        resume_buffer = std::move(paused_buffer_);
+        paused_buffer_.reset();
+      }
     }
 
-    if (!write_in_progress)
+    if (start_write)
     {
       Write();
     }
+
+    if (resume_buffer && is_open_)
+    {
+      ReadHeader(resume_buffer);
+    }
   }
 
   std::string Address() override
@@ -139,10 +182,32 @@ public:
       auto const &remote_endpoint = socket_.remote_endpoint();
       request->SetOriginatingAddress(remote_endpoint.address().to_string(), remote_endpoint.port());
 
+      // pipelined requests are numbered so that their responses can be sent in order
+      bool const keep_alive   = request->keep_alive();
+      bool       read_further = false;
+      {
+        FETCH_LOCK(write_mutex_);
+        uint64_t const sequence = next_request_++;
+        request->SetSequence(sequence);
+
+        if (!keep_alive)
+        {
+          close_after_ = sequence;
+        }
+        else if ((next_request_ - next_response_) < MAX_PIPELINED_REQUESTS)
+        {
+          read_further = true;
+        }
+        else
+        {
+          paused_buffer_ = buffer_ptr;
+        }
+      }
+
       // push the request to the main server
       manager_.PushRequest(handle_, *request);
 
-      if (is_open_)
+      if (is_open_ && read_further)
       {
         ReadHeader(buffer_ptr);
       }
@@ -196,15 +261,22 @@ public:
       if (!ec)
       {
         bool write_more = false;
+        bool close      = false;
         {
           FETCH_LOCK(write_mutex_);
           write_more = !write_queue_.empty();
+          writing_   = write_more;
+          close      = !write_more && close_when_written_;
         }
 
         if (is_open_ && write_more)
         {
           Write();
         }
+        else if (close)
+        {
+          Close();
+        }
       }
       else
       {
@@ -240,6 +312,17 @@ private:
   ResponseQueueType          write_queue_;
   Mutex                      write_mutex_;
 
+  /// @name Pipelining (protected by write_mutex_)
+  /// @{
+  PendingResponses  pending_responses_;
+  uint64_t          next_request_{0};
+  uint64_t          next_response_{0};
+  uint64_t          close_after_{std::numeric_limits<uint64_t>::max()};
+  bool              close_when_written_{false};
+  bool              writing_{false};
+  BufferPointerType paused_buffer_{};
+  /// @}
+
   HandleType handle_{};
   bool       is_open_ = false;
 };
@@ -40,7 +40,7 @@ public:
 
   HandleType  Join(ConnectionType client);
   void        Leave(HandleType handle);
-  bool        Send(HandleType client, HTTPResponse const &res);
+  bool        Send(HandleType client, uint64_t sequence, HTTPResponse const &res);
   void        PushRequest(HandleType client, HTTPRequest const &req);
   std::string GetAddress(HandleType client);
 
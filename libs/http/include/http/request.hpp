@@ -172,6 +172,18 @@ public:
     return auth_level_;
   }
 
+  bool keep_alive() const;
+
+  void SetSequence(uint64_t sequence)
+  {
+    sequence_ = sequence;
+  }
+
+  uint64_t sequence() const
+  {
+    return sequence_;
+  }
+
 private:
   bool ParseStartLine(byte_array::ByteArray &line);
 
@@ -193,6 +205,9 @@ private:
 
   std::size_t content_length_ = 0;
 
+  /// The position of the request among those received on its connection
+  uint64_t sequence_{0};
+
   /// @name Metadata
   /// @{
   Timepoint created_{Clock::now()};
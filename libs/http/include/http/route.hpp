@@ -26,6 +26,7 @@
 #include <cstddef>
 #include <functional>
 #include <regex>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -44,6 +45,19 @@ public:
   using ParameterList  = std::vector<byte_array::ConstByteArray>;
   using ValidatorMap   = std::unordered_map<byte_array::ConstByteArray, validators::Validator>;
 
+  /**
+   * A piece of the route, either a literal to be matched exactly or a named parameter with the
+   * regular expression its value must match
+   */
+  struct Segment
+  {
+    bool                  is_parameter{false};
+    byte_array::ByteArray value{};    ///< The literal or the name of the parameter
+    std::string           pattern{};  ///< The regular expression of the parameter
+  };
+
+  using Segments = std::vector<Segment>;
+
   bool Match(byte_array::ConstByteArray const &path, ViewParameters &params)
   {
     std::size_t i = 0;
@@ -133,6 +147,11 @@ public:
     return path_parameters_;
   }
 
+  Segments const &segments() const
+  {
+    return segments_;
+  }
+
   bool HasParameterDetails(byte_array::ConstByteArray const &name) const
   {
     auto it = validators_.find(name);
@@ -154,6 +173,8 @@ public:
 private:
   void AddMatch(byte_array::ByteArray const &value)
   {
+    segments_.push_back({false, value, {}});
+
     match_.push_back([value](std::size_t &i, byte_array::ByteArray const &path, ViewParameters &) {
       bool ret = path.Match(value, i);
       if (ret)
@@ -179,7 +200,10 @@ private:
     byte_array::ByteArray var = value.SubArray(0, i);
     ++i;
 
-    std::string reg = "^" + std::string(value.SubArray(i, value.size() - i));
+    std::string pattern = std::string(value.SubArray(i, value.size() - i));
+    segments_.push_back({true, var, pattern});
+
+    std::string reg = "^" + pattern;
 
     std::regex rgx(reg);
     match_.push_back(
@@ -213,6 +237,7 @@ private:
   MatchingVector        match_;
   ParameterList         path_parameters_;
   ValidatorMap          validators_;
+  Segments              segments_;
 };
 }  // namespace http
 }  // namespace fetch
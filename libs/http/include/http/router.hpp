@@ -0,0 +1,141 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "http/method.hpp"
+#include "http/route.hpp"
+#include "http/view_parameters.hpp"
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <regex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace http {
+
+/**
+ * Compiled form of a set of routes. The literal parts of all the routes are merged into a trie of
+ * bytes, with the parameters hanging off it as edges to the rest of their route. Looking up a path
+ * visits each of its bytes about once instead of matching it against every route in turn.
+ *
+ * Matching follows Route::Match: parameters take the longest value their pattern allows without
+ * backtracking, and when several routes match, the one that was added first wins.
+ */
+class Router
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+  using Index          = std::size_t;
+
+  static constexpr Index NO_ROUTE = std::numeric_limits<Index>::max();
+
+  /**
+   * Matcher for the value of a route parameter. Patterns that are a single character class with
+   * an optional quantifier (e.g. "[a-fA-F0-9]{64}", "\d+" or ".+") are matched with a lookup table,
+   * anything else with a regular expression.
+   */
+  class Pattern
+  {
+  public:
+    static constexpr std::size_t NO_MATCH = std::numeric_limits<std::size_t>::max();
+
+    explicit Pattern(std::string const &pattern);
+
+    std::size_t Match(ConstByteArray const &path, std::size_t offset) const;
+
+    std::string const &source() const
+    {
+      return source_;
+    }
+
+    bool is_compiled() const
+    {
+      return !regex_;
+    }
+
+  private:
+    using Characters = std::bitset<256>;
+    using RegexPtr   = std::shared_ptr<std::regex>;
+
+    bool Compile(std::string const &pattern);
+
+    std::string source_;
+    Characters  characters_{};
+    std::size_t min_count_{1};
+    std::size_t max_count_{1};
+    RegexPtr    regex_{};
+  };
+
+  Index Add(Method method, Route const &route);
+  Index Match(Method method, ConstByteArray const &path, ViewParameters &params) const;
+
+  std::size_t size() const
+  {
+    return methods_.size();
+  }
+
+private:
+  struct Parameter
+  {
+    ConstByteArray name;
+    std::size_t    pattern;
+    std::size_t    next;
+  };
+
+  struct Node
+  {
+    std::vector<std::pair<uint8_t, std::size_t>> children{};
+    std::vector<Parameter>                       parameters{};
+    std::vector<Index>                           routes{};  ///< Routes ending here, in order
+  };
+
+  struct Capture
+  {
+    ConstByteArray const *name;
+    std::size_t           offset;
+    std::size_t           length;
+  };
+
+  using Captures = std::vector<Capture>;
+
+  struct Search
+  {
+    Method                method;
+    ConstByteArray const &path;
+    Captures              captures;
+    Captures              best_captures;
+    Index                 best;
+  };
+
+  std::size_t AddLiteral(std::size_t node, ConstByteArray const &literal);
+  void        Visit(Search &search, std::size_t node, std::size_t offset) const;
+
+  std::vector<Node>    nodes_{1};
+  std::vector<Pattern> patterns_;
+  std::vector<Method>  methods_;
+};
+
+}  // namespace http
+}  // namespace fetch
@@ -28,9 +28,11 @@
 #include "http/request.hpp"
 #include "http/response.hpp"
 #include "http/route.hpp"
+#include "http/router.hpp"
 #include "http/status.hpp"
 #include "http/tagged_tree.hpp"
 #include "logging/logging.hpp"
+#include "network/details/thread_pool.hpp"
 #include "network/fetch_asio.hpp"
 #include "network/management/network_manager.hpp"
 
@@ -55,6 +57,7 @@ public:
   using HandleType = uint64_t;
 
   using NetworkManager    = network::NetworkManager;
+  using ThreadPool        = network::ThreadPool;
   using Socket            = asio::ip::tcp::tcp::socket;
   using Acceptor          = asio::ip::tcp::tcp::acceptor;
   using ConnectionManager = HTTPConnectionManager;
@@ -75,6 +78,12 @@ public:
 
   virtual ~HTTPServer()
   {
+    // requests being evaluated refer to this class
+    if (workers_)
+    {
+      workers_->Stop();
+    }
+
     auto socketWeak = socket_;
     auto accepWeak  = acceptor_;
 
@@ -102,8 +111,26 @@ public:
     }
   }
 
+  /**
+   * Evaluate requests on a pool of worker threads rather than one at a time. The views and
+   * middleware must then be safe to call concurrently, and must all be added before the server is
+   * started.
+   *
+   * @param num_workers The number of worker threads
+   */
+  void EnableConcurrentDispatch(std::size_t num_workers)
+  {
+    num_workers_ = num_workers;
+  }
+
   void Start(uint16_t port)
   {
+    if ((num_workers_ != 0) && !workers_)
+    {
+      workers_ = network::MakeThreadPool(num_workers_, "HTTP");
+      workers_->Start();
+    }
+
     std::weak_ptr<ConnectionManager> &manager   = manager_;
     std::weak_ptr<Socket> &           socRef    = socket_;
     std::weak_ptr<Acceptor> &         accepRef  = acceptor_;
@@ -163,79 +190,18 @@ public:
       res.AddHeader("Access-Control-Allow-Headers",
                     "Content-Type, Authorization, Content-Length, X-Requested-With");
 
-      SendToManager(client, res);
+      SendToManager(client, req.sequence(), res);
       return;
     }
 
-    // TODO(issue 28): improve such that it works for multiple threads.
-    FETCH_LOCK(eval_mutex_);
-    HTTPResponse res("page not found", mime_types::GetMimeTypeFromExtension(".html"),
-                     Status::CLIENT_ERROR_NOT_FOUND);
-
-    // Ensure that the HTTP server remains operational
-    // even if exceptions are thrown
-    try
+    if (workers_)
     {
-      // applying pre-process middleware
-      for (auto &m : pre_view_middleware_)
-      {
-        m(req);
-      }
-
-      // finding the view that matches the URL
-      ViewParameters params;
-      for (auto &v : views_)
-      {
-        // skip all views that don't match the required method
-        if (v.method != req.method())
-        {
-          continue;
-        }
-
-        if (v.route.Match(req.uri(), params))
-        {
-          // checking that the correct level of authentication is present
-          if (!v.authenticator(req))
-          {
-            res = HTTPResponse("authentication required",
-                               fetch::http::mime_types::GetMimeTypeFromExtension(".html"),
-                               Status::SERVER_ERROR_NETWORK_AUTHENTICATION_REQUIRED);
-            SendToManager(client, res);
-            return;
-          }
-
-          // generating result
-          res = v.view(params, req);
-          break;
-        }
-      }
-
-      // signal that the request has been processed
-      req.SetProcessed();
-
-      for (auto &m : post_view_middleware_)
-      {
-        m(res, req);
-      }
-    }
-    catch (std::exception const &e)
-    {
-      HTTPResponse response("internal error: " + std::string(e.what()),
-                            fetch::http::mime_types::GetMimeTypeFromExtension(".html"),
-                            Status::SERVER_ERROR_INTERNAL_SERVER_ERROR);
-      SendToManager(client, response);
-      return;
-    }
-    catch (...)
-    {
-      HTTPResponse response("unknown internal error",
-                            fetch::http::mime_types::GetMimeTypeFromExtension(".html"),
-                            Status::SERVER_ERROR_INTERNAL_SERVER_ERROR);
-      SendToManager(client, response);
+      workers_->Post([this, client, req]() { Dispatch(client, req); });
       return;
     }
 
-    SendToManager(client, res);
+    FETCH_LOCK(eval_mutex_);
+    Dispatch(client, req);
   }
 
   // Accept static void to avoid having to create shared ptr to this class
@@ -291,6 +257,7 @@ public:
       route.AddValidator(param.name, std::move(v));
     }
 
+    router_.Add(method, route);
     views_.push_back(
         {std::move(description), method, std::move(route), view, std::move(authenticator)});
   }
@@ -315,16 +282,16 @@ public:
     return views_;
   }
 
-  void SendToManager(HandleType client, HTTPResponse const &res)
+  void SendToManager(HandleType client, uint64_t sequence, HTTPResponse const &res)
   {
     std::weak_ptr<ConnectionManager> manager = manager_;
 
-    networkManager_.Post([manager, client, res] {
+    networkManager_.Post([manager, client, sequence, res] {
       auto manager_lock = manager.lock();
 
       if (manager_lock)
       {
-        manager_lock->Send(client, res);
+        manager_lock->Send(client, sequence, res);
       }
     });
   }
@@ -335,12 +302,86 @@ public:
   }
 
 private:
+  /**
+   * Evaluate a request against the mounted views and send the response
+   *
+   * @param client The handle of the client connection
+   * @param req The request
+   */
+  void Dispatch(HandleType client, HTTPRequest req)
+  {
+    HTTPResponse res("page not found", mime_types::GetMimeTypeFromExtension(".html"),
+                     Status::CLIENT_ERROR_NOT_FOUND);
+
+    // Ensure that the HTTP server remains operational
+    // even if exceptions are thrown
+    try
+    {
+      // applying pre-process middleware
+      for (auto &m : pre_view_middleware_)
+      {
+        m(req);
+      }
+
+      // finding the view that matches the URL
+      ViewParameters params;
+      auto const     index = router_.Match(req.method(), req.uri(), params);
+      if (index != Router::NO_ROUTE)
+      {
+        auto const &v = views_[index];
+
+        // checking that the correct level of authentication is present
+        if (!v.authenticator(req))
+        {
+          res = HTTPResponse("authentication required",
+                             fetch::http::mime_types::GetMimeTypeFromExtension(".html"),
+                             Status::SERVER_ERROR_NETWORK_AUTHENTICATION_REQUIRED);
+          SendToManager(client, req.sequence(), res);
+          return;
+        }
+
+        // generating result
+        res = v.view(params, req);
+      }
+
+      // signal that the request has been processed
+      req.SetProcessed();
+
+      for (auto &m : post_view_middleware_)
+      {
+        m(res, req);
+      }
+    }
+    catch (std::exception const &e)
+    {
+      HTTPResponse response("internal error: " + std::string(e.what()),
+                            fetch::http::mime_types::GetMimeTypeFromExtension(".html"),
+                            Status::SERVER_ERROR_INTERNAL_SERVER_ERROR);
+      SendToManager(client, req.sequence(), response);
+      return;
+    }
+    catch (...)
+    {
+      HTTPResponse response("unknown internal error",
+                            fetch::http::mime_types::GetMimeTypeFromExtension(".html"),
+                            Status::SERVER_ERROR_INTERNAL_SERVER_ERROR);
+      SendToManager(client, req.sequence(), response);
+      return;
+    }
+
+    SendToManager(client, req.sequence(), res);
+  }
+
   Mutex eval_mutex_;
 
   std::vector<RequestMiddleware>  pre_view_middleware_;
   MountedViews                    views_;
+  Router                          router_;
   std::vector<ResponseMiddleware> post_view_middleware_;
 
+  std::size_t num_workers_{0};
+  ThreadPool  workers_{};
+
   NetworkManager                   networkManager_;
   std::deque<HTTPRequest>          requests_;
   std::weak_ptr<Acceptor>          acceptor_;
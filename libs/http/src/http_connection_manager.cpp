@@ -70,7 +70,15 @@ void HTTPConnectionManager::Leave(HandleType handle)
   FETCH_LOG_DEBUG(LOGGING_NAME, "Client ", handle, " is leaving");
 }
 
-bool HTTPConnectionManager::Send(HandleType client, HTTPResponse const &res)
+/**
+ * Send the response to a request
+ *
+ * @param client The handle of the client connection
+ * @param sequence The sequence number of the request on its connection
+ * @param res The response
+ * @return true if the client was found, otherwise false
+ */
+bool HTTPConnectionManager::Send(HandleType client, uint64_t sequence, HTTPResponse const &res)
 {
   bool ret = true;
   clients_mutex_.lock();
@@ -79,7 +87,7 @@ bool HTTPConnectionManager::Send(HandleType client, HTTPResponse const &res)
   {
     auto c = clients_[client];
     clients_mutex_.unlock();
-    c->Send(res);
+    c->Send(sequence, res);
     FETCH_LOG_DEBUG(LOGGING_NAME, "Client manager did send message to ", client);
     clients_mutex_.lock();
   }
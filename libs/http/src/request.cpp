@@ -17,14 +17,42 @@
 //------------------------------------------------------------------------------
 
 #include "core/assert.hpp"
+#include "core/string/to_lower.hpp"
 #include "http/request.hpp"
 
 #include <algorithm>
 #include <iostream>
+#include <string>
 
 namespace fetch {
 namespace http {
 
+/**
+ * Determine whether the client expects the connection to remain open once the response has been
+ * sent (RFC 7230, section 6.3)
+ *
+ * @return true if the connection is persistent, otherwise false
+ */
+bool HTTPRequest::keep_alive() const
+{
+  std::string connection{header_["connection"]};
+  std::string protocol{protocol_};
+  string::ToLower(connection);
+  string::ToLower(protocol);
+
+  if (connection == "close")
+  {
+    return false;
+  }
+
+  if (protocol == "http/1.0")
+  {
+    return connection == "keep-alive";
+  }
+
+  return true;
+}
+
 bool HTTPRequest::ParseBody(asio::streambuf &buffer)
 {
   // TODO(issue 35): Handle encoding
@@ -0,0 +1,454 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "http/router.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <regex>
+#include <string>
+
+namespace fetch {
+namespace http {
+namespace {
+
+using Characters = std::bitset<256>;
+
+constexpr std::size_t UNBOUNDED  = std::numeric_limits<std::size_t>::max();
+constexpr std::size_t MAX_DIGITS = 9;
+constexpr char const *SPECIALS   = "^$\\.*+?()[]{}|";
+
+void AddRange(Characters &characters, char first, char last)
+{
+  for (auto c = static_cast<uint8_t>(first); c <= static_cast<uint8_t>(last); ++c)
+  {
+    characters.set(c);
+  }
+}
+
+/**
+ * Add the characters of an escape sequence such as "\d" to the set
+ *
+ * @param characters The set of characters
+ * @param escaped The character following the backslash
+ * @return true if the escape sequence is supported, otherwise false
+ */
+bool AddEscape(Characters &characters, char escaped)
+{
+  switch (escaped)
+  {
+  case 'd':
+    AddRange(characters, '0', '9');
+    return true;
+  case 'w':
+    AddRange(characters, '0', '9');
+    AddRange(characters, 'a', 'z');
+    AddRange(characters, 'A', 'Z');
+    characters.set('_');
+    return true;
+  case 's':
+    for (char c : {' ', '\t', '\n', '\v', '\f', '\r'})
+    {
+      characters.set(static_cast<uint8_t>(c));
+    }
+    return true;
+  default:
+    break;
+  }
+
+  // escaped punctuation stands for itself, letters and digits have special meanings
+  if (std::isalnum(static_cast<unsigned char>(escaped)) != 0)
+  {
+    return false;
+  }
+
+  characters.set(static_cast<uint8_t>(escaped));
+  return true;
+}
+
+bool ParseCount(std::string const &pattern, std::size_t &i, std::size_t &count)
+{
+  std::size_t const start = i;
+
+  count = 0;
+  while ((i < pattern.size()) && (std::isdigit(static_cast<unsigned char>(pattern[i])) != 0))
+  {
+    count = (count * 10u) + static_cast<std::size_t>(pattern[i] - '0');
+    ++i;
+  }
+
+  return (i != start) && ((i - start) <= MAX_DIGITS);
+}
+
+}  // namespace
+
+constexpr Router::Index Router::NO_ROUTE;
+constexpr std::size_t   Router::Pattern::NO_MATCH;
+
+Router::Pattern::Pattern(std::string const &pattern)
+  : source_{pattern}
+{
+  if (!Compile(pattern))
+  {
+    characters_.reset();
+    regex_ = std::make_shared<std::regex>("^" + pattern);
+  }
+}
+
+/**
+ * Match the pattern against the path
+ *
+ * @param path The path being routed
+ * @param offset The position in the path where the value of the parameter starts
+ * @return The length of the value, or NO_MATCH if the pattern does not match
+ */
+std::size_t Router::Pattern::Match(ConstByteArray const &path, std::size_t offset) const
+{
+  if (regex_)
+  {
+    std::string const remainder{path.SubArray(offset)};
+    std::smatch       matches;
+
+    // ambiguous matches are treated as non-matches, as in Route::Match
+    if (!std::regex_search(remainder, matches, *regex_) || (matches.size() != 1))
+    {
+      return NO_MATCH;
+    }
+
+    return static_cast<std::size_t>(matches[0].length());
+  }
+
+  std::size_t const limit = std::min(max_count_, path.size() - offset);
+
+  std::size_t count = 0;
+  while ((count < limit) && characters_.test(path[offset + count]))
+  {
+    ++count;
+  }
+
+  return (count >= min_count_) ? count : NO_MATCH;
+}
+
+/**
+ * Compile a pattern consisting of a single character, escape sequence or character class with an
+ * optional greedy quantifier
+ *
+ * @param pattern The regular expression
+ * @return true if the pattern could be compiled, otherwise false
+ */
+bool Router::Pattern::Compile(std::string const &pattern)
+{
+  std::size_t const size = pattern.size();
+  std::size_t       i    = 0;
+
+  if (size == 0)
+  {
+    return false;
+  }
+
+  // the character set
+  char const first = pattern[i++];
+  if (first == '.')
+  {
+    characters_.set();
+    characters_.reset('\n');
+    characters_.reset('\r');
+  }
+  else if (first == '\\')
+  {
+    if ((i == size) || !AddEscape(characters_, pattern[i++]))
+    {
+      return false;
+    }
+  }
+  else if (first == '[')
+  {
+    bool const negated = (i < size) && (pattern[i] == '^');
+    if (negated)
+    {
+      ++i;
+    }
+
+    // an empty class or one with a leading ']' is left to the regular expression engine
+    if ((i < size) && (pattern[i] == ']'))
+    {
+      return false;
+    }
+
+    while ((i < size) && (pattern[i] != ']'))
+    {
+      char const c = pattern[i++];
+
+      if (c == '\\')
+      {
+        if ((i == size) || !AddEscape(characters_, pattern[i++]))
+        {
+          return false;
+        }
+      }
+      else if (((i + 1) < size) && (pattern[i] == '-') && (pattern[i + 1] != ']'))
+      {
+        char const last = pattern[i + 1];
+        if ((last == '\\') || (last == '[') ||
+            (static_cast<uint8_t>(last) < static_cast<uint8_t>(c)))
+        {
+          return false;
+        }
+
+        AddRange(characters_, c, last);
+        i += 2;
+      }
+      else if (c == '[')
+      {
+        // possibly a POSIX class such as [:alpha:]
+        return false;
+      }
+      else
+      {
+        characters_.set(static_cast<uint8_t>(c));
+      }
+    }
+
+    if (i == size)
+    {
+      return false;
+    }
+    ++i;
+
+    if (negated)
+    {
+      characters_.flip();
+    }
+  }
+  else if (std::string{SPECIALS}.find(first) != std::string::npos)
+  {
+    return false;
+  }
+  else
+  {
+    characters_.set(static_cast<uint8_t>(first));
+  }
+
+  // the quantifier
+  min_count_ = 1;
+  max_count_ = 1;
+
+  if (i < size)
+  {
+    switch (pattern[i++])
+    {
+    case '+':
+      max_count_ = UNBOUNDED;
+      break;
+    case '*':
+      min_count_ = 0;
+      max_count_ = UNBOUNDED;
+      break;
+    case '?':
+      min_count_ = 0;
+      break;
+    case '{':
+      if (!ParseCount(pattern, i, min_count_) || (i == size))
+      {
+        return false;
+      }
+
+      max_count_ = min_count_;
+      if (pattern[i] == ',')
+      {
+        ++i;
+        max_count_ = UNBOUNDED;
+        if ((i < size) && (pattern[i] != '}') && !ParseCount(pattern, i, max_count_))
+        {
+          return false;
+        }
+      }
+
+      if ((i == size) || (pattern[i] != '}') || (max_count_ < min_count_))
+      {
+        return false;
+      }
+      ++i;
+      break;
+    default:
+      return false;
+    }
+  }
+
+  // anything else, including lazy quantifiers, needs the regular expression engine
+  return i == size;
+}
+
+/**
+ * Add a route to the router
+ *
+ * @param method The method of the requests to be routed
+ * @param route The route
+ * @return The index of the route, in the order routes are added
+ */
+Router::Index Router::Add(Method method, Route const &route)
+{
+  std::size_t node = 0;
+
+  for (auto const &segment : route.segments())
+  {
+    if (!segment.is_parameter)
+    {
+      node = AddLiteral(node, segment.value);
+      continue;
+    }
+
+    auto const &parameters = nodes_[node].parameters;
+    auto        it =
+        std::find_if(parameters.begin(), parameters.end(), [this, &segment](Parameter const &p) {
+          return (p.name == segment.value) && (patterns_[p.pattern].source() == segment.pattern);
+        });
+
+    if (it != parameters.end())
+    {
+      node = it->next;
+      continue;
+    }
+
+    std::size_t const next = nodes_.size();
+    patterns_.emplace_back(segment.pattern);
+    nodes_.emplace_back();
+
+    nodes_[node].parameters.push_back({segment.value, patterns_.size() - 1, next});
+    node = next;
+  }
+
+  Index const index = methods_.size();
+  methods_.push_back(method);
+  nodes_[node].routes.push_back(index);
+
+  return index;
+}
+
+/**
+ * Find the route for a request
+ *
+ * @param method The method of the request
+ * @param path The path of the request
+ * @param params The parameters extracted from the path
+ * @return The index of the first route that matches, or NO_ROUTE
+ */
+Router::Index Router::Match(Method method, ConstByteArray const &path, ViewParameters &params) const
+{
+  Search search{method, path, {}, {}, NO_ROUTE};
+  Visit(search, 0, 0);
+
+  params.Clear();
+  if (search.best != NO_ROUTE)
+  {
+    for (auto const &capture : search.best_captures)
+    {
+      params[*capture.name] = path.SubArray(capture.offset, capture.length);
+    }
+  }
+
+  return search.best;
+}
+
+std::size_t Router::AddLiteral(std::size_t node, ConstByteArray const &literal)
+{
+  for (std::size_t i = 0; i < literal.size(); ++i)
+  {
+    uint8_t const c        = literal[i];
+    auto const &  children = nodes_[node].children;
+    auto const    it =
+        std::find_if(children.begin(), children.end(),
+                     [c](std::pair<uint8_t, std::size_t> const &e) { return e.first == c; });
+
+    if (it != children.end())
+    {
+      node = it->second;
+      continue;
+    }
+
+    std::size_t const next = nodes_.size();
+    nodes_.emplace_back();
+    nodes_[node].children.emplace_back(c, next);
+    node = next;
+  }
+
+  return node;
+}
+
+void Router::Visit(Search &search, std::size_t node, std::size_t offset) const
+{
+  ConstByteArray const &path = search.path;
+
+  for (;;)
+  {
+    Node const &current = nodes_[node];
+
+    if (offset == path.size())
+    {
+      for (Index const index : current.routes)
+      {
+        if (index >= search.best)
+        {
+          break;
+        }
+
+        if (methods_[index] == search.method)
+        {
+          search.best          = index;
+          search.best_captures = search.captures;
+          break;
+        }
+      }
+    }
+
+    for (auto const &parameter : current.parameters)
+    {
+      std::size_t const length = patterns_[parameter.pattern].Match(path, offset);
+      if (length == Pattern::NO_MATCH)
+      {
+        continue;
+      }
+
+      search.captures.push_back({&parameter.name, offset, length});
+      Visit(search, parameter.next, offset + length);
+      search.captures.pop_back();
+    }
+
+    if (offset == path.size())
+    {
+      return;
+    }
+
+    auto const it = std::find_if(
+        current.children.begin(), current.children.end(),
+        [c = path[offset]](std::pair<uint8_t, std::size_t> const &e) { return e.first == c; });
+
+    if (it == current.children.end())
+    {
+      return;
+    }
+
+    node = it->second;
+    ++offset;
+  }
+}
+
+}  // namespace http
+}  // namespace fetch
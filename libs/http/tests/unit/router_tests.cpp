@@ -0,0 +1,165 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "http/route.hpp"
+#include "http/router.hpp"
+
+#include "gtest/gtest.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Parameters = std::map<fetch::byte_array::ConstByteArray, fetch::byte_array::ConstByteArray>;
+
+using fetch::byte_array::ConstByteArray;
+using fetch::http::Method;
+using fetch::http::Route;
+using fetch::http::Router;
+using fetch::http::ViewParameters;
+
+Parameters ToMap(ViewParameters const &params)
+{
+  return {params.begin(), params.end()};
+}
+
+class RouterTests : public ::testing::Test
+{
+protected:
+  void Add(Method method, std::string const &path)
+  {
+    routes_.emplace_back(Route::FromString(path));
+    methods_.push_back(method);
+    router_.Add(method, routes_.back());
+  }
+
+  // the index of the first route that matches, as found by matching every route in turn
+  Router::Index LinearMatch(Method method, ConstByteArray const &path, ViewParameters &params)
+  {
+    for (std::size_t i = 0; i < routes_.size(); ++i)
+    {
+      if ((methods_[i] == method) && routes_[i].Match(path, params))
+      {
+        return i;
+      }
+    }
+
+    params.Clear();
+    return Router::NO_ROUTE;
+  }
+
+  void ExpectSameAsRoutes(Method method, std::string const &path)
+  {
+    ViewParameters expected_params;
+    ViewParameters params;
+
+    auto const expected = LinearMatch(method, path, expected_params);
+    auto const actual   = router_.Match(method, path, params);
+
+    EXPECT_EQ(expected, actual) << path;
+    EXPECT_EQ(ToMap(expected_params), ToMap(params)) << path;
+  }
+
+  std::vector<Route>  routes_;
+  std::vector<Method> methods_;
+  Router              router_;
+};
+
+TEST_F(RouterTests, SimplePatternsAreCompiled)
+{
+  EXPECT_TRUE(Router::Pattern{"[a-fA-F0-9]{64}"}.is_compiled());
+  EXPECT_TRUE(Router::Pattern{"[1-9A-HJ-NP-Za-km-z]{48,50}"}.is_compiled());
+  EXPECT_TRUE(Router::Pattern{"\\d+"}.is_compiled());
+  EXPECT_TRUE(Router::Pattern{".+"}.is_compiled());
+  EXPECT_TRUE(Router::Pattern{"[^/]*"}.is_compiled());
+
+  EXPECT_FALSE(Router::Pattern{"(a|b)+"}.is_compiled());
+  EXPECT_FALSE(Router::Pattern{"\\d+?"}.is_compiled());
+  EXPECT_FALSE(Router::Pattern{"ab+"}.is_compiled());
+  EXPECT_FALSE(Router::Pattern{"[[:alpha:]]+"}.is_compiled());
+}
+
+TEST_F(RouterTests, CompiledPatternsMatchLikeRegex)
+{
+  std::string const hex(64, 'a');
+
+  Router::Pattern const digest{"[a-fA-F0-9]{64}"};
+  EXPECT_EQ(64u, digest.Match(hex, 0));
+  EXPECT_EQ(64u, digest.Match(hex + "ff/", 0));
+  EXPECT_EQ(Router::Pattern::NO_MATCH, digest.Match(hex.substr(1), 0));
+
+  Router::Pattern const number{"\\d{2,3}"};
+  EXPECT_EQ(3u, number.Match("/12345", 1));
+  EXPECT_EQ(2u, number.Match("/12a", 1));
+  EXPECT_EQ(Router::Pattern::NO_MATCH, number.Match("/1a", 1));
+
+  Router::Pattern const any{".*"};
+  EXPECT_EQ(0u, any.Match("/abc", 4));
+  EXPECT_EQ(3u, any.Match("/ab\nc", 0));
+}
+
+TEST_F(RouterTests, MatchesTheSameRoutesAsRoute)
+{
+  Add(Method::GET, "/");
+  Add(Method::GET, "/api/status");
+  Add(Method::GET, "/api/status/chain");
+  Add(Method::GET, "/api/status/tx/(digest=[a-fA-F0-9]{64})");
+  Add(Method::GET, "/api/tx/(digest=[a-fA-F0-9]{64})/");
+  Add(Method::POST, "/api/contract/(identifier=[1-9A-HJ-NP-Za-km-z]{48,50})/(query=.+)");
+  Add(Method::POST, "/api/contract/submit");
+  Add(Method::GET, "/pages/(id=\\d+)");
+  Add(Method::GET, "/pages/(name=[a-z]+)");
+  Add(Method::GET, "/pages/(id=\\d+)/(section=(intro|body))");
+  Add(Method::PATCH, "/api/logging/");
+
+  std::string const digest(64, 'c');
+  std::string const identifier(49, 'x');
+
+  for (auto const method : {Method::GET, Method::POST, Method::PATCH})
+  {
+    for (std::string const &path : std::vector<std::string>{"/", "", "/api", "/api/status", "/api/status/", "/api/status/chain",
+          "/api/status/tx/" + digest, "/api/status/tx/" + digest + "a", "/api/tx/" + digest,
+          "/api/tx/" + digest + "/", "/api/contract/" + identifier + "/balance",
+          "/api/contract/" + identifier + "/", "/api/contract/submit", "/pages/12",
+          "/pages/abc", "/pages/12/intro", "/pages/12/other", "/pages/", "/api/logging/",
+          "/api/logging"})
+    {
+      ExpectSameAsRoutes(method, path);
+    }
+  }
+}
+
+TEST_F(RouterTests, FirstMatchingRouteWins)
+{
+  Add(Method::GET, "/items/(id=.+)");
+  Add(Method::GET, "/items/latest");
+  Add(Method::POST, "/items/latest");
+
+  ViewParameters params;
+  EXPECT_EQ(0u, router_.Match(Method::GET, "/items/latest", params));
+  EXPECT_EQ(ConstByteArray{"latest"}, params["id"]);
+
+  EXPECT_EQ(2u, router_.Match(Method::POST, "/items/latest", params));
+  EXPECT_TRUE(ToMap(params).empty());
+
+  EXPECT_EQ(Router::NO_ROUTE, router_.Match(Method::DELETE, "/items/latest", params));
+}
+
+}  // namespace
@@ -0,0 +1,147 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/byte_array/encoders.hpp"
+#include "core/random/lcg.hpp"
+#include "json/document.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+using fetch::json::JSONDocument;
+using fetch::random::LinearCongruentialGenerator;
+
+namespace {
+
+// roughly the size of a serialised single transfer transaction
+constexpr std::size_t TX_PAYLOAD_SIZE = 320;
+
+ConstByteArray RandomBytes(LinearCongruentialGenerator &rng, std::size_t size)
+{
+  ByteArray bytes;
+  bytes.Resize(size);
+
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    bytes[i] = static_cast<uint8_t>(rng());
+  }
+
+  return {bytes};
+}
+
+/**
+ * A bulk transaction submission, in the wire format accepted by the contract HTTP interface
+ */
+ConstByteArray GenerateSubmission(std::size_t count)
+{
+  LinearCongruentialGenerator rng;
+  std::ostringstream          oss;
+
+  oss << '[';
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    if (i != 0)
+    {
+      oss << ',';
+    }
+
+    oss << R"({"ver": "1.2", "data": ")" << RandomBytes(rng, TX_PAYLOAD_SIZE).ToBase64() << R"("})";
+  }
+  oss << ']';
+
+  return ConstByteArray{oss.str()};
+}
+
+/**
+ * A list of transaction statuses, in the format returned by the transaction status interface
+ */
+ConstByteArray GenerateStatuses(std::size_t count)
+{
+  LinearCongruentialGenerator rng;
+  std::ostringstream          oss;
+
+  oss << '[';
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    if (i != 0)
+    {
+      oss << ",\n";
+    }
+
+    oss << "{\n"
+        << R"(  "tx": ")" << RandomBytes(rng, 32).ToHex() << "\",\n"
+        << R"(  "status": "Executed",)"
+        << "\n"
+        << R"(  "exit_code": 0,)"
+        << "\n"
+        << R"(  "charge": )" << (rng() % 10000u) << ",\n"
+        << R"(  "charge_rate": 1,)"
+        << "\n"
+        << R"(  "fee": )" << (rng() % 10000u) << "\n"
+        << '}';
+  }
+  oss << ']';
+
+  return ConstByteArray{oss.str()};
+}
+
+template <ConstByteArray (*Generate)(std::size_t)>
+void JSON_ParseIndexed(benchmark::State &state)
+{
+  auto const document = Generate(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state)
+  {
+    JSONDocument doc;
+    doc.Parse(document);
+
+    benchmark::DoNotOptimize(doc.root());
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(document.size()));
+}
+
+template <ConstByteArray (*Generate)(std::size_t)>
+void JSON_ParseTokeniser(benchmark::State &state)
+{
+  auto const document = Generate(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state)
+  {
+    JSONDocument doc;
+    doc.ParseWithTokeniser(document);
+
+    benchmark::DoNotOptimize(doc.root());
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(document.size()));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(JSON_ParseIndexed, GenerateSubmission)->Range(1, 1024);
+BENCHMARK_TEMPLATE(JSON_ParseTokeniser, GenerateSubmission)->Range(1, 1024);
+BENCHMARK_TEMPLATE(JSON_ParseIndexed, GenerateStatuses)->Range(1, 1024);
+BENCHMARK_TEMPLATE(JSON_ParseTokeniser, GenerateStatuses)->Range(1, 1024);
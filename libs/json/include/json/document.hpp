@@ -21,6 +21,7 @@
 #include "core/byte_array/const_byte_array.hpp"
 #include "core/byte_array/consumers.hpp"
 #include "json/exceptions.hpp"
+#include "json/structural_index.hpp"
 #include "variant/variant.hpp"
 
 #include <cstddef>
@@ -32,6 +33,10 @@ namespace json {
 
 /**
  * Basic JSON parser
+ *
+ * Parsing is done in two stages: the structural index of the document is built first, locating
+ * every string, value and structural character, from which the tokens and finally the variant
+ * tree are produced. Strings in the tree are views into the original document.
  */
 class JSONDocument
 {
@@ -107,6 +112,7 @@ public:
   }
 
   void Parse(ConstByteArray const &document);
+  void ParseWithTokeniser(ConstByteArray const &document);
 
   JSONDocument &operator=(JSONDocument const &) = delete;
   JSONDocument &operator=(JSONDocument &&) = default;
@@ -133,6 +139,8 @@ private:
   };
 
   void        Tokenise(ConstByteArray const &document);
+  void        TokeniseFromIndex(ConstByteArray const &document);
+  void        BuildTree(ConstByteArray const &document);
   static void ExtractPrimitive(Variant &variant, JSONToken const &token,
                                ConstByteArray const &document);
 
@@ -142,6 +150,7 @@ private:
   Variant                  variant_{1024};
   std::size_t              objects_{0};
   std::vector<char>        brace_stack_{};
+  StructuralIndex          index_{};
 };
 }  // namespace json
 }  // namespace fetch
@@ -0,0 +1,55 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace fetch {
+namespace json {
+
+/**
+ * The first stage of parsing a JSON document: the positions of the structural characters
+ * ({, }, [, ], : and ,) outside of strings, of the quotes delimiting the strings and of the first
+ * character of every other value, in document order.
+ *
+ * The document is classified in blocks of 64 bytes, each class of character being represented by
+ * a 64 bit mask. Strings are then located with bitwise arithmetic on the masks, rather than by
+ * looking at each byte in turn.
+ */
+class StructuralIndex
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+  using Positions      = std::vector<uint32_t>;
+
+  void Build(ConstByteArray const &document);
+
+  Positions const &positions() const
+  {
+    return positions_;
+  }
+
+private:
+  Positions positions_;
+};
+
+}  // namespace json
+}  // namespace fetch
@@ -25,15 +25,79 @@
 #include <cmath>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <limits>
 #include <string>
 
 namespace fetch {
 namespace json {
 
 namespace {
+
 constexpr char const *LOGGING_NAME = "JSONDocument";
+
+/**
+ * Convert an integer token (an optional minus sign followed by decimal digits) in place
+ *
+ * @param str The start of the token
+ * @param length The length of the token
+ * @param value The output value
+ * @return true if successful, false if the value does not fit into 64 bits
+ */
+bool ExtractInteger(char const *str, uint64_t length, int64_t &value)
+{
+  bool const negative = (length > 0) && (str[0] == '-');
+
+  // accumulate the magnitude, which for negative numbers can exceed the maximum by one
+  uint64_t const limit = static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) +
+                         static_cast<uint64_t>(negative);
+  uint64_t       magnitude{0};
+
+  for (uint64_t i = negative ? 1 : 0; i < length; ++i)
+  {
+    auto const digit = static_cast<uint64_t>(str[i] - '0');
+    if (magnitude > ((limit - digit) / 10u))
+    {
+      return false;
+    }
+
+    magnitude = (magnitude * 10u) + digit;
+  }
+
+  value = negative ? static_cast<int64_t>(0u - magnitude) : static_cast<int64_t>(magnitude);
+  return true;
+}
+
+bool IsValueDelimiter(uint8_t c)
+{
+  switch (c)
+  {
+  case ' ':
+  case '\t':
+  case '\n':
+  case '\r':
+  case '"':
+  case '{':
+  case '}':
+  case '[':
+  case ']':
+  case ':':
+  case ',':
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool Matches(byte_array::ConstByteArray const &document, uint64_t start, uint64_t end,
+             char const *keyword, uint64_t length)
+{
+  return ((end - start) == length) &&
+         (std::memcmp(document.char_pointer() + start, keyword, length) == 0);
 }
 
+}  // namespace
+
 /**
  * Extract a primitive value from a JSONToken
  *
@@ -70,16 +134,16 @@ void JSONDocument::ExtractPrimitive(Variant &variant, JSONToken const &token,
 
   case NUMBER_INT:
   {
-    std::string const str{document.SubArray(token.first, token.second)};
-    errno   = 0;
-    variant = std::strtoll(str.c_str(), nullptr, 10);
-    if (errno == ERANGE)
+    int64_t value{0};
+    if (!ExtractInteger(document.char_pointer() + token.first, token.second, value))
     {
-      errno = 0;
+      std::string const str{document.SubArray(token.first, token.second)};
       FETCH_LOG_ERROR(LOGGING_NAME, "Failed to convert str=", str, " to integer");
 
       throw JSONParseException(std::string("Failed to convert str=") + str + " to integer");
     }
+
+    variant = value;
     success = true;
     break;
   }
@@ -128,10 +192,30 @@ void JSONDocument::ExtractPrimitive(Variant &variant, JSONToken const &token,
  */
 void JSONDocument::Parse(ConstByteArray const &document)
 {
-  using VariantStack = std::vector<Variant *>;
+  TokeniseFromIndex(document);
+  BuildTree(document);
+}
 
-  // tokenise the document
+/**
+ * Parse a JSON document with the byte by byte tokeniser. This is the reference implementation for
+ * the indexed parser used by Parse.
+ *
+ * @param document The input document
+ */
+void JSONDocument::ParseWithTokeniser(ConstByteArray const &document)
+{
   Tokenise(document);
+  BuildTree(document);
+}
+
+/**
+ * Build the variant tree from the tokens of the document
+ *
+ * @param document The input document
+ */
+void JSONDocument::BuildTree(ConstByteArray const &document)
+{
+  using VariantStack = std::vector<Variant *>;
 
   enum class ObjectState
   {
@@ -321,6 +405,116 @@ void JSONDocument::Parse(ConstByteArray const &document)
   }
 }
 
+/**
+ * Produce the tokens of the document from its structural index. Only the entries of the index
+ * are visited, the remaining bytes are only read when a value is extracted.
+ *
+ * @param document The document to tokenise
+ */
+void JSONDocument::TokeniseFromIndex(ConstByteArray const &document)
+{
+  index_.Build(document);
+
+  brace_stack_.reserve(32);
+  brace_stack_.clear();
+  tokens_.reserve(index_.positions().size());
+  tokens_.clear();
+
+  auto const &positions = index_.positions();
+  auto const  ptr       = document.pointer();
+  auto const  size      = static_cast<uint64_t>(document.size());
+
+  for (std::size_t i = 0; i < positions.size(); ++i)
+  {
+    uint64_t const pos = positions[i];
+
+    switch (ptr[pos])
+    {
+    case '"':
+    {
+      // the index never contains anything between the opening and the closing quote
+      uint64_t const end = positions[++i];
+      tokens_.push_back({pos + 1, end, STRING});
+      break;
+    }
+    case '{':
+      brace_stack_.push_back('}');
+      tokens_.push_back({pos, 0, OPEN_OBJECT});
+      break;
+    case '}':
+      if (brace_stack_.empty() || brace_stack_.back() != '}')
+      {
+        throw JSONParseException("Expected '}', but found ']'");
+      }
+      brace_stack_.pop_back();
+      tokens_.push_back({pos, 0, CLOSE_OBJECT});
+      break;
+    case '[':
+      brace_stack_.push_back(']');
+      tokens_.push_back({pos, 0, OPEN_ARRAY});
+      break;
+    case ']':
+      if (brace_stack_.empty() || brace_stack_.back() != ']')
+      {
+        throw JSONParseException("Expected ']', but found '}'.");
+      }
+      brace_stack_.pop_back();
+      tokens_.push_back({pos, 0, CLOSE_ARRAY});
+      break;
+    case ':':
+      if (brace_stack_.empty() || brace_stack_.back() != '}')
+      {
+        throw JSONParseException("Cannot set property outside of object context");
+      }
+      break;
+    case ',':
+      break;
+    default:
+    {
+      // any other entry is the start of a keyword or a number
+      uint64_t end = pos + 1;
+      while ((end < size) && !IsValueDelimiter(ptr[end]))
+      {
+        ++end;
+      }
+
+      if (Matches(document, pos, end, "true", 4))
+      {
+        tokens_.push_back({pos, end, KEYWORD_TRUE});
+      }
+      else if (Matches(document, pos, end, "false", 5))
+      {
+        tokens_.push_back({pos, end, KEYWORD_FALSE});
+      }
+      else if (Matches(document, pos, end, "null", 4))
+      {
+        tokens_.push_back({pos, end, KEYWORD_NULL});
+      }
+      else
+      {
+        uint64_t   number_end = pos;
+        auto const type       = byte_array::consumers::NumberConsumer<NUMBER_INT, NUMBER_FLOAT>(
+            document, number_end);
+
+        if ((type == -1) || (number_end != end))
+        {
+          throw JSONParseException("Unable to parse value at char " + std::to_string(pos) +
+                                   ": " + std::string{document.SubArray(pos, end - pos)});
+        }
+
+        tokens_.push_back({pos, end - pos, static_cast<uint8_t>(type)});
+      }
+      break;
+    }
+    }
+  }
+
+  if (!brace_stack_.empty())
+  {
+    throw JSONParseException("Object or array indicators are unbalanced.");
+  }
+}
+
 /**
  * Tokenise the input document to be parsed
  *
@@ -0,0 +1,241 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "json/exceptions.hpp"
+#include "json/structural_index.hpp"
+#include "vectorise/platform.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace fetch {
+namespace json {
+namespace {
+
+constexpr std::size_t BLOCK_SIZE = 64;
+
+struct BlockMasks
+{
+  uint64_t quote{0};
+  uint64_t backslash{0};
+  uint64_t structural{0};
+  uint64_t whitespace{0};
+};
+
+#if defined(__AVX2__)
+
+uint64_t ToMask(__m256i const &lo, __m256i const &hi)
+{
+  auto const lo_bits = static_cast<uint32_t>(_mm256_movemask_epi8(lo));
+  auto const hi_bits = static_cast<uint32_t>(_mm256_movemask_epi8(hi));
+
+  return uint64_t{lo_bits} | (uint64_t{hi_bits} << 32u);
+}
+
+BlockMasks Classify(uint8_t const *block)
+{
+  __m256i const lo = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(block));
+  __m256i const hi = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(block + 32));
+
+  auto const eq = [&lo, &hi](char c) {
+    __m256i const value = _mm256_set1_epi8(c);
+    return ToMask(_mm256_cmpeq_epi8(lo, value), _mm256_cmpeq_epi8(hi, value));
+  };
+
+  // '[' and ']' only differ from '{' and '}' in the 0x20 bit
+  __m256i const case_bit = _mm256_set1_epi8(0x20);
+  __m256i const lo_upper = _mm256_or_si256(lo, case_bit);
+  __m256i const hi_upper = _mm256_or_si256(hi, case_bit);
+
+  auto const eq_upper = [&lo_upper, &hi_upper](char c) {
+    __m256i const value = _mm256_set1_epi8(c);
+    return ToMask(_mm256_cmpeq_epi8(lo_upper, value), _mm256_cmpeq_epi8(hi_upper, value));
+  };
+
+  BlockMasks masks;
+  masks.quote      = eq('"');
+  masks.backslash  = eq('\\');
+  masks.structural = eq_upper('{') | eq_upper('}') | eq(':') | eq(',');
+  masks.whitespace = eq(' ') | eq('\t') | eq('\n') | eq('\r');
+
+  return masks;
+}
+
+#else
+
+BlockMasks Classify(uint8_t const *block)
+{
+  BlockMasks masks;
+
+  for (std::size_t i = 0; i < BLOCK_SIZE; ++i)
+  {
+    uint64_t const bit = uint64_t{1} << i;
+
+    switch (block[i])
+    {
+    case '"':
+      masks.quote |= bit;
+      break;
+    case '\\':
+      masks.backslash |= bit;
+      break;
+    case '{':
+    case '}':
+    case '[':
+    case ']':
+    case ':':
+    case ',':
+      masks.structural |= bit;
+      break;
+    case ' ':
+    case '\t':
+    case '\n':
+    case '\r':
+      masks.whitespace |= bit;
+      break;
+    default:
+      break;
+    }
+  }
+
+  return masks;
+}
+
+#endif
+
+/**
+ * Compute the mask of characters escaped by a backslash
+ *
+ * @param backslash The mask of backslashes in the block
+ * @param carry Whether the first character of the block is escaped, updated for the next block
+ * @return The mask of escaped characters
+ */
+uint64_t FindEscaped(uint64_t backslash, uint64_t &carry)
+{
+  uint64_t escaped = carry;
+  backslash &= ~carry;
+  carry = 0;
+
+  // each backslash escapes the next character, which therefore can not escape anything itself
+  while (backslash != 0)
+  {
+    uint64_t const i = platform::CountTrailingZeroes64(backslash);
+    if (i == (BLOCK_SIZE - 1))
+    {
+      carry = 1;
+      break;
+    }
+
+    escaped |= uint64_t{2} << i;
+    backslash &= ~(uint64_t{3} << i);
+  }
+
+  return escaped;
+}
+
+/**
+ * Each bit of the result is the exclusive or of the input bits up to and including its position,
+ * i.e. the bits between an opening quote (inclusive) and a closing quote (exclusive) are set
+ */
+uint64_t PrefixXor(uint64_t bits)
+{
+  bits ^= bits << 1u;
+  bits ^= bits << 2u;
+  bits ^= bits << 4u;
+  bits ^= bits << 8u;
+  bits ^= bits << 16u;
+  bits ^= bits << 32u;
+
+  return bits;
+}
+
+}  // namespace
+
+/**
+ * Build the structural index of a document
+ *
+ * @param document The input document
+ */
+void StructuralIndex::Build(ConstByteArray const &document)
+{
+  std::size_t const size = document.size();
+  if (size > std::numeric_limits<uint32_t>::max())
+  {
+    throw JSONParseException("Document too large to be parsed");
+  }
+
+  positions_.clear();
+  positions_.reserve((size / 8u) + 16u);
+
+  uint8_t const *const data = document.pointer();
+
+  uint64_t escaped_carry   = 0;  // the next block starts with an escaped character
+  uint64_t in_string_carry = 0;  // all ones when the next block starts inside a string
+  uint64_t scalar_carry    = 0;  // the next block starts in the middle of a value
+
+  for (std::size_t offset = 0; offset < size; offset += BLOCK_SIZE)
+  {
+    BlockMasks masks;
+    if ((size - offset) >= BLOCK_SIZE)
+    {
+      masks = Classify(data + offset);
+    }
+    else
+    {
+      // pad the final block with whitespace
+      uint8_t block[BLOCK_SIZE];
+      std::memset(block, ' ', BLOCK_SIZE);
+      std::memcpy(block, data + offset, size - offset);
+
+      masks = Classify(block);
+    }
+
+    uint64_t const escaped   = FindEscaped(masks.backslash, escaped_carry);
+    uint64_t const quotes    = masks.quote & ~escaped;
+    uint64_t const in_string = PrefixXor(quotes) ^ in_string_carry;
+    in_string_carry          = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+
+    // the other values are sequences of anything else, the index records where each one starts
+    uint64_t const structural = masks.structural & ~in_string;
+    uint64_t const scalar     = ~(masks.structural | masks.whitespace | quotes | in_string);
+    uint64_t const starts     = scalar & ~((scalar << 1u) | scalar_carry);
+    scalar_carry              = scalar >> 63u;
+
+    uint64_t bits = structural | quotes | starts;
+    while (bits != 0)
+    {
+      positions_.push_back(
+          static_cast<uint32_t>(offset + platform::CountTrailingZeroes64(bits)));
+      bits &= bits - 1u;
+    }
+  }
+
+  if (in_string_carry != 0)
+  {
+    throw JSONParseException("Unterminated string");
+  }
+}
+
+}  // namespace json
+}  // namespace fetch
@@ -21,7 +21,11 @@
 #include "gtest/gtest.h"
 
 #include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <sstream>
+#include <string>
+#include <vector>
 
 using fetch::json::JSONDocument;
 
@@ -170,3 +174,59 @@ TEST(JsonTests, ExpectedToThrow)
   JSONDocument doc;
   EXPECT_THROW(doc.Parse(text), fetch::json::JSONParseException);
 }
+
+TEST(JsonTests, IndexedParserMatchesTokeniser)
+{
+  // strings and escapes are placed so that they straddle the 64 byte blocks of the index
+  std::vector<std::string> const documents = {
+      R"({"a": 1, "b": [true, false, null], "c": {"d": -2.5e3, "e": "f"}})",
+      R"([1,2,3,[4,[5,[6]]],{"x":{"y":{"z":[]}}}])",
+      R"({"escaped": "a \"quoted\" string with a \\ backslash", "next": 1})",
+      R"({"padding_to_the_block_boundary_____________________": "ab\"cd", "end": 0})",
+      R"({"padding_to_the_block_boundary_________________________": "\\", "end": "\\\""})",
+      R"({"structural": "{[:,]}", "spaces":"   ", "empty": "", "nested": [[], {}]})",
+      "[" + std::string(200, ' ') + "\"" + std::string(150, 'x') + "\"" + "]",
+  };
+
+  for (auto const &text : documents)
+  {
+    JSONDocument indexed;
+    JSONDocument reference;
+
+    ASSERT_NO_THROW(indexed.Parse(text)) << text;
+    ASSERT_NO_THROW(reference.ParseWithTokeniser(text)) << text;
+    EXPECT_EQ(indexed.root(), reference.root()) << text;
+  }
+
+  JSONDocument doc;
+  doc.Parse(documents[2]);
+  EXPECT_EQ(doc["escaped"].As<fetch::byte_array::ConstByteArray>(),
+            R"(a \"quoted\" string with a \\ backslash)");
+}
+
+TEST(JsonTests, IntegerLimits)
+{
+  JSONDocument doc;
+  doc.Parse(R"([9223372036854775807, -9223372036854775808, 0, -0, 007])");
+
+  EXPECT_EQ(doc[0].As<int64_t>(), std::numeric_limits<int64_t>::max());
+  EXPECT_EQ(doc[1].As<int64_t>(), std::numeric_limits<int64_t>::min());
+  EXPECT_EQ(doc[2].As<int64_t>(), 0);
+  EXPECT_EQ(doc[3].As<int64_t>(), 0);
+  EXPECT_EQ(doc[4].As<int64_t>(), 7);
+
+  EXPECT_THROW(doc.Parse("[9223372036854775808]"), fetch::json::JSONParseException);
+  EXPECT_THROW(doc.Parse("[-9223372036854775809]"), fetch::json::JSONParseException);
+}
+
+TEST(JsonTests, MalformedValues)
+{
+  JSONDocument doc;
+  EXPECT_THROW(doc.Parse(R"({"a": "unterminated})"), fetch::json::JSONParseException);
+  EXPECT_THROW(doc.Parse(R"({"a": truefalse})"), fetch::json::JSONParseException);
+  EXPECT_THROW(doc.Parse(R"({"a": nul})"), fetch::json::JSONParseException);
+  EXPECT_THROW(doc.Parse(R"({"a": 12ab})"), fetch::json::JSONParseException);
+  EXPECT_THROW(doc.Parse(R"({"a": -})"), fetch::json::JSONParseException);
+  EXPECT_THROW(doc.Parse(R"(]})"), fetch::json::JSONParseException);
+  EXPECT_THROW(doc.Parse(R"([1 : 2])"), fetch::json::JSONParseException);
+}
@@ -0,0 +1,144 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/constants.hpp"
+#include "chain/transaction_layout.hpp"
+#include "core/bitvector.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "core/random/lcg.hpp"
+#include "crypto/mcl_dkg.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/main_chain.hpp"
+#include "ledger/miner/basic_miner.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::byte_array::ByteArray;
+using fetch::chain::TransactionLayout;
+using fetch::ledger::BasicMiner;
+using fetch::ledger::Block;
+using fetch::ledger::MainChain;
+using fetch::random::LinearCongruentialGenerator;
+
+using LayoutArray = std::vector<TransactionLayout>;
+
+constexpr uint32_t    LOG2_NUM_LANES = 4;
+constexpr uint32_t    NUM_LANES      = 1u << LOG2_NUM_LANES;
+constexpr std::size_t NUM_SLICES     = 16;
+
+// Generate layouts over a random set of lanes, a percentage of which also use a shared (hot) lane
+LayoutArray GenerateLayouts(std::size_t count, uint64_t hot_lane_percentage)
+{
+  static constexpr std::size_t DIGEST_WORDS     = 4;
+  static constexpr uint64_t    MAX_RESOURCES    = 6;
+  static constexpr uint64_t    MAX_CHARGE_RATE  = 1000;
+  static constexpr uint64_t    VALID_FROM_BLOCK = 1;
+  static constexpr uint64_t    VALID_TO_BLOCK   = 1000;
+
+  LinearCongruentialGenerator rng;
+
+  LayoutArray layouts;
+  layouts.reserve(count);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    ByteArray digest;
+    digest.Resize(DIGEST_WORDS * sizeof(uint64_t));
+    auto *raw = reinterpret_cast<uint64_t *>(digest.pointer());
+    for (std::size_t j = 0; j < DIGEST_WORDS; ++j)
+    {
+      raw[j] = rng();
+    }
+
+    BitVector mask{NUM_LANES};
+    for (uint64_t j = 1 + (rng() % MAX_RESOURCES); j > 0; --j)
+    {
+      mask.set(rng() % NUM_LANES, 1);
+    }
+
+    if ((rng() % 100u) < hot_lane_percentage)
+    {
+      mask.set(0, 1);
+    }
+
+    layouts.emplace_back(digest, mask, 1 + (rng() % MAX_CHARGE_RATE), VALID_FROM_BLOCK,
+                         VALID_TO_BLOCK);
+  }
+
+  return layouts;
+}
+
+void BasicMiner_GenerateBlock(benchmark::State &state)
+{
+  fetch::crypto::mcl::details::MCLInitialiser();
+  fetch::chain::InitialiseTestConstants();
+
+  auto const layouts = GenerateLayouts(static_cast<std::size_t>(state.range(0)),
+                                       static_cast<uint64_t>(state.range(1)));
+
+  MainChain chain{MainChain::Mode::IN_MEMORY_DB};
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    auto miner = std::make_unique<BasicMiner>(LOG2_NUM_LANES);
+    for (auto const &layout : layouts)
+    {
+      miner->EnqueueTransaction(layout);
+    }
+
+    // the first block populates the mining pool
+    Block warm_up;
+    warm_up.block_number  = 1;
+    warm_up.previous_hash = chain.GetHeaviestBlockHash();
+    miner->GenerateBlock(warm_up, NUM_LANES, NUM_SLICES, chain);
+
+    Block block;
+    block.block_number  = 1;
+    block.previous_hash = chain.GetHeaviestBlockHash();
+    state.ResumeTiming();
+
+    // subsequent blocks are packed from the existing pool
+    miner->GenerateBlock(block, NUM_LANES, NUM_SLICES, chain);
+
+    state.PauseTiming();
+    miner.reset();
+    state.ResumeTiming();
+  }
+}
+
+void CreateRanges(benchmark::internal::Benchmark *b)
+{
+  for (int64_t num_tx : {1000, 10000, 100000})
+  {
+    b->Args({num_tx, 0});
+    b->Args({num_tx, 50});
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BasicMiner_GenerateBlock)->Apply(CreateRanges)->Unit(benchmark::kMillisecond);
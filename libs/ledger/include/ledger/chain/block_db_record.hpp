@@ -20,6 +20,8 @@
 #include "chain/constants.hpp"
 #include "ledger/chain/block.hpp"
 
+#include <utility>
+
 namespace fetch {
 namespace ledger {
 
@@ -38,6 +40,35 @@ struct BlockDbRecord
   }
 };
 
+/**
+ * The compact summary of a stored block, sufficient for walking the chain without needing to load
+ * the complete block (and therefore its transactions).
+ */
+struct BlockHeaderRecord
+{
+  BlockHeaderRecord() = default;
+  explicit BlockHeaderRecord(Block const &block, Block::Hash next = Block::Hash{})
+    : hash{block.hash}
+    , previous_hash{block.previous_hash}
+    , next_hash{std::move(next)}
+    , block_number{block.block_number}
+    , weight{block.weight}
+    , total_weight{block.total_weight}
+  {}
+
+  Block::Hash   hash;
+  Block::Hash   previous_hash;
+  Block::Hash   next_hash;  ///< empty next hash is used as undefined value
+  Block::Index  block_number{0};
+  Block::Weight weight{0};
+  Block::Weight total_weight{0};
+
+  bool IsGenesis() const
+  {
+    return previous_hash == chain::ZERO_HASH;
+  }
+};
+
 }  // namespace ledger
 
 namespace serializers {
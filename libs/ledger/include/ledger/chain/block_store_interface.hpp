@@ -0,0 +1,101 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/chain/block.hpp"
+
+namespace fetch {
+namespace ledger {
+
+struct BlockDbRecord;
+struct BlockHeaderRecord;
+
+/**
+ * Long term storage for the blocks of the main chain
+ */
+class BlockStoreInterface
+{
+public:
+  // Construction / Destruction
+  BlockStoreInterface()          = default;
+  virtual ~BlockStoreInterface() = default;
+
+  /// @name Block Store Interface
+  /// @{
+
+  /**
+   * Create a new, empty, block store discarding any previous contents
+   */
+  virtual void New() = 0;
+
+  /**
+   * Load the block store from disk, creating a new store if one does not exist
+   */
+  virtual void Load() = 0;
+
+  /**
+   * Flush any outstanding writes to disk
+   */
+  virtual void Flush() = 0;
+
+  /**
+   * Determine if a block is present in the store
+   *
+   * @param hash The hash of the block
+   * @return true if the block is present, otherwise false
+   */
+  virtual bool Has(BlockHash const &hash) = 0;
+
+  /**
+   * Retrieve the complete record for a specified block
+   *
+   * @param hash The hash of the block
+   * @param record The output record to be populated
+   * @return true if successful, otherwise false
+   */
+  virtual bool Get(BlockHash const &hash, BlockDbRecord &record) = 0;
+
+  /**
+   * Retrieve the header summary for a specified block, without loading its contents
+   *
+   * @param hash The hash of the block
+   * @param header The output header to be populated
+   * @return true if successful, otherwise false
+   */
+  virtual bool GetHeader(BlockHash const &hash, BlockHeaderRecord &header) = 0;
+
+  /**
+   * Store (or update) the record for a block
+   *
+   * @param record The record to be stored
+   */
+  virtual void Set(BlockDbRecord const &record) = 0;
+
+  /**
+   * Update the forward reference of a stored block
+   *
+   * @param hash The hash of the block to be updated
+   * @param next_hash The hash of the next block in the chain
+   * @return true if successful, otherwise false if the block is not present
+   */
+  virtual bool SetNextHash(BlockHash const &hash, BlockHash const &next_hash) = 0;
+  /// @}
+};
+
+}  // namespace ledger
+}  // namespace fetch
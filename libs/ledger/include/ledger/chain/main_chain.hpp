@@ -26,9 +26,9 @@
 #include "core/mutex.hpp"
 #include "crypto/fnv.hpp"
 #include "ledger/chain/block.hpp"
+#include "ledger/chain/block_store_interface.hpp"
 #include "meta/type_util.hpp"
 #include "network/generics/milli_timer.hpp"
-#include "storage/object_store.hpp"
 #include "storage/resource_mapper.hpp"
 #include "telemetry/telemetry.hpp"
 
@@ -121,6 +121,7 @@ constexpr char const *ToString(BlockStatus status)
 }
 
 struct BlockDbRecord;
+struct BlockHeaderRecord;
 
 struct TimeTravelogue;
 
@@ -143,6 +144,13 @@ public:
     LOAD_PERSISTENT_DB
   };
 
+  // The format of the long term storage for blocks (when persistent)
+  enum class StoreType
+  {
+    OBJECT_STORE = 0,  ///< Complete block records in a generic object store
+    MAPPED_LOG         ///< Append-only, memory mapped segments with a separate header table
+  };
+
   // When traversing the chain and returning a subset due to hitting a limit,
   // either return blocks closer to genesis (least recent in time), or
   // return closer to head (most recent)
@@ -153,7 +161,8 @@ public:
   };
 
   // Construction / Destruction
-  explicit MainChain(Mode mode = Mode::IN_MEMORY_DB, bool dirty_block_functionality = false);
+  explicit MainChain(Mode mode = Mode::IN_MEMORY_DB, bool dirty_block_functionality = false,
+                     StoreType store_type = StoreType::OBJECT_STORE);
   MainChain(MainChain const &rhs) = delete;
   MainChain(MainChain &&rhs)      = delete;
   ~MainChain();
@@ -208,12 +217,13 @@ public:
 
 private:
   using DbRecord      = BlockDbRecord;
+  using HeaderRecord  = BlockHeaderRecord;
   using BlockMap      = std::unordered_map<BlockHash, BlockPtr>;
   using References    = std::unordered_multimap<BlockHash, BlockHash>;
   using TipsMap       = std::unordered_map<BlockHash, Tip>;
   using BlockHashList = std::list<BlockHash>;
   using LooseBlockMap = std::unordered_map<BlockHash, BlockHashList>;
-  using BlockStore    = fetch::storage::ObjectStore<DbRecord>;
+  using BlockStore    = BlockStoreInterface;
   using BlockStorePtr = std::unique_ptr<BlockStore>;
   using RMutex        = std::recursive_mutex;
   using RLock         = std::unique_lock<RMutex>;
@@ -272,6 +282,7 @@ private:
   bool     LookupBlockFromCache(BlockHash const &hash, BlockPtr &block) const;
   bool     LookupBlockFromStorage(BlockHash const &hash, BlockPtr &block,
                                   BlockHash *next_hash = nullptr) const;
+  bool     LookupHeader(BlockHash const &hash, HeaderRecord &header) const;
   bool     IsBlockInCache(BlockHash const &hash) const;
   void     AddBlockToCache(BlockPtr const &block) const;
   void     AddBlockToBloomFilter(Block const &block) const;
@@ -286,6 +297,7 @@ private:
   BlockMap::size_type UncacheBlock(BlockHash const &hash) const;
   void                KeepBlock(BlockPtr const &block) const;
   bool LoadBlock(BlockHash const &hash, Block &block, BlockHash *next_hash = nullptr) const;
+  bool LoadHeader(BlockHash const &hash, HeaderRecord &header) const;
   /// @}
 
   /// @name Tip Management
@@ -0,0 +1,154 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+#include "ledger/chain/block_db_record.hpp"
+#include "ledger/chain/block_store_interface.hpp"
+#include "storage/fetch_mmap.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Append-only, memory mapped block store
+ *
+ * The store is made up of three sets of files:
+ *
+ * - Segments (`<prefix>.segment.<n>.db`) which hold the serialised blocks. Blocks are only ever
+ *   appended to the most recent segment and are never rewritten.
+ * - A header table (`<prefix>.headers.db`) of fixed size entries holding the previous hash, next
+ *   hash, block number and weights of each block, along with the location of the block in the
+ *   segments. Walking the chain only ever touches this table.
+ * - A hash index (`<prefix>.hash_index.db`), an open addressing table of fixed size slots mapping
+ *   the block hash to its position in the header table. The index can always be rebuilt from the
+ *   header table and this is done on load should it be found to be inconsistent.
+ *
+ * All of the files are accessed through memory mappings, so lookups do not require any file IO
+ * and only the deserialisation of the block itself when the complete block is requested.
+ */
+class MappedBlockStore : public BlockStoreInterface
+{
+public:
+  static constexpr std::size_t DEFAULT_SEGMENT_SIZE = 64ull * 1024ull * 1024ull;  // 64MiB
+  static constexpr std::size_t MAX_DIGEST_SIZE      = 32;
+
+  // Construction / Destruction
+  explicit MappedBlockStore(std::string prefix       = "chain",
+                            std::size_t segment_size = DEFAULT_SEGMENT_SIZE);
+  MappedBlockStore(MappedBlockStore const &) = delete;
+  MappedBlockStore(MappedBlockStore &&)      = delete;
+  ~MappedBlockStore() override = default;
+
+  /// @name Block Store Interface
+  /// @{
+  void New() override;
+  void Load() override;
+  void Flush() override;
+  bool Has(BlockHash const &hash) override;
+  bool Get(BlockHash const &hash, BlockDbRecord &record) override;
+  bool GetHeader(BlockHash const &hash, BlockHeaderRecord &header) override;
+  void Set(BlockDbRecord const &record) override;
+  bool SetNextHash(BlockHash const &hash, BlockHash const &next_hash) override;
+  /// @}
+
+  std::size_t size() const;
+  std::size_t num_segments() const;
+
+  // Operators
+  MappedBlockStore &operator=(MappedBlockStore const &) = delete;
+  MappedBlockStore &operator=(MappedBlockStore &&) = delete;
+
+private:
+  using Mapping    = mio::mmap_sink;
+  using MappingPtr = std::unique_ptr<Mapping>;
+  using Segments   = std::vector<MappingPtr>;
+  using RawDigest  = std::array<uint8_t, MAX_DIGEST_SIZE>;
+
+  /**
+   * The fixed size prefix of both the header table and the hash index
+   */
+  struct TableHeader
+  {
+    uint64_t magic{0};
+    uint64_t count{0};
+  };
+
+  /**
+   * The fixed size summary of a stored block
+   */
+  struct Entry
+  {
+    RawDigest hash;
+    RawDigest previous_hash;
+    RawDigest next_hash;
+    uint64_t  block_number;
+    uint64_t  weight;
+    uint64_t  total_weight;
+    uint64_t  offset;  ///< The offset of the serialised block in its segment
+    uint32_t  segment;
+    uint32_t  length;  ///< The length of the serialised block
+    uint8_t   hash_length;
+    uint8_t   previous_hash_length;
+    uint8_t   next_hash_length;
+    uint8_t   reserved[5];
+  };
+
+  static constexpr uint64_t NOT_FOUND = ~uint64_t{0};
+
+  /// @name Internal (must hold lock)
+  /// @{
+  void      Reset();
+  bool      Recover();
+  uint64_t  Lookup(BlockHash const &hash);
+  Entry &   GetEntry(uint64_t index);
+  void      Append(BlockDbRecord const &record);
+  uint8_t * Reserve(std::size_t length, uint32_t &segment, uint64_t &offset);
+  void      AddSegment(std::size_t min_size);
+  void      GrowHeaders();
+  void      RebuildIndex(std::size_t capacity);
+  void      InsertIntoIndex(uint64_t index);
+  void      Unmap();
+  /// @}
+
+  std::string SegmentFilename(std::size_t segment) const;
+
+  std::string const prefix_;
+  std::string const headers_filename_;
+  std::string const index_filename_;
+  std::size_t const segment_size_;
+
+  mutable Mutex lock_;
+  Mapping       headers_;                  ///< The mapping of the header table
+  std::size_t   headers_capacity_{0};      ///< The max number of entries in the header table
+  Mapping       index_;                    ///< The mapping of the hash index
+  std::size_t   index_capacity_{0};        ///< The number of slots in the hash index
+  Segments      segments_;                 ///< The mappings of all the segments
+  uint64_t      num_entries_{0};           ///< The number of blocks in the store
+  uint64_t      segment_write_offset_{0};  ///< The append position in the most recent segment
+};
+
+}  // namespace ledger
+}  // namespace fetch
@@ -0,0 +1,64 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/chain/block_db_record.hpp"
+#include "ledger/chain/block_store_interface.hpp"
+#include "storage/object_store.hpp"
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Block store which keeps the complete block records in a generic object store (`chain.db` and
+ * `chain.index.db`). All lookups, including those of the block headers, require the full record to
+ * be deserialized.
+ */
+class ObjectBlockStore : public BlockStoreInterface
+{
+public:
+  // Construction / Destruction
+  ObjectBlockStore()                         = default;
+  ObjectBlockStore(ObjectBlockStore const &) = delete;
+  ObjectBlockStore(ObjectBlockStore &&)      = delete;
+  ~ObjectBlockStore() override               = default;
+
+  /// @name Block Store Interface
+  /// @{
+  void New() override;
+  void Load() override;
+  void Flush() override;
+  bool Has(BlockHash const &hash) override;
+  bool Get(BlockHash const &hash, BlockDbRecord &record) override;
+  bool GetHeader(BlockHash const &hash, BlockHeaderRecord &header) override;
+  void Set(BlockDbRecord const &record) override;
+  bool SetNextHash(BlockHash const &hash, BlockHash const &next_hash) override;
+  /// @}
+
+  // Operators
+  ObjectBlockStore &operator=(ObjectBlockStore const &) = delete;
+  ObjectBlockStore &operator=(ObjectBlockStore &&) = delete;
+
+private:
+  using Store = storage::ObjectStore<BlockDbRecord>;
+
+  Store store_;
+};
+
+}  // namespace ledger
+}  // namespace fetch
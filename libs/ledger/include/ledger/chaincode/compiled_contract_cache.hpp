@@ -0,0 +1,108 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/digest.hpp"
+#include "telemetry/telemetry.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+
+namespace fetch {
+namespace vm {
+
+struct Executable;
+
+}  // namespace vm
+namespace ledger {
+
+/**
+ * Process wide cache of compiled smart contracts, keyed by the digest of the contract source.
+ *
+ * The executables are immutable once compiled and therefore can be shared between all the
+ * instances of a contract, irrespective of the executor that created them. The opcodes inside an
+ * executable refer to the bindings of the smart contract module, so only executables compiled
+ * against that module may be placed in the cache.
+ *
+ * Concurrent lookups of the same contract result in a single compilation, with the other callers
+ * waiting on its result. Failed compilations are not cached. The least recently used executables
+ * are evicted once the cache is full.
+ */
+class CompiledContractCache
+{
+public:
+  using ExecutablePtr = std::shared_ptr<vm::Executable const>;
+  using Compiler      = std::function<ExecutablePtr()>;
+
+  static constexpr std::size_t DEFAULT_MAX_ENTRIES = 256;
+
+  static CompiledContractCache &Instance();
+
+  // Construction / Destruction
+  explicit CompiledContractCache(std::size_t max_entries = DEFAULT_MAX_ENTRIES);
+  CompiledContractCache(CompiledContractCache const &) = delete;
+  CompiledContractCache(CompiledContractCache &&)      = delete;
+  ~CompiledContractCache()                             = default;
+
+  ExecutablePtr LookupOrCompile(Digest const &digest, Compiler const &compile);
+  void          Clear();
+
+  /// @name Accessors
+  /// @{
+  std::size_t size() const;
+  std::size_t max_entries() const;
+  /// @}
+
+  // Operators
+  CompiledContractCache &operator=(CompiledContractCache const &) = delete;
+  CompiledContractCache &operator=(CompiledContractCache &&) = delete;
+
+private:
+  using Result = std::shared_future<ExecutablePtr>;
+
+  struct Entry
+  {
+    Digest   digest;
+    Result   executable;
+    uint64_t id{0};  ///< Distinguishes an entry from a later one for the same digest
+  };
+
+  using EntryList = std::list<Entry>;  ///< Ordered from the most to the least recently used
+  using EntryMap  = DigestMap<EntryList::iterator>;
+
+  void Remove(Digest const &digest, uint64_t id);
+
+  std::size_t const max_entries_;
+
+  mutable std::mutex lock_;  ///< guards all the members below
+  EntryList          entries_;
+  EntryMap           index_;
+  uint64_t           next_id_{0};
+
+  telemetry::CounterPtr hit_count_;
+  telemetry::CounterPtr miss_count_;
+  telemetry::CounterPtr eviction_count_;
+};
+
+}  // namespace ledger
+}  // namespace fetch
@@ -50,6 +50,7 @@ public:
   /// @name Accessors
   /// @{
   Digest const &   digest() const;
+  SliceIndex       slice() const;
   BitVector const &shards() const;
   Result const &   result() const;
   TokenAmount      fee() const;
@@ -86,6 +87,11 @@ inline Digest const &ExecutionItem::digest() const
   return digest_;
 }
 
+inline ExecutionItem::SliceIndex ExecutionItem::slice() const
+{
+  return slice_;
+}
+
 inline BitVector const &ExecutionItem::shards() const
 {
   return shards_;
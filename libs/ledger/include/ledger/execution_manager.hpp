@@ -27,7 +27,7 @@
 #include "ledger/execution_manager_interface.hpp"
 #include "ledger/executor.hpp"
 #include "ledger/storage_unit/storage_unit_interface.hpp"
-#include "network/details/thread_pool.hpp"
+#include "ledger/work_stealing_executor_pool.hpp"
 #include "storage/object_store.hpp"
 #include "telemetry/telemetry.hpp"
 #include "transaction_status_cache.hpp"
@@ -47,6 +47,14 @@ namespace ledger {
 /**
  * The Execution Manager is the object which orchestrates the execution of a
  * specified block across a series of executors and lanes.
+ *
+ * Execution items are dispatched to a work stealing pool of executors. In the pipelined mode
+ * items from the next slice are started as soon as the lanes that they touch are no longer used
+ * by any unfinished item of the current slice, rather than waiting for the whole slice to
+ * complete.
+ *
+ * When state prefetching is enabled, the transactions of the next slice along with the state that
+ * they are known to access are retrieved in the background while the current slice executes.
  */
 class ExecutionManager : public ExecutionManagerInterface,
                          public std::enable_shared_from_this<ExecutionManager>
@@ -56,9 +64,16 @@ public:
   using ExecutorPtr     = std::shared_ptr<ExecutorInterface>;
   using ExecutorFactory = std::function<ExecutorPtr()>;
 
+  enum class Mode
+  {
+    SLICE_BARRIER,  ///< Each slice is started only once the previous slice has completed
+    PIPELINED       ///< Non-conflicting items of the next slice can start early
+  };
+
   // Construction / Destruction
   ExecutionManager(std::size_t num_executors, uint32_t log2_num_lanes, StorageUnitPtr storage,
-                   ExecutorFactory const &factory, TransactionStatusCache::ShrdPtr tx_status_cache);
+                   ExecutorFactory const &factory, TransactionStatusCache::ShrdPtr tx_status_cache,
+                   Mode mode = Mode::SLICE_BARRIER, bool prefetch_state = false);
 
   /// @name Execution Manager Interface
   /// @{
@@ -79,17 +94,25 @@ public:
     return completed_executions_;
   }
 
+  uint64_t pipelined_executions() const;
+
 private:
+  using SliceIndex = ExecutionItem::SliceIndex;
+
   struct Counters
   {
-    std::size_t active{0};
-    std::size_t remaining{0};
+    std::size_t active{0};     ///< The number of items dispatched but not complete
+    std::size_t remaining{0};  ///< The number of incomplete items in the current slice
+    std::size_t lookahead{0};  ///< The number of incomplete items in the next slice
+    SliceIndex  slice{0};      ///< The index of the current slice
   };
 
   using ExecutionItemPtr  = std::unique_ptr<ExecutionItem>;
   using ExecutionItemList = std::vector<ExecutionItemPtr>;
   using ExecutionPlan     = std::vector<ExecutionItemList>;
-  using ThreadPool        = fetch::network::ThreadPool;
+  using ExecutorPool      = std::unique_ptr<WorkStealingExecutorPool>;
+  using ItemList          = WorkStealingExecutorPool::ItemList;
+  using LaneOccupancy     = std::vector<uint32_t>;
   using Counter           = std::atomic<std::size_t>;
   using Flag              = std::atomic<bool>;
   using StateHash         = StorageUnitInterface::Hash;
@@ -113,6 +136,7 @@ private:
   };
 
   uint32_t const log2_num_lanes_;
+  Mode const     mode_;
 
   Flag running_{false};
   Flag monitor_ready_{false};
@@ -128,16 +152,19 @@ private:
   Condition monitor_wake_;
   Condition monitor_notify_;
 
-  Mutex        idle_executors_lock_;  ///< guards `idle_executors`
-  ExecutorList idle_executors_;
+  Mutex         lookahead_lock_;  ///< guards `lane_occupancy_` and `deferred_`
+  LaneOccupancy lane_occupancy_;  ///< Number of unfinished dispatched items using each lane
+  ItemList      deferred_;        ///< Items of the next slice which are yet to be dispatched
 
   Counter completed_executions_{0};
   Counter num_slices_{0};
 
   Waitable<Counters> counters_{};
 
-  ThreadPool thread_pool_;
-  ThreadPtr  monitor_thread_;
+  ExecutorPool executor_pool_;
+  ThreadPtr    monitor_thread_;
+
+  ExecutorInterface::StatePrefetcherPtr prefetcher_;  ///< The (optional) state prefetcher
 
   TransactionStatusCache::ShrdPtr tx_status_cache_;  ///< Ref to the tx status cache
   // Telemetry
@@ -145,12 +172,24 @@ private:
   CounterPtr   slices_executed_count_;
   CounterPtr   fees_settled_count_;
   CounterPtr   blocks_completed_count_;
+  CounterPtr   tx_pipelined_count_;
   HistogramPtr execution_duration_;
 
   void MonitorThreadEntrypoint();
 
   bool PlanExecution(Block const &block);
-  void DispatchExecution(ExecutionItem &item);
+  void DispatchExecution(ExecutorInterface &executor, ExecutionItem &item);
+
+  /// @name Lane Scheduling
+  /// @{
+  void ScheduleSlice(SliceIndex slice, ItemList &ready);
+  void PrefetchSlice(SliceIndex slice);
+  void CollectReadyItems(ItemList &ready);
+  bool IsLaneSetFree(ExecutionItem const &item) const;
+  void AcquireLanes(ExecutionItem const &item);
+  void ReleaseLanes(ExecutionItem const &item);
+  void DrainActiveItems();
+  /// @}
 };
 
 }  // namespace ledger
@@ -61,6 +61,7 @@ public:
                  BitVector const &shards) override;
   void   SettleFees(chain::Address const &miner, BlockIndex block, TokenAmount amount,
                     uint32_t log2_num_lanes, StakeUpdateEvents const &stake_updates) override;
+  void   AttachPrefetcher(StatePrefetcherPtr const &prefetcher) override;
   /// @}
 
 private:
@@ -74,9 +75,10 @@ private:
 
   /// @name Resources
   /// @{
-  StorageUnitPtr storage_;             ///< The collection of resources
-  ChainCodeCache chain_code_cache_{};  //< The factory to create new chain code instances
-  TokenContract  token_contract_{};
+  StorageUnitPtr     storage_;             ///< The collection of resources
+  StatePrefetcherPtr prefetcher_{};        ///< The (optional) source of prefetched state
+  ChainCodeCache     chain_code_cache_{};  //< The factory to create new chain code instances
+  TokenContract      token_contract_{};
   /// @}
 
   /// @name Per Execution State
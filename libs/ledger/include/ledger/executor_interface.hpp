@@ -21,6 +21,8 @@
 #include "ledger/consensus/stake_update_event.hpp"
 #include "ledger/execution_result.hpp"
 
+#include <memory>
+
 namespace fetch {
 
 class BitVector;
@@ -33,6 +35,8 @@ class Address;
 
 namespace ledger {
 
+class StatePrefetcher;
+
 class ExecutorInterface
 {
 public:
@@ -43,6 +47,8 @@ public:
   using Status      = ContractExecutionStatus;
   using Result      = ContractExecutionResult;
 
+  using StatePrefetcherPtr = std::shared_ptr<StatePrefetcher>;
+
   // Construction / Destruction
   ExecutorInterface()          = default;
   virtual ~ExecutorInterface() = default;
@@ -54,6 +60,15 @@ public:
   virtual void   SettleFees(chain::Address const &miner, BlockIndex block, TokenAmount amount,
                             uint32_t log2_num_lanes, StakeUpdateEvents const &stake_updates) = 0;
   /// @}
+
+  /**
+   * Attach the prefetcher through which the executor should retrieve its transactions and state.
+   * Executors which are not able to make use of it can ignore it.
+   *
+   * @param prefetcher The prefetcher shared between the executors of the execution manager
+   */
+  virtual void AttachPrefetcher(StatePrefetcherPtr const & /*prefetcher*/)
+  {}
 };
 
 }  // namespace ledger
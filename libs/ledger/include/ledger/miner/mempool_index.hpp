@@ -0,0 +1,143 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction_layout.hpp"
+#include "core/digest.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <set>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Persistent index over the transaction layouts held by the miner.
+ *
+ * Layouts are bucketed by the lowest lane of their resource mask and ordered by charge rate inside
+ * each bucket, so the highest paying candidates can be visited without sorting the pool for every
+ * block. When a slice has claimed a lane the complete bucket for that lane can be skipped since
+ * every layout within it would collide. The masks themselves are stored in a single flat array of
+ * words so that collision checks do not need to allocate.
+ *
+ * Entries are also indexed by the block range in which they are valid, allowing expired and not
+ * yet active layouts to be removed without visiting the rest of the pool.
+ */
+class MempoolIndex
+{
+public:
+  using TransactionLayout = chain::TransactionLayout;
+  using TokenAmount       = TransactionLayout::TokenAmount;
+  using BlockIndex        = TransactionLayout::BlockIndex;
+  using TxLayoutSet       = std::unordered_set<TransactionLayout>;
+  using Slice             = std::vector<TransactionLayout>;
+
+  // Construction / Destruction
+  explicit MempoolIndex(uint32_t log2_num_lanes);
+  MempoolIndex(MempoolIndex const &) = delete;
+  MempoolIndex(MempoolIndex &&)      = delete;
+  ~MempoolIndex()                    = default;
+
+  /// @name Accessors
+  /// @{
+  std::size_t size() const;
+  bool        empty() const;
+  bool        Contains(Digest const &digest) const;
+  TxLayoutSet TxLayouts() const;
+  /// @}
+
+  /// @name Basic Operations
+  /// @{
+  bool        Add(TransactionLayout const &layout);
+  bool        Remove(Digest const &digest);
+  std::size_t Remove(DigestSet const &digests);
+  std::size_t RemoveInvalid(BlockIndex block_index);
+  std::size_t PackSlice(Slice &slice);
+  /// @}
+
+  // Operators
+  MempoolIndex &operator=(MempoolIndex const &) = delete;
+  MempoolIndex &operator=(MempoolIndex &&) = delete;
+
+private:
+  using MaskWord = uint64_t;
+  using Slot     = uint32_t;
+
+  struct Entry
+  {
+    TransactionLayout layout{};
+    uint64_t          sequence{0};  ///< Insertion order, breaks ties between equal charge rates
+    BlockIndex        valid_from{0};
+    uint32_t          num_lanes{0};
+    uint32_t          bucket{0};
+  };
+
+  struct Key
+  {
+    TokenAmount charge_rate;
+    uint64_t    sequence;
+    Slot        slot;
+
+    bool operator<(Key const &other) const
+    {
+      if (charge_rate != other.charge_rate)
+      {
+        return charge_rate > other.charge_rate;
+      }
+
+      return sequence < other.sequence;
+    }
+  };
+
+  using Bucket      = std::set<Key>;
+  using Buckets     = std::vector<Bucket>;
+  using RangeIndex  = std::set<std::pair<BlockIndex, Slot>>;
+  using SlotMap     = DigestMap<Slot>;
+  using SlotArray   = std::vector<Slot>;
+  using EntryArray  = std::deque<Entry>;
+  using MaskArray   = std::vector<MaskWord>;
+  using Cursor      = std::pair<Bucket::const_iterator, uint32_t>;
+  using CursorArray = std::vector<Cursor>;
+
+  Key             KeyOf(Slot slot) const;
+  MaskWord const *MaskOf(Slot slot) const;
+  void            Erase(Slot slot);
+
+  uint32_t const num_lanes_;
+  std::size_t    words_per_mask_;
+  uint64_t       next_sequence_{0};
+
+  EntryArray  entries_;      ///< Entry storage, indexed by slot
+  MaskArray   masks_;        ///< Flat lane masks, words_per_mask_ words per slot
+  SlotArray   free_slots_;   ///< Slots available for reuse
+  SlotMap     lookup_;       ///< Digest to slot lookup
+  Buckets     buckets_;      ///< Fee ordered buckets, indexed by the lowest lane of the mask
+  RangeIndex  expiry_;       ///< Slots ordered by valid until
+  RangeIndex  activation_;   ///< Slots ordered by (effective) valid from
+  MaskArray   slice_state_;  ///< Scratch lane mask used while packing a slice
+  CursorArray cursors_;      ///< Scratch bucket cursors used while packing a slice
+  SlotArray   selected_;     ///< Scratch list of slots selected while packing a slice
+};
+
+}  // namespace ledger
+}  // namespace fetch
@@ -0,0 +1,137 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/digest.hpp"
+#include "ledger/storage_unit/storage_unit_interface.hpp"
+#include "telemetry/telemetry.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace fetch {
+namespace chain {
+
+class Transaction;
+
+}  // namespace chain
+namespace ledger {
+
+/**
+ * Warms up the state and the transaction bodies needed by the executors ahead of execution.
+ *
+ * The execution manager hands over the digests of the next slice while the current slice is being
+ * executed. A background thread retrieves the transactions and requests, as a single batch, the
+ * state which they are known to touch (the wallets of the sender and of the transfer recipients).
+ *
+ * The executors read and write the state through this object. Writes are forwarded to the
+ * underlying storage and update the cache, whereas prefetched values are only added if the key is
+ * not already present. This ensures that a prefetch racing a write can never replace the newer
+ * value. The cache must be cleared whenever the state is modified by any other route, i.e. between
+ * blocks.
+ */
+class StatePrefetcher : public StorageInterface
+{
+public:
+  using StorageUnitPtr = std::shared_ptr<StorageUnitInterface>;
+  using TransactionPtr = std::shared_ptr<chain::Transaction>;
+  using Digests        = std::vector<Digest>;
+
+  static constexpr char const *LOGGING_NAME = "StatePrefetcher";
+
+  // Construction / Destruction
+  explicit StatePrefetcher(StorageUnitPtr storage);
+  StatePrefetcher(StatePrefetcher const &) = delete;
+  StatePrefetcher(StatePrefetcher &&)      = delete;
+  ~StatePrefetcher() override;
+
+  void Start();
+  void Stop();
+
+  /// @name Prefetching
+  /// @{
+  void           Prefetch(Digests digests);
+  TransactionPtr TakeTransaction(Digest const &digest);
+  void           Clear();
+  std::size_t    pending() const;
+  /// @}
+
+  /// @name State Interface
+  /// @{
+  Document Get(ResourceAddress const &key) const override;
+  Document GetOrCreate(ResourceAddress const &key) override;
+  void     Set(ResourceAddress const &key, StateValue const &value) override;
+  bool     Lock(ShardIndex shard) override;
+  bool     Unlock(ShardIndex shard) override;
+  void     Reset() override;
+  /// @}
+
+  /// @name Batched State Interface
+  /// @{
+  Documents GetMany(Addresses const &keys) const override;
+  void      SetMany(KeyValues const &entries) override;
+  /// @}
+
+  // Operators
+  StatePrefetcher &operator=(StatePrefetcher const &) = delete;
+  StatePrefetcher &operator=(StatePrefetcher &&) = delete;
+
+private:
+  using StateCache       = std::unordered_map<ResourceAddress, StateValue>;
+  using TransactionCache = DigestMap<TransactionPtr>;
+  using BatchQueue       = std::deque<Digests>;
+  using ThreadPtr        = std::unique_ptr<std::thread>;
+  using Flag             = std::atomic<bool>;
+  using Generation       = uint64_t;
+
+  void ThreadEntrypoint();
+  void PrefetchBatch(Digests const &digests, Generation generation);
+
+  bool Lookup(ResourceAddress const &key, Document &doc) const;
+  void Insert(Addresses const &keys, Documents const &docs, Generation generation);
+  void Update(ResourceAddress const &key, StateValue const &value);
+
+  StorageUnitPtr storage_;
+
+  mutable std::mutex      lock_;            ///< guards all the members below
+  std::condition_variable work_available_;  ///< signalled when a batch is queued
+  BatchQueue              queue_;           ///< The batches waiting to be prefetched
+  std::size_t             in_progress_{0};  ///< The number of batches being prefetched
+  Generation              generation_{0};   ///< Incremented whenever the caches are cleared
+  mutable StateCache      state_cache_;     ///< The cached (prefetched or written) state
+  TransactionCache        tx_cache_;        ///< The prefetched transactions
+
+  Flag      running_{false};
+  ThreadPtr thread_;
+
+  telemetry::CounterPtr hit_count_;
+  telemetry::CounterPtr miss_count_;
+  telemetry::CounterPtr tx_hit_count_;
+  telemetry::CounterPtr tx_miss_count_;
+};
+
+}  // namespace ledger
+}  // namespace fetch
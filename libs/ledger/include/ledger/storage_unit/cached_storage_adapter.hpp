@@ -53,6 +53,11 @@ public:
   void     Reset() override;
   /// @}
 
+  /// @name Batched State Interface
+  /// @{
+  Documents GetMany(Addresses const &keys) const override;
+  /// @}
+
 private:
   struct CacheEntry
   {
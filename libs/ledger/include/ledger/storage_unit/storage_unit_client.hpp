@@ -74,6 +74,9 @@ public:
   Document Get(ResourceAddress const &key) const override;
   void     Set(ResourceAddress const &key, StateValue const &value) override;
 
+  Documents GetMany(Addresses const &keys) const override;
+  void      SetMany(KeyValues const &entries) override;
+
   void Reset() override;
 
   // state hash functions
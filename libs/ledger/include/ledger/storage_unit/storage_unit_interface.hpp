@@ -23,6 +23,7 @@
 #include "storage/document.hpp"
 #include "storage/resource_mapper.hpp"
 
+#include <utility>
 #include <vector>
 
 namespace fetch {
@@ -43,6 +44,9 @@ public:
   using StateValue      = byte_array::ConstByteArray;
   using ShardIndex      = uint32_t;
   using Keys            = std::vector<storage::ResourceID>;
+  using Addresses       = std::vector<ResourceAddress>;
+  using Documents       = std::vector<Document>;
+  using KeyValues       = std::vector<std::pair<ResourceAddress, StateValue>>;
 
   // Construction / Destruction
   StorageInterface()          = default;
@@ -57,8 +61,47 @@ public:
   virtual bool     Unlock(ShardIndex shard)                                 = 0;
   virtual void     Reset()                                                  = 0;
   /// @}
+
+  /// @name Batched State Interface
+  /// @{
+  virtual Documents GetMany(Addresses const &keys) const;
+  virtual void      SetMany(KeyValues const &entries);
+  /// @}
 };
 
+/**
+ * Get a series of resources from the storage engine. Implementations backed by a remote store
+ * should override this in order to avoid a round trip per key.
+ *
+ * @param keys The keys to be accessed
+ * @return The documents, in the same order as the keys
+ */
+inline StorageInterface::Documents StorageInterface::GetMany(Addresses const &keys) const
+{
+  Documents docs{};
+  docs.reserve(keys.size());
+
+  for (auto const &key : keys)
+  {
+    docs.emplace_back(Get(key));
+  }
+
+  return docs;
+}
+
+/**
+ * Set a series of values on the storage engine
+ *
+ * @param entries The key and value pairs to be set
+ */
+inline void StorageInterface::SetMany(KeyValues const &entries)
+{
+  for (auto const &entry : entries)
+  {
+    Set(entry.first, entry.second);
+  }
+}
+
 class StorageUnitInterface : public StorageInterface
 {
 public:
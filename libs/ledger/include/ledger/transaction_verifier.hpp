@@ -17,12 +17,13 @@
 //
 //------------------------------------------------------------------------------
 
-#include "core/containers/queue.hpp"
+#include "core/containers/lock_free_queue.hpp"
 #include "telemetry/telemetry.hpp"
 
 #include <cstddef>
 #include <memory>
 #include <thread>
+#include <vector>
 
 namespace fetch {
 namespace chain {
@@ -39,9 +40,11 @@ class TransactionVerifier
 public:
   using TransactionPtr = std::shared_ptr<chain::Transaction>;
 
+  static constexpr std::size_t DEFAULT_BATCH_SIZE = 32;
+
   // Construction / Destruction
   TransactionVerifier(TransactionSink &sink, std::size_t verifying_threads,
-                      std::string const &name);
+                      std::string const &name, std::size_t batch_size = DEFAULT_BATCH_SIZE);
   TransactionVerifier(TransactionVerifier const &) = delete;
   TransactionVerifier(TransactionVerifier &&)      = delete;
   ~TransactionVerifier();
@@ -66,8 +69,9 @@ private:
   static constexpr std::size_t QUEUE_SIZE = 1u << 16u;  // 65K
 
   using Flag            = std::atomic<bool>;
-  using VerifiedQueue   = core::MPSCQueue<TransactionPtr, QUEUE_SIZE>;
-  using UnverifiedQueue = core::MPMCQueue<TransactionPtr, QUEUE_SIZE>;
+  using TransactionList = std::vector<TransactionPtr>;
+  using VerifiedQueue   = core::LockFreeQueue<TransactionPtr, QUEUE_SIZE>;
+  using UnverifiedQueue = core::LockFreeQueue<TransactionPtr, QUEUE_SIZE>;
   using ThreadPtr       = std::unique_ptr<std::thread>;
   using Threads         = std::vector<ThreadPtr>;
   using Sink            = TransactionSink;
@@ -78,6 +82,7 @@ private:
   void Dispatcher();
 
   std::size_t const verifying_threads_;
+  std::size_t const batch_size_;
   std::string const name_;
   Sink &            sink_;
   Flag              active_{true};
@@ -94,6 +99,7 @@ private:
   CounterPtr verified_tx_total_;
   CounterPtr discarded_tx_total_;
   CounterPtr dispatched_tx_total_;
+  CounterPtr verified_batches_total_;
   GaugePtr   num_threads_;
 };
 
@@ -0,0 +1,137 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+#include "ledger/executor_interface.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+class ExecutionItem;
+
+/**
+ * Pool of worker threads, each of which owns exactly one executor.
+ *
+ * Every worker has its own deque of pending execution items. Workers take items from the front
+ * of their own deque and, when this is empty, steal from the back of the other workers' deques.
+ * Since the executor is pinned to the worker there is no global idle executor list to contend on
+ * when an item is dispatched.
+ *
+ *        Post() ──▶ round robin
+ *                       │
+ *          ┌────────────┼────────────┐
+ *          ▼            ▼            ▼
+ *     ┌─────────┐  ┌─────────┐  ┌─────────┐
+ *     │ Deque 0 │  │ Deque 1 │  │ Deque N │ ◀── steal (back)
+ *     └─────────┘  └─────────┘  └─────────┘
+ *          │            │            │
+ *     Worker 0     Worker 1     Worker N
+ *    (Executor 0) (Executor 1) (Executor N)
+ */
+class WorkStealingExecutorPool
+{
+public:
+  using ExecutorPtr    = std::shared_ptr<ExecutorInterface>;
+  using ExecutorList   = std::vector<ExecutorPtr>;
+  using ExecuteHandler = std::function<void(ExecutorInterface &, ExecutionItem &)>;
+  using ItemList       = std::vector<ExecutionItem *>;
+
+  // Construction / Destruction
+  WorkStealingExecutorPool(ExecutorList executors, ExecuteHandler handler, std::string name);
+  WorkStealingExecutorPool(WorkStealingExecutorPool const &) = delete;
+  WorkStealingExecutorPool(WorkStealingExecutorPool &&)      = delete;
+  ~WorkStealingExecutorPool();
+
+  /// @name Pool control
+  /// @{
+  void Start();
+  void Stop();
+  /// @}
+
+  /// @name Dispatch
+  /// @{
+  void Post(ExecutionItem &item);
+  void Post(ItemList const &items);
+  /// @}
+
+  /// @name Accessors
+  /// @{
+  std::size_t  size() const;
+  std::size_t  pending() const;
+  std::size_t  steal_count() const;
+  ExecutorPtr &executor(std::size_t index);
+  /// @}
+
+  // Operators
+  WorkStealingExecutorPool &operator=(WorkStealingExecutorPool const &) = delete;
+  WorkStealingExecutorPool &operator=(WorkStealingExecutorPool &&) = delete;
+
+private:
+  using ItemQueue = std::deque<ExecutionItem *>;
+  using ThreadPtr = std::unique_ptr<std::thread>;
+  using Flag      = std::atomic<bool>;
+  using Counter   = std::atomic<std::size_t>;
+
+  struct Worker
+  {
+    explicit Worker(ExecutorPtr exec)
+      : executor{std::move(exec)}
+    {}
+
+    ExecutorPtr executor;
+    Mutex       lock;   ///< guards `queue`
+    ItemQueue   queue;  ///< items local to this worker
+    ThreadPtr   thread;
+  };
+
+  using WorkerPtr  = std::unique_ptr<Worker>;
+  using WorkerList = std::vector<WorkerPtr>;
+
+  void WorkerLoop(std::size_t index);
+
+  ExecutionItem *PopLocal(std::size_t index);
+  ExecutionItem *Steal(std::size_t thief);
+  void           Enqueue(ExecutionItem &item);
+
+  ExecuteHandler const handler_;
+  std::string const    name_;
+  WorkerList           workers_;
+
+  Counter next_worker_{0};  ///< round robin index for new items
+  Counter pending_{0};      ///< the number of items queued (but not yet started)
+  Counter steals_{0};       ///< the total number of items taken from another worker
+  Flag    running_{false};
+
+  std::mutex              idle_lock_;  ///< associated mutex for `work_available_`
+  std::condition_variable work_available_;
+};
+
+}  // namespace ledger
+}  // namespace fetch
@@ -19,12 +19,15 @@
 #include "chain/transaction_layout_rpc_serializers.hpp"
 #include "chain/transaction_validity_period.hpp"
 #include "core/assert.hpp"
+#include "core/bitvector.hpp"
 #include "core/byte_array/byte_array.hpp"
 #include "core/byte_array/encoders.hpp"
 #include "crypto/hash.hpp"
 #include "crypto/sha256.hpp"
 #include "ledger/chain/block_db_record.hpp"
 #include "ledger/chain/main_chain.hpp"
+#include "ledger/chain/mapped_block_store.hpp"
+#include "ledger/chain/object_block_store.hpp"
 #include "ledger/chain/time_travelogue.hpp"
 #include "network/generics/milli_timer.hpp"
 #include "telemetry/counter.hpp"
@@ -57,8 +60,10 @@ const uint64_t DIRTY_TIMEOUT{600};
  * Constructs the main chain
  *
  * @param mode Flag to signal which storage mode has been requested
+ * @param dirty_block_functionality Flag to signal if removed blocks should be temporarily rejected
+ * @param store_type The format of the long term block storage (persistent modes only)
  */
-MainChain::MainChain(Mode mode, bool dirty_block_functionality)
+MainChain::MainChain(Mode mode, bool dirty_block_functionality, StoreType store_type)
   : mode_{mode}
   , dirty_block_functionality_{dirty_block_functionality}
   , bloom_filter_{OVERLAP}
@@ -80,7 +85,14 @@ MainChain::MainChain(Mode mode, bool dirty_block_functionality)
   if (Mode::IN_MEMORY_DB != mode)
   {
     // create the block store
-    block_store_ = std::make_unique<BlockStore>();
+    if (StoreType::MAPPED_LOG == store_type)
+    {
+      block_store_ = std::make_unique<MappedBlockStore>();
+    }
+    else
+    {
+      block_store_ = std::make_unique<ObjectBlockStore>();
+    }
 
     RecoverFromFile(mode);
   }
@@ -115,7 +127,7 @@ void MainChain::Reset()
 
   if (block_store_)
   {
-    block_store_->New("chain.db", "chain.index.db");
+    block_store_->New();
     head_store_.close();
     head_store_.open("chain.head.db",
                      std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
@@ -343,23 +355,16 @@ void MainChain::KeepBlock(BlockPtr const &block) const
 
   auto const &hash{block->hash};
 
-  DbRecord record;
-
   if (!block->IsGenesis())
   {
     // notify stored parent
-    if (block_store_->Get(storage::ResourceID(block->previous_hash), record))
+    if (block_store_->SetNextHash(block->previous_hash, hash))
     {
-      if (record.next_hash != hash)
-      {
-        record.next_hash = hash;
-        block_store_->Set(storage::ResourceID(record.hash()), record);
-      }
-      // before checking for this block's children in storage, reset next_hash to genesis
-      record.next_hash = Digest{};
       CacheReference(block->previous_hash, hash, true);
     }
   }
+
+  DbRecord record;
   record.block = *block;
 
   // detect if any of this block's children has made it to the store already
@@ -367,7 +372,7 @@ void MainChain::KeepBlock(BlockPtr const &block) const
   for (auto ref_it{forward_refs.first}; ref_it != forward_refs.second; ++ref_it)
   {
     auto const &child{ref_it->second};
-    if (block_store_->Has(storage::ResourceID(child)))
+    if (block_store_->Has(child))
     {
       record.next_hash = child;
       CacheReference(hash, child, true);
@@ -376,7 +381,7 @@ void MainChain::KeepBlock(BlockPtr const &block) const
   }
 
   // now write the block itself; if next_hash is genesis, it will be rewritten later by a child
-  block_store_->Set(storage::ResourceID(hash), record);
+  block_store_->Set(record);
 }
 
 /**
@@ -391,7 +396,7 @@ bool MainChain::LoadBlock(BlockHash const &hash, Block &block, BlockHash *next_h
   assert(static_cast<bool>(block_store_));
 
   DbRecord record;
-  if (block_store_->Get(storage::ResourceID(hash), record))
+  if (block_store_->Get(hash, record))
   {
     block = record.block;
     AddBlockToBloomFilter(block);
@@ -415,6 +420,38 @@ bool MainChain::LoadBlock(BlockHash const &hash, Block &block, BlockHash *next_h
   return false;
 }
 
+/**
+ * Internal: load the header summary of a block from the permanent store
+ *
+ * Unlike LoadBlock, the contents of the block are not required, so with a suitable block store the
+ * block is never deserialised. As a result the block is not added to the bloom filter.
+ *
+ * @param[in]  hash The hash of the block to be loaded
+ * @param[out] header The header of the block
+ * @return True iff the block is found in the storage
+ */
+bool MainChain::LoadHeader(BlockHash const &hash, HeaderRecord &header) const
+{
+  assert(static_cast<bool>(block_store_));
+
+  if (block_store_->GetHeader(hash, header))
+  {
+    // update references assuming those from storage are unique
+    if (!header.IsGenesis())
+    {
+      CacheReference(header.previous_hash, hash, true);
+    }
+    if (!header.next_hash.empty())
+    {
+      CacheReference(hash, header.next_hash, true);
+    }
+
+    return true;
+  }
+
+  return false;
+}
+
 void MainChain::AddBlockToBloomFilter(Block const &block) const
 {
   for (auto const &slice : block.slices)
@@ -787,7 +824,9 @@ bool MainChain::GetPathToCommonAncestor(Blocks &blocks, BlockHash tip_hash, Bloc
   // clear the output structure
   blocks.clear();
 
-  BlockPtr left, right;
+  // only the left side is returned, so the right side only needs to walk the block headers
+  BlockPtr     left;
+  HeaderRecord right;
 
   BlockHash left_hash  = std::move(tip_hash);
   BlockHash right_hash = std::move(node_hash);
@@ -837,10 +876,9 @@ bool MainChain::GetPathToCommonAncestor(Blocks &blocks, BlockHash tip_hash, Bloc
     }
 
     // load up the right side
-    if (!right || right->hash != right_hash)
+    if (right.hash.empty() || right.hash != right_hash)
     {
-      right = LookupBlock(right_hash);
-      if (!right)
+      if (!LookupHeader(right_hash, right))
       {
         FETCH_LOG_WARN(LOGGING_NAME, "Unable to look up block (right): 0x", ToHex(right_hash));
         success = false;
@@ -849,19 +887,19 @@ bool MainChain::GetPathToCommonAncestor(Blocks &blocks, BlockHash tip_hash, Bloc
     }
 
     FETCH_LOG_DEBUG(LOGGING_NAME, "Left: 0x", ToHex(left_hash), " -> ", left->block_number,
-                    " Right: 0x", ToHex(right_hash), " -> ", right->block_number);
+                    " Right: 0x", ToHex(right_hash), " -> ", right.block_number);
 
     if (left_hash == right_hash)
     {
       break;
     }
 
-    if (left->block_number <= right->block_number)
+    if (left->block_number <= right.block_number)
     {
-      right_hash = right->previous_hash;
+      right_hash = right.previous_hash;
     }
 
-    if (left->block_number >= right->block_number)
+    if (left->block_number >= right.block_number)
     {
       left_hash = left->previous_hash;
     }
@@ -1005,7 +1043,7 @@ void MainChain::RecoverFromFile(Mode mode)
   // load the database files
   if (Mode::CREATE_PERSISTENT_DB == mode)
   {
-    block_store_->New("chain.db", "chain.index.db");
+    block_store_->New();
     head_store_.open("chain.head.db",
                      std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
 
@@ -1015,31 +1053,23 @@ void MainChain::RecoverFromFile(Mode mode)
     return;
   }
   assert(mode == Mode::LOAD_PERSISTENT_DB);
+  bool bloom_filter_recovered{false};
   if (Mode::LOAD_PERSISTENT_DB == mode)
   {
-    using namespace fetch::serializers;
-
-    block_store_->Load("chain.db", "chain.index.db");
+    block_store_->Load();
     head_store_.open("chain.head.db", std::ios::binary | std::ios::in | std::ios::out);
 
-    std::ifstream in(BLOOM_FILTER_STORE, std::ios::binary | std::ios::in);
-
-    if (in.is_open())
+    try
     {
-      try
-      {
-        byte_array::ByteArray bloom_filter_data{in};
-
-        LargeObjectSerializeHelper buffer{bloom_filter_data};
-
-        buffer >> bloom_filter_;
-      }
-      catch (std::exception const &e)
-      {
-        FETCH_LOG_ERROR(LOGGING_NAME,
-                        "Failed to load Bloom filter from storage! Reason: ", e.what());
-        Reset();
-      }
+      bloom_filter_.Load(BLOOM_FILTER_STORE);
+      bloom_filter_recovered = true;
+    }
+    catch (std::exception const &e)
+    {
+      // the filter is rebuilt from the complete blocks as the chain is walked below
+      FETCH_LOG_WARN(LOGGING_NAME, "Unable to load Bloom filter from storage, rebuilding. Reason: ",
+                     e.what());
+      bloom_filter_.Reset();
     }
   }
 
@@ -1054,20 +1084,37 @@ void MainChain::RecoverFromFile(Mode mode)
   {
     auto block_index = head->block_number;
 
-    // Copy head block so as to walk down the chain
-    BlockPtr next = std::make_shared<Block>(*head);
+    // Walk down the chain. Only the headers are needed for this, unless the bloom filter could not
+    // be recovered in which case it must be repopulated from the complete blocks
+    HeaderRecord next{*head};
+    Block        next_block;
+
+    auto const load_previous = [&]() {
+      if (bloom_filter_recovered)
+      {
+        return LoadHeader(next.previous_hash, next);
+      }
+
+      if (LoadBlock(next.previous_hash, next_block))
+      {
+        next = HeaderRecord{next_block};
+        return true;
+      }
+
+      return false;
+    };
 
-    while (LoadBlock(next->previous_hash, *next))
+    while (load_previous())
     {
-      if (next->block_number != block_index - 1)
+      if (next.block_number != block_index - 1)
       {
         FETCH_LOG_WARN(LOGGING_NAME,
                        "Discontinuity found when walking main chain during recovery. Current: ",
-                       block_index, " prev: ", next->block_number, " Resetting");
+                       block_index, " prev: ", next.block_number, " Resetting");
         break;
       }
 
-      block_index = next->block_number;
+      block_index = next.block_number;
     }
 
     if (block_index != 0)
@@ -1115,7 +1162,7 @@ void MainChain::RecoverFromFile(Mode mode)
   // Recovering the chain has failed in some way, reset the storage.
   if (!recovery_complete)
   {
-    block_store_->New("chain.db", "chain.index.db");
+    block_store_->New();
 
     // reopen the file and clear the contents
     head_store_.close();
@@ -1175,10 +1222,10 @@ void MainChain::WriteToFile()
       FETCH_LOG_DEBUG(LOGGING_NAME, "Writing block. ", block->block_number);
 
       // Recover the current head block from the file
-      BlockPtr current_file_head = std::make_shared<Block>();
-      BlockPtr block_head        = block;
+      HeaderRecord current_file_head;
+      BlockPtr     block_head = block;
 
-      LoadBlock(GetHeadHash(), *current_file_head);
+      LoadHeader(GetHeadHash(), current_file_head);
 
       // Now keep adding the block and its prev to the file until we are certain the file contains
       // an unbroken chain. Assuming that the current_file_head is unbroken we can write until we
@@ -1188,13 +1235,13 @@ void MainChain::WriteToFile()
         KeepBlock(block);
 
         // Keep the current_file_head one block behind
-        while (current_file_head->block_number > block->block_number - 1)
+        while (current_file_head.block_number > block->block_number - 1)
         {
-          LoadBlock(current_file_head->previous_hash, *current_file_head);
+          LoadHeader(current_file_head.previous_hash, current_file_head);
         }
 
         // Successful case
-        if (current_file_head->hash == block->previous_hash)
+        if (current_file_head.hash == block->previous_hash)
         {
           break;
         }
@@ -1628,6 +1675,28 @@ bool MainChain::LookupBlock(BlockHash const &hash, BlockPtr &block, BlockHash *n
   return is_in_storage;
 }
 
+/**
+ * Attempt to look up the header summary of a block.
+ *
+ * As with LookupBlock the in memory cache is searched first, but should this fail only the header
+ * of the block is read from the persistent storage.
+ *
+ * @param hash The hash of the block to search for
+ * @param header The output header to be populated
+ * @return true if successful, otherwise false
+ */
+bool MainChain::LookupHeader(BlockHash const &hash, HeaderRecord &header) const
+{
+  BlockPtr block;
+  if (LookupBlockFromCache(hash, block))
+  {
+    header = HeaderRecord{*block};
+    return true;
+  }
+
+  return block_store_ && LoadHeader(hash, header);
+}
+
 /**
  * Attempt to locate a block stored in the in memory cache
  *
@@ -2004,20 +2073,36 @@ DigestSet MainChain::DetectDuplicateTransactions(BlockHash const &           sta
     return {};
   }
 
-  DigestSet potential_duplicates{};
+  ProgressiveBloomFilter::Keys    digests{};
+  ProgressiveBloomFilter::Indices valid_until{};
+  digests.reserve(transactions.size());
+  valid_until.reserve(transactions.size());
+
   for (auto const &tx_layout : transactions)
   {
-    std::pair<bool, std::size_t> const result =
-        bloom_filter_.Match(tx_layout.digest(), tx_layout.valid_until());
-    bloom_filter_queried_bit_count_->set(result.second);
-    if (result.first)
+    digests.push_back(tx_layout.digest());
+    valid_until.push_back(tx_layout.valid_until());
+  }
+
+  BitVector         matches{};
+  std::size_t const positives = bloom_filter_.MatchMany(digests, valid_until, matches);
+
+  DigestSet potential_duplicates{};
+  if (positives > 0)
+  {
+    for (std::size_t i = 0; i < digests.size(); ++i)
     {
-      bloom_filter_positive_count_->increment();
-      potential_duplicates.insert(tx_layout.digest());
+      if (matches.bit(i))
+      {
+        potential_duplicates.insert(digests[i]);
+      }
     }
-    bloom_filter_query_count_->increment();
   }
 
+  bloom_filter_queried_bit_count_->set(SplitBlockBloomFilter::WORDS_PER_BLOCK);
+  bloom_filter_positive_count_->add(positives);
+  bloom_filter_query_count_->add(digests.size());
+
   DigestSet duplicates{};
   if (!potential_duplicates.empty())
   {
@@ -2053,22 +2138,16 @@ DigestSet MainChain::DetectDuplicateTransactions(BlockHash const &           sta
 
 void MainChain::FlushToDisk(bool flush_bloom)
 {
-  using namespace fetch::serializers;
-
   if (block_store_)
   {
-    block_store_->Flush(false);
+    block_store_->Flush();
   }
 
   if (flush_bloom && (mode_ != Mode::IN_MEMORY_DB))
   {
     try
     {
-      std::ofstream out(BLOOM_FILTER_STORE, std::ios::binary | std::ios::out | std::ios::trunc);
-      LargeObjectSerializeHelper buffer{};
-      buffer << bloom_filter_;
-
-      out << buffer.data();
+      bloom_filter_.Save(BLOOM_FILTER_STORE);
     }
     catch (std::exception const &e)
     {
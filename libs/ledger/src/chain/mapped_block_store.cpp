@@ -0,0 +1,635 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/serializers/main_serializer.hpp"
+#include "ledger/chain/mapped_block_store.hpp"
+#include "logging/logging.hpp"
+#include "storage/storage_exception.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+using byte_array::ConstByteArray;
+using storage::StorageException;
+
+constexpr char const *LOGGING_NAME = "MappedBlockStore";
+
+constexpr uint64_t    HEADERS_MAGIC             = 0x5244484b434f4c42ull;  // "BLOCKHDR"
+constexpr uint64_t    INDEX_MAGIC               = 0x5844494b434f4c42ull;  // "BLOCKIDX"
+constexpr std::size_t INITIAL_HEADERS_CAPACITY  = 1024;
+constexpr std::size_t INITIAL_INDEX_CAPACITY    = 2048;
+constexpr uint64_t    EMPTY_SLOT                = 0;
+constexpr uint64_t    MAX_SERIALISED_BLOCK_SIZE = std::numeric_limits<uint32_t>::max();
+
+bool FileExists(std::string const &filename)
+{
+  std::ifstream stream(filename, std::ios::binary);
+  return stream.good();
+}
+
+std::size_t FileSize(std::string const &filename)
+{
+  std::ifstream stream(filename, std::ios::binary | std::ios::ate);
+  return stream.good() ? static_cast<std::size_t>(stream.tellg()) : 0;
+}
+
+/**
+ * Create a new (zero filled) file of the specified size, replacing any existing file
+ */
+void CreateFile(std::string const &filename, std::size_t size)
+{
+  std::ofstream stream(filename, std::ios::binary | std::ios::out | std::ios::trunc);
+  if (size > 0)
+  {
+    stream.seekp(static_cast<std::streamoff>(size - 1));
+    stream.put('\0');
+  }
+
+  if (!stream)
+  {
+    throw StorageException("Unable to create block store file");
+  }
+}
+
+/**
+ * Extend an existing file to the specified size, new contents are zero filled
+ */
+void ExtendFile(std::string const &filename, std::size_t size)
+{
+  assert(size > 0);
+
+  std::fstream stream(filename, std::ios::binary | std::ios::in | std::ios::out);
+  stream.seekp(static_cast<std::streamoff>(size - 1));
+  stream.put('\0');
+
+  if (!stream)
+  {
+    throw StorageException("Unable to extend block store file");
+  }
+}
+
+void MapFile(mio::mmap_sink &mapping, std::string const &filename)
+{
+  std::error_code error;
+  mapping.map(filename, 0, mio::map_entire_file, error);
+  if (error)
+  {
+    throw StorageException("Unable to map block store file");
+  }
+}
+
+void SyncMapping(mio::mmap_sink &mapping)
+{
+  if (mapping.is_mapped())
+  {
+    std::error_code error;
+    mapping.sync(error);
+    if (error)
+    {
+      throw StorageException("Unable to sync block store file");
+    }
+  }
+}
+
+template <typename RawDigest>
+void CopyDigest(BlockHash const &digest, RawDigest &raw, uint8_t &length)
+{
+  if (digest.size() > raw.size())
+  {
+    throw StorageException("Digest too large for block store");
+  }
+
+  raw.fill(0);
+  std::memcpy(raw.data(), digest.pointer(), digest.size());
+  length = static_cast<uint8_t>(digest.size());
+}
+
+template <typename RawDigest>
+BlockHash ToDigest(RawDigest const &raw, uint8_t length)
+{
+  return (length != 0u) ? BlockHash{raw.data(), length} : BlockHash{};
+}
+
+/**
+ * Determine the home slot for a digest in the hash index
+ *
+ * Block hashes are cryptographic digests, so a prefix of the digest is already suitably
+ * distributed. It is mixed anyway to be robust to digests with common prefixes.
+ */
+std::size_t SlotFor(BlockHash const &digest, std::size_t mask)
+{
+  uint64_t key{digest.size()};
+  std::memcpy(&key, digest.pointer(), std::min(digest.size(), sizeof(key)));
+
+  key *= 0x9e3779b97f4a7c15ull;
+  return static_cast<std::size_t>(key ^ (key >> 32u)) & mask;
+}
+
+std::size_t IndexCapacityFor(std::size_t num_entries)
+{
+  std::size_t capacity = INITIAL_INDEX_CAPACITY;
+  while (capacity < (num_entries * 2))
+  {
+    capacity <<= 1u;
+  }
+
+  return capacity;
+}
+
+}  // namespace
+
+/**
+ * Construct the block store, no files are touched until the store is either created or loaded
+ *
+ * @param prefix The filename prefix for all of the files of the store
+ * @param segment_size The size in bytes of each of the segment files
+ */
+MappedBlockStore::MappedBlockStore(std::string prefix, std::size_t segment_size)
+  : prefix_{std::move(prefix)}
+  , headers_filename_{prefix_ + ".headers.db"}
+  , index_filename_{prefix_ + ".hash_index.db"}
+  , segment_size_{segment_size}
+{}
+
+void MappedBlockStore::New()
+{
+  FETCH_LOCK(lock_);
+  Reset();
+}
+
+void MappedBlockStore::Load()
+{
+  FETCH_LOCK(lock_);
+
+  // a damaged header table or segment is reported to the caller rather than discarded, only the
+  // hash index is rebuilt (inside Recover) since it holds nothing that is not also stored elsewhere
+  if (!Recover())
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "No previous block store found, creating a new one");
+    Reset();
+  }
+}
+
+void MappedBlockStore::Flush()
+{
+  FETCH_LOCK(lock_);
+
+  for (auto &segment : segments_)
+  {
+    SyncMapping(*segment);
+  }
+
+  SyncMapping(headers_);
+  SyncMapping(index_);
+}
+
+bool MappedBlockStore::Has(BlockHash const &hash)
+{
+  FETCH_LOCK(lock_);
+  return Lookup(hash) != NOT_FOUND;
+}
+
+bool MappedBlockStore::Get(BlockHash const &hash, BlockDbRecord &record)
+{
+  FETCH_LOCK(lock_);
+
+  auto const index = Lookup(hash);
+  if (index == NOT_FOUND)
+  {
+    return false;
+  }
+
+  auto const &entry = GetEntry(index);
+  if ((entry.segment >= segments_.size()) ||
+      ((entry.offset + entry.length) > segments_[entry.segment]->size()))
+  {
+    throw StorageException("Invalid block location in block store");
+  }
+
+  auto const *data = reinterpret_cast<uint8_t const *>(segments_[entry.segment]->data());
+
+  serializers::MsgPackSerializer serializer{ConstByteArray{data + entry.offset, entry.length}};
+  serializer >> record.block;
+
+  record.next_hash = ToDigest(entry.next_hash, entry.next_hash_length);
+
+  return true;
+}
+
+bool MappedBlockStore::GetHeader(BlockHash const &hash, BlockHeaderRecord &header)
+{
+  FETCH_LOCK(lock_);
+
+  auto const index = Lookup(hash);
+  if (index == NOT_FOUND)
+  {
+    return false;
+  }
+
+  auto const &entry = GetEntry(index);
+
+  header.hash          = ToDigest(entry.hash, entry.hash_length);
+  header.previous_hash = ToDigest(entry.previous_hash, entry.previous_hash_length);
+  header.next_hash     = ToDigest(entry.next_hash, entry.next_hash_length);
+  header.block_number  = entry.block_number;
+  header.weight        = entry.weight;
+  header.total_weight  = entry.total_weight;
+
+  return true;
+}
+
+void MappedBlockStore::Set(BlockDbRecord const &record)
+{
+  FETCH_LOCK(lock_);
+
+  auto const index = Lookup(record.hash());
+  if (index == NOT_FOUND)
+  {
+    Append(record);
+  }
+  else
+  {
+    // the contents of a block can never change, only its forward reference
+    auto &entry = GetEntry(index);
+    CopyDigest(record.next_hash, entry.next_hash, entry.next_hash_length);
+  }
+}
+
+bool MappedBlockStore::SetNextHash(BlockHash const &hash, BlockHash const &next_hash)
+{
+  FETCH_LOCK(lock_);
+
+  auto const index = Lookup(hash);
+  if (index == NOT_FOUND)
+  {
+    return false;
+  }
+
+  auto &entry = GetEntry(index);
+  CopyDigest(next_hash, entry.next_hash, entry.next_hash_length);
+
+  return true;
+}
+
+std::size_t MappedBlockStore::size() const
+{
+  FETCH_LOCK(lock_);
+  return static_cast<std::size_t>(num_entries_);
+}
+
+std::size_t MappedBlockStore::num_segments() const
+{
+  FETCH_LOCK(lock_);
+  return segments_.size();
+}
+
+/**
+ * Internal: Discard all the previous contents of the store and create an empty store
+ */
+void MappedBlockStore::Reset()
+{
+  Unmap();
+
+  // remove all the previous segments
+  for (std::size_t segment = 0;; ++segment)
+  {
+    auto const filename = SegmentFilename(segment);
+    if (!FileExists(filename))
+    {
+      break;
+    }
+
+    std::remove(filename.c_str());
+  }
+
+  // create the empty header table
+  CreateFile(headers_filename_, sizeof(TableHeader) + (INITIAL_HEADERS_CAPACITY * sizeof(Entry)));
+  MapFile(headers_, headers_filename_);
+
+  auto *header  = reinterpret_cast<TableHeader *>(headers_.data());
+  header->magic = HEADERS_MAGIC;
+  header->count = 0;
+
+  headers_capacity_     = INITIAL_HEADERS_CAPACITY;
+  num_entries_          = 0;
+  segment_write_offset_ = 0;
+
+  RebuildIndex(INITIAL_INDEX_CAPACITY);
+}
+
+/**
+ * Internal: Attempt to map the previous contents of the store
+ *
+ * @return true if successful, otherwise false if there is no previous store
+ * @throws StorageException if the header table or the segments are inconsistent
+ */
+bool MappedBlockStore::Recover()
+{
+  Unmap();
+
+  // map the header table
+  std::size_t const headers_size = FileSize(headers_filename_);
+  if (headers_size < sizeof(TableHeader))
+  {
+    return false;
+  }
+
+  MapFile(headers_, headers_filename_);
+
+  auto const *header = reinterpret_cast<TableHeader const *>(headers_.data());
+  headers_capacity_  = (headers_size - sizeof(TableHeader)) / sizeof(Entry);
+  num_entries_       = header->count;
+
+  if ((header->magic != HEADERS_MAGIC) || (num_entries_ > headers_capacity_))
+  {
+    throw StorageException("Inconsistent block store header table");
+  }
+
+  // map all of the segments that are referenced by the header table
+  if (num_entries_ > 0)
+  {
+    auto const &last = GetEntry(num_entries_ - 1);
+
+    for (std::size_t segment = 0; segment <= last.segment; ++segment)
+    {
+      auto const filename = SegmentFilename(segment);
+      if (!FileExists(filename))
+      {
+        throw StorageException("Missing block store segment");
+      }
+
+      segments_.emplace_back(std::make_unique<Mapping>());
+      MapFile(*segments_.back(), filename);
+    }
+
+    segment_write_offset_ = last.offset + last.length;
+    if (segment_write_offset_ > segments_.back()->size())
+    {
+      throw StorageException("Truncated block store segment");
+    }
+  }
+
+  // map the hash index, rebuilding it if it is missing or inconsistent with the header table
+  bool index_valid{false};
+
+  std::size_t const index_size = FileSize(index_filename_);
+  if (index_size >= sizeof(TableHeader))
+  {
+    try
+    {
+      MapFile(index_, index_filename_);
+
+      auto const *index_header = reinterpret_cast<TableHeader const *>(index_.data());
+      index_capacity_          = (index_size - sizeof(TableHeader)) / sizeof(uint64_t);
+
+      bool const is_power_of_two =
+          (index_capacity_ != 0) && ((index_capacity_ & (index_capacity_ - 1)) == 0);
+
+      index_valid = (index_header->magic == INDEX_MAGIC) &&
+                    (index_header->count == num_entries_) && is_power_of_two &&
+                    ((num_entries_ * 2) <= index_capacity_);
+    }
+    catch (StorageException const &ex)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Unable to map block store hash index: ", ex.what());
+    }
+  }
+
+  if (!index_valid)
+  {
+    FETCH_LOG_INFO(LOGGING_NAME, "Rebuilding block store hash index");
+    RebuildIndex(IndexCapacityFor(num_entries_));
+  }
+
+  return true;
+}
+
+/**
+ * Internal: Lookup the position of a block in the header table
+ *
+ * @param hash The hash of the block
+ * @return The index of the entry in the header table, otherwise NOT_FOUND
+ */
+uint64_t MappedBlockStore::Lookup(BlockHash const &hash)
+{
+  if ((index_capacity_ == 0) || hash.empty() || (hash.size() > MAX_DIGEST_SIZE))
+  {
+    return NOT_FOUND;
+  }
+
+  auto const *      slots = reinterpret_cast<uint64_t const *>(index_.data() + sizeof(TableHeader));
+  std::size_t const mask  = index_capacity_ - 1;
+
+  for (std::size_t slot = SlotFor(hash, mask);; slot = (slot + 1) & mask)
+  {
+    uint64_t const value = slots[slot];
+    if (value == EMPTY_SLOT)
+    {
+      return NOT_FOUND;
+    }
+
+    auto const &entry = GetEntry(value - 1);
+    if ((entry.hash_length == hash.size()) &&
+        (std::memcmp(entry.hash.data(), hash.pointer(), hash.size()) == 0))
+    {
+      return value - 1;
+    }
+  }
+}
+
+MappedBlockStore::Entry &MappedBlockStore::GetEntry(uint64_t index)
+{
+  assert(index < headers_capacity_);
+  return reinterpret_cast<Entry *>(headers_.data() + sizeof(TableHeader))[index];
+}
+
+/**
+ * Internal: Append a new block to the store
+ *
+ * The block is written to the segment, and synced to disk, before its entry is added to the
+ * header table. The entry is added before it is added to the index. An append interrupted by a
+ * crash or a power failure is therefore discarded on load: the header table can never reference
+ * a block that is not on disk, and the index is rebuilt if it does not match the header table.
+ *
+ * @param record The record to be added
+ */
+void MappedBlockStore::Append(BlockDbRecord const &record)
+{
+  serializers::MsgPackSerializer serializer;
+  serializer << record.block;
+
+  auto const &data = serializer.data();
+  if (data.size() > MAX_SERIALISED_BLOCK_SIZE)
+  {
+    throw StorageException("Block too large for block store");
+  }
+
+  // write the block into the segment
+  uint32_t segment{0};
+  uint64_t offset{0};
+  std::memcpy(Reserve(data.size(), segment, offset), data.pointer(), data.size());
+  SyncMapping(*segments_[segment]);
+
+  // add the entry to the header table
+  if (num_entries_ == headers_capacity_)
+  {
+    GrowHeaders();
+  }
+
+  auto &entry = GetEntry(num_entries_);
+  std::memset(&entry, 0, sizeof(Entry));
+
+  CopyDigest(record.hash(), entry.hash, entry.hash_length);
+  CopyDigest(record.block.previous_hash, entry.previous_hash, entry.previous_hash_length);
+  CopyDigest(record.next_hash, entry.next_hash, entry.next_hash_length);
+  entry.block_number = record.block.block_number;
+  entry.weight       = record.block.weight;
+  entry.total_weight = record.block.total_weight;
+  entry.offset       = offset;
+  entry.segment      = segment;
+  entry.length       = static_cast<uint32_t>(data.size());
+
+  ++num_entries_;
+  reinterpret_cast<TableHeader *>(headers_.data())->count = num_entries_;
+
+  // finally add the entry to the index
+  if ((num_entries_ * 2) > index_capacity_)
+  {
+    RebuildIndex(index_capacity_ * 2);
+  }
+  else
+  {
+    InsertIntoIndex(num_entries_ - 1);
+    reinterpret_cast<TableHeader *>(index_.data())->count = num_entries_;
+  }
+}
+
+/**
+ * Internal: Reserve space at the end of the most recent segment, adding a new one if required
+ *
+ * @param length The number of bytes required
+ * @param segment The output index of the segment
+ * @param offset The output offset into the segment
+ * @return A pointer to the reserved space
+ */
+uint8_t *MappedBlockStore::Reserve(std::size_t length, uint32_t &segment, uint64_t &offset)
+{
+  if (segments_.empty() || ((segment_write_offset_ + length) > segments_.back()->size()))
+  {
+    AddSegment(length);
+  }
+
+  segment = static_cast<uint32_t>(segments_.size() - 1);
+  offset  = segment_write_offset_;
+
+  segment_write_offset_ += length;
+
+  return reinterpret_cast<uint8_t *>(segments_.back()->data()) + offset;
+}
+
+void MappedBlockStore::AddSegment(std::size_t min_size)
+{
+  auto const filename = SegmentFilename(segments_.size());
+
+  CreateFile(filename, std::max(segment_size_, min_size));
+
+  segments_.emplace_back(std::make_unique<Mapping>());
+  MapFile(*segments_.back(), filename);
+
+  segment_write_offset_ = 0;
+}
+
+void MappedBlockStore::GrowHeaders()
+{
+  std::size_t const capacity = headers_capacity_ * 2;
+
+  headers_.unmap();
+  ExtendFile(headers_filename_, sizeof(TableHeader) + (capacity * sizeof(Entry)));
+  MapFile(headers_, headers_filename_);
+
+  headers_capacity_ = capacity;
+}
+
+/**
+ * Internal: Recreate the hash index from the header table
+ *
+ * @param capacity The number of slots in the new index, must be a power of two
+ */
+void MappedBlockStore::RebuildIndex(std::size_t capacity)
+{
+  assert((capacity & (capacity - 1)) == 0);
+
+  index_.unmap();
+  CreateFile(index_filename_, sizeof(TableHeader) + (capacity * sizeof(uint64_t)));
+  MapFile(index_, index_filename_);
+
+  index_capacity_ = capacity;
+
+  for (uint64_t index = 0; index < num_entries_; ++index)
+  {
+    InsertIntoIndex(index);
+  }
+
+  auto *header  = reinterpret_cast<TableHeader *>(index_.data());
+  header->magic = INDEX_MAGIC;
+  header->count = num_entries_;
+}
+
+void MappedBlockStore::InsertIntoIndex(uint64_t index)
+{
+  auto &            entry = GetEntry(index);
+  BlockHash const   hash  = ToDigest(entry.hash, entry.hash_length);
+  std::size_t const mask  = index_capacity_ - 1;
+
+  auto *slots = reinterpret_cast<uint64_t *>(index_.data() + sizeof(TableHeader));
+
+  std::size_t slot = SlotFor(hash, mask);
+  while (slots[slot] != EMPTY_SLOT)
+  {
+    slot = (slot + 1) & mask;
+  }
+
+  slots[slot] = index + 1;
+}
+
+void MappedBlockStore::Unmap()
+{
+  segments_.clear();
+  headers_.unmap();
+  index_.unmap();
+
+  headers_capacity_ = 0;
+  index_capacity_   = 0;
+}
+
+std::string MappedBlockStore::SegmentFilename(std::size_t segment) const
+{
+  return prefix_ + ".segment." + std::to_string(segment) + ".db";
+}
+
+}  // namespace ledger
+}  // namespace fetch
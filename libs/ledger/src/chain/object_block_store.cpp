@@ -0,0 +1,92 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/chain/object_block_store.hpp"
+#include "storage/resource_mapper.hpp"
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+constexpr char const *DOCUMENT_FILE = "chain.db";
+constexpr char const *INDEX_FILE    = "chain.index.db";
+
+}  // namespace
+
+void ObjectBlockStore::New()
+{
+  store_.New(DOCUMENT_FILE, INDEX_FILE);
+}
+
+void ObjectBlockStore::Load()
+{
+  store_.Load(DOCUMENT_FILE, INDEX_FILE);
+}
+
+void ObjectBlockStore::Flush()
+{
+  store_.Flush(false);
+}
+
+bool ObjectBlockStore::Has(BlockHash const &hash)
+{
+  return store_.Has(storage::ResourceID(hash));
+}
+
+bool ObjectBlockStore::Get(BlockHash const &hash, BlockDbRecord &record)
+{
+  return store_.Get(storage::ResourceID(hash), record);
+}
+
+bool ObjectBlockStore::GetHeader(BlockHash const &hash, BlockHeaderRecord &header)
+{
+  BlockDbRecord record;
+  if (!Get(hash, record))
+  {
+    return false;
+  }
+
+  header = BlockHeaderRecord{record.block, record.next_hash};
+
+  return true;
+}
+
+void ObjectBlockStore::Set(BlockDbRecord const &record)
+{
+  store_.Set(storage::ResourceID(record.hash()), record);
+}
+
+bool ObjectBlockStore::SetNextHash(BlockHash const &hash, BlockHash const &next_hash)
+{
+  BlockDbRecord record;
+  if (!Get(hash, record))
+  {
+    return false;
+  }
+
+  if (record.next_hash != next_hash)
+  {
+    record.next_hash = next_hash;
+    store_.Set(storage::ResourceID(hash), record);
+  }
+
+  return true;
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -0,0 +1,170 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/chaincode/compiled_contract_cache.hpp"
+#include "telemetry/counter.hpp"
+#include "telemetry/registry.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+
+using telemetry::Registry;
+
+/**
+ * Get the cache shared by all the smart contracts of the process
+ *
+ * @return The reference to the cache
+ */
+CompiledContractCache &CompiledContractCache::Instance()
+{
+  static CompiledContractCache instance;
+  return instance;
+}
+
+/**
+ * Construct the cache
+ *
+ * @param max_entries The maximum number of executables to be retained
+ */
+CompiledContractCache::CompiledContractCache(std::size_t max_entries)
+  : max_entries_{std::max<std::size_t>(max_entries, 1)}
+  , hit_count_{Registry::Instance().CreateCounter(
+        "ledger_compiled_contract_cache_hit_total",
+        "The total number of smart contract compilations avoided by the cache")}
+  , miss_count_{Registry::Instance().CreateCounter(
+        "ledger_compiled_contract_cache_miss_total",
+        "The total number of smart contracts compiled by the cache")}
+  , eviction_count_{Registry::Instance().CreateCounter(
+        "ledger_compiled_contract_cache_eviction_total",
+        "The total number of compiled smart contracts evicted from the cache")}
+{}
+
+/**
+ * Look up the compiled executable for a contract, compiling it if it is not present in the cache
+ *
+ * If the same contract is already being compiled by another thread, the call waits for that
+ * compilation to complete rather than starting a second one.
+ *
+ * @param digest The digest of the contract source
+ * @param compile The function compiling the contract, expected to throw on failure
+ * @return The compiled executable
+ */
+CompiledContractCache::ExecutablePtr CompiledContractCache::LookupOrCompile(
+    Digest const &digest, Compiler const &compile)
+{
+  std::promise<ExecutablePtr> promise{};
+  Result                      result{};
+  uint64_t                    id{0};
+
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+
+    auto it = index_.find(digest);
+    if (it != index_.end())
+    {
+      // refresh the position of the entry
+      entries_.splice(entries_.begin(), entries_, it->second);
+      result = it->second->executable;
+    }
+    else
+    {
+      id     = ++next_id_;
+      result = promise.get_future().share();
+
+      entries_.push_front(Entry{digest, result, id});
+      index_.emplace(digest, entries_.begin());
+
+      // evict the least recently used entries. Any thread waiting on one of them keeps its own
+      // reference to the result
+      while (entries_.size() > max_entries_)
+      {
+        index_.erase(entries_.back().digest);
+        entries_.pop_back();
+        eviction_count_->increment();
+      }
+    }
+  }
+
+  // another thread has compiled, or is compiling, this contract
+  if (id == 0)
+  {
+    hit_count_->increment();
+    return result.get();
+  }
+
+  miss_count_->increment();
+
+  try
+  {
+    promise.set_value(compile());
+  }
+  catch (...)
+  {
+    // failed compilations are not cached, however the waiting threads are given the same error
+    promise.set_exception(std::current_exception());
+    Remove(digest, id);
+  }
+
+  return result.get();
+}
+
+/**
+ * Remove all the executables from the cache
+ */
+void CompiledContractCache::Clear()
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  index_.clear();
+  entries_.clear();
+}
+
+std::size_t CompiledContractCache::size() const
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  return entries_.size();
+}
+
+std::size_t CompiledContractCache::max_entries() const
+{
+  return max_entries_;
+}
+
+/**
+ * Remove the entry for a contract, provided that it has not since been replaced
+ *
+ * @param digest The digest of the contract source
+ * @param id The identifier of the entry to be removed
+ */
+void CompiledContractCache::Remove(Digest const &digest, uint64_t id)
+{
+  std::lock_guard<std::mutex> guard(lock_);
+
+  auto it = index_.find(digest);
+  if ((it != index_.end()) && (it->second->id == id))
+  {
+    entries_.erase(it->second);
+    index_.erase(it);
+  }
+}
+
+}  // namespace ledger
+}  // namespace fetch
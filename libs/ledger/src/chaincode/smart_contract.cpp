@@ -22,6 +22,7 @@
 #include "crypto/fnv.hpp"
 #include "crypto/hash.hpp"
 #include "crypto/sha256.hpp"
+#include "ledger/chaincode/compiled_contract_cache.hpp"
 #include "ledger/chaincode/contract.hpp"
 #include "ledger/chaincode/contract_context.hpp"
 #include "ledger/chaincode/smart_contract.hpp"
@@ -105,7 +106,6 @@ constexpr char const *LOGGING_NAME = "SmartContract";
 SmartContract::SmartContract(std::string const &source)
   : source_{source}
   , digest_{fetch::crypto::Hash<fetch::crypto::SHA256>(ConstByteArray(source))}
-  , executable_{std::make_shared<Executable>()}
   , module_{VMFactory::GetModule(VMFactory::USE_SMART_CONTRACTS)}
 {
   if (source_.empty())
@@ -122,14 +122,32 @@ SmartContract::SmartContract(std::string const &source)
   module_->CreateFreeFunction(
       "getContext", [this](vm::VM *) -> vm_modules::ledger::ContextPtr { return context_; });
 
-  // create and compile the executable
-  fetch::vm::SourceFiles files  = {{"default.etch", source}};
-  auto                   errors = vm_modules::VMFactory::Compile(module_, files, *executable_);
+  // look up the executable, only compiling it if it is not already known to the process. Since
+  // all the smart contract modules have identical bindings the executable can be shared
+  bool compiled{false};
+  executable_ = CompiledContractCache::Instance().LookupOrCompile(digest_, [this, &compiled]() {
+    auto executable = std::make_shared<Executable>();
+    compiled        = true;
 
-  // if there are any compilation errors
-  if (!errors.empty())
+    // create and compile the executable
+    fetch::vm::SourceFiles files  = {{"default.etch", source_}};
+    auto                   errors = vm_modules::VMFactory::Compile(module_, files, *executable);
+
+    // if there are any compilation errors
+    if (!errors.empty())
+    {
+      throw SmartContractException(SmartContractException::Category::COMPILATION,
+                                   std::move(errors));
+    }
+
+    return executable;
+  });
+
+  // the type and opcode tables of the module are only populated when a compiler is set up on it,
+  // which needs to be done explicitly when the executable was served from the cache
+  if (!compiled)
   {
-    throw SmartContractException(SmartContractException::Category::COMPILATION, std::move(errors));
+    vm::Compiler compiler{module_.get()};
   }
 
   // since we now have a fully compiled executable we can evaluate the functions and assign the
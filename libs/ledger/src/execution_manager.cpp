@@ -26,15 +26,16 @@
 #include "ledger/execution_manager.hpp"
 #include "ledger/executor.hpp"
 #include "ledger/state_adapter.hpp"
+#include "ledger/state_prefetcher.hpp"
 #include "ledger/transaction_status_cache.hpp"
 #include "logging/logging.hpp"
-#include "moment/deadline_timer.hpp"
 #include "storage/resource_mapper.hpp"
 #include "telemetry/counter.hpp"
 #include "telemetry/histogram.hpp"
 #include "telemetry/registry.hpp"
 #include "telemetry/utils/timer.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <memory>
 #include <thread>
@@ -53,13 +54,18 @@ using telemetry::Registry;
  * Constructs a execution manager instance
  *
  * @param num_executors The specified number of executors (and threads)
+ * @param mode The scheduling mode to be used between slices
+ * @param prefetch_state Whether the state of the next slice should be retrieved ahead of execution
  */
 ExecutionManager::ExecutionManager(std::size_t num_executors, uint32_t log2_num_lanes,
                                    StorageUnitPtr storage, ExecutorFactory const &factory,
-                                   TransactionStatusCache::ShrdPtr tx_status_cache)
+                                   TransactionStatusCache::ShrdPtr tx_status_cache, Mode mode,
+                                   bool prefetch_state)
   : log2_num_lanes_{log2_num_lanes}
+  , mode_{mode}
   , storage_{std::move(storage)}
-  , thread_pool_{network::MakeThreadPool(num_executors, "Executor")}
+  , lane_occupancy_(1u << log2_num_lanes, 0)
+  , prefetcher_{prefetch_state ? std::make_shared<StatePrefetcher>(storage_) : nullptr}
   , tx_status_cache_{std::move(tx_status_cache)}
   , tx_executed_count_(Registry::Instance().CreateCounter(
         "ledger_exec_mgr_tx_executed_total", "The total number of executed transactions"))
@@ -69,6 +75,9 @@ ExecutionManager::ExecutionManager(std::size_t num_executors, uint32_t log2_num_
         "ledger_exec_mgr_fees_settled_total", "The total number of settle fees rounds"))
   , blocks_completed_count_(Registry::Instance().CreateCounter(
         "ledger_exec_mgr_blocks_completed_total", "The total number of settle fees rounds"))
+  , tx_pipelined_count_(Registry::Instance().CreateCounter(
+        "ledger_exec_mgr_tx_pipelined_total",
+        "The total number of transactions started before the previous slice completed"))
   , execution_duration_(Registry::Instance().CreateHistogram(
         {0.000001, 0.000002, 0.000003, 0.000004, 0.000005, 0.000006, 0.000007, 0.000008, 0.000009,
          0.00001,  0.00002,  0.00003,  0.00004,  0.00005,  0.00006,  0.00007,  0.00008,  0.00009,
@@ -127,22 +136,28 @@ ExecutionManager::ExecutionManager(std::size_t num_executors, uint32_t log2_num_
       "ledger_executor_settle_fees_duration",
       "The execution duration in seconds for executing a transaction");
 
-  // setup the executor pool
+  // create the executor instances, each of which is pinned to a worker of the pool
+  ExecutorList executors{};
+  executors.reserve(num_executors);
+  for (std::size_t i = 0; i < num_executors; ++i)
   {
-    FETCH_LOCK(idle_executors_lock_);
+    auto executor = factory();
+    assert(static_cast<bool>(executor));
 
-    // ensure lists are reserved
-    idle_executors_.reserve(num_executors);
-
-    // create the executor instances
-    for (std::size_t i = 0; i < num_executors; ++i)
+    if (prefetcher_)
     {
-      auto executor = factory();
-      assert(static_cast<bool>(executor));
-
-      idle_executors_.emplace_back(std::move(executor));
+      executor->AttachPrefetcher(prefetcher_);
     }
+
+    executors.emplace_back(std::move(executor));
   }
+
+  executor_pool_ = std::make_unique<WorkStealingExecutorPool>(
+      std::move(executors),
+      [this](ExecutorInterface &executor, ExecutionItem &item) {
+        DispatchExecution(executor, item);
+      },
+      "Executor");
 }
 
 /**
@@ -231,62 +246,253 @@ bool ExecutionManager::PlanExecution(Block const &block)
 }
 
 /**
- * Dispatches an execution item to the next available executor
+ * Executes an item on the specified executor and schedules any items which were waiting for the
+ * lanes of this item to become free
  *
- * This function should be called from a context of a thread pool
+ * This function is called from the context of the executor pool workers
  *
+ * @param executor The executor pinned to the calling worker
  * @param item The execution item to dispatch
  */
-void ExecutionManager::DispatchExecution(ExecutionItem &item)
+void ExecutionManager::DispatchExecution(ExecutorInterface &executor, ExecutionItem &item)
 {
-  ExecutorPtr executor;
+  // execute the item
+  {
+    telemetry::FunctionTimer const timer{*execution_duration_};
+    item.Execute(executor);
+  }
+
+  auto const &result{item.result()};
+
+  // determine what the status is
+  if (ExecutorInterface::Status::SUCCESS != result.status)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Error executing tx: 0x", item.digest().ToHex(),
+                   " status: ", ledger::ToString(result.status));
+  }
+
+  ++completed_executions_;
+  tx_executed_count_->increment();
 
-  // look up a free executor
+  // free up the lanes of this item and determine which (if any) items of the next slice can now be
+  // started
+  ItemList ready{};
+  if (Mode::PIPELINED == mode_)
   {
-    FETCH_LOCK(idle_executors_lock_);
-    if (!idle_executors_.empty())
+    FETCH_LOCK(lookahead_lock_);
+    ReleaseLanes(item);
+    CollectReadyItems(ready);
+  }
+
+  // the newly ready items must be accounted for before this item is marked as complete
+  counters_.ApplyVoid([&item, &ready](Counters &counters) {
+    counters.active += ready.size();
+    --counters.active;
+
+    if (item.slice() == counters.slice)
     {
-      executor = idle_executors_.back();
-      idle_executors_.pop_back();
+      --counters.remaining;
+    }
+    else
+    {
+      --counters.lookahead;
     }
+  });
+
+  if (!ready.empty())
+  {
+    tx_pipelined_count_->add(ready.size());
+    executor_pool_->Post(ready);
   }
+}
+
+/**
+ * Make the specified slice the current slice. All of the deferred items of the slice are moved into
+ * the ready list and the items of the next slice are staged. In pipelined mode, any items of the
+ * next slice whose lanes are not used by any unfinished item are also added to the ready list.
+ *
+ * Must be called with the `execution_plan_lock_` held.
+ *
+ * @param slice The index of the slice which is now current
+ * @param ready The output list of items which should be dispatched
+ */
+void ExecutionManager::ScheduleSlice(SliceIndex slice, ItemList &ready)
+{
+  bool const pipelined = (Mode::PIPELINED == mode_);
 
-  // We must have a executor present for this to work. This should always
-  // be the case provided num_executors == num_threads (in thread pool)
-  assert(executor);
+  FETCH_LOCK(lookahead_lock_);
 
-  if (executor)
+  // all the previous slices have completed at this point, therefore all the remaining items in this
+  // slice can be started
+  if (slice == 0)
   {
-    // increment the active counters
-    counters_.ApplyVoid([](auto &counters) { ++counters.active; });
+    std::fill(lane_occupancy_.begin(), lane_occupancy_.end(), 0u);
 
-    // execute the item
-    item.Execute(*executor);
-    auto const &result{item.result()};
+    for (auto const &item : execution_plan_[slice])
+    {
+      ready.push_back(item.get());
+    }
+  }
+  else
+  {
+    ready.swap(deferred_);
+  }
+
+  deferred_.clear();
 
-    // determine what the status is
-    if (ExecutorInterface::Status::SUCCESS != result.status)
+  if (pipelined)
+  {
+    for (auto *item : ready)
     {
-      FETCH_LOG_WARN(LOGGING_NAME, "Error executing tx: 0x", item.digest().ToHex(),
-                     " status: ", ledger::ToString(result.status));
+      AcquireLanes(*item);
     }
+  }
 
-    counters_.ApplyVoid([](auto &counters) {
-      --counters.active;
-      --counters.remaining;
-    });
+  // stage the items of the following slice
+  SliceIndex const next_slice = slice + 1;
+  std::size_t      num_next{0};
+  if (next_slice < execution_plan_.size())
+  {
+    num_next = execution_plan_[next_slice].size();
 
-    ++completed_executions_;
-    tx_executed_count_->increment();
+    for (auto const &item : execution_plan_[next_slice])
+    {
+      deferred_.push_back(item.get());
+    }
 
+    if (pipelined)
     {
-      FETCH_LOCK(idle_executors_lock_);
-      idle_executors_.push_back(std::move(executor));
+      std::size_t const num_ready = ready.size();
+      CollectReadyItems(ready);
+      tx_pipelined_count_->add(ready.size() - num_ready);
     }
+
+    PrefetchSlice(next_slice);
   }
-  else
+
+  // update the counters for the new slice. Since none of the items from the next slice can have
+  // been dispatched yet they are all outstanding
+  counters_.ApplyVoid([this, slice, num_next, &ready](Counters &counters) {
+    if (slice == 0)
+    {
+      counters.active    = 0;
+      counters.remaining = execution_plan_[slice].size();
+    }
+    else
+    {
+      // items of this slice might have already been completed while it was the next slice
+      counters.remaining = counters.lookahead;
+    }
+
+    counters.active += ready.size();
+    counters.lookahead = num_next;
+    counters.slice     = slice;
+  });
+}
+
+/**
+ * Request that the transactions and state of the specified slice are retrieved in the background
+ *
+ * Must be called with the `execution_plan_lock_` held.
+ *
+ * @param slice The index of the slice to be prefetched
+ */
+void ExecutionManager::PrefetchSlice(SliceIndex slice)
+{
+  if (!prefetcher_)
   {
-    FETCH_LOG_ERROR(LOGGING_NAME, "Failed to secure an idle executor");
+    return;
+  }
+
+  StatePrefetcher::Digests digests{};
+  digests.reserve(execution_plan_[slice].size());
+
+  for (auto const &item : execution_plan_[slice])
+  {
+    digests.emplace_back(item->digest());
+  }
+
+  prefetcher_->Prefetch(std::move(digests));
+}
+
+/**
+ * Move all the deferred items whose lanes are not in use into the ready list
+ *
+ * Must be called with the `lookahead_lock_` held.
+ *
+ * @param ready The output list of items which should be dispatched
+ */
+void ExecutionManager::CollectReadyItems(ItemList &ready)
+{
+  auto it = deferred_.begin();
+  while (it != deferred_.end())
+  {
+    if (IsLaneSetFree(**it))
+    {
+      AcquireLanes(**it);
+      ready.push_back(*it);
+      it = deferred_.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+bool ExecutionManager::IsLaneSetFree(ExecutionItem const &item) const
+{
+  for (std::size_t const lane : item.shards())
+  {
+    if (lane_occupancy_[lane] != 0u)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void ExecutionManager::AcquireLanes(ExecutionItem const &item)
+{
+  for (std::size_t const lane : item.shards())
+  {
+    ++lane_occupancy_[lane];
+  }
+}
+
+void ExecutionManager::ReleaseLanes(ExecutionItem const &item)
+{
+  for (std::size_t const lane : item.shards())
+  {
+    assert(lane_occupancy_[lane] > 0);
+    --lane_occupancy_[lane];
+  }
+}
+
+/**
+ * Discard any items which have not been dispatched and wait for all the active items to complete.
+ * In pipelined mode items of the next slice might still be executing when the current slice fails.
+ */
+void ExecutionManager::DrainActiveItems()
+{
+  {
+    FETCH_LOCK(lookahead_lock_);
+    deferred_.clear();
+  }
+
+  while (running_)
+  {
+    bool const drained = counters_.Wait(
+        [](Counters const &counters) -> bool { return counters.active == 0; },
+        std::chrono::seconds{2});
+
+    if (drained)
+    {
+      break;
+    }
+
+    FETCH_LOG_WARN(LOGGING_NAME, "### Extra long drain of active executions");
   }
 }
 
@@ -316,8 +522,13 @@ void ExecutionManager::Start()
     throw std::runtime_error("Failed waiting for the monitor to start");
   }
 
-  // fire up the main worker thread pool
-  thread_pool_->Start();
+  // fire up the executor workers
+  executor_pool_->Start();
+
+  if (prefetcher_)
+  {
+    prefetcher_->Start();
+  }
 }
 
 /**
@@ -342,8 +553,13 @@ void ExecutionManager::Stop()
     monitor_thread_.reset();
   }
 
-  // tear down the thread pool
-  thread_pool_->Stop();
+  // tear down the executor workers
+  executor_pool_->Stop();
+
+  if (prefetcher_)
+  {
+    prefetcher_->Stop();
+  }
 }
 
 void ExecutionManager::SetLastProcessedBlock(Digest hash)
@@ -361,6 +577,14 @@ ExecutionManager::State ExecutionManager::GetState()
   return state_.Apply([](Summary const &summary) { return summary.state; });
 }
 
+/**
+ * @return The number of items which were started before the previous slice had completed
+ */
+uint64_t ExecutionManager::pipelined_executions() const
+{
+  return tx_pipelined_count_->count();
+}
+
 bool ExecutionManager::Abort()
 {
   // TODO(private issue 533): Implement user execution abort
@@ -400,6 +624,8 @@ void ExecutionManager::MonitorThreadEntrypoint()
     case MonitorState::FAILED:
       FETCH_LOG_WARN(LOGGING_NAME, "Execution Engine experience fatal error");
 
+      DrainActiveItems();
+
       state_.ApplyVoid([](Summary &summary) { summary.state = State::EXECUTION_FAILED; });
       monitor_state = MonitorState::IDLE;
       break;
@@ -407,6 +633,8 @@ void ExecutionManager::MonitorThreadEntrypoint()
     case MonitorState::STALLED:
       FETCH_LOG_DEBUG(LOGGING_NAME, "Now Stalled");
 
+      DrainActiveItems();
+
       state_.ApplyVoid([](Summary &summary) { summary.state = State::TRANSACTIONS_UNAVAILABLE; });
       monitor_state = MonitorState::IDLE;
       break;
@@ -424,6 +652,13 @@ void ExecutionManager::MonitorThreadEntrypoint()
 
       state_.ApplyVoid([](Summary &summary) { summary.state = State::IDLE; });
 
+      // the state can be changed by other means between blocks (fee settlement, reverts) so none
+      // of the prefetched values can be carried over to the next block
+      if (prefetcher_)
+      {
+        prefetcher_->Clear();
+      }
+
       FETCH_LOG_DEBUG(LOGGING_NAME, "Now Idle");
 
       // enter the idle state where we wait for the next block to be posted
@@ -463,23 +698,12 @@ void ExecutionManager::MonitorThreadEntrypoint()
       }
       else
       {
-        auto const &slice_plan = execution_plan_[current_slice];
-
-        // determine the target number of executions being expected (must be
-        // done before the thread pool dispatch)
-        counters_.ApplyVoid([&slice_plan](auto &counters) {
-          counters = Counters{0, slice_plan.size()};
-        });
+        // determine the items that can be started along with the target number of executions
+        // being expected (must be done before the executor pool dispatch)
+        ItemList ready{};
+        ScheduleSlice(current_slice, ready);
 
-        auto self = shared_from_this();
-        for (auto &item : slice_plan)
-        {
-          // create the closure and dispatch to the thread pool
-          thread_pool_->Post([self, &item]() {
-            telemetry::FunctionTimer const timer{*(self->execution_duration_)};
-            self->DispatchExecution(*item);
-          });
-        }
+        executor_pool_->Post(ready);
 
         monitor_state = MonitorState::RUNNING;
       }
@@ -586,46 +810,21 @@ void ExecutionManager::MonitorThreadEntrypoint()
 
     case MonitorState::SETTLE_FEES:
     {
-      moment::DeadlineTimer executor_deadline("ExecMgr");
-      executor_deadline.Restart(1000u);
-
-      // In rare cases due to scheduling, no executors might have been returned to the idle queue.
-      // This busy wait loop will catch this event and has a fixed duration.
-      for (;;)
-      {
-        if (executor_deadline.HasExpired())
-        {
-          FETCH_LOG_WARN(LOGGING_NAME, "Unable to locate free executor to settle miner fees");
-          break;
-        }
-
-        // attempt to settle the fees using one of the free executors
-        {
-          FETCH_LOCK(idle_executors_lock_);
-          if (!idle_executors_.empty())
-          {
-            // lookup the last block miner
-            chain::Address last_block_miner;
-            BlockIndex     last_block_number{0};
-
-            // extract the information from the summary structure
-            state_.ApplyVoid([&last_block_miner, &last_block_number](Summary const &summary) {
-              last_block_miner  = summary.last_block_miner;
-              last_block_number = summary.last_block_number;
-            });
-
-            // get the first one and settle the fees
-            idle_executors_.front()->SettleFees(last_block_miner, last_block_number,
-                                                aggregate_block_fees, log2_num_lanes_,
-                                                aggregated_stake_events);
-            fees_settled_count_->increment();
-            break;
-          }
-        }
+      // all the execution items for the block have completed at this point, so the executors are
+      // all idle and one can be borrowed from the pool to settle the fees
+      chain::Address last_block_miner;
+      BlockIndex     last_block_number{0};
+
+      // extract the information from the summary structure
+      state_.ApplyVoid([&last_block_miner, &last_block_number](Summary const &summary) {
+        last_block_miner  = summary.last_block_miner;
+        last_block_number = summary.last_block_number;
+      });
 
-        // due to the race on the idle executors wait here
-        std::this_thread::sleep_for(std::chrono::milliseconds{2});
-      }
+      executor_pool_->executor(0)->SettleFees(last_block_miner, last_block_number,
+                                              aggregate_block_fees, log2_num_lanes_,
+                                              aggregated_stake_events);
+      fees_settled_count_->increment();
 
       // move on to the next state
       monitor_state = MonitorState::BOOKMARKING_STATE;
@@ -27,6 +27,7 @@
 #include "ledger/consensus/stake_update_interface.hpp"
 #include "ledger/executor.hpp"
 #include "ledger/fees/storage_fee.hpp"
+#include "ledger/state_prefetcher.hpp"
 #include "ledger/state_sentinel_adapter.hpp"
 #include "ledger/storage_unit/cached_storage_adapter.hpp"
 #include "telemetry/histogram.hpp"
@@ -106,8 +107,10 @@ Executor::Result Executor::Execute(Digest const &digest, BlockIndex block, Slice
     result.charge_rate  = current_tx_->charge_rate();
     result.charge_limit = current_tx_->charge_limit();
 
-    // create the storage cache
-    storage_cache_ = std::make_shared<CachedStorageAdapter>(*storage_);
+    // create the storage cache, reading through the prefetched state when available
+    StorageInterface &state = prefetcher_ ? static_cast<StorageInterface &>(*prefetcher_)
+                                          : static_cast<StorageInterface &>(*storage_);
+    storage_cache_ = std::make_shared<CachedStorageAdapter>(state);
 
     // follow the three step process for executing a transaction
     //
@@ -179,12 +182,28 @@ void Executor::SettleFees(chain::Address const &miner, BlockIndex block, TokenAm
   FETCH_LOG_TRACE(LOGGING_NAME, "Aggregating stake updates...complete");
 }
 
+void Executor::AttachPrefetcher(StatePrefetcherPtr const &prefetcher)
+{
+  prefetcher_ = prefetcher;
+}
+
 bool Executor::RetrieveTransaction(Digest const &digest)
 {
   telemetry::FunctionTimer const timer{*tx_retrieve_duration_};
 
   bool success{false};
 
+  // the transaction might have already been retrieved ahead of execution
+  if (prefetcher_)
+  {
+    current_tx_ = prefetcher_->TakeTransaction(digest);
+
+    if (current_tx_)
+    {
+      return true;
+    }
+  }
+
   try
   {
     // create a new transaction
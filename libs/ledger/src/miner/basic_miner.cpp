@@ -18,7 +18,6 @@
 
 #include "chain/address.hpp"
 #include "chain/transaction.hpp"
-#include "chain/transaction_validity_period.hpp"
 #include "ledger/chain/block.hpp"
 #include "ledger/chain/main_chain.hpp"
 #include "ledger/miner/basic_miner.hpp"
@@ -27,34 +26,12 @@
 #include "telemetry/gauge.hpp"
 #include "telemetry/registry.hpp"
 
-#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
-#include <iterator>
-#include <thread>
-#include <vector>
 
 namespace fetch {
 namespace ledger {
-namespace {
-
-/**
- * Clip the specified to the bounds: [min_value, max_value]
- *
- * @tparam T The type of the value
- * @param value The input value to be clipped
- * @param min_value The minimum (inclusive) value
- * @param max_value The maximum (inclusive) value
- * @return The clipped value
- */
-template <typename T>
-T Clip3(T value, T min_value, T max_value)
-{
-  return std::min(std::max(value, min_value), max_value);
-}
-
-}  // namespace
 
 /**
  * Construct the BasicMiner
@@ -64,8 +41,7 @@ T Clip3(T value, T min_value, T max_value)
  */
 BasicMiner::BasicMiner(uint32_t log2_num_lanes)
   : log2_num_lanes_{log2_num_lanes}
-  , max_num_threads_{std::thread::hardware_concurrency()}
-  , thread_pool_{max_num_threads_, "Miner"}
+  , mining_pool_{log2_num_lanes}
   , mining_pool_size_{telemetry::Registry::Instance().CreateGauge<uint64_t>(
         "ledger_miner_mining_pool_size", "The current size of the mining pool")}
   , max_mining_pool_size_{telemetry::Registry::Instance().CreateGauge<uint64_t>(
@@ -132,22 +108,21 @@ void BasicMiner::GenerateBlock(Block &block, std::size_t num_lanes, std::size_t
   FETCH_LOCK(mining_pool_lock_);
   assert(num_lanes == (1u << log2_num_lanes_));
 
-  // splice the contents of the pending queue into the main mining pool
+  // take the contents of the pending queue, releasing the lock as quickly as possible
+  Queue incoming{};
   {
     FETCH_LOCK(pending_lock_);
-    mining_pool_.Splice(pending_);
+    incoming.Splice(pending_);
   }
 
-  // generate an invalid transaction set and remove them from the mining pool
-  DigestSet invalid{};
-  for (auto const &layout : mining_pool_)
+  // add the new transactions to the mining pool, the existing contents are already indexed
+  for (auto const &layout : incoming)
   {
-    if (chain::Transaction::Validity::VALID != chain::GetValidity(layout, block.block_number))
-    {
-      invalid.emplace(layout.digest());
-    }
+    mining_pool_.Add(layout);
   }
-  mining_pool_.Remove(invalid);
+
+  // remove the transactions which have expired or are not yet valid for this block
+  mining_pool_.RemoveInvalid(block.block_number);
 
   // detect the transactions which have already been incorporated into previous blocks
   auto const duplicates =
@@ -166,54 +141,18 @@ void BasicMiner::GenerateBlock(Block &block, std::size_t num_lanes, std::size_t
 
   FETCH_LOG_INFO(LOGGING_NAME, "Starting block packing. Pool Size: ", pool_size_before);
 
-  // determine how many of the threads should be used in this block generation
-  auto const num_threads = Clip3<std::size_t>(mining_pool_.size() / 1000u, 1u, max_num_threads_);
-
   // prepare the basic formatting for the block
   block.slices.resize(num_slices);
 
-  // skip thread generation in the simple case
-  if (num_threads == 1)
-  {
-    GenerateSlices(mining_pool_, block, 0, 1, num_lanes);
-  }
-  else if (num_threads > 1)
+  // populate the slices in order, the highest fee transactions are packed first
+  for (auto &slice : block.slices)
   {
-    // split the main queue into a series of smaller queues that can be executed in parallel
-    std::vector<Queue> transaction_lists(num_threads);
-
-    std::size_t const num_tx_per_thread = mining_pool_.size() / num_threads;
-
-    for (std::size_t i = 0; i < num_threads; ++i)
+    if (mining_pool_.empty())
     {
-      Queue &txs = transaction_lists[i];
-
-      auto start = mining_pool_.begin();
-      auto end   = start;
-      // NB: Clang's libc++ incorrectly requires the second argument to be of difference_type
-      // (it is of deduced type in the Standard)
-      std::advance(end, static_cast<int32_t>(std::min(num_tx_per_thread, mining_pool_.size())));
-
-      // TODO(private issue XXX): While this efficiently breaks up the transaction queue into even
-      //  chunks it assumes that the fees of the transactions are roughly the same. This algorithm
-      //  should be updated to maximise collected fees for the miner.
-
-      // splice in the contents of the array
-      txs.Splice(mining_pool_, start, end);
-
-      thread_pool_.Dispatch([&txs, &block, i, num_threads, num_lanes]() {
-        GenerateSlices(txs, block, i, num_threads, num_lanes);
-      });
+      break;
     }
 
-    // wait for all the threads to complete
-    thread_pool_.Wait();
-
-    // return all the transactions to the main queue
-    for (std::size_t i = 0; i < num_threads; ++i)
-    {
-      mining_pool_.Splice(transaction_lists[i]);
-    }
+    mining_pool_.PackSlice(slice);
   }
 
   block.UpdateTimestamp();
@@ -236,89 +175,5 @@ uint64_t BasicMiner::GetBacklog() const
   return mining_pool_.size();
 }
 
-/**
- * Internal: Generate a selection of slices
- *
- * @param transactions The transaction queue to be used when generating the selection of slices
- * @param block The reference to the block to populate
- * @param offset The slice index offset to start from
- * @param interval The slice index interval to be used when selecting the next slice to populate
- * @param num_lanes The number of lanes of the block
- */
-void BasicMiner::GenerateSlices(Queue &transactions, Block &block, std::size_t offset,
-                                std::size_t interval, std::size_t num_lanes)
-{
-  // sort by fees
-  transactions.Sort(SortByFee);
-
-  for (std::size_t slice_idx = offset; slice_idx < block.slices.size(); slice_idx += interval)
-  {
-    auto &slice = block.slices[slice_idx];
-
-    // generate the slice
-    GenerateSlice(transactions, slice, slice_idx, num_lanes);
-  }
-}
-
-/**
- * Internal: Generate a slice
- *
- * @param transactions The transaction queue to be used when generating the slice
- * @param slice The slice to be populated
- * @param slice_index The slice number
- * @param num_lanes The number of lanes for the block
- */
-void BasicMiner::GenerateSlice(Queue &transactions, Block::Slice &      slice,
-                               std::size_t /*slice_index*/, std::size_t num_lanes)
-{
-  BitVector slice_state{num_lanes};
-
-  auto it = transactions.begin();
-  while (it != transactions.end())
-  {
-    // exit the search loop once the slice is full
-    if (slice_state.PopCount() == num_lanes)
-    {
-      break;
-    }
-
-    BitVector const &mask = it->mask();
-
-    // calculate the collisions for this
-    BitVector const collisions = slice_state & mask;
-
-    // determine if there are collisions
-    if (collisions.PopCount() == 0)
-    {
-      // update the slice state
-      slice_state |= mask;
-
-      // insert the transaction into the slice
-      slice.push_back(*it);
-
-      // remove the transaction from the main queue
-      it = transactions.Erase(it);
-    }
-    else
-    {
-      // advance to the next iterator
-      ++it;
-    }
-  }
-}
-
-/**
- * Sorting method for transactions
- *
- * @param a The reference to a transaction entry
- * @param b The reference to the other transaction entry
- * @return true if a is preferable to b, otherwise false
- */
-bool BasicMiner::SortByFee(TransactionLayout const &a, TransactionLayout const &b)
-{
-  // this doesn't seem to the a good metric
-  return a.charge_rate() > b.charge_rate();
-}
-
 }  // namespace ledger
 }  // namespace fetch
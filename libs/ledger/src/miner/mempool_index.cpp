@@ -0,0 +1,376 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction.hpp"
+#include "ledger/miner/mempool_index.hpp"
+#include "vectorise/platform.hpp"
+
+#include <algorithm>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+constexpr uint32_t BITS_PER_WORD = 64u;
+
+/**
+ * Determine the block index from which the layout should be considered valid. Mirrors the fallback
+ * used by chain::GetValidity for layouts which do not specify a valid from field.
+ *
+ * @param layout The layout being examined
+ * @return The effective valid from block index
+ */
+chain::TransactionLayout::BlockIndex EffectiveValidFrom(chain::TransactionLayout const &layout)
+{
+  using chain::Transaction;
+
+  if (layout.valid_from() != 0)
+  {
+    return layout.valid_from();
+  }
+
+  auto const valid_until = layout.valid_until();
+
+  return valid_until >= Transaction::DEFAULT_TX_VALIDITY_PERIOD
+             ? valid_until - Transaction::DEFAULT_TX_VALIDITY_PERIOD
+             : 0u;
+}
+
+}  // namespace
+
+/**
+ * Construct an empty index
+ *
+ * @param log2_num_lanes The log2 of the number of lanes for layouts being stored
+ */
+MempoolIndex::MempoolIndex(uint32_t log2_num_lanes)
+  : num_lanes_{1u << log2_num_lanes}
+  , words_per_mask_{(num_lanes_ + BITS_PER_WORD - 1u) / BITS_PER_WORD}
+  , buckets_(num_lanes_ + 1u)  // the additional bucket holds layouts which use no lanes
+  , slice_state_(words_per_mask_)
+{}
+
+/**
+ * Get the number of layouts stored in the index
+ *
+ * @return The number of layouts
+ */
+std::size_t MempoolIndex::size() const
+{
+  return lookup_.size();
+}
+
+/**
+ * Determine if the index is empty
+ *
+ * @return true if empty, otherwise false
+ */
+bool MempoolIndex::empty() const
+{
+  return lookup_.empty();
+}
+
+/**
+ * Determine if a layout with the specified digest is present in the index
+ *
+ * @param digest The digest to search for
+ * @return true if present, otherwise false
+ */
+bool MempoolIndex::Contains(Digest const &digest) const
+{
+  return lookup_.find(digest) != lookup_.end();
+}
+
+/**
+ * Build the set of all the layouts currently stored in the index
+ *
+ * @return The set of layouts
+ */
+MempoolIndex::TxLayoutSet MempoolIndex::TxLayouts() const
+{
+  TxLayoutSet layouts{};
+  layouts.reserve(lookup_.size());
+
+  // walk the storage in slot order, released slots are identified by an empty digest
+  for (auto const &entry : entries_)
+  {
+    if (!entry.layout.digest().empty())
+    {
+      layouts.emplace(entry.layout);
+    }
+  }
+
+  return layouts;
+}
+
+/**
+ * Add a transaction layout to the index
+ *
+ * Layouts with an incompatible mask, duplicates and layouts whose validity period is too long to
+ * ever be accepted are rejected.
+ *
+ * @param layout The layout to be added
+ * @return true if the layout was added, otherwise false
+ */
+bool MempoolIndex::Add(TransactionLayout const &layout)
+{
+  auto const &mask = layout.mask();
+  if ((mask.size() != num_lanes_) || Contains(layout.digest()))
+  {
+    return false;
+  }
+
+  BlockIndex const valid_from = EffectiveValidFrom(layout);
+  if (layout.valid_until() - valid_from > chain::Transaction::MAXIMUM_TX_VALIDITY_PERIOD)
+  {
+    return false;
+  }
+
+  // allocate the slot for the entry
+  Slot slot{0};
+  if (free_slots_.empty())
+  {
+    slot = static_cast<Slot>(entries_.size());
+    entries_.emplace_back();
+    masks_.resize(masks_.size() + words_per_mask_);
+  }
+  else
+  {
+    slot = free_slots_.back();
+    free_slots_.pop_back();
+  }
+
+  // copy the mask into the flat array, determining the bucket (lowest lane) along the way
+  MaskWord *words     = masks_.data() + (slot * words_per_mask_);
+  uint32_t  bucket    = num_lanes_;
+  uint32_t  num_lanes = 0;
+  for (std::size_t i = 0; i < words_per_mask_; ++i)
+  {
+    words[i] = mask(i);
+
+    if ((bucket == num_lanes_) && (words[i] != 0))
+    {
+      auto const lowest = platform::CountTrailingZeroes64(words[i]);
+      bucket            = static_cast<uint32_t>((i * BITS_PER_WORD) + lowest);
+    }
+
+    num_lanes += static_cast<uint32_t>(platform::CountSetBits(words[i]));
+  }
+
+  Entry &entry     = entries_[slot];
+  entry.layout     = layout;
+  entry.sequence   = next_sequence_++;
+  entry.valid_from = valid_from;
+  entry.num_lanes  = num_lanes;
+  entry.bucket     = bucket;
+
+  // update the indices
+  lookup_.emplace(layout.digest(), slot);
+  buckets_[bucket].insert(KeyOf(slot));
+  expiry_.emplace(layout.valid_until(), slot);
+  activation_.emplace(valid_from, slot);
+
+  return true;
+}
+
+/**
+ * Remove the layout specified by the digest
+ *
+ * @param digest The digest of the layout to be removed
+ * @return true if the layout was removed, otherwise false
+ */
+bool MempoolIndex::Remove(Digest const &digest)
+{
+  auto const it = lookup_.find(digest);
+  if (it == lookup_.end())
+  {
+    return false;
+  }
+
+  Erase(it->second);
+
+  return true;
+}
+
+/**
+ * Remove the set of layouts specified by the input digests
+ *
+ * @param digests The set of digests to be removed
+ * @return The number of layouts removed
+ */
+std::size_t MempoolIndex::Remove(DigestSet const &digests)
+{
+  std::size_t count{0};
+
+  for (auto const &digest : digests)
+  {
+    if (Remove(digest))
+    {
+      ++count;
+    }
+  }
+
+  return count;
+}
+
+/**
+ * Remove all the layouts which are not valid for the specified block index. This is either because
+ * they have expired or because they are not yet active.
+ *
+ * Only the invalid layouts are visited.
+ *
+ * @param block_index The block index being generated
+ * @return The number of layouts removed
+ */
+std::size_t MempoolIndex::RemoveInvalid(BlockIndex block_index)
+{
+  std::size_t count{0};
+
+  // expired layouts: valid_until <= block_index
+  while (!expiry_.empty() && (expiry_.begin()->first <= block_index))
+  {
+    Erase(expiry_.begin()->second);
+    ++count;
+  }
+
+  // pending layouts: valid_from > block_index
+  while (!activation_.empty() && (activation_.rbegin()->first > block_index))
+  {
+    Erase(activation_.rbegin()->second);
+    ++count;
+  }
+
+  return count;
+}
+
+/**
+ * Greedily pack the slice with the highest charge rate layouts that do not collide with each other.
+ * Packed layouts are removed from the index.
+ *
+ * The candidates are visited in the same order as a charge rate sort of the whole pool, but by
+ * merging the bucket heads instead. Once a lane has been claimed the bucket for that lane is
+ * dropped from the merge.
+ *
+ * @param slice The slice to be populated
+ * @return The number of layouts added to the slice
+ */
+std::size_t MempoolIndex::PackSlice(Slice &slice)
+{
+  // orders the heap so that the cursor with the highest priority key is at the front
+  auto const compare = [](Cursor const &a, Cursor const &b) { return *b.first < *a.first; };
+
+  std::fill(slice_state_.begin(), slice_state_.end(), MaskWord{0});
+  selected_.clear();
+  cursors_.clear();
+
+  for (uint32_t bucket = 0; bucket < buckets_.size(); ++bucket)
+  {
+    if (!buckets_[bucket].empty())
+    {
+      cursors_.emplace_back(buckets_[bucket].begin(), bucket);
+    }
+  }
+
+  std::make_heap(cursors_.begin(), cursors_.end(), compare);
+
+  uint32_t lanes_used{0};
+  while (!cursors_.empty() && (lanes_used < num_lanes_))
+  {
+    std::pop_heap(cursors_.begin(), cursors_.end(), compare);
+    Cursor cursor = cursors_.back();
+    cursors_.pop_back();
+
+    uint32_t const bucket = cursor.second;
+
+    // every layout in the bucket uses this lane, if it has been claimed the bucket is exhausted
+    if ((bucket < num_lanes_) &&
+        ((slice_state_[bucket / BITS_PER_WORD] >> (bucket % BITS_PER_WORD)) & 1u))
+    {
+      continue;
+    }
+
+    Slot const      slot = cursor.first->slot;
+    MaskWord const *mask = MaskOf(slot);
+
+    bool collision{false};
+    for (std::size_t i = 0; i < words_per_mask_; ++i)
+    {
+      collision |= (slice_state_[i] & mask[i]) != 0;
+    }
+
+    if (!collision)
+    {
+      for (std::size_t i = 0; i < words_per_mask_; ++i)
+      {
+        slice_state_[i] |= mask[i];
+      }
+
+      lanes_used += entries_[slot].num_lanes;
+      selected_.push_back(slot);
+    }
+
+    // advance the cursor on to the next candidate in the bucket
+    if (++cursor.first != buckets_[bucket].end())
+    {
+      cursors_.push_back(cursor);
+      std::push_heap(cursors_.begin(), cursors_.end(), compare);
+    }
+  }
+
+  // transfer the selected layouts into the slice
+  slice.reserve(slice.size() + selected_.size());
+  for (Slot const slot : selected_)
+  {
+    slice.push_back(entries_[slot].layout);
+    Erase(slot);
+  }
+
+  return selected_.size();
+}
+
+MempoolIndex::Key MempoolIndex::KeyOf(Slot slot) const
+{
+  Entry const &entry = entries_[slot];
+  return {entry.layout.charge_rate(), entry.sequence, slot};
+}
+
+MempoolIndex::MaskWord const *MempoolIndex::MaskOf(Slot slot) const
+{
+  return masks_.data() + (slot * words_per_mask_);
+}
+
+/**
+ * Internal: Remove the entry in the specified slot from all the indices and release the slot
+ *
+ * @param slot The slot to be released
+ */
+void MempoolIndex::Erase(Slot slot)
+{
+  Entry &entry = entries_[slot];
+
+  buckets_[entry.bucket].erase(KeyOf(slot));
+  expiry_.erase({entry.layout.valid_until(), slot});
+  activation_.erase({entry.valid_from, slot});
+  lookup_.erase(entry.layout.digest());
+
+  entry.layout = TransactionLayout{};
+  free_slots_.push_back(slot);
+}
+
+}  // namespace ledger
+}  // namespace fetch
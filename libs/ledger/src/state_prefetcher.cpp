@@ -0,0 +1,394 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction.hpp"
+#include "core/set_thread_name.hpp"
+#include "ledger/state_adapter.hpp"
+#include "ledger/state_prefetcher.hpp"
+#include "logging/logging.hpp"
+#include "telemetry/counter.hpp"
+#include "telemetry/registry.hpp"
+
+#include <chrono>
+#include <exception>
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+using telemetry::Registry;
+
+constexpr char const *TOKEN_CONTRACT_SCOPE = "fetch.token";
+const std::chrono::milliseconds WAIT_TIMEOUT{300};
+
+}  // namespace
+
+/**
+ * Construct the prefetcher
+ *
+ * @param storage The storage unit from which the state and transactions are retrieved
+ */
+StatePrefetcher::StatePrefetcher(StorageUnitPtr storage)
+  : storage_{std::move(storage)}
+  , hit_count_{Registry::Instance().CreateCounter(
+        "ledger_state_prefetch_hit_total", "The total number of state reads served by a prefetch")}
+  , miss_count_{Registry::Instance().CreateCounter(
+        "ledger_state_prefetch_miss_total", "The total number of state reads not prefetched")}
+  , tx_hit_count_{Registry::Instance().CreateCounter(
+        "ledger_state_prefetch_tx_hit_total", "The total number of prefetched transactions used")}
+  , tx_miss_count_{Registry::Instance().CreateCounter(
+        "ledger_state_prefetch_tx_miss_total", "The total number of transactions not prefetched")}
+{}
+
+StatePrefetcher::~StatePrefetcher()
+{
+  Stop();
+}
+
+void StatePrefetcher::Start()
+{
+  if (!running_.exchange(true))
+  {
+    thread_ = std::make_unique<std::thread>(&StatePrefetcher::ThreadEntrypoint, this);
+  }
+}
+
+void StatePrefetcher::Stop()
+{
+  if (running_.exchange(false))
+  {
+    {
+      std::lock_guard<std::mutex> lock(lock_);
+      work_available_.notify_all();
+    }
+
+    thread_->join();
+    thread_.reset();
+  }
+
+  Clear();
+}
+
+/**
+ * Queue a series of transactions for which the state should be warmed up
+ *
+ * @param digests The digests of the transactions
+ */
+void StatePrefetcher::Prefetch(Digests digests)
+{
+  if (digests.empty())
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(lock_);
+  queue_.emplace_back(std::move(digests));
+  work_available_.notify_one();
+}
+
+/**
+ * Take ownership of a prefetched transaction
+ *
+ * @param digest The digest of the transaction
+ * @return The transaction if it has been prefetched, otherwise a null pointer
+ */
+StatePrefetcher::TransactionPtr StatePrefetcher::TakeTransaction(Digest const &digest)
+{
+  TransactionPtr tx{};
+
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+
+    auto it = tx_cache_.find(digest);
+    if (it != tx_cache_.end())
+    {
+      tx = std::move(it->second);
+      tx_cache_.erase(it);
+    }
+  }
+
+  (tx ? tx_hit_count_ : tx_miss_count_)->increment();
+
+  return tx;
+}
+
+/**
+ * Discard all the cached state and transactions along with any queued or in flight prefetches
+ */
+void StatePrefetcher::Clear()
+{
+  std::lock_guard<std::mutex> lock(lock_);
+
+  queue_.clear();
+  state_cache_.clear();
+  tx_cache_.clear();
+
+  // any prefetch which is currently in flight must not populate the caches
+  ++generation_;
+}
+
+/**
+ * Get the number of batches which are either queued or being prefetched
+ *
+ * @return The number of outstanding batches
+ */
+std::size_t StatePrefetcher::pending() const
+{
+  std::lock_guard<std::mutex> lock(lock_);
+  return queue_.size() + in_progress_;
+}
+
+StatePrefetcher::Document StatePrefetcher::Get(ResourceAddress const &key) const
+{
+  Document doc{};
+
+  if (!Lookup(key, doc))
+  {
+    doc = storage_->Get(key);
+  }
+
+  return doc;
+}
+
+StatePrefetcher::Document StatePrefetcher::GetOrCreate(ResourceAddress const &key)
+{
+  Document doc{};
+
+  if (!Lookup(key, doc))
+  {
+    doc = storage_->GetOrCreate(key);
+  }
+
+  return doc;
+}
+
+void StatePrefetcher::Set(ResourceAddress const &key, StateValue const &value)
+{
+  storage_->Set(key, value);
+  Update(key, value);
+}
+
+bool StatePrefetcher::Lock(ShardIndex shard)
+{
+  return storage_->Lock(shard);
+}
+
+bool StatePrefetcher::Unlock(ShardIndex shard)
+{
+  return storage_->Unlock(shard);
+}
+
+void StatePrefetcher::Reset()
+{
+  Clear();
+  storage_->Reset();
+}
+
+StatePrefetcher::Documents StatePrefetcher::GetMany(Addresses const &keys) const
+{
+  Documents docs(keys.size());
+
+  Addresses                missing_keys{};
+  std::vector<std::size_t> missing_indices{};
+
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    if (!Lookup(keys[i], docs[i]))
+    {
+      missing_keys.emplace_back(keys[i]);
+      missing_indices.emplace_back(i);
+    }
+  }
+
+  if (!missing_keys.empty())
+  {
+    auto missing_docs = storage_->GetMany(missing_keys);
+
+    for (std::size_t i = 0; i < missing_docs.size(); ++i)
+    {
+      docs[missing_indices[i]] = std::move(missing_docs[i]);
+    }
+  }
+
+  return docs;
+}
+
+void StatePrefetcher::SetMany(KeyValues const &entries)
+{
+  storage_->SetMany(entries);
+
+  for (auto const &entry : entries)
+  {
+    Update(entry.first, entry.second);
+  }
+}
+
+void StatePrefetcher::ThreadEntrypoint()
+{
+  SetThreadName("ExecPrefetch");
+
+  while (running_)
+  {
+    Digests    digests{};
+    Generation generation{0};
+
+    {
+      std::unique_lock<std::mutex> lock(lock_);
+
+      if (queue_.empty())
+      {
+        work_available_.wait_for(lock, WAIT_TIMEOUT);
+        continue;
+      }
+
+      digests = std::move(queue_.front());
+      queue_.pop_front();
+
+      generation = generation_;
+      ++in_progress_;
+    }
+
+    try
+    {
+      PrefetchBatch(digests, generation);
+    }
+    catch (std::exception const &ex)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Exception caught while prefetching state: ", ex.what());
+    }
+
+    std::lock_guard<std::mutex> lock(lock_);
+    --in_progress_;
+  }
+}
+
+/**
+ * Retrieve a series of transactions along with the state that they are known to access
+ *
+ * @param digests The digests of the transactions
+ * @param generation The generation of the caches when the batch was started
+ */
+void StatePrefetcher::PrefetchBatch(Digests const &digests, Generation generation)
+{
+  TransactionCache txs{};
+  Addresses        keys{};
+
+  for (auto const &digest : digests)
+  {
+    auto tx = std::make_shared<chain::Transaction>();
+    if (!storage_->GetTransaction(digest, *tx))
+    {
+      continue;
+    }
+
+    // the wallets of the sender and the transfer recipients are always accessed, at the very
+    // least in order to deduct the fees
+    keys.emplace_back(StateAdapter::CreateAddress(TOKEN_CONTRACT_SCOPE, tx->from().display()));
+    for (auto const &transfer : tx->transfers())
+    {
+      keys.emplace_back(StateAdapter::CreateAddress(TOKEN_CONTRACT_SCOPE, transfer.to.display()));
+    }
+
+    txs.emplace(digest, std::move(tx));
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+
+    if (generation != generation_)
+    {
+      return;
+    }
+
+    tx_cache_.insert(txs.begin(), txs.end());
+  }
+
+  if (!keys.empty())
+  {
+    Insert(keys, storage_->GetMany(keys), generation);
+  }
+}
+
+/**
+ * Look up a resource in the cache
+ *
+ * @param key The resource address
+ * @param doc The document to be populated
+ * @return true if the resource was cached, otherwise false
+ */
+bool StatePrefetcher::Lookup(ResourceAddress const &key, Document &doc) const
+{
+  bool found{false};
+
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+
+    auto it = state_cache_.find(key);
+    if (it != state_cache_.end())
+    {
+      doc.document = it->second;
+      found        = true;
+    }
+  }
+
+  (found ? hit_count_ : miss_count_)->increment();
+
+  return found;
+}
+
+/**
+ * Add prefetched values to the cache. Any value which is already present has been written since
+ * the prefetch was issued and therefore is not replaced.
+ *
+ * @param keys The resource addresses
+ * @param docs The corresponding documents
+ * @param generation The generation of the caches when the prefetch was started
+ */
+void StatePrefetcher::Insert(Addresses const &keys, Documents const &docs, Generation generation)
+{
+  std::lock_guard<std::mutex> lock(lock_);
+
+  if (generation != generation_)
+  {
+    return;
+  }
+
+  for (std::size_t i = 0; i < keys.size() && i < docs.size(); ++i)
+  {
+    if (!docs[i].failed)
+    {
+      state_cache_.emplace(keys[i], docs[i].document);
+    }
+  }
+}
+
+/**
+ * Update the cache with a value which has been written to the storage
+ *
+ * @param key The resource address
+ * @param value The value which has been written
+ */
+void StatePrefetcher::Update(ResourceAddress const &key, StateValue const &value)
+{
+  std::lock_guard<std::mutex> lock(lock_);
+  state_cache_[key] = value;
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -19,6 +19,9 @@
 #include "ledger/storage_unit/cached_storage_adapter.hpp"
 
 #include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
 
 namespace fetch {
 namespace ledger {
@@ -38,22 +41,30 @@ CachedStorageAdapter::CachedStorageAdapter(StorageInterface &storage)
 CachedStorageAdapter::~CachedStorageAdapter() = default;
 
 /**
- * Trigger a flush of the cached entries to the storage engine
+ * Trigger a flush of the cached entries to the storage engine. All the pending entries are handed
+ * to the storage engine as a single batch
  */
 void CachedStorageAdapter::Flush()
 {
   cache_.ApplyVoid([this](auto &cache) {
+    KeyValues entries{};
+
     for (auto &entry : cache)
     {
       if (!entry.second.flushed)
       {
-        // set the value on the storage engine
-        storage_.Set(entry.first, entry.second.value);
+        entries.emplace_back(entry.first, entry.second.value);
 
         // signal the entry as flushed
         entry.second.flushed = true;
       }
     }
+
+    if (!entries.empty())
+    {
+      // set the values on the storage engine
+      storage_.SetMany(entries);
+    }
   });
 }
 
@@ -96,6 +107,55 @@ CachedStorageAdapter::Document CachedStorageAdapter::Get(ResourceAddress const &
   return result;
 }
 
+/**
+ * Get a series of resources from the storage engine or cache. Only the keys which are not
+ * present in the cache are requested from the storage engine, as a single batch
+ *
+ * @param keys The keys to be accessed
+ * @return The documents containing the results, in the same order as the keys
+ */
+CachedStorageAdapter::Documents CachedStorageAdapter::GetMany(Addresses const &keys) const
+{
+  Documents results(keys.size());
+
+  Addresses                missing_keys{};
+  std::vector<std::size_t> missing_indices{};
+
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    if (HasCacheEntry(keys[i]))
+    {
+      // retrieve the document directly from the cache
+      results[i].document = GetCacheEntry(keys[i]);
+    }
+    else
+    {
+      missing_keys.emplace_back(keys[i]);
+      missing_indices.emplace_back(i);
+    }
+  }
+
+  if (!missing_keys.empty())
+  {
+    // not in the cache need to retrieve
+    auto docs = storage_.GetMany(missing_keys);
+    assert(docs.size() == missing_keys.size());
+
+    for (std::size_t i = 0; i < docs.size(); ++i)
+    {
+      if (!docs[i].failed)
+      {
+        // update the result
+        AddCacheEntry(missing_keys[i], docs[i].document);
+      }
+
+      results[missing_indices[i]] = std::move(docs[i]);
+    }
+  }
+
+  return results;
+}
+
 /**
  * Get or Create a resource in the storage engine
  *
@@ -24,7 +24,9 @@
 #include "ledger/storage_unit/transaction_finder_protocol.hpp"
 #include "ledger/storage_unit/transaction_storage_protocol.hpp"
 
+#include <algorithm>
 #include <cstddef>
+#include <deque>
 #include <iterator>
 #include <map>
 #include <memory>
@@ -58,6 +60,91 @@ AddressList GenerateAddressList(ShardConfigs const &shards)
 constexpr char const *MERKLE_FILENAME_DOC   = "merkle_stack.db";
 constexpr char const *MERKLE_FILENAME_INDEX = "merkle_stack_index.db";
 
+constexpr std::size_t MAX_BATCH_SIZE       = 256;  ///< The max number of keys in a single request
+constexpr std::size_t MAX_PENDING_REQUESTS = 8;    ///< The max number of batches in flight
+
+using Indices = std::vector<std::size_t>;
+using Batch   = std::pair<uint32_t, Indices>;
+using Batches = std::vector<Batch>;
+
+/**
+ * Split a series of keyed items into bounded, per lane batches. The batches are interleaved
+ * across the lanes so that the requests in flight are spread over as many lanes as possible.
+ *
+ * @param items The items to be batched
+ * @param key_of The function mapping an item to its resource key
+ * @param log2_num_lanes The log2 of the number of lanes
+ * @return The lane and item indices of each batch
+ */
+template <typename Items, typename KeyOf>
+Batches GroupByLane(Items const &items, KeyOf &&key_of, uint32_t log2_num_lanes)
+{
+  std::vector<Indices> lanes(std::size_t{1} << log2_num_lanes);
+  for (std::size_t i = 0; i < items.size(); ++i)
+  {
+    lanes[key_of(items[i]).lane(log2_num_lanes)].push_back(i);
+  }
+
+  Batches batches{};
+  for (std::size_t offset = 0;; offset += MAX_BATCH_SIZE)
+  {
+    bool more{false};
+    for (uint32_t lane = 0; lane < lanes.size(); ++lane)
+    {
+      auto const &indices = lanes[lane];
+      if (offset < indices.size())
+      {
+        auto const begin = indices.begin() + static_cast<std::ptrdiff_t>(offset);
+        auto const count = std::min(MAX_BATCH_SIZE, indices.size() - offset);
+
+        batches.emplace_back(lane, Indices(begin, begin + static_cast<std::ptrdiff_t>(count)));
+        more = true;
+      }
+    }
+
+    if (!more)
+    {
+      break;
+    }
+  }
+
+  return batches;
+}
+
+/**
+ * Issue a series of batched requests keeping at most MAX_PENDING_REQUESTS of them in flight. The
+ * responses are handed to the completion handler in the order that the requests were issued.
+ *
+ * @param batches The batches to be requested
+ * @param issue The handler making the request for a batch, returns a null promise on failure
+ * @param complete The handler processing the response for a batch
+ */
+template <typename Issue, typename Complete>
+void PipelineRequests(Batches const &batches, Issue &&issue, Complete &&complete)
+{
+  std::deque<std::pair<Promise, Batch const *>> pending{};
+
+  auto const complete_oldest = [&pending, &complete]() {
+    complete(pending.front().first, *pending.front().second);
+    pending.pop_front();
+  };
+
+  for (auto const &batch : batches)
+  {
+    if (pending.size() >= MAX_PENDING_REQUESTS)
+    {
+      complete_oldest();
+    }
+
+    pending.emplace_back(issue(batch), &batch);
+  }
+
+  while (!pending.empty())
+  {
+    complete_oldest();
+  }
+}
+
 }  // namespace
 
 StorageUnitClient::StorageUnitClient(MuddleEndpoint &muddle, ShardConfigs const &shards,
@@ -511,6 +598,111 @@ void StorageUnitClient::Set(ResourceAddress const &key, StateValue const &value)
   }
 }
 
+StorageUnitClient::Documents StorageUnitClient::GetMany(Addresses const &keys) const
+{
+  Documents docs(keys.size());
+
+  auto const batches =
+      GroupByLane(keys, [](ResourceAddress const &key) -> ResourceID const & { return key; },
+                  log2_num_lanes_);
+
+  auto const issue = [this, &keys](Batch const &batch) -> Promise {
+    std::vector<ResourceID> rids{};
+    rids.reserve(batch.second.size());
+    for (auto const index : batch.second)
+    {
+      rids.emplace_back(keys[index].as_resource_id());
+    }
+
+    try
+    {
+      return rpc_client_->CallSpecificAddress(LookupAddress(batch.first), RPC_STATE,
+                                              RevertibleDocumentStoreProtocol::GET_MANY, rids);
+    }
+    catch (std::exception const &e)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Failed to call GET_MANY, because: ", e.what());
+    }
+
+    return {};
+  };
+
+  auto const complete = [&docs](Promise const &promise, Batch const &batch) {
+    auto const &indices = batch.second;
+
+    Documents results{};
+    if (promise && promise->GetResult(results) && (results.size() == indices.size()))
+    {
+      for (std::size_t i = 0; i < indices.size(); ++i)
+      {
+        docs[indices[i]] = std::move(results[i]);
+      }
+    }
+    else
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Unable to get ", indices.size(), " documents from lane ",
+                     batch.first);
+
+      // signal the failure
+      for (auto const index : indices)
+      {
+        docs[index].failed = true;
+      }
+    }
+  };
+
+  PipelineRequests(batches, issue, complete);
+
+  return docs;
+}
+
+void StorageUnitClient::SetMany(KeyValues const &entries)
+{
+  auto const batches = GroupByLane(
+      entries, [](KeyValues::value_type const &entry) -> ResourceID const & { return entry.first; },
+      log2_num_lanes_);
+
+  auto const issue = [this, &entries](Batch const &batch) -> Promise {
+    RevertibleDocumentStoreProtocol::KeyValues values{};
+    values.reserve(batch.second.size());
+    for (auto const index : batch.second)
+    {
+      values.emplace_back(entries[index].first.as_resource_id(), entries[index].second);
+    }
+
+    try
+    {
+      return rpc_client_->CallSpecificAddress(LookupAddress(batch.first), RPC_STATE,
+                                              RevertibleDocumentStoreProtocol::SET_MANY, values);
+    }
+    catch (std::exception const &e)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Failed to call SET_MANY, because: ", e.what());
+    }
+
+    return {};
+  };
+
+  auto const complete = [](Promise const &promise, Batch const &batch) {
+    try
+    {
+      if (promise && promise->Wait())
+      {
+        return;
+      }
+    }
+    catch (std::exception const &e)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Failed to call SET_MANY, because: ", e.what());
+    }
+
+    FETCH_LOG_WARN(LOGGING_NAME, "Unable to set ", batch.second.size(), " documents on lane ",
+                   batch.first);
+  };
+
+  PipelineRequests(batches, issue, complete);
+}
+
 bool StorageUnitClient::Lock(ShardIndex index)
 {
   bool success{false};
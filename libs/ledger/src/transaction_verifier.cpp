@@ -19,6 +19,7 @@
 #include "chain/transaction.hpp"
 #include "core/set_thread_name.hpp"
 #include "core/string/to_lower.hpp"
+#include "crypto/batch_verifier.hpp"
 #include "ledger/storage_unit/transaction_sinks.hpp"
 #include "ledger/transaction_verifier.hpp"
 #include "logging/logging.hpp"
@@ -40,6 +41,7 @@ using telemetry::Registry;
 
 constexpr char const *          LOGGING_NAME = "TxVerifier";
 const std::chrono::milliseconds POP_TIMEOUT{300};
+const std::chrono::milliseconds BATCH_POP_TIMEOUT{0};
 
 std::string CreateMetricName(std::string const &prefix, std::string const &name)
 {
@@ -81,10 +83,12 @@ telemetry::CounterPtr CreateCounter(std::string const &prefix, std::string const
  * @param sink The destination for verified transactions
  * @param verifying_threads The number of verifying threads to be used
  * @param name The name of the verifier
+ * @param batch_size The maximum number of transactions to be verified together by each thread
  */
 TransactionVerifier::TransactionVerifier(TransactionSink &sink, std::size_t verifying_threads,
-                                         std::string const &name)
+                                         std::string const &name, std::size_t batch_size)
   : verifying_threads_(verifying_threads)
+  , batch_size_(std::max<std::size_t>(batch_size, 1u))
   , name_(name)
   , sink_(sink)
   , unverified_queue_length_(
@@ -103,6 +107,8 @@ TransactionVerifier::TransactionVerifier(TransactionSink &sink, std::size_t veri
                                       "The total number of verified transactions seen"))
   , dispatched_tx_total_(CreateCounter(name, "dispatched_transactions_total",
                                        "The total number of verified that have been dispatched"))
+  , verified_batches_total_(CreateCounter(name, "verified_batches_total",
+                                          "The total number of verification batches processed"))
   , num_threads_(CreateGauge(name, "threads", "The current number of processing threads in use"))
 {
   // since these lengths are fixed
@@ -180,36 +186,59 @@ void TransactionVerifier::AddTransaction(TransactionPtr &&tx)
 }
 
 /**
- * Internal: Thread process for the verification of
+ * Internal: Thread process for the verification of transactions
+ *
+ * Each thread waits for a transaction to be available and then greedily collects up to the batch
+ * size of transactions which are already queued. The whole batch is then verified together.
  */
 void TransactionVerifier::Verifier()
 {
-  TransactionPtr tx;
+  TransactionPtr        tx;
+  TransactionList       batch{};
+  crypto::BatchVerifier batch_verifier{};
+
+  batch.reserve(batch_size_);
 
   while (active_)
   {
     try
     {
       // wait for a mutable transaction to be available
-      if (unverified_queue_.Pop(tx, POP_TIMEOUT))
+      if (!unverified_queue_.Pop(tx, POP_TIMEOUT))
       {
-        unverified_queue_length_->decrement();
+        continue;
+      }
 
-        FETCH_LOG_DEBUG(LOGGING_NAME, "Verifying TX: 0x", tx->digest().ToHex());
+      // collect any other transactions which are immediately available
+      batch.clear();
+      batch.emplace_back(std::move(tx));
+      while ((batch.size() < batch_size_) && unverified_queue_.Pop(tx, BATCH_POP_TIMEOUT))
+      {
+        batch.emplace_back(std::move(tx));
+      }
 
-        // check the status
-        if (tx->Verify())
+      unverified_queue_length_->decrement(batch.size());
+
+      FETCH_LOG_DEBUG(LOGGING_NAME, "Verifying batch of ", batch.size(), " TXs");
+
+      // check the status
+      chain::Transaction::Verify(batch, batch_verifier);
+      verified_batches_total_->increment();
+
+      for (auto &verified_tx : batch)
+      {
+        if (verified_tx->IsVerified())
         {
-          FETCH_LOG_DEBUG(LOGGING_NAME, "TX Verify Complete: 0x", tx->digest().ToHex());
+          FETCH_LOG_DEBUG(LOGGING_NAME, "TX Verify Complete: 0x", verified_tx->digest().ToHex());
 
-          verified_queue_.Push(std::move(tx));
+          verified_queue_.Push(std::move(verified_tx));
           verified_queue_length_->increment();
           verified_tx_total_->increment();
         }
         else
         {
           FETCH_LOG_WARN(LOGGING_NAME, name_ + " Unable to verify transaction: 0x",
-                         tx->digest().ToHex());
+                         verified_tx->digest().ToHex());
 
           discarded_tx_total_->increment();
         }
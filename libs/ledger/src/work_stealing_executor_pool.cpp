@@ -0,0 +1,252 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/set_thread_name.hpp"
+#include "ledger/execution_item.hpp"
+#include "ledger/work_stealing_executor_pool.hpp"
+
+#include <cassert>
+#include <stdexcept>
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Construct the pool, one worker is created for each of the executors provided
+ *
+ * @param executors The set of executors to be pinned to the workers
+ * @param handler The handler to be called by the worker to execute an item
+ * @param name The prefix for the worker thread names
+ */
+WorkStealingExecutorPool::WorkStealingExecutorPool(ExecutorList executors, ExecuteHandler handler,
+                                                   std::string name)
+  : handler_{std::move(handler)}
+  , name_{std::move(name)}
+{
+  if (executors.empty())
+  {
+    throw std::runtime_error("Unable to create executor pool without executors");
+  }
+
+  workers_.reserve(executors.size());
+  for (auto &executor : executors)
+  {
+    assert(static_cast<bool>(executor));
+    workers_.emplace_back(std::make_unique<Worker>(std::move(executor)));
+  }
+}
+
+WorkStealingExecutorPool::~WorkStealingExecutorPool()
+{
+  Stop();
+}
+
+/**
+ * Start all the worker threads
+ */
+void WorkStealingExecutorPool::Start()
+{
+  bool expected{false};
+  if (!running_.compare_exchange_strong(expected, true))
+  {
+    return;
+  }
+
+  for (std::size_t i = 0; i < workers_.size(); ++i)
+  {
+    workers_[i]->thread =
+        std::make_unique<std::thread>(&WorkStealingExecutorPool::WorkerLoop, this, i);
+  }
+}
+
+/**
+ * Stop all the worker threads. Any items which have not been started are discarded
+ */
+void WorkStealingExecutorPool::Stop()
+{
+  bool expected{true};
+  if (!running_.compare_exchange_strong(expected, false))
+  {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(idle_lock_);
+    work_available_.notify_all();
+  }
+
+  for (auto &worker : workers_)
+  {
+    if (worker->thread)
+    {
+      worker->thread->join();
+      worker->thread.reset();
+    }
+
+    FETCH_LOCK(worker->lock);
+    pending_ -= worker->queue.size();
+    worker->queue.clear();
+  }
+}
+
+/**
+ * Post a single item for execution
+ *
+ * @param item The item to be executed. Must remain valid until it has been executed
+ */
+void WorkStealingExecutorPool::Post(ExecutionItem &item)
+{
+  Enqueue(item);
+
+  {
+    std::lock_guard<std::mutex> lock(idle_lock_);
+  }
+  work_available_.notify_one();
+}
+
+/**
+ * Post a series of items for execution. The items are distributed across the workers
+ *
+ * @param items The items to be executed. Must remain valid until they have been executed
+ */
+void WorkStealingExecutorPool::Post(ItemList const &items)
+{
+  if (items.empty())
+  {
+    return;
+  }
+
+  for (auto *item : items)
+  {
+    assert(item != nullptr);
+    Enqueue(*item);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(idle_lock_);
+  }
+  work_available_.notify_all();
+}
+
+std::size_t WorkStealingExecutorPool::size() const
+{
+  return workers_.size();
+}
+
+std::size_t WorkStealingExecutorPool::pending() const
+{
+  return pending_;
+}
+
+std::size_t WorkStealingExecutorPool::steal_count() const
+{
+  return steals_;
+}
+
+/**
+ * Access the executor pinned to a given worker. Callers must ensure that the pool is not
+ * executing any items while they use the executor
+ *
+ * @param index The index of the worker
+ * @return The executor of that worker
+ */
+WorkStealingExecutorPool::ExecutorPtr &WorkStealingExecutorPool::executor(std::size_t index)
+{
+  return workers_.at(index)->executor;
+}
+
+void WorkStealingExecutorPool::Enqueue(ExecutionItem &item)
+{
+  std::size_t const index = next_worker_++ % workers_.size();
+  auto &            worker{*workers_[index]};
+
+  FETCH_LOCK(worker.lock);
+  worker.queue.push_back(&item);
+  ++pending_;
+}
+
+ExecutionItem *WorkStealingExecutorPool::PopLocal(std::size_t index)
+{
+  auto &worker{*workers_[index]};
+
+  FETCH_LOCK(worker.lock);
+  if (worker.queue.empty())
+  {
+    return nullptr;
+  }
+
+  auto *item = worker.queue.front();
+  worker.queue.pop_front();
+  --pending_;
+
+  return item;
+}
+
+ExecutionItem *WorkStealingExecutorPool::Steal(std::size_t thief)
+{
+  std::size_t const num_workers = workers_.size();
+
+  for (std::size_t offset = 1; offset < num_workers; ++offset)
+  {
+    auto &victim{*workers_[(thief + offset) % num_workers]};
+
+    FETCH_LOCK(victim.lock);
+    if (!victim.queue.empty())
+    {
+      auto *item = victim.queue.back();
+      victim.queue.pop_back();
+      --pending_;
+      ++steals_;
+
+      return item;
+    }
+  }
+
+  return nullptr;
+}
+
+void WorkStealingExecutorPool::WorkerLoop(std::size_t index)
+{
+  SetThreadName(name_, index);
+
+  auto &executor{*workers_[index]->executor};
+
+  while (running_)
+  {
+    // prefer local work, otherwise attempt to steal from one of the other workers
+    ExecutionItem *item = PopLocal(index);
+    if (item == nullptr)
+    {
+      item = Steal(index);
+    }
+
+    if (item != nullptr)
+    {
+      handler_(executor, *item);
+      continue;
+    }
+
+    // no work could be found, wait for some to arrive
+    std::unique_lock<std::mutex> lock(idle_lock_);
+    work_available_.wait(lock, [this]() { return !running_ || (pending_ > 0); });
+  }
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -36,6 +36,7 @@
 #include <memory>
 #include <random>
 #include <sstream>
+#include <tuple>
 #include <vector>
 
 namespace {
@@ -48,6 +49,7 @@ using fetch::ledger::BlockStatus;
 using fetch::ledger::testing::BlockGenerator;
 
 using Rng               = std::mt19937_64;
+using MainChainConfig   = std::tuple<MainChain::Mode, MainChain::StoreType>;
 using MainChainPtr      = std::unique_ptr<MainChain>;
 using BlockGeneratorPtr = std::unique_ptr<BlockGenerator>;
 using BlockPtr          = BlockGenerator::BlockPtr;
@@ -106,7 +108,7 @@ std::string Hashes(std::vector<BlockPtr> const &v)
   return ret_val.str();
 }
 
-class MainChainTests : public ::testing::TestWithParam<MainChain::Mode>
+class MainChainTests : public ::testing::TestWithParam<MainChainConfig>
 {
 public:
   static void SetUpTestCase()
@@ -121,9 +123,10 @@ protected:
     static constexpr std::size_t NUM_LANES  = 1;
     static constexpr std::size_t NUM_SLICES = 2;
 
-    auto const main_chain_mode = GetParam();
+    auto const main_chain_mode       = std::get<0>(GetParam());
+    auto const main_chain_store_type = std::get<1>(GetParam());
 
-    chain_     = std::make_unique<MainChain>(main_chain_mode);
+    chain_     = std::make_unique<MainChain>(main_chain_mode, false, main_chain_store_type);
     generator_ = std::make_unique<BlockGenerator>(NUM_LANES, NUM_SLICES);
   }
 
@@ -995,8 +998,11 @@ TEST_P(MainChainTests, AddingBlockWithDuplicateTxInSameBlockFails)
   ASSERT_EQ(chain_->GetHeaviestBlockHash(), genesis->hash);
 }
 
-INSTANTIATE_TEST_SUITE_P(ParamBased, MainChainTests,
-                         ::testing::Values(MainChain::Mode::CREATE_PERSISTENT_DB,
-                                           MainChain::Mode::IN_MEMORY_DB));
+INSTANTIATE_TEST_SUITE_P(
+    ParamBased, MainChainTests,
+    ::testing::Values(
+        MainChainConfig{MainChain::Mode::CREATE_PERSISTENT_DB, MainChain::StoreType::OBJECT_STORE},
+        MainChainConfig{MainChain::Mode::CREATE_PERSISTENT_DB, MainChain::StoreType::MAPPED_LOG},
+        MainChainConfig{MainChain::Mode::IN_MEMORY_DB, MainChain::StoreType::OBJECT_STORE}));
 
 }  // namespace
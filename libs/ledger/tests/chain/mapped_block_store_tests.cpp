@@ -0,0 +1,305 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/constants.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/block_db_record.hpp"
+#include "ledger/chain/mapped_block_store.hpp"
+#include "storage/storage_exception.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace fetch;
+using namespace fetch::ledger;
+
+using BlockStorePtr = std::unique_ptr<MappedBlockStore>;
+
+constexpr char const *PREFIX = "mapped_block_store_tests";
+
+class MappedBlockStoreTests : public ::testing::Test
+{
+public:
+  static void SetUpTestCase()
+  {
+    chain::InitialiseTestConstants();
+  }
+
+protected:
+  static constexpr std::size_t SMALL_SEGMENT_SIZE = 4096;
+
+  void SetUp() override
+  {
+    store_ = std::make_unique<MappedBlockStore>(PREFIX, SMALL_SEGMENT_SIZE);
+    store_->New();
+  }
+
+  void TearDown() override
+  {
+    store_->New();
+    store_.reset();
+
+    std::remove((std::string{PREFIX} + ".headers.db").c_str());
+    std::remove((std::string{PREFIX} + ".hash_index.db").c_str());
+  }
+
+  void Reload()
+  {
+    store_->Flush();
+    store_ = std::make_unique<MappedBlockStore>(PREFIX, SMALL_SEGMENT_SIZE);
+    store_->Load();
+  }
+
+  static std::vector<Block> GenerateChain(std::size_t length)
+  {
+    std::vector<Block> blocks(length);
+
+    BlockHash previous_hash = chain::ZERO_HASH;
+    for (std::size_t i = 0; i < length; ++i)
+    {
+      auto &block = blocks[i];
+
+      block.previous_hash = previous_hash;
+      block.merkle_hash   = byte_array::ByteArray(std::string(32, static_cast<char>('a' + i % 26)));
+      block.block_number  = i;
+      block.weight        = 1 + (i % 7);
+      block.total_weight  = i * 3;
+      block.timestamp     = 1000 + i;
+
+      if (i == 0)
+      {
+        block.hash = chain::GetGenesisDigest();
+      }
+      else
+      {
+        block.UpdateDigest();
+      }
+
+      previous_hash = block.hash;
+    }
+
+    return blocks;
+  }
+
+  void Store(std::vector<Block> const &blocks)
+  {
+    for (auto const &block : blocks)
+    {
+      BlockDbRecord record;
+      record.block = block;
+      store_->Set(record);
+    }
+  }
+
+  void ExpectStored(std::vector<Block> const &blocks)
+  {
+    for (auto const &block : blocks)
+    {
+      BlockDbRecord record;
+      ASSERT_TRUE(store_->Get(block.hash, record));
+      EXPECT_EQ(record.block.hash, block.hash);
+      EXPECT_EQ(record.block.previous_hash, block.previous_hash);
+      EXPECT_EQ(record.block.merkle_hash, block.merkle_hash);
+      EXPECT_EQ(record.block.block_number, block.block_number);
+      EXPECT_EQ(record.block.timestamp, block.timestamp);
+
+      BlockHeaderRecord header;
+      ASSERT_TRUE(store_->GetHeader(block.hash, header));
+      EXPECT_EQ(header.hash, block.hash);
+      EXPECT_EQ(header.previous_hash, block.previous_hash);
+      EXPECT_EQ(header.block_number, block.block_number);
+      EXPECT_EQ(header.weight, block.weight);
+      EXPECT_EQ(header.total_weight, block.total_weight);
+    }
+  }
+
+  BlockStorePtr store_;
+};
+
+TEST_F(MappedBlockStoreTests, CheckEmptyStore)
+{
+  auto const blocks = GenerateChain(1);
+
+  BlockDbRecord     record;
+  BlockHeaderRecord header;
+
+  EXPECT_EQ(store_->size(), 0);
+  EXPECT_FALSE(store_->Has(blocks[0].hash));
+  EXPECT_FALSE(store_->Get(blocks[0].hash, record));
+  EXPECT_FALSE(store_->GetHeader(blocks[0].hash, header));
+  EXPECT_FALSE(store_->SetNextHash(blocks[0].hash, blocks[0].hash));
+}
+
+TEST_F(MappedBlockStoreTests, CheckBlocksAreStored)
+{
+  auto const blocks = GenerateChain(100);
+  Store(blocks);
+
+  EXPECT_EQ(store_->size(), blocks.size());
+  EXPECT_GT(store_->num_segments(), 1);
+
+  for (auto const &block : blocks)
+  {
+    EXPECT_TRUE(store_->Has(block.hash));
+  }
+
+  ExpectStored(blocks);
+
+  // storing a block again does not add a duplicate
+  Store({blocks[10]});
+  EXPECT_EQ(store_->size(), blocks.size());
+}
+
+TEST_F(MappedBlockStoreTests, CheckForwardReferences)
+{
+  auto const blocks = GenerateChain(3);
+  Store(blocks);
+
+  BlockHeaderRecord header;
+  ASSERT_TRUE(store_->GetHeader(blocks[0].hash, header));
+  EXPECT_TRUE(header.next_hash.empty());
+  EXPECT_TRUE(header.IsGenesis());
+
+  ASSERT_TRUE(store_->SetNextHash(blocks[0].hash, blocks[1].hash));
+  ASSERT_TRUE(store_->GetHeader(blocks[0].hash, header));
+  EXPECT_EQ(header.next_hash, blocks[1].hash);
+
+  // rewriting the record of the block updates the forward reference
+  BlockDbRecord record;
+  record.block     = blocks[1];
+  record.next_hash = blocks[2].hash;
+  store_->Set(record);
+
+  ASSERT_TRUE(store_->Get(blocks[1].hash, record));
+  EXPECT_EQ(record.next_hash, blocks[2].hash);
+  EXPECT_EQ(store_->size(), blocks.size());
+}
+
+TEST_F(MappedBlockStoreTests, CheckWalkingTheChain)
+{
+  auto const blocks = GenerateChain(50);
+  Store(blocks);
+
+  BlockHeaderRecord header;
+  ASSERT_TRUE(store_->GetHeader(blocks.back().hash, header));
+
+  std::size_t steps{0};
+  while (!header.IsGenesis())
+  {
+    ASSERT_TRUE(store_->GetHeader(header.previous_hash, header));
+    ++steps;
+  }
+
+  EXPECT_EQ(steps, blocks.size() - 1);
+  EXPECT_EQ(header.hash, blocks.front().hash);
+}
+
+TEST_F(MappedBlockStoreTests, CheckReload)
+{
+  auto const blocks = GenerateChain(5000);
+  Store(blocks);
+  ASSERT_TRUE(store_->SetNextHash(blocks[7].hash, blocks[8].hash));
+
+  Reload();
+
+  EXPECT_EQ(store_->size(), blocks.size());
+  ExpectStored(blocks);
+
+  BlockHeaderRecord header;
+  ASSERT_TRUE(store_->GetHeader(blocks[7].hash, header));
+  EXPECT_EQ(header.next_hash, blocks[8].hash);
+
+  // the store can continue to be appended to after it has been loaded
+  auto const more_blocks = GenerateChain(5001);
+  Store({more_blocks.back()});
+  EXPECT_EQ(store_->size(), blocks.size() + 1);
+
+  Reload();
+  ExpectStored(blocks);
+  ExpectStored({more_blocks.back()});
+}
+
+TEST_F(MappedBlockStoreTests, CheckIndexIsRebuiltOnLoad)
+{
+  auto const blocks = GenerateChain(200);
+  Store(blocks);
+  store_->Flush();
+  store_.reset();
+
+  std::remove((std::string{PREFIX} + ".hash_index.db").c_str());
+
+  store_ = std::make_unique<MappedBlockStore>(PREFIX, SMALL_SEGMENT_SIZE);
+  store_->Load();
+
+  EXPECT_EQ(store_->size(), blocks.size());
+  ExpectStored(blocks);
+}
+
+TEST_F(MappedBlockStoreTests, CheckDamagedSegmentIsNotDiscardedOnLoad)
+{
+  auto const blocks = GenerateChain(200);
+  Store(blocks);
+  store_->Flush();
+  store_.reset();
+
+  // replace the first segment with an empty file
+  std::string const segment_filename = std::string{PREFIX} + ".segment.0.db";
+  std::string const backup_filename  = segment_filename + ".backup";
+
+  ASSERT_EQ(0, std::rename(segment_filename.c_str(), backup_filename.c_str()));
+  std::ofstream{segment_filename, std::ios::binary | std::ios::trunc};
+
+  store_ = std::make_unique<MappedBlockStore>(PREFIX, SMALL_SEGMENT_SIZE);
+  EXPECT_THROW(store_->Load(), storage::StorageException);
+
+  // once the segment is restored all of the blocks are still there
+  ASSERT_EQ(0, std::rename(backup_filename.c_str(), segment_filename.c_str()));
+
+  store_ = std::make_unique<MappedBlockStore>(PREFIX, SMALL_SEGMENT_SIZE);
+  store_->Load();
+
+  EXPECT_EQ(store_->size(), blocks.size());
+  ExpectStored(blocks);
+}
+
+TEST_F(MappedBlockStoreTests, CheckNewDiscardsContents)
+{
+  auto const blocks = GenerateChain(100);
+  Store(blocks);
+
+  store_->New();
+
+  EXPECT_EQ(store_->size(), 0);
+  EXPECT_EQ(store_->num_segments(), 0);
+  EXPECT_FALSE(store_->Has(blocks[0].hash));
+
+  Reload();
+  EXPECT_EQ(store_->size(), 0);
+}
+
+}  // namespace
@@ -0,0 +1,152 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/constants.hpp"
+#include "ledger/chaincode/compiled_contract_cache.hpp"
+#include "ledger/chaincode/smart_contract.hpp"
+#include "vm/generator.hpp"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::Digest;
+using fetch::ledger::CompiledContractCache;
+using fetch::ledger::SmartContract;
+using fetch::vm::Executable;
+
+using ExecutablePtr = CompiledContractCache::ExecutablePtr;
+
+class CompiledContractCacheTests : public ::testing::Test
+{
+protected:
+  CompiledContractCache::Compiler CountingCompiler()
+  {
+    return [this]() -> ExecutablePtr {
+      ++num_compilations_;
+      return std::make_shared<Executable>();
+    };
+  }
+
+  std::atomic<std::size_t> num_compilations_{0};
+};
+
+TEST_F(CompiledContractCacheTests, ContractIsOnlyCompiledOnce)
+{
+  CompiledContractCache cache{};
+
+  auto const first  = cache.LookupOrCompile(Digest{"contract"}, CountingCompiler());
+  auto const second = cache.LookupOrCompile(Digest{"contract"}, CountingCompiler());
+
+  EXPECT_EQ(num_compilations_, 1u);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST_F(CompiledContractCacheTests, ConcurrentLookupsWaitForASingleCompilation)
+{
+  static constexpr std::size_t NUM_THREADS = 8;
+
+  CompiledContractCache cache{};
+
+  auto const slow_compiler = [this]() -> ExecutablePtr {
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    ++num_compilations_;
+    return std::make_shared<Executable>();
+  };
+
+  std::vector<ExecutablePtr> results(NUM_THREADS);
+  std::vector<std::thread>   threads{};
+  for (std::size_t i = 0; i < NUM_THREADS; ++i)
+  {
+    threads.emplace_back([&cache, &results, &slow_compiler, i]() {
+      results[i] = cache.LookupOrCompile(Digest{"contract"}, slow_compiler);
+    });
+  }
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_EQ(num_compilations_, 1u);
+  for (auto const &result : results)
+  {
+    EXPECT_EQ(result, results.front());
+  }
+}
+
+TEST_F(CompiledContractCacheTests, FailedCompilationsAreNotCached)
+{
+  CompiledContractCache cache{};
+
+  auto const failing_compiler = []() -> ExecutablePtr { throw std::runtime_error("bad source"); };
+
+  EXPECT_THROW(cache.LookupOrCompile(Digest{"contract"}, failing_compiler), std::runtime_error);
+  EXPECT_EQ(cache.size(), 0u);
+
+  EXPECT_TRUE(cache.LookupOrCompile(Digest{"contract"}, CountingCompiler()));
+  EXPECT_EQ(num_compilations_, 1u);
+}
+
+TEST_F(CompiledContractCacheTests, LeastRecentlyUsedContractIsEvicted)
+{
+  CompiledContractCache cache{2};
+
+  cache.LookupOrCompile(Digest{"a"}, CountingCompiler());
+  cache.LookupOrCompile(Digest{"b"}, CountingCompiler());
+  cache.LookupOrCompile(Digest{"a"}, CountingCompiler());
+  cache.LookupOrCompile(Digest{"c"}, CountingCompiler());
+
+  EXPECT_EQ(num_compilations_, 3u);
+  EXPECT_EQ(cache.size(), 2u);
+
+  // "a" was used more recently than "b"
+  cache.LookupOrCompile(Digest{"a"}, CountingCompiler());
+  EXPECT_EQ(num_compilations_, 3u);
+
+  cache.LookupOrCompile(Digest{"b"}, CountingCompiler());
+  EXPECT_EQ(num_compilations_, 4u);
+}
+
+TEST_F(CompiledContractCacheTests, SmartContractInstancesShareTheirExecutable)
+{
+  fetch::chain::InitialiseTestConstants();
+
+  static char const *SOURCE = R"(
+    @action
+    function increment(value : Int32) : Int32
+      return value + 1;
+    endfunction
+  )";
+
+  SmartContract const first{SOURCE};
+  SmartContract const second{SOURCE};
+
+  EXPECT_EQ(first.executable(), second.executable());
+}
+
+}  // namespace
@@ -0,0 +1,205 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/constants.hpp"
+#include "fake_executor.hpp"
+#include "ledger/execution_manager.hpp"
+#include "ledger/transaction_status_cache.hpp"
+#include "mock_storage_unit.hpp"
+#include "test_block.hpp"
+
+#include "gmock/gmock.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace fetch::ledger;
+
+using FakeExecutorPtr  = std::shared_ptr<FakeExecutor>;
+using FakeExecutorList = std::vector<FakeExecutorPtr>;
+using State            = ExecutionManager::State;
+
+using ::testing::_;
+using ::testing::AtMost;
+using ::testing::NiceMock;
+using ScheduleStatus   = ExecutionManager::ScheduleStatus;
+
+constexpr uint32_t    LOG2_NUM_LANES = 3;
+constexpr std::size_t NUM_LANES      = 1u << LOG2_NUM_LANES;
+constexpr std::size_t NUM_SLICES     = 16;
+
+class ExecutionManagerPipelinedTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    fetch::chain::InitialiseTestConstants();
+
+    CreateManager(false);
+  }
+
+  void CreateManager(bool prefetch_state)
+  {
+    storage_ = std::make_shared<NiceMock<MockStorageUnit>>();
+    executors_.clear();
+
+    manager_ = std::make_shared<ExecutionManager>(
+        4, LOG2_NUM_LANES, storage_,
+        [this]() {
+          auto executor = std::make_shared<FakeExecutor>();
+          executors_.push_back(executor);
+          return executor;
+        },
+        TransactionStatusCache::factory(), ExecutionManager::Mode::PIPELINED, prefetch_state);
+  }
+
+  /**
+   * Generate a block where each slice contains a random set of transactions on disjoint, randomly
+   * sized lane ranges
+   */
+  Block GenerateBlock(std::size_t &num_transactions)
+  {
+    std::mt19937 rng{42};
+
+    Block block{};
+    block.slices.resize(NUM_SLICES);
+
+    for (auto &slice : block.slices)
+    {
+      std::size_t lane = 0;
+      while (lane < NUM_LANES)
+      {
+        std::size_t const width = std::min<std::size_t>((rng() % 3) + 1, NUM_LANES - lane);
+
+        fetch::BitVector mask{NUM_LANES};
+        for (std::size_t i = 0; i < width; ++i)
+        {
+          mask.set(lane + i, 1);
+        }
+
+        slice.emplace_back(
+            fetch::chain::TransactionLayout{TestBlock::GenerateHash(rng), mask, 1, 0, 100});
+        ++num_transactions;
+
+        lane += width;
+      }
+    }
+
+    return block;
+  }
+
+  bool WaitUntilManagerIsIdle(std::size_t num_executions)
+  {
+    for (std::size_t i = 0; i < 200; ++i)
+    {
+      if ((manager_->completed_executions() == num_executions) &&
+          (State::IDLE == manager_->GetState()))
+      {
+        return true;
+      }
+
+      std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    }
+
+    return false;
+  }
+
+  std::shared_ptr<NiceMock<MockStorageUnit>> storage_;
+  std::shared_ptr<ExecutionManager>          manager_;
+  FakeExecutorList                           executors_;
+};
+
+TEST_F(ExecutionManagerPipelinedTests, LanesAreExecutedInSliceOrder)
+{
+  std::size_t num_transactions{0};
+  auto const  block = GenerateBlock(num_transactions);
+
+  manager_->Start();
+
+  ASSERT_EQ(manager_->Execute(block), ScheduleStatus::SCHEDULED);
+  ASSERT_TRUE(WaitUntilManagerIsIdle(num_transactions));
+
+  manager_->Stop();
+
+  // some items must have been started before the previous slice had completed
+  EXPECT_GT(manager_->pipelined_executions(), 0u);
+
+  FakeExecutor::HistoryElementCache history{};
+  for (auto &executor : executors_)
+  {
+    executor->CollectHistory(history);
+  }
+
+  ASSERT_EQ(history.size(), num_transactions);
+
+  // order the history by start time
+  std::sort(history.begin(), history.end(),
+            [](auto const &a, auto const &b) { return a.timestamp < b.timestamp; });
+
+  // on every lane the transactions must have been started in slice order
+  std::map<std::size_t, uint64_t> last_slice{};
+  for (auto const &element : history)
+  {
+    for (std::size_t const lane : element.shards)
+    {
+      auto it = last_slice.find(lane);
+      if (it != last_slice.end())
+      {
+        EXPECT_LE(it->second, element.slice);
+      }
+
+      last_slice[lane] = element.slice;
+    }
+  }
+}
+
+TEST_F(ExecutionManagerPipelinedTests, OnlyTheNextSliceIsPrefetched)
+{
+  CreateManager(true);
+
+  std::size_t num_transactions{0};
+  auto const  block = GenerateBlock(num_transactions);
+
+  // the prefetches are discarded once the block completes, so the later slices might not be
+  // requested at all
+  for (std::size_t slice = 0; slice < block.slices.size(); ++slice)
+  {
+    for (auto const &layout : block.slices[slice])
+    {
+      EXPECT_CALL(*storage_, GetTransaction(layout.digest(), _)).Times(AtMost(slice == 0 ? 0 : 1));
+    }
+  }
+
+  manager_->Start();
+
+  ASSERT_EQ(manager_->Execute(block), ScheduleStatus::SCHEDULED);
+  ASSERT_TRUE(WaitUntilManagerIsIdle(num_transactions));
+
+  manager_->Stop();
+}
+
+}  // namespace
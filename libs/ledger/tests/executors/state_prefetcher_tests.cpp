@@ -0,0 +1,150 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/address.hpp"
+#include "chain/constants.hpp"
+#include "chain/transaction.hpp"
+#include "chain/transaction_builder.hpp"
+#include "crypto/ecdsa.hpp"
+#include "ledger/state_adapter.hpp"
+#include "ledger/state_prefetcher.hpp"
+#include "mock_storage_unit.hpp"
+
+#include "gmock/gmock.h"
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+namespace {
+
+using fetch::chain::Address;
+using fetch::chain::TransactionBuilder;
+using fetch::crypto::ECDSASigner;
+using fetch::ledger::StateAdapter;
+using fetch::ledger::StatePrefetcher;
+using fetch::storage::ResourceAddress;
+
+using testing::_;
+using testing::NiceMock;
+
+using MockStorageUnitPtr = std::shared_ptr<NiceMock<MockStorageUnit>>;
+
+class StatePrefetcherTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    fetch::chain::InitialiseTestConstants();
+
+    storage_    = std::make_shared<NiceMock<MockStorageUnit>>();
+    prefetcher_ = std::make_unique<StatePrefetcher>(storage_);
+
+    ECDSASigner signer{};
+    auto const  tx = TransactionBuilder()
+                        .From(Address{signer.identity()})
+                        .Transfer(Address{ECDSASigner{}.identity()}, 10)
+                        .Signer(signer.identity())
+                        .Seal()
+                        .Sign(signer)
+                        .Build();
+
+    digest_ = tx->digest();
+    wallet_ = StateAdapter::CreateAddress("fetch.token", tx->from().display());
+
+    storage_->GetFake().AddTransaction(*tx);
+    storage_->GetFake().Set(wallet_, "balance");
+
+    prefetcher_->Start();
+  }
+
+  void TearDown() override
+  {
+    prefetcher_->Stop();
+  }
+
+  bool WaitForPrefetch()
+  {
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+      if (prefetcher_->pending() == 0)
+      {
+        return true;
+      }
+
+      std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+
+    return false;
+  }
+
+  MockStorageUnitPtr               storage_;
+  std::unique_ptr<StatePrefetcher> prefetcher_;
+  fetch::Digest                    digest_;
+  ResourceAddress                  wallet_;
+};
+
+TEST_F(StatePrefetcherTests, PrefetchedTransactionCanOnlyBeTakenOnce)
+{
+  prefetcher_->Prefetch({digest_});
+  ASSERT_TRUE(WaitForPrefetch());
+
+  auto const tx = prefetcher_->TakeTransaction(digest_);
+  ASSERT_TRUE(tx);
+  EXPECT_EQ(tx->digest(), digest_);
+
+  EXPECT_FALSE(prefetcher_->TakeTransaction(digest_));
+}
+
+TEST_F(StatePrefetcherTests, PrefetchedStateIsServedFromTheCache)
+{
+  prefetcher_->Prefetch({digest_});
+  ASSERT_TRUE(WaitForPrefetch());
+
+  EXPECT_CALL(*storage_, Get(_)).Times(0);
+  EXPECT_CALL(*storage_, GetOrCreate(_)).Times(0);
+
+  EXPECT_EQ(prefetcher_->Get(wallet_).document, "balance");
+  EXPECT_EQ(prefetcher_->GetOrCreate(wallet_).document, "balance");
+}
+
+TEST_F(StatePrefetcherTests, WritesReplacePrefetchedState)
+{
+  prefetcher_->Prefetch({digest_});
+  ASSERT_TRUE(WaitForPrefetch());
+
+  prefetcher_->SetMany({{wallet_, "updated"}});
+
+  EXPECT_EQ(prefetcher_->Get(wallet_).document, "updated");
+  EXPECT_EQ(storage_->GetFake().Get(wallet_).document, "updated");
+}
+
+TEST_F(StatePrefetcherTests, ClearDiscardsPrefetchedState)
+{
+  prefetcher_->Prefetch({digest_});
+  ASSERT_TRUE(WaitForPrefetch());
+
+  prefetcher_->Clear();
+
+  EXPECT_CALL(*storage_, Get(wallet_)).Times(1);
+
+  EXPECT_EQ(prefetcher_->Get(wallet_).document, "balance");
+  EXPECT_FALSE(prefetcher_->TakeTransaction(digest_));
+}
+
+}  // namespace
@@ -0,0 +1,164 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "fake_executor.hpp"
+#include "ledger/execution_item.hpp"
+#include "ledger/work_stealing_executor_pool.hpp"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace fetch::ledger;
+
+using FakeExecutorPtr  = std::shared_ptr<FakeExecutor>;
+using FakeExecutorList = std::vector<FakeExecutorPtr>;
+using ExecutionItemPtr = std::unique_ptr<ExecutionItem>;
+using ExecutionItems   = std::vector<ExecutionItemPtr>;
+
+class WorkStealingExecutorPoolTests : public ::testing::Test
+{
+protected:
+  static constexpr std::size_t NUM_EXECUTORS = 4;
+
+  void SetUp() override
+  {
+    WorkStealingExecutorPool::ExecutorList executors{};
+    for (std::size_t i = 0; i < NUM_EXECUTORS; ++i)
+    {
+      auto executor = std::make_shared<FakeExecutor>();
+      fakes_.push_back(executor);
+      executors.push_back(executor);
+    }
+
+    pool_ = std::make_unique<WorkStealingExecutorPool>(
+        std::move(executors),
+        [this](ExecutorInterface &executor, ExecutionItem &item) {
+          item.Execute(executor);
+          ++completed_;
+        },
+        "TestExec");
+  }
+
+  void TearDown() override
+  {
+    pool_->Stop();
+  }
+
+  ExecutionItems GenerateItems(std::size_t count)
+  {
+    ExecutionItems items{};
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      items.emplace_back(
+          std::make_unique<ExecutionItem>(fetch::Digest{}, 0, 0, fetch::BitVector{1}));
+    }
+
+    return items;
+  }
+
+  bool WaitForCompletions(std::size_t count)
+  {
+    for (std::size_t i = 0; i < 200; ++i)
+    {
+      if (completed_ == count)
+      {
+        return true;
+      }
+
+      std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+
+    return false;
+  }
+
+  std::size_t TotalExecutions() const
+  {
+    std::size_t total{0};
+    for (auto const &executor : fakes_)
+    {
+      total += executor->GetNumExecutions();
+    }
+
+    return total;
+  }
+
+  FakeExecutorList                          fakes_;
+  std::unique_ptr<WorkStealingExecutorPool> pool_;
+  std::atomic<std::size_t>                  completed_{0};
+};
+
+TEST_F(WorkStealingExecutorPoolTests, AllItemsAreExecutedOnce)
+{
+  auto items = GenerateItems(1000);
+
+  WorkStealingExecutorPool::ItemList list{};
+  for (auto &item : items)
+  {
+    list.push_back(item.get());
+  }
+
+  pool_->Start();
+  pool_->Post(list);
+
+  ASSERT_TRUE(WaitForCompletions(items.size()));
+  EXPECT_EQ(TotalExecutions(), items.size());
+  EXPECT_EQ(pool_->pending(), 0u);
+}
+
+TEST_F(WorkStealingExecutorPoolTests, ItemsPostedBeforeStartAreExecuted)
+{
+  auto items = GenerateItems(NUM_EXECUTORS * 3);
+
+  for (auto &item : items)
+  {
+    pool_->Post(*item);
+  }
+
+  EXPECT_EQ(pool_->pending(), items.size());
+
+  pool_->Start();
+
+  ASSERT_TRUE(WaitForCompletions(items.size()));
+  EXPECT_EQ(TotalExecutions(), items.size());
+}
+
+TEST_F(WorkStealingExecutorPoolTests, StopDiscardsPendingItems)
+{
+  auto items = GenerateItems(10);
+
+  for (auto &item : items)
+  {
+    pool_->Post(*item);
+  }
+
+  pool_->Start();
+  pool_->Stop();
+
+  EXPECT_EQ(pool_->pending(), 0u);
+  EXPECT_EQ(TotalExecutions(), static_cast<std::size_t>(completed_));
+}
+
+}  // namespace
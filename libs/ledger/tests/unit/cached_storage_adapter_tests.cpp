@@ -29,7 +29,13 @@ using fetch::ledger::StorageInterface;
 using fetch::storage::ResourceAddress;
 using fetch::storage::Document;
 
+using Addresses = StorageInterface::Addresses;
+using Documents = StorageInterface::Documents;
+using KeyValues = StorageInterface::KeyValues;
+
+using testing::_;
 using testing::Return;
+using testing::UnorderedElementsAre;
 
 class MockStorage : public StorageInterface
 {
@@ -40,6 +46,8 @@ public:
   MOCK_METHOD1(Lock, bool(ShardIndex));
   MOCK_METHOD1(Unlock, bool(ShardIndex));
   MOCK_METHOD0(Reset, void());
+  MOCK_CONST_METHOD1(GetMany, Documents(Addresses const &));
+  MOCK_METHOD1(SetMany, void(KeyValues const &));
 };
 
 class CachedStorageAdapterTests : public testing::Test
@@ -99,4 +107,46 @@ TEST_F(CachedStorageAdapterTests, Get_does_not_cache_result_if_retrieval_from_st
   cached_storage_adapter.Get(key);
 }
 
+TEST_F(CachedStorageAdapterTests, GetMany_only_requests_keys_missing_from_the_cache)
+{
+  ResourceAddress const other{"other"};
+
+  Document doc;
+  doc.document = "value";
+
+  Document other_doc;
+  other_doc.document = "other value";
+
+  EXPECT_CALL(mock_storage, Get(key)).WillOnce(Return(doc));
+  EXPECT_CALL(mock_storage, GetMany(Addresses{other})).WillOnce(Return(Documents{other_doc}));
+
+  cached_storage_adapter.Get(key);
+
+  auto const docs = cached_storage_adapter.GetMany({key, other});
+  ASSERT_EQ(docs.size(), 2u);
+  EXPECT_EQ(docs[0].document, doc.document);
+  EXPECT_EQ(docs[1].document, other_doc.document);
+
+  // both values are now cached
+  cached_storage_adapter.GetMany({other, key});
+}
+
+TEST_F(CachedStorageAdapterTests, Flush_sets_all_pending_values_in_a_single_batch)
+{
+  ResourceAddress const other{"other"};
+
+  EXPECT_CALL(mock_storage, Set(_, _)).Times(0);
+  EXPECT_CALL(mock_storage, SetMany(UnorderedElementsAre(KeyValues::value_type{key, "1"},
+                                                         KeyValues::value_type{other, "2"})))
+      .Times(1);
+
+  cached_storage_adapter.Set(key, "1");
+  cached_storage_adapter.Set(other, "2");
+
+  cached_storage_adapter.Flush();
+
+  // nothing left to flush
+  cached_storage_adapter.Flush();
+}
+
 }  // namespace
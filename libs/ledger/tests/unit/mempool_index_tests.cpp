@@ -0,0 +1,222 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction_layout.hpp"
+#include "core/bitvector.hpp"
+#include "core/digest.hpp"
+#include "core/random/lcg.hpp"
+#include "ledger/miner/mempool_index.hpp"
+#include "tx_generator.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <vector>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::DigestSet;
+using fetch::chain::TransactionLayout;
+using fetch::ledger::MempoolIndex;
+using fetch::random::LinearCongruentialGenerator;
+
+using MempoolIndexPtr = std::unique_ptr<MempoolIndex>;
+using Slice           = MempoolIndex::Slice;
+using LayoutList      = std::list<TransactionLayout>;
+
+constexpr uint32_t LOG2_NUM_LANES = 4;
+constexpr uint32_t NUM_LANES      = 1u << LOG2_NUM_LANES;
+
+class MempoolIndexTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    index_ = std::make_unique<MempoolIndex>(LOG2_NUM_LANES);
+    generator_.Seed();
+    rng_.Seed(42);
+  }
+
+  TransactionLayout Generate(uint64_t charge_rate, uint64_t valid_from = 1,
+                             uint64_t valid_until = 1000)
+  {
+    auto const layout = generator_(static_cast<uint32_t>(rng_() % 6u));
+
+    return {layout.digest(), layout.mask(), charge_rate, valid_from, valid_until};
+  }
+
+  // Reference implementation: stable sort of the pool by charge rate followed by a first fit scan
+  static void ReferencePack(LayoutList &pool, Slice &slice)
+  {
+    BitVector slice_state{NUM_LANES};
+
+    auto it = pool.begin();
+    while ((it != pool.end()) && (slice_state.PopCount() != NUM_LANES))
+    {
+      if (!slice_state.Intersects(it->mask()))
+      {
+        slice_state |= it->mask();
+        slice.push_back(*it);
+        it = pool.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+
+  MempoolIndexPtr             index_;
+  TransactionGenerator        generator_{LOG2_NUM_LANES};
+  LinearCongruentialGenerator rng_;
+};
+
+TEST_F(MempoolIndexTests, CheckAdditionsAndDuplicates)
+{
+  auto const tx1 = Generate(10);
+  auto const tx2 = Generate(20);
+
+  EXPECT_TRUE(index_->empty());
+  EXPECT_TRUE(index_->Add(tx1));
+  EXPECT_TRUE(index_->Add(tx2));
+  EXPECT_FALSE(index_->Add(tx1));
+
+  EXPECT_EQ(index_->size(), 2u);
+  EXPECT_TRUE(index_->Contains(tx1.digest()));
+  EXPECT_TRUE(index_->Contains(tx2.digest()));
+
+  auto const layouts = index_->TxLayouts();
+  EXPECT_EQ(layouts.size(), 2u);
+  EXPECT_EQ(layouts.count(tx1), 1u);
+  EXPECT_EQ(layouts.count(tx2), 1u);
+}
+
+TEST_F(MempoolIndexTests, CheckIncompatibleLayoutsRejected)
+{
+  TransactionGenerator other{LOG2_NUM_LANES + 1};
+
+  // incorrect mask size
+  EXPECT_FALSE(index_->Add(other(2)));
+
+  // validity period which is too long to ever be valid
+  EXPECT_FALSE(index_->Add(Generate(10, 1, 1000000)));
+
+  EXPECT_TRUE(index_->empty());
+}
+
+TEST_F(MempoolIndexTests, CheckRemoval)
+{
+  auto const tx1 = Generate(10);
+  auto const tx2 = Generate(20);
+  auto const tx3 = Generate(30);
+
+  ASSERT_TRUE(index_->Add(tx1));
+  ASSERT_TRUE(index_->Add(tx2));
+  ASSERT_TRUE(index_->Add(tx3));
+
+  EXPECT_TRUE(index_->Remove(tx2.digest()));
+  EXPECT_FALSE(index_->Remove(tx2.digest()));
+  EXPECT_EQ(index_->size(), 2u);
+
+  EXPECT_EQ(index_->Remove(DigestSet{tx1.digest(), tx2.digest(), tx3.digest()}), 2u);
+  EXPECT_TRUE(index_->empty());
+
+  // removed slots are reused
+  EXPECT_TRUE(index_->Add(tx2));
+  EXPECT_EQ(index_->size(), 1u);
+  EXPECT_TRUE(index_->Contains(tx2.digest()));
+}
+
+TEST_F(MempoolIndexTests, CheckInvalidRemoval)
+{
+  auto const expires_early = Generate(10, 1, 10);
+  auto const expires_late  = Generate(10, 1, 100);
+  auto const not_yet_valid = Generate(10, 50, 100);
+  auto const fallback      = Generate(10, 0, 20);  // valid from is derived from valid until
+
+  ASSERT_TRUE(index_->Add(expires_early));
+  ASSERT_TRUE(index_->Add(expires_late));
+  ASSERT_TRUE(index_->Add(not_yet_valid));
+  ASSERT_TRUE(index_->Add(fallback));
+
+  EXPECT_EQ(index_->RemoveInvalid(5), 1u);
+  EXPECT_TRUE(index_->Contains(expires_early.digest()));
+  EXPECT_TRUE(index_->Contains(expires_late.digest()));
+  EXPECT_FALSE(index_->Contains(not_yet_valid.digest()));
+  EXPECT_TRUE(index_->Contains(fallback.digest()));
+
+  EXPECT_EQ(index_->RemoveInvalid(10), 1u);
+  EXPECT_FALSE(index_->Contains(expires_early.digest()));
+  EXPECT_TRUE(index_->Contains(expires_late.digest()));
+
+  EXPECT_EQ(index_->RemoveInvalid(99), 1u);
+  EXPECT_TRUE(index_->Contains(expires_late.digest()));
+  EXPECT_FALSE(index_->Contains(fallback.digest()));
+
+  EXPECT_EQ(index_->RemoveInvalid(100), 1u);
+  EXPECT_TRUE(index_->empty());
+}
+
+TEST_F(MempoolIndexTests, CheckPackingMatchesReference)
+{
+  static constexpr std::size_t NUM_ROUNDS       = 5;
+  static constexpr std::size_t NUM_TX_PER_ROUND = 300;
+  static constexpr std::size_t NUM_SLICES       = 8;
+
+  LayoutList pool{};
+
+  for (std::size_t round = 0; round < NUM_ROUNDS; ++round)
+  {
+    // top up the pool, using a narrow range of charge rates so that ties are common
+    for (std::size_t i = 0; i < NUM_TX_PER_ROUND; ++i)
+    {
+      auto const layout = Generate(1 + (rng_() % 8u));
+
+      ASSERT_TRUE(index_->Add(layout));
+      pool.push_back(layout);
+    }
+
+    pool.sort([](TransactionLayout const &a, TransactionLayout const &b) {
+      return a.charge_rate() > b.charge_rate();
+    });
+
+    for (std::size_t i = 0; i < NUM_SLICES; ++i)
+    {
+      Slice expected{};
+      Slice actual{};
+
+      ReferencePack(pool, expected);
+      EXPECT_EQ(index_->PackSlice(actual), expected.size());
+
+      ASSERT_EQ(actual.size(), expected.size());
+      for (std::size_t j = 0; j < expected.size(); ++j)
+      {
+        EXPECT_EQ(actual[j].digest(), expected[j].digest());
+        EXPECT_FALSE(index_->Contains(actual[j].digest()));
+      }
+    }
+
+    EXPECT_EQ(index_->size(), pool.size());
+  }
+}
+
+}  // namespace
@@ -19,13 +19,30 @@
 
 #include "logging/backtrace.hpp"
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <ostream>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 
 namespace fetch {
+
+enum class LogLevel
+{
+  TRACE,
+  DEBUG,
+  INFO,
+  WARNING,
+  ERROR,
+  CRITICAL,
+};
+
+void Log(LogLevel level, char const *name, std::string &&message);
+
 namespace detail {
 
 template <typename T, typename... Args>
@@ -62,18 +79,290 @@ std::string Format(Args &&... args)
   return oss.str();
 }
 
+/// @name Asynchronous Log Records
+/// @{
+
+/**
+ * When logging asynchronously, the arguments of a log message are copied into a binary record
+ * and only formatted by the background logging thread. This is possible for arguments whose
+ * output does not depend on any user defined stream operator: booleans, characters, numbers,
+ * pointers and strings. Messages with any other argument are formatted on the calling thread.
+ */
+enum class LogArgumentTag : uint8_t
+{
+  BOOL,
+  CHAR,
+  SIGNED,
+  UNSIGNED,
+  FLOATING,
+  POINTER,
+  STRING,
+};
+
+template <typename V>
+uint8_t *WriteLogArgument(uint8_t *out, LogArgumentTag tag, V const &value)
+{
+  *out++ = static_cast<uint8_t>(tag);
+  std::memcpy(out, &value, sizeof(V));
+  return out + sizeof(V);
+}
+
+inline uint8_t *WriteLogArgument(uint8_t *out, char const *value, uint32_t length)
+{
+  out = WriteLogArgument(out, LogArgumentTag::STRING, length);
+  std::memcpy(out, value, length);
+  return out + length;
+}
+
+template <typename T, typename = void>
+struct LogArgument
+{
+  static constexpr bool CAPTURED = false;
+};
+
+template <typename T>
+struct LogArgument<T, std::enable_if_t<std::is_same<T, bool>::value>>
+{
+  static constexpr bool CAPTURED = true;
+
+  static std::size_t Size(T const & /*value*/)
+  {
+    return 1u + sizeof(uint8_t);
+  }
+
+  static uint8_t *Write(uint8_t *out, T const &value)
+  {
+    return WriteLogArgument(out, LogArgumentTag::BOOL, static_cast<uint8_t>(value ? 1u : 0u));
+  }
+};
+
+template <typename T>
+struct LogArgument<T, std::enable_if_t<std::is_same<T, char>::value ||
+                                       std::is_same<T, signed char>::value ||
+                                       std::is_same<T, unsigned char>::value>>
+{
+  static constexpr bool CAPTURED = true;
+
+  static std::size_t Size(T const & /*value*/)
+  {
+    return 1u + sizeof(char);
+  }
+
+  static uint8_t *Write(uint8_t *out, T const &value)
+  {
+    return WriteLogArgument(out, LogArgumentTag::CHAR, static_cast<char>(value));
+  }
+};
+
+template <typename T>
+struct LogArgument<T, std::enable_if_t<std::is_integral<T>::value &&
+                                       !std::is_same<T, bool>::value && (sizeof(T) > 1u)>>
+{
+  static constexpr bool CAPTURED = true;
+
+  static std::size_t Size(T const & /*value*/)
+  {
+    return 1u + sizeof(uint64_t);
+  }
+
+  static uint8_t *Write(uint8_t *out, T const &value)
+  {
+    if (std::is_signed<T>::value)
+    {
+      return WriteLogArgument(out, LogArgumentTag::SIGNED, static_cast<int64_t>(value));
+    }
+    return WriteLogArgument(out, LogArgumentTag::UNSIGNED, static_cast<uint64_t>(value));
+  }
+};
+
+template <typename T>
+struct LogArgument<T, std::enable_if_t<std::is_same<T, float>::value ||
+                                       std::is_same<T, double>::value>>
+{
+  static constexpr bool CAPTURED = true;
+
+  static std::size_t Size(T const & /*value*/)
+  {
+    return 1u + sizeof(double);
+  }
+
+  static uint8_t *Write(uint8_t *out, T const &value)
+  {
+    return WriteLogArgument(out, LogArgumentTag::FLOATING, static_cast<double>(value));
+  }
+};
+
+template <typename T>
+struct LogArgument<T, std::enable_if_t<std::is_same<T, void const *>::value ||
+                                       std::is_same<T, void *>::value>>
+{
+  static constexpr bool CAPTURED = true;
+
+  static std::size_t Size(T const & /*value*/)
+  {
+    return 1u + sizeof(void const *);
+  }
+
+  static uint8_t *Write(uint8_t *out, T const &value)
+  {
+    return WriteLogArgument(out, LogArgumentTag::POINTER, static_cast<void const *>(value));
+  }
+};
+
+template <typename T>
+struct LogArgument<T, std::enable_if_t<std::is_same<T, char const *>::value ||
+                                       std::is_same<T, char *>::value>>
+{
+  static constexpr bool CAPTURED = true;
+
+  static std::size_t Size(T const &value)
+  {
+    return 1u + sizeof(uint32_t) + ((value != nullptr) ? std::strlen(value) : 0u);
+  }
+
+  static uint8_t *Write(uint8_t *out, T const &value)
+  {
+    auto const length = static_cast<uint32_t>((value != nullptr) ? std::strlen(value) : 0u);
+    return WriteLogArgument(out, value, length);
+  }
+};
+
+template <typename T>
+struct LogArgument<T, std::enable_if_t<std::is_same<T, std::string>::value>>
+{
+  static constexpr bool CAPTURED = true;
+
+  static std::size_t Size(T const &value)
+  {
+    return 1u + sizeof(uint32_t) + value.size();
+  }
+
+  static uint8_t *Write(uint8_t *out, T const &value)
+  {
+    return WriteLogArgument(out, value.data(), static_cast<uint32_t>(value.size()));
+  }
+};
+
+template <typename... Args>
+struct LogArguments;
+
+template <>
+struct LogArguments<>
+{
+  static constexpr bool CAPTURED = true;
+
+  static std::size_t Size()
+  {
+    return 0;
+  }
+
+  static uint8_t *Write(uint8_t *out)
+  {
+    return out;
+  }
+};
+
+template <typename T, typename... Args>
+struct LogArguments<T, Args...>
+{
+  using Argument = LogArgument<std::decay_t<T>>;
+  using Rest     = LogArguments<Args...>;
+
+  static constexpr bool CAPTURED = Argument::CAPTURED && Rest::CAPTURED;
+
+  static std::size_t Size(T const &value, Args const &... args)
+  {
+    return Argument::Size(value) + Rest::Size(args...);
+  }
+
+  static uint8_t *Write(uint8_t *out, T const &value, Args const &... args)
+  {
+    return Rest::Write(Argument::Write(out, value), args...);
+  }
+};
+
+struct AsyncLogSlot
+{
+  uint8_t *payload{nullptr};   ///< Where the arguments are to be written, if the record is queued
+  bool     synchronous{false};  ///< Whether the message must be logged synchronously instead
+};
+
+bool         IsLogLevelEnabled(LogLevel level);
+bool         IsAsyncLoggingEnabled();
+AsyncLogSlot BeginAsyncRecord(LogLevel level, char const *name, std::size_t payload_size);
+void         CommitAsyncRecord();
+
+template <typename... Args>
+std::enable_if_t<LogArguments<std::decay_t<Args>...>::CAPTURED> LogAsync(LogLevel    level,
+                                                                          char const *name,
+                                                                          Args &... args)
+{
+  using Arguments = LogArguments<std::decay_t<Args>...>;
+
+  AsyncLogSlot const slot = BeginAsyncRecord(level, name, Arguments::Size(args...));
+  if (slot.payload != nullptr)
+  {
+    Arguments::Write(slot.payload, args...);
+    CommitAsyncRecord();
+  }
+  else if (slot.synchronous)
+  {
+    Log(level, name, Format(args...));
+  }
+}
+
+template <typename... Args>
+std::enable_if_t<!LogArguments<std::decay_t<Args>...>::CAPTURED> LogAsync(LogLevel    level,
+                                                                           char const *name,
+                                                                           Args &... args)
+{
+  std::string message = Format(args...);
+
+  AsyncLogSlot const slot = BeginAsyncRecord(level, name, LogArgument<std::string>::Size(message));
+  if (slot.payload != nullptr)
+  {
+    LogArgument<std::string>::Write(slot.payload, message);
+    CommitAsyncRecord();
+  }
+  else if (slot.synchronous)
+  {
+    Log(level, name, std::move(message));
+  }
+}
+
+/**
+ * Log a message, either asynchronously or by formatting it on the calling thread
+ */
+template <typename... Args>
+void LogMessage(LogLevel level, char const *name, Args &... args)
+{
+  if (!IsLogLevelEnabled(level))
+  {
+    return;
+  }
+
+  if (IsAsyncLoggingEnabled())
+  {
+    LogAsync(level, name, args...);
+  }
+  else
+  {
+    Log(level, name, Format(args...));
+  }
+}
+
+/// @}
+
 }  // namespace detail
 
-enum class LogLevel
+enum class LogOverflowPolicy
 {
-  TRACE,
-  DEBUG,
-  INFO,
-  WARNING,
-  ERROR,
-  CRITICAL,
+  DROP,   ///< Messages that do not fit into the calling thread's ring are counted and dropped
+  BLOCK,  ///< The calling thread waits for the background thread to make space
 };
 
+constexpr std::size_t DEFAULT_ASYNC_LOG_RING_SIZE = 256u * 1024u;
+
 using LogLevelMap = std::unordered_map<std::string, LogLevel>;
 
 /// @name Log Library Functions
@@ -105,6 +394,30 @@ void Log(LogLevel level, char const *name, std::string &&message);
  */
 LogLevelMap GetLogLevelMap();
 
+/**
+ * Switch to asynchronous logging. Each logging thread copies its messages into a ring of binary
+ * records, which are formatted and written out by a background thread. Errors, critical messages
+ * and messages too large for the ring are still written by the calling thread, once its queued
+ * messages have been written out.
+ *
+ * @param ring_size The size in bytes of each thread's ring
+ * @param policy What to do with messages that do not fit into the ring
+ */
+void EnableAsyncLogging(std::size_t       ring_size = DEFAULT_ASYNC_LOG_RING_SIZE,
+                        LogOverflowPolicy policy    = LogOverflowPolicy::DROP);
+
+/**
+ * Write out all queued messages and switch back to synchronous logging
+ */
+void DisableAsyncLogging();
+
+/**
+ * Retrieve the number of messages dropped because a thread's ring was full
+ *
+ * @return The number of dropped messages
+ */
+uint64_t GetDroppedLogCount();
+
 /// @}
 
 /// @name Helper Wrappers
@@ -113,37 +426,37 @@ LogLevelMap GetLogLevelMap();
 template <typename... Args>
 void LogTraceV2(char const *name, Args &&... args)
 {
-  Log(LogLevel::TRACE, name, detail::Format(std::forward<Args>(args)...));
+  detail::LogMessage(LogLevel::TRACE, name, args...);
 }
 
 template <typename... Args>
 void LogDebugV2(char const *name, Args &&... args)
 {
-  Log(LogLevel::DEBUG, name, detail::Format(std::forward<Args>(args)...));
+  detail::LogMessage(LogLevel::DEBUG, name, args...);
 }
 
 template <typename... Args>
 void LogInfoV2(char const *name, Args &&... args)
 {
-  Log(LogLevel::INFO, name, detail::Format(std::forward<Args>(args)...));
+  detail::LogMessage(LogLevel::INFO, name, args...);
 }
 
 template <typename... Args>
 void LogWarningV2(char const *name, Args &&... args)
 {
-  Log(LogLevel::WARNING, name, detail::Format(std::forward<Args>(args)...));
+  detail::LogMessage(LogLevel::WARNING, name, args...);
 }
 
 template <typename... Args>
 void LogErrorV2(char const *name, Args &&... args)
 {
-  Log(LogLevel::ERROR, name, detail::Format(std::forward<Args>(args)...));
+  detail::LogMessage(LogLevel::ERROR, name, args...);
 }
 
 template <typename... Args>
 void LogCriticalV2(char const *name, Args &&... args)
 {
-  Log(LogLevel::CRITICAL, name, detail::Format(std::forward<Args>(args)...));
+  detail::LogMessage(LogLevel::CRITICAL, name, args...);
 }
 
 /// @}
@@ -40,8 +40,20 @@
 
 #include "logging/logging.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
 #include <mutex>
+#include <sstream>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 #ifdef FETCH_ENABLE_BACKTRACE
 
@@ -64,7 +76,10 @@ public:
   LogRegistry(LogRegistry &&)      = delete;
   ~LogRegistry()                   = default;
 
+  using LogTime = spdlog::log_clock::time_point;
+
   void Log(LogLevel level, char const *name, std::string &&message);
+  void Log(LogLevel level, char const *name, std::string &&message, LogTime time);
   void SetLevel(char const *name, LogLevel level);
   void SetGlobalLevel(LogLevel level);
 
@@ -91,8 +106,133 @@ private:
   std::atomic<LogLevel> global_level_{LogLevel::TRACE};
 };
 
+/**
+ * Single producer, single consumer ring of variable sized log records. Every record starts with
+ * its size in bytes. A record is never split across the end of the buffer; when it does not fit,
+ * the remaining space is skipped and marked with a zero size (if there is room for one).
+ */
+class LogRing
+{
+public:
+  static constexpr std::size_t SIZE_PREFIX = sizeof(uint32_t);
+
+  // Construction / Destruction
+  explicit LogRing(std::size_t capacity);
+  LogRing(LogRing const &) = delete;
+  LogRing(LogRing &&)      = delete;
+  ~LogRing()               = default;
+
+  /// @name Producer Interface
+  /// @{
+  uint8_t *Reserve(std::size_t size);
+  void     Commit();
+  /// @}
+
+  /// @name Consumer Interface
+  /// @{
+  template <typename Consumer>
+  bool Consume(Consumer &&consumer);
+  bool empty() const;
+  /// @}
+
+  std::size_t max_record_size() const
+  {
+    return capacity_ / 4u;
+  }
+
+  // Operators
+  LogRing &operator=(LogRing const &) = delete;
+  LogRing &operator=(LogRing &&) = delete;
+
+  std::atomic<bool>     writing{false};  ///< Set by the producer while it fills in a record
+  std::atomic<uint64_t> dropped{0};      ///< Number of records that did not fit
+
+private:
+  std::size_t const          capacity_;
+  std::size_t const          mask_;
+  std::unique_ptr<uint8_t[]> buffer_;
+  uint64_t                   pending_head_{0};  ///< Producer only
+
+  // keep the positions of the producer and the consumer on separate cache lines
+  uint8_t               padding0_[64]{};
+  std::atomic<uint64_t> head_{0};
+  uint8_t               padding1_[64]{};
+  std::atomic<uint64_t> tail_{0};
+  uint8_t               padding2_[64]{};
+};
+
+/**
+ * Owner of the per thread rings and of the background thread that formats and writes out the
+ * queued records
+ */
+class AsyncLogBackend
+{
+public:
+  // Construction / Destruction
+  AsyncLogBackend() = default;
+  AsyncLogBackend(AsyncLogBackend const &) = delete;
+  AsyncLogBackend(AsyncLogBackend &&)      = delete;
+  ~AsyncLogBackend();
+
+  void Enable(std::size_t ring_size, LogOverflowPolicy policy);
+  void Disable();
+
+  detail::AsyncLogSlot Begin(LogLevel level, char const *name, std::size_t payload_size);
+  void                 Commit();
+
+  uint64_t dropped();
+
+  bool enabled() const
+  {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  // Operators
+  AsyncLogBackend &operator=(AsyncLogBackend const &) = delete;
+  AsyncLogBackend &operator=(AsyncLogBackend &&) = delete;
+
+private:
+  using LogTime = spdlog::log_clock::time_point;
+
+  static constexpr std::size_t RECORD_HEADER =
+      LogRing::SIZE_PREFIX + sizeof(LogTime::rep) + sizeof(uint8_t) + sizeof(uint16_t);
+
+  using RingPtr   = std::shared_ptr<LogRing>;
+  using Rings     = std::vector<RingPtr>;
+  using Clock     = std::chrono::steady_clock;
+  using Timestamp = Clock::time_point;
+
+  Rings GetRings();
+  bool  Drain();
+  void  WaitUntilWritten(LogRing const &ring);
+  void  ReportDrops();
+  void  Run();
+
+  static void Write(uint8_t const *record, std::size_t size);
+
+  std::mutex control_lock_;  ///< Serialises Enable and Disable
+  std::thread thread_;
+
+  std::mutex              lock_;  ///< Protects the members below
+  std::condition_variable wake_;
+  Rings                   rings_;
+  uint64_t                retired_dropped_{0};
+  bool                    running_{false};
+
+  std::atomic<bool>              enabled_{false};
+  std::atomic<std::size_t>       ring_size_{DEFAULT_ASYNC_LOG_RING_SIZE};
+  std::atomic<LogOverflowPolicy> policy_{LogOverflowPolicy::DROP};
+
+  // background thread only
+  uint64_t  reported_dropped_{0};
+  Timestamp last_report_{};
+};
+
 LogRegistry                                          registry;
 std::shared_ptr<spdlog::sinks::stdout_color_sink_mt> COLOUR_SINK;
+AsyncLogBackend                                      async_backend;
+
+thread_local std::shared_ptr<LogRing> this_thread_ring;
 
 LogLevel ConvertToLevel(spdlog::level::level_enum level)
 {
@@ -167,6 +307,44 @@ void LogRegistry::Log(LogLevel level, char const *name, std::string &&message)
   GetLogger(name).log(ConvertFromLevel(level), message);
 }
 
+/**
+ * Log a message that was queued earlier, keeping the time at which it was logged
+ *
+ * @param level The level of the message
+ * @param name The name of the origin
+ * @param message The formatted message
+ * @param time The time at which the message was logged
+ */
+void LogRegistry::Log(LogLevel level, char const *name, std::string &&message, LogTime time)
+{
+  if (level < global_level_)
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(lock_);
+
+  auto &     logger    = GetLogger(name);
+  auto const spd_level = ConvertFromLevel(level);
+
+  if (!logger.should_log(spd_level))
+  {
+    return;
+  }
+
+  // the logger always stamps messages with the current time, so pass this one to its sinks
+  spdlog::details::log_msg msg{spdlog::source_loc{}, logger.name(), spd_level, message};
+  msg.time = time;
+
+  for (auto &sink : logger.sinks())
+  {
+    if (sink->should_log(spd_level))
+    {
+      sink->log(msg);
+    }
+  }
+}
+
 void LogRegistry::SetLevel(char const *name, LogLevel level)
 {
   std::lock_guard<std::mutex> guard(lock_);
@@ -231,8 +409,482 @@ LogRegistry::Logger &LogRegistry::GetLogger(char const *name)
   return *(it->second);
 }
 
+LogRing::LogRing(std::size_t capacity)
+  : capacity_{capacity}
+  , mask_{capacity - 1u}
+  , buffer_{new uint8_t[capacity]}
+{}
+
+/**
+ * Reserve space for the next record, it becomes visible to the consumer once committed
+ *
+ * @param size The size of the record in bytes, including its size prefix
+ * @return Where to write the record, or nullptr if the ring is full
+ */
+uint8_t *LogRing::Reserve(std::size_t size)
+{
+  uint64_t const    head   = head_.load(std::memory_order_relaxed);
+  std::size_t const offset = static_cast<std::size_t>(head) & mask_;
+  std::size_t const to_end = capacity_ - offset;
+  bool const        wraps  = size > to_end;
+  std::size_t const needed = wraps ? (size + to_end) : size;
+
+  if (capacity_ - (head - tail_.load(std::memory_order_acquire)) < needed)
+  {
+    return nullptr;
+  }
+
+  pending_head_ = head + needed;
+
+  if (!wraps)
+  {
+    return buffer_.get() + offset;
+  }
+
+  if (to_end >= SIZE_PREFIX)
+  {
+    std::memset(buffer_.get() + offset, 0, SIZE_PREFIX);
+  }
+
+  return buffer_.get();
+}
+
+void LogRing::Commit()
+{
+  head_.store(pending_head_, std::memory_order_release);
+}
+
+/**
+ * Pass the oldest record to the consumer and release its space
+ *
+ * @param consumer Callable with the record and its size
+ * @return true if there was a record, otherwise false
+ */
+template <typename Consumer>
+bool LogRing::Consume(Consumer &&consumer)
+{
+  uint64_t tail = tail_.load(std::memory_order_relaxed);
+  if (tail == head_.load(std::memory_order_acquire))
+  {
+    return false;
+  }
+
+  std::size_t       offset = static_cast<std::size_t>(tail) & mask_;
+  std::size_t const to_end = capacity_ - offset;
+
+  uint32_t size = 0;
+  if (to_end >= SIZE_PREFIX)
+  {
+    std::memcpy(&size, buffer_.get() + offset, SIZE_PREFIX);
+  }
+
+  if (size == 0)
+  {
+    // the record was wrapped around to the start of the buffer
+    tail += to_end;
+    offset = 0;
+    std::memcpy(&size, buffer_.get(), SIZE_PREFIX);
+  }
+
+  consumer(buffer_.get() + offset, static_cast<std::size_t>(size));
+  tail_.store(tail + size, std::memory_order_release);
+
+  return true;
+}
+
+bool LogRing::empty() const
+{
+  return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire);
+}
+
+AsyncLogBackend::~AsyncLogBackend()
+{
+  Disable();
+}
+
+void AsyncLogBackend::Enable(std::size_t ring_size, LogOverflowPolicy policy)
+{
+  std::lock_guard<std::mutex> control_guard(control_lock_);
+
+  // rings are indexed with a mask so their size must be a power of two
+  std::size_t capacity = 4096u;
+  while (capacity < ring_size)
+  {
+    capacity <<= 1u;
+  }
+
+  ring_size_ = capacity;
+  policy_    = policy;
+
+  if (!thread_.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      running_ = true;
+    }
+
+    thread_ = std::thread([this]() { Run(); });
+  }
+
+  enabled_ = true;
+}
+
+void AsyncLogBackend::Disable()
+{
+  std::lock_guard<std::mutex> control_guard(control_lock_);
+
+  if (!thread_.joinable())
+  {
+    return;
+  }
+
+  // new messages are logged synchronously from here on, wait for the ones being queued to finish
+  enabled_ = false;
+
+  for (auto const &ring : GetRings())
+  {
+    while (ring->writing)
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    running_ = false;
+  }
+
+  wake_.notify_one();
+  thread_.join();
+}
+
+/**
+ * Reserve space for a record in the calling thread's ring
+ *
+ * @param level The level of the log message
+ * @param name The name of the origin
+ * @param payload_size The size of the encoded arguments
+ * @return The slot for the arguments
+ */
+detail::AsyncLogSlot AsyncLogBackend::Begin(LogLevel level, char const *name,
+                                            std::size_t payload_size)
+{
+  detail::AsyncLogSlot slot{};
+
+  auto &ring = this_thread_ring;
+  if (!ring)
+  {
+    ring = std::make_shared<LogRing>(ring_size_.load());
+
+    std::lock_guard<std::mutex> guard(lock_);
+    rings_.push_back(ring);
+  }
+
+  auto const        name_length = static_cast<uint16_t>(std::min<std::size_t>(
+      std::strlen(name), std::numeric_limits<uint16_t>::max()));
+  std::size_t const size        = RECORD_HEADER + name_length + payload_size;
+
+  // errors are written straight away so they are not lost if the process is about to die, and
+  // messages too large for the ring are written directly. In both cases this thread's earlier
+  // messages are written out first to keep them in order
+  if ((level >= LogLevel::ERROR) || (size > ring->max_record_size()))
+  {
+    WaitUntilWritten(*ring);
+
+    slot.synchronous = true;
+    return slot;
+  }
+
+  // pairs with Disable() so that no record is left behind once it returns
+  ring->writing = true;
+  if (!enabled_)
+  {
+    ring->writing = false;
+
+    slot.synchronous = true;
+    return slot;
+  }
+
+  uint8_t *record = ring->Reserve(size);
+  while (record == nullptr)
+  {
+    if (policy_.load(std::memory_order_relaxed) == LogOverflowPolicy::DROP)
+    {
+      ring->dropped.fetch_add(1, std::memory_order_relaxed);
+      ring->writing.store(false, std::memory_order_release);
+
+      return slot;
+    }
+
+    std::this_thread::yield();
+    record = ring->Reserve(size);
+  }
+
+  auto const record_size = static_cast<uint32_t>(size);
+  auto const raw_time    = spdlog::log_clock::now().time_since_epoch().count();
+  auto const raw_level   = static_cast<uint8_t>(level);
+
+  uint8_t *out = record;
+  std::memcpy(out, &record_size, sizeof(record_size));
+  out += sizeof(record_size);
+  std::memcpy(out, &raw_time, sizeof(raw_time));
+  out += sizeof(raw_time);
+  std::memcpy(out, &raw_level, sizeof(raw_level));
+  out += sizeof(raw_level);
+  std::memcpy(out, &name_length, sizeof(name_length));
+  out += sizeof(name_length);
+  std::memcpy(out, name, name_length);
+
+  slot.payload = out + name_length;
+  return slot;
+}
+
+void AsyncLogBackend::Commit()
+{
+  auto &ring = *this_thread_ring;
+
+  ring.Commit();
+  ring.writing.store(false, std::memory_order_release);
+}
+
+uint64_t AsyncLogBackend::dropped()
+{
+  std::lock_guard<std::mutex> guard(lock_);
+
+  uint64_t total = retired_dropped_;
+  for (auto const &ring : rings_)
+  {
+    total += ring->dropped.load(std::memory_order_relaxed);
+  }
+
+  return total;
+}
+
+AsyncLogBackend::Rings AsyncLogBackend::GetRings()
+{
+  std::lock_guard<std::mutex> guard(lock_);
+
+  // forget about the rings of threads that have finished, once everything in them is written
+  auto const finished = [this](RingPtr const &ring) {
+    if ((ring.use_count() == 1) && ring->empty())
+    {
+      retired_dropped_ += ring->dropped.load(std::memory_order_relaxed);
+      return true;
+    }
+
+    return false;
+  };
+
+  rings_.erase(std::remove_if(rings_.begin(), rings_.end(), finished), rings_.end());
+
+  return rings_;
+}
+
+/**
+ * Write out everything that is currently queued
+ *
+ * @return true if any record was written, otherwise false
+ */
+bool AsyncLogBackend::Drain()
+{
+  bool written = false;
+
+  for (auto const &ring : GetRings())
+  {
+    while (ring->Consume(&AsyncLogBackend::Write))
+    {
+      written = true;
+    }
+  }
+
+  return written;
+}
+
+/**
+ * Wait for the background thread to write out everything queued in a ring
+ *
+ * @param ring The ring of the calling thread
+ */
+void AsyncLogBackend::WaitUntilWritten(LogRing const &ring)
+{
+  // the background thread (or Disable, once it has stopped) always drains every ring
+  while (!ring.empty())
+  {
+    wake_.notify_one();
+    std::this_thread::yield();
+  }
+}
+
+void AsyncLogBackend::ReportDrops()
+{
+  static constexpr std::chrono::seconds REPORT_INTERVAL{1};
+
+  Timestamp const now = Clock::now();
+  if ((now - last_report_) < REPORT_INTERVAL)
+  {
+    return;
+  }
+
+  last_report_ = now;
+
+  uint64_t const total = dropped();
+  if (total != reported_dropped_)
+  {
+    registry.Log(LogLevel::WARNING, "AsyncLogging",
+                 "Dropped " + std::to_string(total - reported_dropped_) +
+                     " log messages (total: " + std::to_string(total) + ")");
+
+    reported_dropped_ = total;
+  }
+}
+
+void AsyncLogBackend::Run()
+{
+  for (;;)
+  {
+    bool const written = Drain();
+    ReportDrops();
+
+    std::unique_lock<std::mutex> guard(lock_);
+    if (!running_)
+    {
+      break;
+    }
+
+    if (!written)
+    {
+      wake_.wait_for(guard, std::chrono::milliseconds(1));
+    }
+  }
+
+  // no more records can be queued at this point
+  Drain();
+  last_report_ = Timestamp{};
+  ReportDrops();
+}
+
+/**
+ * Format a record in the same way as detail::Format and write it to the registry
+ *
+ * @param record The record, starting with its size prefix
+ * @param size The size of the record
+ */
+void AsyncLogBackend::Write(uint8_t const *record, std::size_t size)
+{
+  using detail::LogArgumentTag;
+
+  uint8_t const *const end = record + size;
+
+  LogTime::rep raw_time    = 0;
+  uint8_t      raw_level   = 0;
+  uint16_t     name_length = 0;
+
+  uint8_t const *in = record + LogRing::SIZE_PREFIX;
+  std::memcpy(&raw_time, in, sizeof(raw_time));
+  in += sizeof(raw_time);
+  std::memcpy(&raw_level, in, sizeof(raw_level));
+  in += sizeof(raw_level);
+  std::memcpy(&name_length, in, sizeof(name_length));
+  in += sizeof(name_length);
+
+  std::string const name(reinterpret_cast<char const *>(in), name_length);
+  in += name_length;
+
+  auto const read = [&in](auto &value) {
+    std::memcpy(&value, in, sizeof(value));
+    in += sizeof(value);
+  };
+
+  std::ostringstream stream;
+  while (in < end)
+  {
+    auto const tag = static_cast<LogArgumentTag>(*in++);
+
+    switch (tag)
+    {
+    case LogArgumentTag::BOOL:
+    {
+      uint8_t value = 0;
+      read(value);
+      stream << (value != 0);
+      break;
+    }
+    case LogArgumentTag::CHAR:
+    {
+      char value = 0;
+      read(value);
+      stream << value;
+      break;
+    }
+    case LogArgumentTag::SIGNED:
+    {
+      int64_t value = 0;
+      read(value);
+      stream << value;
+      break;
+    }
+    case LogArgumentTag::UNSIGNED:
+    {
+      uint64_t value = 0;
+      read(value);
+      stream << value;
+      break;
+    }
+    case LogArgumentTag::FLOATING:
+    {
+      double value = 0;
+      read(value);
+      stream << value;
+      break;
+    }
+    case LogArgumentTag::POINTER:
+    {
+      void const *value = nullptr;
+      read(value);
+      stream << value;
+      break;
+    }
+    case LogArgumentTag::STRING:
+    {
+      uint32_t length = 0;
+      read(length);
+      stream.write(reinterpret_cast<char const *>(in), static_cast<std::streamsize>(length));
+      in += length;
+      break;
+    }
+    }
+  }
+
+  registry.Log(static_cast<LogLevel>(raw_level), name.c_str(), stream.str(),
+               LogTime{LogTime::duration{raw_time}});
+}
+
 }  // namespace
 
+namespace detail {
+
+bool IsLogLevelEnabled(LogLevel level)
+{
+  return level >= registry.global_level();
+}
+
+bool IsAsyncLoggingEnabled()
+{
+  return async_backend.enabled();
+}
+
+AsyncLogSlot BeginAsyncRecord(LogLevel level, char const *name, std::size_t payload_size)
+{
+  return async_backend.Begin(level, name, payload_size);
+}
+
+void CommitAsyncRecord()
+{
+  async_backend.Commit();
+}
+
+}  // namespace detail
+
 void SetLogLevel(char const *name, LogLevel level)
 {
   registry.SetLevel(name, level);
@@ -253,4 +905,19 @@ LogLevelMap GetLogLevelMap()
   return registry.GetLogLevelMap();
 }
 
+void EnableAsyncLogging(std::size_t ring_size, LogOverflowPolicy policy)
+{
+  async_backend.Enable(ring_size, policy);
+}
+
+void DisableAsyncLogging()
+{
+  async_backend.Disable();
+}
+
+uint64_t GetDroppedLogCount()
+{
+  return async_backend.dropped();
+}
+
 }  // namespace fetch
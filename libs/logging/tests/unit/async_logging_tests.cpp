@@ -0,0 +1,276 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "logging/logging.hpp"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <thread>
+
+namespace {
+
+using fetch::DisableAsyncLogging;
+using fetch::EnableAsyncLogging;
+using fetch::GetDroppedLogCount;
+using fetch::LogOverflowPolicy;
+
+constexpr char const *LOGGING_NAME = "AsyncLoggingTests";
+constexpr std::size_t RING_SIZE    = 4096;
+
+std::string Message(std::size_t index)
+{
+  return "async message " + std::to_string(index) + ".";
+}
+
+std::string FormatTime(std::chrono::system_clock::time_point time)
+{
+  std::time_t const seconds = std::chrono::system_clock::to_time_t(time);
+
+  char buffer[32] = {};
+  std::strftime(buffer, sizeof(buffer), "%Y/%m/%d %H:%M:%S", std::localtime(&seconds));
+
+  return buffer;
+}
+
+bool ContainsInOrder(std::string const &output, std::size_t count)
+{
+  std::size_t position = 0;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    position = output.find(Message(i), position);
+    if (position == std::string::npos)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+class AsyncLoggingTests : public ::testing::Test
+{
+protected:
+  void TearDown() override
+  {
+    DisableAsyncLogging();
+  }
+
+  // while stdout is locked the background thread can not write out any message
+  void BlockWriter()
+  {
+    flockfile(stdout);
+  }
+
+  void UnblockWriter()
+  {
+    funlockfile(stdout);
+  }
+};
+
+TEST_F(AsyncLoggingTests, WrapAroundKeepsMessagesInOrder)
+{
+  static constexpr std::size_t COUNT = 500;
+
+  testing::internal::CaptureStdout();
+
+  EnableAsyncLogging(RING_SIZE, LogOverflowPolicy::BLOCK);
+  for (std::size_t i = 0; i < COUNT; ++i)
+  {
+    fetch::LogInfoV2(LOGGING_NAME, "async message ", i, '.');
+  }
+  DisableAsyncLogging();
+
+  EXPECT_TRUE(ContainsInOrder(testing::internal::GetCapturedStdout(), COUNT));
+}
+
+TEST_F(AsyncLoggingTests, DisableWritesQueuedMessages)
+{
+  static constexpr std::size_t COUNT = 20;
+
+  testing::internal::CaptureStdout();
+
+  EnableAsyncLogging(RING_SIZE, LogOverflowPolicy::BLOCK);
+
+  BlockWriter();
+  for (std::size_t i = 0; i < COUNT; ++i)
+  {
+    fetch::LogInfoV2(LOGGING_NAME, Message(i));
+  }
+  UnblockWriter();
+
+  DisableAsyncLogging();
+
+  EXPECT_TRUE(ContainsInOrder(testing::internal::GetCapturedStdout(), COUNT));
+}
+
+TEST_F(AsyncLoggingTests, BlockPolicyWaitsForSpace)
+{
+  static constexpr std::size_t COUNT = 500;
+
+  uint64_t const dropped = GetDroppedLogCount();
+
+  testing::internal::CaptureStdout();
+
+  EnableAsyncLogging(RING_SIZE, LogOverflowPolicy::BLOCK);
+
+  std::atomic<std::size_t> logged{0};
+
+  BlockWriter();
+  std::thread producer([&logged]() {
+    for (std::size_t i = 0; i < COUNT; ++i)
+    {
+      fetch::LogInfoV2(LOGGING_NAME, "async message ", i, '.');
+      ++logged;
+    }
+  });
+
+  // the ring holds much less than all of the messages
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  std::size_t const logged_while_blocked = logged;
+
+  UnblockWriter();
+  producer.join();
+
+  DisableAsyncLogging();
+
+  EXPECT_LT(logged_while_blocked, COUNT);
+  EXPECT_TRUE(ContainsInOrder(testing::internal::GetCapturedStdout(), COUNT));
+  EXPECT_EQ(dropped, GetDroppedLogCount());
+}
+
+TEST_F(AsyncLoggingTests, DropPolicyCountsAndReportsDroppedMessages)
+{
+  static constexpr std::size_t COUNT = 500;
+
+  uint64_t const dropped_before = GetDroppedLogCount();
+
+  testing::internal::CaptureStdout();
+
+  EnableAsyncLogging(RING_SIZE, LogOverflowPolicy::DROP);
+
+  BlockWriter();
+  for (std::size_t i = 0; i < COUNT; ++i)
+  {
+    fetch::LogInfoV2(LOGGING_NAME, "async message ", i, '.');
+  }
+  UnblockWriter();
+
+  DisableAsyncLogging();
+
+  std::string const output        = testing::internal::GetCapturedStdout();
+  uint64_t const    dropped_after = GetDroppedLogCount();
+
+  std::size_t written = 0;
+  for (std::size_t i = 0; i < COUNT; ++i)
+  {
+    if (output.find(Message(i)) != std::string::npos)
+    {
+      ++written;
+    }
+  }
+
+  EXPECT_GT(written, 0u);
+  EXPECT_GT(dropped_after, dropped_before);
+  EXPECT_EQ(COUNT, written + (dropped_after - dropped_before));
+  EXPECT_NE(std::string::npos, output.find("(total: " + std::to_string(dropped_after) + ")"));
+}
+
+TEST_F(AsyncLoggingTests, ErrorsAreWrittenAfterQueuedMessages)
+{
+  static constexpr std::size_t COUNT = 50;
+
+  testing::internal::CaptureStdout();
+
+  EnableAsyncLogging(RING_SIZE, LogOverflowPolicy::BLOCK);
+  for (std::size_t i = 0; i < COUNT; ++i)
+  {
+    fetch::LogInfoV2(LOGGING_NAME, "async message ", i, '.');
+  }
+  fetch::LogErrorV2(LOGGING_NAME, "async error");
+
+  // the error is written by the time the call returns, without waiting for Disable
+  std::string const output = testing::internal::GetCapturedStdout();
+
+  EXPECT_TRUE(ContainsInOrder(output, COUNT));
+  EXPECT_GT(output.find("async error"), output.find(Message(COUNT - 1)));
+  EXPECT_NE(std::string::npos, output.find("async error"));
+}
+
+TEST_F(AsyncLoggingTests, LargeMessagesAreWrittenAfterQueuedMessages)
+{
+  static constexpr std::size_t COUNT = 50;
+
+  std::string const large(RING_SIZE, 'x');
+
+  testing::internal::CaptureStdout();
+
+  EnableAsyncLogging(RING_SIZE, LogOverflowPolicy::BLOCK);
+  for (std::size_t i = 0; i < COUNT; ++i)
+  {
+    fetch::LogInfoV2(LOGGING_NAME, "async message ", i, '.');
+  }
+  fetch::LogInfoV2(LOGGING_NAME, large);
+  fetch::LogInfoV2(LOGGING_NAME, Message(COUNT));
+  DisableAsyncLogging();
+
+  std::string const output = testing::internal::GetCapturedStdout();
+
+  EXPECT_TRUE(ContainsInOrder(output, COUNT + 1));
+  EXPECT_GT(output.find(large), output.find(Message(COUNT - 1)));
+  EXPECT_LT(output.find(large), output.find(Message(COUNT)));
+}
+
+TEST_F(AsyncLoggingTests, TimestampIsTakenWhenLogged)
+{
+  testing::internal::CaptureStdout();
+
+  EnableAsyncLogging(RING_SIZE, LogOverflowPolicy::BLOCK);
+
+  // the background thread stops on the first message, so the second one stays queued
+  BlockWriter();
+  fetch::LogInfoV2(LOGGING_NAME, "async blocker");
+
+  auto const before = std::chrono::system_clock::now();
+  fetch::LogInfoV2(LOGGING_NAME, "async timestamp");
+  auto const after = std::chrono::system_clock::now();
+
+  // the message is written in a later second than it was logged in
+  std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+  UnblockWriter();
+
+  DisableAsyncLogging();
+
+  std::string const output = testing::internal::GetCapturedStdout();
+
+  std::size_t const end   = output.find("async timestamp");
+  std::size_t const begin = output.rfind('\n', end) + 1;
+  std::string const line  = output.substr(begin, end - begin);
+
+  ASSERT_NE(std::string::npos, end);
+  EXPECT_TRUE((line.find(FormatTime(before)) != std::string::npos) ||
+              (line.find(FormatTime(after)) != std::string::npos));
+}
+
+}  // namespace
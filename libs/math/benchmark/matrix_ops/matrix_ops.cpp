@@ -16,13 +16,31 @@
 //
 //------------------------------------------------------------------------------
 
+#include "math/linalg/blas/base.hpp"
+#include "math/linalg/blas/gemm_nn_novector.hpp"
+#include "math/linalg/blas/gemm_nn_threaded.hpp"
+#include "math/linalg/blas/gemm_nn_vector.hpp"
+#include "math/linalg/prototype.hpp"
 #include "math/matrix_operations.hpp"
 #include "math/tensor/tensor.hpp"
 
 #include "benchmark/benchmark.h"
 
+#include <cstdint>
 #include <vector>
 
+namespace {
+
+// report the throughput of an (m x k) by (k x n) matrix product in GFLOP/s
+void SetGemmCounters(benchmark::State &state, fetch::math::SizeType m, fetch::math::SizeType n,
+                     fetch::math::SizeType k)
+{
+  state.counters["GFLOP/s"] = benchmark::Counter(static_cast<double>(2 * m * n * k) * 1e-9,
+                                                 benchmark::Counter::kIsIterationInvariantRate);
+}
+
+}  // namespace
+
 template <class T, int C, int H, int W>
 void BM_BooleanMaskEmpty(benchmark::State &state)
 {
@@ -656,6 +674,8 @@ void BM_Dot(benchmark::State &state)
   {
     fetch::math::Dot(t, ret);
   }
+
+  SetGemmCounters(state, H, W, W);
 }
 
 BENCHMARK_TEMPLATE(BM_Dot, int, 256, 256)->Unit(benchmark::kMillisecond);
@@ -700,6 +720,8 @@ void BM_DotTranspose(benchmark::State &state)
   {
     fetch::math::DotTranspose(t, ret);
   }
+
+  SetGemmCounters(state, H, W, W);
 }
 
 BENCHMARK_TEMPLATE(BM_DotTranspose, int, 256, 256)->Unit(benchmark::kMillisecond);
@@ -744,6 +766,8 @@ void BM_TransposeDot(benchmark::State &state)
   {
     fetch::math::TransposeDot(t, ret);
   }
+
+  SetGemmCounters(state, H, W, W);
 }
 
 BENCHMARK_TEMPLATE(BM_TransposeDot, int, 256, 256)->Unit(benchmark::kMillisecond);
@@ -770,6 +794,57 @@ BENCHMARK_TEMPLATE(BM_TransposeDot, fetch::fixed_point::FixedPoint<16, 16>, 512,
 BENCHMARK_TEMPLATE(BM_TransposeDot, fetch::fixed_point::FixedPoint<32, 32>, 512, 512)
     ->Unit(benchmark::kMillisecond);
 
+template <class T, uint64_t P, int N>
+void BM_Gemm(benchmark::State &state)
+{
+  using SizeType = fetch::math::SizeType;
+  using namespace fetch::math::linalg;
+
+  fetch::math::Tensor<T> a(std::vector<SizeType>{N, N});
+  fetch::math::Tensor<T> b(std::vector<SizeType>{N, N});
+  fetch::math::Tensor<T> c(std::vector<SizeType>{N, N});
+  a.FillUniformRandom();
+  b.FillUniformRandom();
+
+  Blas<T, Signature(_C <= _alpha, _A, _B, _beta, _C),
+       Computes(_C <= _alpha * _A * _B + _beta * _C), P>
+      gemm_nn;
+
+  for (auto _ : state)
+  {
+    gemm_nn(T{1}, a.View(), b.View(), T{0}, c.View());
+  }
+
+  SetGemmCounters(state, N, N, N);
+}
+
+constexpr uint64_t NOT_PARALLEL = fetch::platform::Parallelisation::NOT_PARALLEL;
+constexpr uint64_t VECTORISE    = fetch::platform::Parallelisation::VECTORISE;
+constexpr uint64_t THREADED =
+    fetch::platform::Parallelisation::VECTORISE | fetch::platform::Parallelisation::THREADING;
+
+BENCHMARK_TEMPLATE(BM_Gemm, float, NOT_PARALLEL, 256)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Gemm, float, VECTORISE, 256)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Gemm, float, THREADED, 256)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Gemm, double, NOT_PARALLEL, 256)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Gemm, double, VECTORISE, 256)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Gemm, double, THREADED, 256)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Gemm, fetch::fixed_point::FixedPoint<16, 16>, NOT_PARALLEL, 256)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Gemm, fetch::fixed_point::FixedPoint<16, 16>, THREADED, 256)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Gemm, fetch::fixed_point::FixedPoint<32, 32>, NOT_PARALLEL, 256)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Gemm, fetch::fixed_point::FixedPoint<32, 32>, THREADED, 256)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_Gemm, float, NOT_PARALLEL, 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Gemm, float, VECTORISE, 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Gemm, float, THREADED, 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Gemm, double, NOT_PARALLEL, 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Gemm, double, VECTORISE, 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Gemm, double, THREADED, 1024)->Unit(benchmark::kMillisecond);
+
 template <class T, int C, int H, int W>
 void BM_DynamicStitch(benchmark::State &state)
 {
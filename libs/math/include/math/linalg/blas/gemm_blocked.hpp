@@ -0,0 +1,56 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <cstddef>
+
+namespace fetch {
+namespace math {
+namespace linalg {
+namespace details {
+
+/**
+ * A read only matrix operand of the blocked GEMM. The element (i, j) is found at
+ * data[i * row_stride + j * column_stride], which allows transposed operands to be described by
+ * swapping the strides.
+ */
+template <typename T>
+struct GemmOperand
+{
+  T const *   data{nullptr};
+  std::size_t row_stride{1};
+  std::size_t column_stride{1};
+};
+
+/**
+ * Computes C = alpha * A * B + beta * C, with A (m x k), B (k x n) and C (m x n) column major
+ * with the leading dimension ldc.
+ *
+ * The product is computed in the style of GotoBLAS: blocks of A and panels of B are packed into
+ * contiguous buffers sized for the caches, and a register blocked micro-kernel computes each
+ * small tile of C. Large products are partitioned over the rows or columns of C and computed in
+ * parallel, the partitioning never changes the order of the accumulation of each element.
+ */
+template <typename T>
+void GemmBlocked(std::size_t m, std::size_t n, std::size_t k, T alpha, GemmOperand<T> const &a,
+                 GemmOperand<T> const &b, T beta, T *c, std::size_t ldc);
+
+}  // namespace details
+}  // namespace linalg
+}  // namespace math
+}  // namespace fetch
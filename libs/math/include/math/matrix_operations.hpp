@@ -22,10 +22,13 @@
 #include "math/fundamental_operators.hpp"
 #include "math/linalg/blas/base.hpp"
 #include "math/linalg/blas/gemm_nn_novector.hpp"
+#include "math/linalg/blas/gemm_nn_threaded.hpp"
 #include "math/linalg/blas/gemm_nn_vector.hpp"
 #include "math/linalg/blas/gemm_nt_novector.hpp"
+#include "math/linalg/blas/gemm_nt_threaded.hpp"
 #include "math/linalg/blas/gemm_nt_vector.hpp"
 #include "math/linalg/blas/gemm_tn_novector.hpp"
+#include "math/linalg/blas/gemm_tn_threaded.hpp"
 #include "math/linalg/blas/gemm_tn_vector.hpp"
 #include "math/linalg/prototype.hpp"
 #include "math/meta/math_type_traits.hpp"
@@ -1085,9 +1088,10 @@ fetch::math::meta::IfIsMathArray<ArrayType, void> Dot(ArrayType const &A, ArrayT
 
   enum
   {
-    OPTIMISATION_FLAGS = meta::HasVectorSupport<Type>::value
-                             ? platform::Parallelisation::VECTORISE
-                             : platform::Parallelisation::NOT_PARALLEL
+    OPTIMISATION_FLAGS =
+        meta::HasVectorSupport<Type>::value
+            ? platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING
+            : platform::Parallelisation::NOT_PARALLEL
   };
 
   Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
@@ -1135,9 +1139,10 @@ fetch::math::meta::IfIsMathArray<ArrayType, void> DotTranspose(ArrayType const &
 
   enum
   {
-    OPTIMISATION_FLAGS = meta::HasVectorSupport<Type>::value
-                             ? platform::Parallelisation::VECTORISE
-                             : platform::Parallelisation::NOT_PARALLEL
+    OPTIMISATION_FLAGS =
+        meta::HasVectorSupport<Type>::value
+            ? platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING
+            : platform::Parallelisation::NOT_PARALLEL
   };
 
   Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
@@ -1186,9 +1191,10 @@ fetch::math::meta::IfIsMathArray<ArrayType, void> TransposeDot(ArrayType const &
 
   enum
   {
-    OPTIMISATION_FLAGS = meta::HasVectorSupport<Type>::value
-                             ? platform::Parallelisation::VECTORISE
-                             : platform::Parallelisation::NOT_PARALLEL
+    OPTIMISATION_FLAGS =
+        meta::HasVectorSupport<Type>::value
+            ? platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING
+            : platform::Parallelisation::NOT_PARALLEL
   };
 
   Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
@@ -0,0 +1,490 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/base_types.hpp"
+#include "math/linalg/blas/gemm_blocked.hpp"
+#include "vectorise/fixed_point/fixed_point.hpp"
+#include "vectorise/fixed_point/type_traits.hpp"
+#include "vectorise/threading/parallel_chunks.hpp"
+#include "vectorise/threading/pool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace fetch {
+namespace math {
+namespace linalg {
+namespace details {
+namespace {
+
+// the minimum number of multiply-adds to be given to each thread
+constexpr std::size_t MIN_WORK_PER_THREAD = std::size_t{1} << 20u;
+
+/**
+ * The register blocked micro-kernel, computing the MR x NR tile of C (column major) from a packed
+ * sliver of A (MR rows, interleaved by column) and a packed sliver of B (NR columns, interleaved
+ * by row). The cache blocking parameters are chosen with the kernel: an MC x KC block of A is
+ * kept in L2 while a KC x NC panel of B lives in L3.
+ */
+template <typename T>
+struct GemmKernel
+{
+  static constexpr std::size_t MR = 4;
+  static constexpr std::size_t NR = 4;
+  static constexpr std::size_t MC = 64;
+  static constexpr std::size_t KC = 128;
+  static constexpr std::size_t NC = 1024;
+
+  static void Run(std::size_t kc, T const *a, T const *b, T *tile)
+  {
+    T acc[MR * NR];
+    std::fill(acc, acc + (MR * NR), T{0});
+
+    for (std::size_t l = 0; l < kc; ++l)
+    {
+      for (std::size_t q = 0; q < NR; ++q)
+      {
+        for (std::size_t r = 0; r < MR; ++r)
+        {
+          acc[(q * MR) + r] = static_cast<T>(acc[(q * MR) + r] + a[r] * b[q]);
+        }
+      }
+
+      a += MR;
+      b += NR;
+    }
+
+    std::copy(acc, acc + (MR * NR), tile);
+  }
+};
+
+#if defined(__AVX2__)
+
+inline __m256 MultiplyAdd(__m256 const &a, __m256 const &b, __m256 const &c)
+{
+#if defined(__FMA__)
+  return _mm256_fmadd_ps(a, b, c);
+#else
+  return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+}
+
+inline __m256d MultiplyAdd(__m256d const &a, __m256d const &b, __m256d const &c)
+{
+#if defined(__FMA__)
+  return _mm256_fmadd_pd(a, b, c);
+#else
+  return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+}
+
+// 16 x 6 tile: 12 accumulators, 2 values of A and a broadcast value of B fit the 16 registers
+template <>
+struct GemmKernel<float>
+{
+  static constexpr std::size_t MR = 16;
+  static constexpr std::size_t NR = 6;
+  static constexpr std::size_t MC = 144;
+  static constexpr std::size_t KC = 256;
+  static constexpr std::size_t NC = 3072;
+
+  static void Run(std::size_t kc, float const *a, float const *b, float *tile)
+  {
+    // the columns are unrolled by hand to keep the accumulators in registers
+    __m256 c00 = _mm256_setzero_ps();
+    __m256 c01 = _mm256_setzero_ps();
+    __m256 c02 = _mm256_setzero_ps();
+    __m256 c03 = _mm256_setzero_ps();
+    __m256 c04 = _mm256_setzero_ps();
+    __m256 c05 = _mm256_setzero_ps();
+    __m256 c10 = _mm256_setzero_ps();
+    __m256 c11 = _mm256_setzero_ps();
+    __m256 c12 = _mm256_setzero_ps();
+    __m256 c13 = _mm256_setzero_ps();
+    __m256 c14 = _mm256_setzero_ps();
+    __m256 c15 = _mm256_setzero_ps();
+
+    for (std::size_t l = 0; l < kc; ++l)
+    {
+      __m256 const a0 = _mm256_loadu_ps(a);
+      __m256 const a1 = _mm256_loadu_ps(a + 8);
+
+      __m256 const b0 = _mm256_broadcast_ss(b);
+      c00             = MultiplyAdd(a0, b0, c00);
+      c10             = MultiplyAdd(a1, b0, c10);
+
+      __m256 const b1 = _mm256_broadcast_ss(b + 1);
+      c01             = MultiplyAdd(a0, b1, c01);
+      c11             = MultiplyAdd(a1, b1, c11);
+
+      __m256 const b2 = _mm256_broadcast_ss(b + 2);
+      c02             = MultiplyAdd(a0, b2, c02);
+      c12             = MultiplyAdd(a1, b2, c12);
+
+      __m256 const b3 = _mm256_broadcast_ss(b + 3);
+      c03             = MultiplyAdd(a0, b3, c03);
+      c13             = MultiplyAdd(a1, b3, c13);
+
+      __m256 const b4 = _mm256_broadcast_ss(b + 4);
+      c04             = MultiplyAdd(a0, b4, c04);
+      c14             = MultiplyAdd(a1, b4, c14);
+
+      __m256 const b5 = _mm256_broadcast_ss(b + 5);
+      c05             = MultiplyAdd(a0, b5, c05);
+      c15             = MultiplyAdd(a1, b5, c15);
+
+      a += MR;
+      b += NR;
+    }
+
+    _mm256_storeu_ps(tile, c00);
+    _mm256_storeu_ps(tile + 8, c10);
+    _mm256_storeu_ps(tile + 16, c01);
+    _mm256_storeu_ps(tile + 24, c11);
+    _mm256_storeu_ps(tile + 32, c02);
+    _mm256_storeu_ps(tile + 40, c12);
+    _mm256_storeu_ps(tile + 48, c03);
+    _mm256_storeu_ps(tile + 56, c13);
+    _mm256_storeu_ps(tile + 64, c04);
+    _mm256_storeu_ps(tile + 72, c14);
+    _mm256_storeu_ps(tile + 80, c05);
+    _mm256_storeu_ps(tile + 88, c15);
+  }
+};
+
+// 8 x 6 tile, the double precision equivalent of the single precision kernel
+template <>
+struct GemmKernel<double>
+{
+  static constexpr std::size_t MR = 8;
+  static constexpr std::size_t NR = 6;
+  static constexpr std::size_t MC = 96;
+  static constexpr std::size_t KC = 256;
+  static constexpr std::size_t NC = 3072;
+
+  static void Run(std::size_t kc, double const *a, double const *b, double *tile)
+  {
+    // the columns are unrolled by hand to keep the accumulators in registers
+    __m256d c00 = _mm256_setzero_pd();
+    __m256d c01 = _mm256_setzero_pd();
+    __m256d c02 = _mm256_setzero_pd();
+    __m256d c03 = _mm256_setzero_pd();
+    __m256d c04 = _mm256_setzero_pd();
+    __m256d c05 = _mm256_setzero_pd();
+    __m256d c10 = _mm256_setzero_pd();
+    __m256d c11 = _mm256_setzero_pd();
+    __m256d c12 = _mm256_setzero_pd();
+    __m256d c13 = _mm256_setzero_pd();
+    __m256d c14 = _mm256_setzero_pd();
+    __m256d c15 = _mm256_setzero_pd();
+
+    for (std::size_t l = 0; l < kc; ++l)
+    {
+      __m256d const a0 = _mm256_loadu_pd(a);
+      __m256d const a1 = _mm256_loadu_pd(a + 4);
+
+      __m256d const b0 = _mm256_broadcast_sd(b);
+      c00              = MultiplyAdd(a0, b0, c00);
+      c10              = MultiplyAdd(a1, b0, c10);
+
+      __m256d const b1 = _mm256_broadcast_sd(b + 1);
+      c01              = MultiplyAdd(a0, b1, c01);
+      c11              = MultiplyAdd(a1, b1, c11);
+
+      __m256d const b2 = _mm256_broadcast_sd(b + 2);
+      c02              = MultiplyAdd(a0, b2, c02);
+      c12              = MultiplyAdd(a1, b2, c12);
+
+      __m256d const b3 = _mm256_broadcast_sd(b + 3);
+      c03              = MultiplyAdd(a0, b3, c03);
+      c13              = MultiplyAdd(a1, b3, c13);
+
+      __m256d const b4 = _mm256_broadcast_sd(b + 4);
+      c04              = MultiplyAdd(a0, b4, c04);
+      c14              = MultiplyAdd(a1, b4, c14);
+
+      __m256d const b5 = _mm256_broadcast_sd(b + 5);
+      c05              = MultiplyAdd(a0, b5, c05);
+      c15              = MultiplyAdd(a1, b5, c15);
+
+      a += MR;
+      b += NR;
+    }
+
+    _mm256_storeu_pd(tile, c00);
+    _mm256_storeu_pd(tile + 4, c10);
+    _mm256_storeu_pd(tile + 8, c01);
+    _mm256_storeu_pd(tile + 12, c11);
+    _mm256_storeu_pd(tile + 16, c02);
+    _mm256_storeu_pd(tile + 20, c12);
+    _mm256_storeu_pd(tile + 24, c03);
+    _mm256_storeu_pd(tile + 28, c13);
+    _mm256_storeu_pd(tile + 32, c04);
+    _mm256_storeu_pd(tile + 36, c14);
+    _mm256_storeu_pd(tile + 40, c05);
+    _mm256_storeu_pd(tile + 44, c15);
+  }
+};
+
+#endif
+
+/**
+ * Pack an mc x kc block of A, starting at (row, col), into slivers of MR rows. Rows beyond the
+ * end of the block are zero filled so that the kernel never needs to handle partial tiles.
+ */
+template <typename T>
+void PackA(GemmOperand<T> const &a, std::size_t row, std::size_t col, std::size_t mc,
+           std::size_t kc, T *packed)
+{
+  constexpr std::size_t MR = GemmKernel<T>::MR;
+
+  for (std::size_t i = 0; i < mc; i += MR)
+  {
+    std::size_t const rows = std::min(MR, mc - i);
+
+    for (std::size_t l = 0; l < kc; ++l)
+    {
+      T const *src = a.data + ((row + i) * a.row_stride) + ((col + l) * a.column_stride);
+
+      for (std::size_t r = 0; r < rows; ++r)
+      {
+        packed[r] = src[r * a.row_stride];
+      }
+
+      std::fill(packed + rows, packed + MR, T{0});
+      packed += MR;
+    }
+  }
+}
+
+/**
+ * Pack a kc x nc panel of B, starting at (row, col), into slivers of NR columns
+ */
+template <typename T>
+void PackB(GemmOperand<T> const &b, std::size_t row, std::size_t col, std::size_t kc,
+           std::size_t nc, T *packed)
+{
+  constexpr std::size_t NR = GemmKernel<T>::NR;
+
+  for (std::size_t j = 0; j < nc; j += NR)
+  {
+    std::size_t const columns = std::min(NR, nc - j);
+
+    for (std::size_t l = 0; l < kc; ++l)
+    {
+      T const *src = b.data + ((row + l) * b.row_stride) + ((col + j) * b.column_stride);
+
+      for (std::size_t q = 0; q < columns; ++q)
+      {
+        packed[q] = src[q * b.column_stride];
+      }
+
+      std::fill(packed + columns, packed + NR, T{0});
+      packed += NR;
+    }
+  }
+}
+
+template <typename T>
+void Scale(std::size_t m, std::size_t n, T beta, T *c, std::size_t ldc)
+{
+  if (beta == T{1})
+  {
+    return;
+  }
+
+  for (std::size_t j = 0; j < n; ++j)
+  {
+    T *column = c + (j * ldc);
+
+    for (std::size_t i = 0; i < m; ++i)
+    {
+      column[i] = (beta == T{0}) ? T{0} : static_cast<T>(beta * column[i]);
+    }
+  }
+}
+
+/**
+ * Accumulate alpha * A * B into C on the calling thread
+ */
+template <typename T>
+void GemmSerial(std::size_t m, std::size_t n, std::size_t k, T alpha, GemmOperand<T> const &a,
+                GemmOperand<T> const &b, T *c, std::size_t ldc)
+{
+  using Kernel = GemmKernel<T>;
+
+  constexpr std::size_t MR = Kernel::MR;
+  constexpr std::size_t NR = Kernel::NR;
+
+  // the packing buffers are reused by all the products computed on this thread
+  thread_local std::vector<T> packed_a;
+  thread_local std::vector<T> packed_b;
+
+  packed_a.resize(Kernel::MC * Kernel::KC);
+  packed_b.resize(Kernel::KC * (((std::min(Kernel::NC, n) + NR - 1) / NR) * NR));
+
+  T tile[MR * NR];
+
+  for (std::size_t jc = 0; jc < n; jc += Kernel::NC)
+  {
+    std::size_t const nc = std::min(Kernel::NC, n - jc);
+
+    for (std::size_t pc = 0; pc < k; pc += Kernel::KC)
+    {
+      std::size_t const kc = std::min(Kernel::KC, k - pc);
+      PackB(b, pc, jc, kc, nc, packed_b.data());
+
+      for (std::size_t ic = 0; ic < m; ic += Kernel::MC)
+      {
+        std::size_t const mc = std::min(Kernel::MC, m - ic);
+        PackA(a, ic, pc, mc, kc, packed_a.data());
+
+        for (std::size_t jr = 0; jr < nc; jr += NR)
+        {
+          std::size_t const columns = std::min(NR, nc - jr);
+
+          for (std::size_t ir = 0; ir < mc; ir += MR)
+          {
+            std::size_t const rows = std::min(MR, mc - ir);
+            Kernel::Run(kc, packed_a.data() + (ir * kc), packed_b.data() + (jr * kc), tile);
+
+            T *block = c + ((jc + jr) * ldc) + ic + ir;
+            for (std::size_t q = 0; q < columns; ++q)
+            {
+              for (std::size_t r = 0; r < rows; ++r)
+              {
+                T const product = (alpha == T{1}) ? tile[(q * MR) + r]
+                                                  : static_cast<T>(alpha * tile[(q * MR) + r]);
+
+                block[(q * ldc) + r] = static_cast<T>(block[(q * ldc) + r] + product);
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+threading::Pool &GemmPool()
+{
+  static threading::Pool pool{
+      std::max(std::size_t{1}, std::size_t{std::thread::hardware_concurrency()}), "GEMM"};
+  return pool;
+}
+
+}  // namespace
+
+template <typename T>
+void GemmBlocked(std::size_t m, std::size_t n, std::size_t k, T alpha, GemmOperand<T> const &a,
+                 GemmOperand<T> const &b, T beta, T *c, std::size_t ldc)
+{
+  if ((m == 0) || (n == 0) || (((alpha == T{0}) || (k == 0)) && (beta == T{1})))
+  {
+    return;
+  }
+
+  Scale(m, n, beta, c, ldc);
+
+  if ((alpha == T{0}) || (k == 0))
+  {
+    return;
+  }
+
+  // fixed point arithmetic reports overflows through a shared state, so it stays on this thread
+  std::size_t threads = 1;
+  if (!meta::IsFixedPoint<T>)
+  {
+    threads = std::min(GemmPool().concurrency(), (m * n * k) / MIN_WORK_PER_THREAD);
+  }
+
+  if (threads <= 1)
+  {
+    GemmSerial(m, n, k, alpha, a, b, c, ldc);
+    return;
+  }
+
+  // partition the larger of the dimensions of C, in multiples of the tile size
+  bool const        split_columns = (n >= m);
+  std::size_t const granularity   = split_columns ? GemmKernel<T>::NR : GemmKernel<T>::MR;
+  std::size_t const extent        = split_columns ? n : m;
+  std::size_t const tiles         = (extent + granularity - 1) / granularity;
+  std::size_t const jobs          = std::min(threads, tiles);
+  std::size_t const chunk         = ((tiles + jobs - 1) / jobs) * granularity;
+
+  auto const compute = [=](std::size_t start, std::size_t end) {
+    std::size_t const size = end - start;
+
+    if (split_columns)
+    {
+      GemmOperand<T> const sub_b{b.data + (start * b.column_stride), b.row_stride,
+                                 b.column_stride};
+      GemmSerial(m, size, k, alpha, a, sub_b, c + (start * ldc), ldc);
+    }
+    else
+    {
+      GemmOperand<T> const sub_a{a.data + (start * a.row_stride), a.row_stride, a.column_stride};
+      GemmSerial(size, n, k, alpha, sub_a, b, c + start, ldc);
+    }
+  };
+
+  threading::ParallelChunks(GemmPool(), extent, chunk, compute);
+}
+
+template void GemmBlocked<float>(std::size_t, std::size_t, std::size_t, float,
+                                 GemmOperand<float> const &, GemmOperand<float> const &, float,
+                                 float *, std::size_t);
+template void GemmBlocked<double>(std::size_t, std::size_t, std::size_t, double,
+                                  GemmOperand<double> const &, GemmOperand<double> const &, double,
+                                  double *, std::size_t);
+template void GemmBlocked<int32_t>(std::size_t, std::size_t, std::size_t, int32_t,
+                                   GemmOperand<int32_t> const &, GemmOperand<int32_t> const &,
+                                   int32_t, int32_t *, std::size_t);
+template void GemmBlocked<int64_t>(std::size_t, std::size_t, std::size_t, int64_t,
+                                   GemmOperand<int64_t> const &, GemmOperand<int64_t> const &,
+                                   int64_t, int64_t *, std::size_t);
+template void GemmBlocked<fixed_point::fp32_t>(std::size_t, std::size_t, std::size_t,
+                                               fixed_point::fp32_t,
+                                               GemmOperand<fixed_point::fp32_t> const &,
+                                               GemmOperand<fixed_point::fp32_t> const &,
+                                               fixed_point::fp32_t, fixed_point::fp32_t *,
+                                               std::size_t);
+template void GemmBlocked<fixed_point::fp64_t>(std::size_t, std::size_t, std::size_t,
+                                               fixed_point::fp64_t,
+                                               GemmOperand<fixed_point::fp64_t> const &,
+                                               GemmOperand<fixed_point::fp64_t> const &,
+                                               fixed_point::fp64_t, fixed_point::fp64_t *,
+                                               std::size_t);
+template void GemmBlocked<fixed_point::fp128_t>(std::size_t, std::size_t, std::size_t,
+                                                fixed_point::fp128_t,
+                                                GemmOperand<fixed_point::fp128_t> const &,
+                                                GemmOperand<fixed_point::fp128_t> const &,
+                                                fixed_point::fp128_t, fixed_point::fp128_t *,
+                                                std::size_t);
+
+}  // namespace details
+}  // namespace linalg
+}  // namespace math
+}  // namespace fetch
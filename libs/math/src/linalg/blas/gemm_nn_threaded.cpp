@@ -0,0 +1,76 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/linalg/blas/base.hpp"
+#include "math/linalg/blas/gemm_blocked.hpp"
+#include "math/linalg/blas/gemm_nn_threaded.hpp"
+#include "math/linalg/prototype.hpp"
+#include "math/tensor/tensor_view.hpp"
+
+namespace fetch {
+namespace math {
+namespace linalg {
+
+template <typename S>
+void Blas<S, Signature(_C <= _alpha, _A, _B, _beta, _C),
+          Computes(_C <= _alpha * _A * _B + _beta * _C),
+          platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING>::
+     operator()(Type const alpha, TensorView<Type> const a, TensorView<Type> const b, Type const beta,
+           TensorView<Type> c) const
+{
+  details::GemmOperand<Type> const op_a{a.data().pointer(), 1, a.padded_height()};
+  details::GemmOperand<Type> const op_b{b.data().pointer(), 1, b.padded_height()};
+
+  details::GemmBlocked(c.height(), c.width(), a.width(), alpha, op_a, op_b, beta,
+                       c.data().pointer(), c.padded_height());
+}
+
+template class Blas<int32_t, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                    Computes(_C <= _alpha * _A * _B + _beta * _C),
+                    platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING>;
+
+template class Blas<int64_t, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                    Computes(_C <= _alpha * _A * _B + _beta * _C),
+                    platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING>;
+
+template class Blas<double, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                    Computes(_C <= _alpha * _A * _B + _beta * _C),
+                    platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING>;
+
+template class Blas<float, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                    Computes(_C <= _alpha * _A * _B + _beta * _C),
+                    platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING>;
+
+template class Blas<fetch::fixed_point::FixedPoint<16, 16>,
+                    Signature(_C <= _alpha, _A, _B, _beta, _C),
+                    Computes(_C <= _alpha * _A * _B + _beta * _C),
+                    platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING>;
+
+template class Blas<fetch::fixed_point::FixedPoint<32, 32>,
+                    Signature(_C <= _alpha, _A, _B, _beta, _C),
+                    Computes(_C <= _alpha * _A * _B + _beta * _C),
+                    platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING>;
+
+template class Blas<fetch::fixed_point::FixedPoint<64, 64>,
+                    Signature(_C <= _alpha, _A, _B, _beta, _C),
+                    Computes(_C <= _alpha * _A * _B + _beta * _C),
+                    platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING>;
+
+}  // namespace linalg
+}  // namespace math
+}  // namespace fetch
@@ -0,0 +1,136 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/linalg/blas/base.hpp"
+#include "math/linalg/blas/gemm_nn_novector.hpp"
+#include "math/linalg/blas/gemm_nn_threaded.hpp"
+#include "math/linalg/blas/gemm_nt_novector.hpp"
+#include "math/linalg/blas/gemm_nt_threaded.hpp"
+#include "math/linalg/blas/gemm_tn_novector.hpp"
+#include "math/linalg/blas/gemm_tn_threaded.hpp"
+#include "math/linalg/prototype.hpp"
+#include "math/tensor/tensor.hpp"
+#include "test_types.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+
+using namespace fetch;
+using namespace fetch::math;
+using namespace fetch::math::linalg;
+
+namespace {
+
+constexpr uint64_t THREADED =
+    platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING;
+
+// shapes which are not multiples of the tiles, and large enough to be blocked and threaded
+std::vector<std::vector<SizeType>> const SHAPES = {
+    {1, 1, 1}, {3, 5, 7}, {17, 13, 9}, {65, 300, 31}, {300, 257, 129}};
+
+template <typename T>
+class BlasGemmThreadedTest : public ::testing::Test
+{
+};
+
+TYPED_TEST_SUITE(BlasGemmThreadedTest, math::test::FloatingTypes, );
+
+template <typename Type, typename Reference, typename Threaded>
+void CheckAgainstReference(Tensor<Type> const &a, Tensor<Type> const &b, SizeType m, SizeType n,
+                           Type alpha, Type beta)
+{
+  Tensor<Type> c({m, n});
+  c.FillUniformRandom();
+  Tensor<Type> expected = c.Copy();
+
+  Reference reference;
+  reference(alpha, a.View(), b.View(), beta, expected.View());
+
+  Threaded threaded;
+  threaded(alpha, a.View(), b.View(), beta, c.View());
+
+  ASSERT_TRUE(expected.AllClose(c, fetch::math::Type<Type>("0.0001"),
+                                fetch::math::Type<Type>("0.0001")));
+}
+
+}  // namespace
+
+TYPED_TEST(BlasGemmThreadedTest, gemm_nn_matches_reference)
+{
+  using Type      = TypeParam;
+  using Reference = Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                         Computes(_C <= _alpha * _A * _B + _beta * _C),
+                         platform::Parallelisation::NOT_PARALLEL>;
+  using Threaded  = Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                        Computes(_C <= _alpha * _A * _B + _beta * _C), THREADED>;
+
+  for (auto const &shape : SHAPES)
+  {
+    Tensor<Type> a({shape[0], shape[2]});
+    Tensor<Type> b({shape[2], shape[1]});
+    a.FillUniformRandom();
+    b.FillUniformRandom();
+
+    CheckAgainstReference<Type, Reference, Threaded>(a, b, shape[0], shape[1], Type(1), Type(0));
+    CheckAgainstReference<Type, Reference, Threaded>(a, b, shape[0], shape[1], Type(2), Type(1));
+    CheckAgainstReference<Type, Reference, Threaded>(a, b, shape[0], shape[1], Type(0), Type(2));
+  }
+}
+
+TYPED_TEST(BlasGemmThreadedTest, gemm_nt_matches_reference)
+{
+  using Type      = TypeParam;
+  using Reference = Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                         Computes(_C <= _alpha * _A * T(_B) + _beta * _C),
+                         platform::Parallelisation::NOT_PARALLEL>;
+  using Threaded  = Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                        Computes(_C <= _alpha * _A * T(_B) + _beta * _C), THREADED>;
+
+  for (auto const &shape : SHAPES)
+  {
+    Tensor<Type> a({shape[0], shape[2]});
+    Tensor<Type> b({shape[1], shape[2]});
+    a.FillUniformRandom();
+    b.FillUniformRandom();
+
+    CheckAgainstReference<Type, Reference, Threaded>(a, b, shape[0], shape[1], Type(1), Type(0));
+    CheckAgainstReference<Type, Reference, Threaded>(a, b, shape[0], shape[1], Type(2), Type(1));
+  }
+}
+
+TYPED_TEST(BlasGemmThreadedTest, gemm_tn_matches_reference)
+{
+  using Type      = TypeParam;
+  using Reference = Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                         Computes(_C <= _alpha * T(_A) * _B + _beta * _C),
+                         platform::Parallelisation::NOT_PARALLEL>;
+  using Threaded  = Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                        Computes(_C <= _alpha * T(_A) * _B + _beta * _C), THREADED>;
+
+  for (auto const &shape : SHAPES)
+  {
+    Tensor<Type> a({shape[2], shape[0]});
+    Tensor<Type> b({shape[2], shape[1]});
+    a.FillUniformRandom();
+    b.FillUniformRandom();
+
+    CheckAgainstReference<Type, Reference, Threaded>(a, b, shape[0], shape[1], Type(1), Type(0));
+    CheckAgainstReference<Type, Reference, Threaded>(a, b, shape[0], shape[1], Type(2), Type(1));
+  }
+}
@@ -30,6 +30,11 @@
 #include <type_traits>
 
 namespace fetch {
+namespace crypto {
+
+class BatchVerifier;
+
+}  // namespace crypto
 namespace muddle {
 
 /**
@@ -156,9 +161,11 @@ public:
   // Binary
   static bool ToBuffer(Packet const &packet, void *buffer, std::size_t length);
   static bool FromBuffer(Packet &packet, void const *buffer, std::size_t length);
+  static bool FromBuffer(Packet &packet, byte_array::ConstByteArray const &buffer);
 
-  void Sign(crypto::Prover const &prover);
-  bool Verify() const;
+  void        Sign(crypto::Prover const &prover);
+  bool        Verify() const;
+  std::size_t AddToBatch(crypto::BatchVerifier &verifier) const;
 
 private:
   RoutingHeader header_{};  ///< The header containing primarily routing information
@@ -170,8 +177,9 @@ private:
   mutable Address target_;
   mutable Address sender_;
 
-  void         SetStamped(bool set = true) noexcept;
-  BinaryHeader StaticHeader() const noexcept;
+  void                       SetStamped(bool set = true) noexcept;
+  BinaryHeader               StaticHeader() const noexcept;
+  byte_array::ConstByteArray SignedData() const;
 
   template <typename V, typename D>
   friend struct serializers::MapSerializer;
@@ -383,12 +391,16 @@ inline Packet::BinaryHeader Packet::StaticHeader() const noexcept
   return *reinterpret_cast<BinaryHeader const *>(&retVal);
 }
 
+inline byte_array::ConstByteArray Packet::SignedData() const
+{
+  return (serializers::MsgPackSerializer() << StaticHeader() << payload_).data();
+}
+
 inline void Packet::Sign(crypto::Prover const &prover)
 {
   SetStamped();
 
-  auto const signature =
-      prover.Sign((serializers::MsgPackSerializer() << StaticHeader() << payload_).data());
+  auto const signature = prover.Sign(SignedData());
 
   if (!signature.empty())
   {
@@ -407,8 +419,7 @@ inline bool Packet::Verify() const
   {
     return false;  // null signature is not genuine in non-trusted networks
   }
-  auto retVal = crypto::Verify(
-      GetSender(), (serializers::MsgPackSerializer() << StaticHeader() << payload_).data(), stamp_);
+  auto retVal = crypto::Verify(GetSender(), SignedData(), stamp_);
   return retVal;
 }
 
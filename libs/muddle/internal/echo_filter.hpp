@@ -0,0 +1,133 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace fetch {
+namespace muddle {
+
+/**
+ * Concurrent, time bucketed set of recently seen packet ids used to filter out broadcast echoes
+ *
+ * The ids are distributed over a number of independently locked shards so that routing threads
+ * rarely contend with each other. Within each shard, the ids are held in a ring of generations
+ * (compact open addressing tables), each covering a fixed period of time. New ids are always
+ * added to the current generation and expiry simply discards the oldest generation, rather than
+ * examining each of the entries.
+ */
+class EchoFilter
+{
+public:
+  using Clock     = std::chrono::steady_clock;
+  using Timepoint = Clock::time_point;
+  using Duration  = Clock::duration;
+  using Snapshot  = std::unordered_map<std::size_t, Timepoint>;
+
+  static constexpr std::size_t NUM_SHARDS      = 32;
+  static constexpr std::size_t NUM_GENERATIONS = 11;
+
+  // Construction / Destruction
+  explicit EchoFilter(Duration generation_period = std::chrono::seconds{60},
+                      Timepoint now              = Clock::now());
+  EchoFilter(EchoFilter const &) = delete;
+  EchoFilter(EchoFilter &&)      = delete;
+  ~EchoFilter()                  = default;
+
+  /// @name Filter Operations
+  /// @{
+  bool        Add(std::size_t id);
+  bool        Contains(std::size_t id) const;
+  std::size_t Trim(Timepoint now = Clock::now());
+  /// @}
+
+  std::size_t size() const;
+  Snapshot    GetSnapshot() const;
+
+  // Operators
+  EchoFilter &operator=(EchoFilter const &) = delete;
+  EchoFilter &operator=(EchoFilter &&) = delete;
+
+private:
+  /**
+   * Open addressing (linear probing) set of ids
+   */
+  class IdSet
+  {
+  public:
+    IdSet();
+
+    bool        Insert(uint64_t id);
+    bool        Contains(uint64_t id) const;
+    void        Clear();
+    std::size_t size() const;
+
+    template <typename Visitor>
+    void Visit(Visitor &&visitor) const
+    {
+      if (contains_empty_)
+      {
+        visitor(EMPTY);
+      }
+
+      for (auto const id : slots_)
+      {
+        if (id != EMPTY)
+        {
+          visitor(id);
+        }
+      }
+    }
+
+  private:
+    static constexpr uint64_t    EMPTY            = 0;
+    static constexpr std::size_t INITIAL_CAPACITY = 256;
+
+    void Grow();
+
+    std::vector<uint64_t> slots_;
+    std::size_t           size_{0};
+    bool                  contains_empty_{false};
+  };
+
+  struct Shard
+  {
+    mutable Mutex                          lock;
+    std::array<IdSet, NUM_GENERATIONS>     generations;
+    std::array<Timepoint, NUM_GENERATIONS> started;
+    std::size_t                            current{0};
+  };
+
+  Shard &      LookupShard(std::size_t id);
+  Shard const &LookupShard(std::size_t id) const;
+
+  Duration const                generation_period_;
+  std::array<Shard, NUM_SHARDS> shards_;
+  Mutex                         trim_lock_;
+  Timepoint                     next_rotation_;
+};
+
+}  // namespace muddle
+}  // namespace fetch
@@ -0,0 +1,108 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/containers/lock_free_queue.hpp"
+#include "muddle/packet.hpp"
+#include "network/management/abstract_connection.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fetch {
+namespace muddle {
+
+/**
+ * Pipelined verification stage for the signatures of incoming packets
+ *
+ * Packets are distributed over a set of worker threads based on their sender, each of which has
+ * its own bounded queue. Since all the packets from a given sender are always handled by the same
+ * worker, they are reported in the order in which they were submitted. This also means that each
+ * sender's decoded public key only needs to be cached by a single worker.
+ *
+ * Workers drain the packets which are immediately available from their queue and verify them
+ * together as a batch. The handler is then called (on the worker thread) for each of the packets,
+ * in order, with the verification result. Packets which are neither stamped nor broadcasts do not
+ * require verification and are passed through as genuine.
+ */
+class PacketVerifier
+{
+public:
+  using PacketPtr = std::shared_ptr<Packet>;
+  using Handle    = network::AbstractConnection::ConnectionHandleType;
+  using Handler   = std::function<void(Handle, PacketPtr const &, bool)>;
+
+  static constexpr std::size_t QUEUE_SIZE         = 1u << 10u;  // 1K
+  static constexpr std::size_t DEFAULT_BATCH_SIZE = 32;
+
+  static std::size_t DefaultNumWorkers();
+
+  // Construction / Destruction
+  PacketVerifier(std::string name, std::size_t num_workers, Handler handler,
+                 std::size_t batch_size = DEFAULT_BATCH_SIZE);
+  PacketVerifier(PacketVerifier const &) = delete;
+  PacketVerifier(PacketVerifier &&)      = delete;
+  ~PacketVerifier();
+
+  /// @name Processor Controls
+  /// @{
+  void Start();
+  void Stop();
+  bool IsRunning() const;
+  /// @}
+
+  bool Submit(Handle handle, PacketPtr const &packet);
+
+  static bool RequiresVerification(Packet const &packet);
+
+  // Operators
+  PacketVerifier &operator=(PacketVerifier const &) = delete;
+  PacketVerifier &operator=(PacketVerifier &&) = delete;
+
+private:
+  struct Entry
+  {
+    Handle    handle{0};
+    PacketPtr packet{};
+  };
+
+  using Flag      = std::atomic<bool>;
+  using Queue     = core::LockFreeQueue<Entry, QUEUE_SIZE>;
+  using QueuePtr  = std::unique_ptr<Queue>;
+  using Queues    = std::vector<QueuePtr>;
+  using ThreadPtr = std::unique_ptr<std::thread>;
+  using Threads   = std::vector<ThreadPtr>;
+
+  std::size_t SelectWorker(Packet const &packet) const;
+  void        Worker(Queue &queue);
+
+  std::string const name_;
+  std::size_t const batch_size_;
+  Handler const     handler_;
+  Flag              active_{false};
+  Queues            queues_;
+  Threads           threads_;
+};
+
+}  // namespace muddle
+}  // namespace fetch
@@ -18,6 +18,8 @@
 //------------------------------------------------------------------------------
 
 #include "blacklist.hpp"
+#include "echo_filter.hpp"
+#include "packet_verifier.hpp"
 #include "subscription_registrar.hpp"
 
 #include "core/mutex.hpp"
@@ -74,7 +76,7 @@ public:
   using RoutingTable = std::unordered_map<Packet::RawAddress, RoutingData>;
   using Clock        = std::chrono::steady_clock;
   using Timepoint    = Clock::time_point;
-  using EchoCache    = std::unordered_map<std::size_t, Timepoint>;
+  using EchoCache    = EchoFilter::Snapshot;
 
   // Helper functions
   static Packet::RawAddress ConvertAddress(Packet::Address const &address);
@@ -169,6 +171,7 @@ private:
   void DispatchDirect(Handle handle, PacketPtr const &packet);
 
   void DispatchPacket(PacketPtr const &packet, Address const &transmitter);
+  void RouteVerified(Handle handle, PacketPtr const &packet, bool genuine);
 
   bool IsEcho(Packet const &packet, bool register_echo = true);
   void CleanEchoCache();
@@ -197,8 +200,7 @@ private:
 
   PeerTrackerPtr tracker_{nullptr};
 
-  mutable Mutex echo_cache_lock_;
-  EchoCache     echo_cache_;
+  EchoFilter echo_filter_;
 
   ThreadPool dispatch_thread_pool_;
 
@@ -259,6 +261,9 @@ private:
   telemetry::CounterPtr         connection_dropped_total_;
   /// @}
 
+  /// The verification workers route packets, so must be destroyed before any of the other members
+  PacketVerifier packet_verifier_;
+
   friend class DirectMessageService;
 };
 
@@ -0,0 +1,311 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "echo_filter.hpp"
+
+#include <algorithm>
+
+namespace fetch {
+namespace muddle {
+namespace {
+
+// mix the bits of the id, since the same id also selects the shard
+std::size_t Mix(uint64_t key)
+{
+  key ^= key >> 33u;
+  key *= 0xff51afd7ed558ccdull;
+  key ^= key >> 33u;
+  return static_cast<std::size_t>(key);
+}
+
+// the upper bits select the shard, the lower bits the slot within each of the shard's tables
+std::size_t ShardIndex(std::size_t id)
+{
+  return (Mix(id) >> 32u) % EchoFilter::NUM_SHARDS;
+}
+
+}  // namespace
+
+EchoFilter::IdSet::IdSet()
+  : slots_(INITIAL_CAPACITY, EMPTY)
+{}
+
+/**
+ * Insert an id into the set
+ *
+ * @param id The id to insert
+ * @return true if the id was inserted, false if it was already present
+ */
+bool EchoFilter::IdSet::Insert(uint64_t id)
+{
+  // the value used to mark empty slots is tracked separately
+  if (id == EMPTY)
+  {
+    bool const inserted = !contains_empty_;
+    contains_empty_     = true;
+    size_ += inserted ? 1 : 0;
+    return inserted;
+  }
+
+  // keep the load factor at or below 1/2
+  if (((size_ + 1) * 2) > slots_.size())
+  {
+    Grow();
+  }
+
+  std::size_t const mask = slots_.size() - 1;
+  for (std::size_t index = Mix(id) & mask;; index = (index + 1) & mask)
+  {
+    auto &slot = slots_[index];
+
+    if (slot == id)
+    {
+      return false;
+    }
+
+    if (slot == EMPTY)
+    {
+      slot = id;
+      ++size_;
+      return true;
+    }
+  }
+}
+
+bool EchoFilter::IdSet::Contains(uint64_t id) const
+{
+  if (id == EMPTY)
+  {
+    return contains_empty_;
+  }
+
+  std::size_t const mask = slots_.size() - 1;
+  for (std::size_t index = Mix(id) & mask;; index = (index + 1) & mask)
+  {
+    auto const slot = slots_[index];
+
+    if (slot == id)
+    {
+      return true;
+    }
+
+    if (slot == EMPTY)
+    {
+      return false;
+    }
+  }
+}
+
+/**
+ * Remove all the ids from the set. Storage which has grown (for example during a burst of
+ * traffic) is released.
+ */
+void EchoFilter::IdSet::Clear()
+{
+  if (slots_.size() > INITIAL_CAPACITY)
+  {
+    std::vector<uint64_t>(INITIAL_CAPACITY, EMPTY).swap(slots_);
+  }
+  else
+  {
+    std::fill(slots_.begin(), slots_.end(), EMPTY);
+  }
+
+  size_           = 0;
+  contains_empty_ = false;
+}
+
+std::size_t EchoFilter::IdSet::size() const
+{
+  return size_;
+}
+
+void EchoFilter::IdSet::Grow()
+{
+  std::vector<uint64_t> previous(slots_.size() * 2, EMPTY);
+  previous.swap(slots_);
+  size_ = contains_empty_ ? 1 : 0;
+
+  for (auto const id : previous)
+  {
+    if (id != EMPTY)
+    {
+      Insert(id);
+    }
+  }
+}
+
+/**
+ * Construct an echo filter
+ *
+ * Ids are retained for between (NUM_GENERATIONS - 1) and NUM_GENERATIONS generation periods
+ *
+ * @param generation_period The period of time covered by each generation
+ * @param now The current time
+ */
+EchoFilter::EchoFilter(Duration generation_period, Timepoint now)
+  : generation_period_{generation_period}
+  , next_rotation_{now + generation_period}
+{
+  for (auto &shard : shards_)
+  {
+    shard.started.fill(now);
+  }
+}
+
+/**
+ * Add an id to the filter
+ *
+ * @param id The id to be added
+ * @return true if the id was added, false if it was already present (i.e. an echo)
+ */
+bool EchoFilter::Add(std::size_t id)
+{
+  auto const key   = static_cast<uint64_t>(id);
+  auto &     shard = LookupShard(id);
+
+  FETCH_LOCK(shard.lock);
+
+  for (std::size_t i = 0; i < NUM_GENERATIONS; ++i)
+  {
+    if (i != shard.current && shard.generations[i].Contains(key))
+    {
+      return false;
+    }
+  }
+
+  return shard.generations[shard.current].Insert(key);
+}
+
+/**
+ * Determine if the id is present in the filter
+ *
+ * @param id The id to be checked
+ * @return true if present, otherwise false
+ */
+bool EchoFilter::Contains(std::size_t id) const
+{
+  auto const  key   = static_cast<uint64_t>(id);
+  auto const &shard = LookupShard(id);
+
+  FETCH_LOCK(shard.lock);
+
+  return std::any_of(shard.generations.begin(), shard.generations.end(),
+                     [key](IdSet const &generation) { return generation.Contains(key); });
+}
+
+/**
+ * Expire the generations of ids which are older than the retention period. Intended to be called
+ * periodically.
+ *
+ * @param now The current time
+ * @return The number of ids which were removed
+ */
+std::size_t EchoFilter::Trim(Timepoint now)
+{
+  FETCH_LOCK(trim_lock_);
+
+  std::size_t removed{0};
+
+  for (std::size_t rotation = 0; (rotation < NUM_GENERATIONS) && (now >= next_rotation_);
+       ++rotation)
+  {
+    // advance each of the shards on to the next (oldest) generation, discarding its contents
+    for (auto &shard : shards_)
+    {
+      FETCH_LOCK(shard.lock);
+
+      shard.current = (shard.current + 1) % NUM_GENERATIONS;
+
+      auto &generation = shard.generations[shard.current];
+      removed += generation.size();
+      generation.Clear();
+
+      shard.started[shard.current] = now;
+    }
+
+    next_rotation_ += generation_period_;
+  }
+
+  // after a long gap do not try to catch up, simply restart the rotation from now
+  if (now >= next_rotation_)
+  {
+    next_rotation_ = now + generation_period_;
+  }
+
+  return removed;
+}
+
+/**
+ * @return The total number of ids in the filter
+ */
+std::size_t EchoFilter::size() const
+{
+  std::size_t total{0};
+
+  for (auto const &shard : shards_)
+  {
+    FETCH_LOCK(shard.lock);
+
+    for (auto const &generation : shard.generations)
+    {
+      total += generation.size();
+    }
+  }
+
+  return total;
+}
+
+/**
+ * Build a snapshot of the contents of the filter. Each id is reported with the start time of its
+ * generation.
+ *
+ * @return The snapshot of ids
+ */
+EchoFilter::Snapshot EchoFilter::GetSnapshot() const
+{
+  Snapshot snapshot{};
+
+  for (auto const &shard : shards_)
+  {
+    FETCH_LOCK(shard.lock);
+
+    for (std::size_t i = 0; i < NUM_GENERATIONS; ++i)
+    {
+      auto const started = shard.started[i];
+      shard.generations[i].Visit([&snapshot, started](uint64_t id) {
+        snapshot.emplace(static_cast<std::size_t>(id), started);
+      });
+    }
+  }
+
+  return snapshot;
+}
+
+EchoFilter::Shard &EchoFilter::LookupShard(std::size_t id)
+{
+  return shards_[ShardIndex(id)];
+}
+
+EchoFilter::Shard const &EchoFilter::LookupShard(std::size_t id) const
+{
+  return shards_[ShardIndex(id)];
+}
+
+}  // namespace muddle
+}  // namespace fetch
@@ -17,8 +17,11 @@
 //------------------------------------------------------------------------------
 
 #include "core/byte_array/byte_array.hpp"
+#include "crypto/batch_verifier.hpp"
+#include "crypto/identity.hpp"
 #include "muddle/packet.hpp"
 
+#include <cassert>
 #include <cstring>
 
 namespace fetch {
@@ -118,5 +121,65 @@ bool Packet::FromBuffer(Packet &packet, void const *buffer, std::size_t length)
   return true;
 }
 
+/**
+ * Read in a packet from a specified packet buffer without copying
+ *
+ * The payload and stamp of the packet reference the memory of the input buffer, which is kept
+ * alive for as long as the packet (or the payload) is.
+ *
+ * @param packet The packet to be populated
+ * @param buffer The input buffer
+ * @return true if successful, otherwise false
+ */
+bool Packet::FromBuffer(Packet &packet, byte_array::ConstByteArray const &buffer)
+{
+  if (buffer.size() < sizeof(packet.header_))
+  {
+    return false;
+  }
+
+  // read the header
+  std::memcpy(&packet.header_, buffer.pointer(), sizeof(packet.header_));
+
+  std::size_t payload_length = buffer.size() - sizeof(packet.header_);
+  if (packet.IsStamped())
+  {
+    if (payload_length < SIGNATURE_SIZE)
+    {
+      return false;
+    }
+
+    payload_length -= SIGNATURE_SIZE;
+  }
+
+  std::size_t const payload_offset = sizeof(packet.header_);
+
+  packet.payload_ = (payload_length != 0u) ? buffer.SubArray(payload_offset, payload_length)
+                                           : Payload{};
+
+  if (packet.IsStamped())
+  {
+    packet.stamp_ = buffer.SubArray(payload_offset + payload_length, SIGNATURE_SIZE);
+  }
+
+  return true;
+}
+
+/**
+ * Add the signature of the packet to a batch of signatures to be verified
+ *
+ * The packet must be stamped. Once the batch has been verified the result for this packet is
+ * available from the verifier with the returned index.
+ *
+ * @param verifier The batch verifier to be populated
+ * @return The index of the packet's signature in the batch
+ */
+std::size_t Packet::AddToBatch(crypto::BatchVerifier &verifier) const
+{
+  assert(IsStamped());
+
+  return verifier.Add(crypto::Identity{GetSender()}, SignedData(), stamp_);
+}
+
 }  // namespace muddle
 }  // namespace fetch
@@ -0,0 +1,287 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "packet_verifier.hpp"
+
+#include "core/set_thread_name.hpp"
+#include "crypto/batch_verifier.hpp"
+#include "logging/logging.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <utility>
+
+namespace fetch {
+namespace muddle {
+namespace {
+
+constexpr char const *          LOGGING_NAME = "PacketVerifier";
+const std::chrono::milliseconds POP_TIMEOUT{100};
+const std::chrono::milliseconds PUSH_TIMEOUT{100};
+
+constexpr std::size_t MAX_DEFAULT_WORKERS = 8;
+constexpr std::size_t NOT_REQUIRED        = std::numeric_limits<std::size_t>::max();
+constexpr std::size_t NOT_VERIFIABLE      = NOT_REQUIRED - 1;
+
+}  // namespace
+
+/**
+ * Determine the default number of workers based on the number of available cores
+ *
+ * @return The number of workers to use
+ */
+std::size_t PacketVerifier::DefaultNumWorkers()
+{
+  std::size_t const num_cores = std::thread::hardware_concurrency();
+
+  return std::min(std::max(num_cores, std::size_t{1}), MAX_DEFAULT_WORKERS);
+}
+
+/**
+ * Construct the packet verifier
+ *
+ * @param name The name used for the worker threads
+ * @param num_workers The number of worker threads (and queues) to use
+ * @param handler The handler to be called with the result of each verification
+ * @param batch_size The max number of packets verified together by a worker
+ */
+PacketVerifier::PacketVerifier(std::string name, std::size_t num_workers, Handler handler,
+                               std::size_t batch_size)
+  : name_{std::move(name)}
+  , batch_size_{std::max(batch_size, std::size_t{1})}
+  , handler_{std::move(handler)}
+{
+  num_workers = std::max(num_workers, std::size_t{1});
+
+  queues_.reserve(num_workers);
+  for (std::size_t i = 0; i < num_workers; ++i)
+  {
+    queues_.emplace_back(std::make_unique<Queue>());
+  }
+}
+
+PacketVerifier::~PacketVerifier()
+{
+  // ensure that the workers have been stopped
+  Stop();
+}
+
+/**
+ * Start the worker threads
+ */
+void PacketVerifier::Start()
+{
+  if (active_.exchange(true))
+  {
+    return;
+  }
+
+  threads_.reserve(queues_.size());
+  for (std::size_t i = 0; i < queues_.size(); ++i)
+  {
+    threads_.emplace_back(std::make_unique<std::thread>([this, i]() {
+      SetThreadName(name_ + "-V:", i);
+      Worker(*queues_[i]);
+    }));
+  }
+}
+
+/**
+ * Stop the worker threads, discarding any packets which have not yet been verified
+ */
+void PacketVerifier::Stop()
+{
+  // signal the worker threads to stop
+  active_ = false;
+
+  // wait for the threads to complete
+  for (auto &thread : threads_)
+  {
+    thread->join();
+    thread.reset();
+  }
+  threads_.clear();
+
+  // release any outstanding packets
+  Entry entry;
+  for (auto &queue : queues_)
+  {
+    while (queue->TryPop(entry))
+    {
+      entry.packet.reset();
+    }
+  }
+}
+
+bool PacketVerifier::IsRunning() const
+{
+  return active_;
+}
+
+/**
+ * Submit a packet to be verified
+ *
+ * The call will block while the queue of the selected worker is full, applying back pressure to
+ * the caller.
+ *
+ * @param handle The handle of the connection from which the packet was received
+ * @param packet The packet to be verified
+ * @return true if the packet was queued, otherwise false if the verifier is not running
+ */
+bool PacketVerifier::Submit(Handle handle, PacketPtr const &packet)
+{
+  auto &queue = *queues_[SelectWorker(*packet)];
+
+  std::size_t count{0};
+  while (active_)
+  {
+    if (queue.Push(Entry{handle, packet}, count, PUSH_TIMEOUT))
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Determine if the specified packet requires its signature to be verified
+ *
+ * @param packet The packet to be checked
+ * @return true if the packet needs to be verified, otherwise false
+ */
+bool PacketVerifier::RequiresVerification(Packet const &packet)
+{
+  return packet.IsStamped() || packet.IsBroadcast();
+}
+
+/**
+ * Internal: Select the worker for a packet based on its sender
+ *
+ * @param packet The packet being submitted
+ * @return The index of the worker
+ */
+std::size_t PacketVerifier::SelectWorker(Packet const &packet) const
+{
+  // the sender addresses are public keys, so any part of them is suitably distributed
+  uint64_t key{0};
+  std::memcpy(&key, packet.GetSenderRaw().data(), sizeof(key));
+
+  return static_cast<std::size_t>(key % queues_.size());
+}
+
+/**
+ * Internal: Thread process for the verification of packets
+ *
+ * Each worker waits for a packet to be available and then greedily collects up to the batch size
+ * of packets which are already queued. The whole batch is verified together and then the results
+ * are reported in the order in which the packets were submitted. A packet which can not be verified
+ * (e.g. a sender which is not a valid public key) is reported as not genuine, and does not affect
+ * the other packets in the batch.
+ *
+ * @param queue The queue serviced by this worker
+ */
+void PacketVerifier::Worker(Queue &queue)
+{
+  Entry                    entry;
+  std::vector<Entry>       batch{};
+  std::vector<std::size_t> indices{};
+  crypto::BatchVerifier    verifier{};
+
+  batch.reserve(batch_size_);
+  indices.reserve(batch_size_);
+
+  while (active_)
+  {
+    try
+    {
+      // wait for a packet to be available
+      if (!queue.Pop(entry, POP_TIMEOUT))
+      {
+        continue;
+      }
+
+      // collect any other packets which are immediately available
+      batch.clear();
+      batch.emplace_back(std::move(entry));
+      while ((batch.size() < batch_size_) && queue.TryPop(entry))
+      {
+        batch.emplace_back(std::move(entry));
+      }
+
+      // add all the signatures which need to be checked into the batch
+      verifier.Reset();
+      indices.clear();
+      for (auto const &queued : batch)
+      {
+        auto const &packet = *queued.packet;
+
+        if (!RequiresVerification(packet))
+        {
+          indices.push_back(NOT_REQUIRED);
+        }
+        else if (!packet.IsStamped())
+        {
+          // null signature is not genuine in non-trusted networks
+          indices.push_back(NOT_VERIFIABLE);
+        }
+        else
+        {
+          indices.push_back(packet.AddToBatch(verifier));
+        }
+      }
+
+      if (!verifier.empty())
+      {
+        verifier.Verify();
+      }
+
+      // report the results in submission order
+      for (std::size_t i = 0; i < batch.size(); ++i)
+      {
+        std::size_t const index = indices[i];
+
+        bool const genuine =
+            (index == NOT_REQUIRED) || ((index != NOT_VERIFIABLE) && verifier.IsValid(index));
+
+        // a failure to handle one packet must not affect the rest of the batch
+        try
+        {
+          handler_(batch[i].handle, batch[i].packet, genuine);
+        }
+        catch (std::exception const &ex)
+        {
+          FETCH_LOG_WARN(LOGGING_NAME, name_, " Exception caught handling packet: ", ex.what());
+        }
+      }
+
+      batch.clear();
+    }
+    catch (std::exception const &ex)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, name_, " Exception caught: ", ex.what());
+    }
+  }
+}
+
+}  // namespace muddle
+}  // namespace fetch
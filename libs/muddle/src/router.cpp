@@ -316,24 +316,37 @@ Router::Router(NetworkId network_id, Address address, MuddleRegister &reg, Prove
                       "The total number of packets that have failed to be routed"))
   , connection_dropped_total_(CreateCounter("ledger_router_connection_dropped_total",
                                             "The total number of connections dropped"))
+  , packet_verifier_("Router", PacketVerifier::DefaultNumWorkers(),
+                     [this](Handle handle, PacketPtr const &packet, bool genuine) {
+                       RouteVerified(handle, packet, genuine);
+                     })
 {}
 
 /**
- * Starts the routers internal dispatch thread pool
+ * Starts the routers internal dispatch thread pool and, when signing is enabled, the packet
+ * verification workers
  */
 void Router::Start()
 {
   dispatch_thread_pool_->Start();
   stopping_ = false;
+
+  if (signing_enabled_)
+  {
+    packet_verifier_.Start();
+  }
 }
 
 /**
- * Stops the routers internal dispatch thread pool
+ * Stops the routers internal dispatch thread pool and packet verification workers
  */
 void Router::Stop()
 {
   stopping_ = true;
 
+  // the verification workers feed the dispatch thread pool so must be stopped first
+  packet_verifier_.Stop();
+
   {
     FETCH_LOCK(delivery_attempts_lock_);
     delivery_attempts_.clear();
@@ -346,7 +359,7 @@ bool Router::Genuine(PacketPtr const &p) const
 {
   bool genuine{true};
 
-  if (p->IsStamped() || p->IsBroadcast())
+  if (PacketVerifier::RequiresVerification(*p))
   {
     genuine = p->Verify();
   }
@@ -390,7 +403,27 @@ void Router::Route(Handle handle, PacketPtr const &packet)
     return;
   }
 
-  if (!Genuine(packet))
+  // in signed networks the verification of the packet is handed off to the pool of verification
+  // workers, which route the packet once it has been checked. Should the workers not be running
+  // the packet is verified inline
+  if (signing_enabled_ && packet_verifier_.Submit(handle, packet))
+  {
+    return;
+  }
+
+  RouteVerified(handle, packet, Genuine(packet));
+}
+
+/**
+ * Internal: Routes a packet once its authenticity has been checked
+ *
+ * @param handle The handle of the receiving connection for the packet
+ * @param packet The input packet to route
+ * @param genuine Flag to signal if the packet's authenticity has been verified
+ */
+void Router::RouteVerified(Handle handle, PacketPtr const &packet, bool genuine)
+{
+  if (!genuine)
   {
     FETCH_LOG_WARN(logging_name_, "Packet's authenticity not verified:", DescribePacket(*packet));
     fraudulent_packet_total_->increment();
@@ -931,29 +964,16 @@ void Router::DispatchPacket(PacketPtr const &packet, Address const &transmitter)
  */
 bool Router::IsEcho(Packet const &packet, bool register_echo)
 {
-  bool is_echo = true;
-
   // combine the 3 fields together into a single index
   std::size_t const index = GenerateEchoId(packet);
 
+  // register the echo (if needed)
+  if (register_echo)
   {
-    FETCH_LOCK(echo_cache_lock_);
-
-    // look up if the echo is in the cache
-    auto it = echo_cache_.find(index);
-    if (it == echo_cache_.end())
-    {
-      // register the echo (in needed)
-      if (register_echo)
-      {
-        echo_cache_[index] = Clock::now();
-      }
-
-      is_echo = false;
-    }
+    return !echo_filter_.Add(index);
   }
 
-  return is_echo;
+  return echo_filter_.Contains(index);
 }
 
 /**
@@ -961,31 +981,8 @@ bool Router::IsEcho(Packet const &packet, bool register_echo)
  */
 void Router::CleanEchoCache()
 {
-  FETCH_LOCK(echo_cache_lock_);
-
   echo_cache_trims_total_->increment();
-
-  auto const now = Clock::now();
-
-  auto it = echo_cache_.begin();
-  while (it != echo_cache_.end())
-  {
-    // calculate the time delta
-    auto const delta = now - it->second;
-
-    if (delta > std::chrono::seconds{600})
-    {
-      // remove the element
-      it = echo_cache_.erase(it);
-
-      echo_cache_removals_total_->increment();
-    }
-    else
-    {
-      // move on to the next element in the cache
-      ++it;
-    }
-  }
+  echo_cache_removals_total_->add(echo_filter_.Trim());
 }
 
 void Router::Blacklist(Address const &target)
@@ -1005,8 +1002,7 @@ bool Router::IsBlacklisted(Address const &target) const
 
 Router::EchoCache Router::echo_cache() const
 {
-  FETCH_LOCK(echo_cache_lock_);
-  return echo_cache_;
+  return echo_filter_.GetSnapshot();
 }
 
 NetworkId const &Router::network() const
@@ -0,0 +1,135 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "echo_filter.hpp"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::muddle::EchoFilter;
+
+constexpr std::chrono::seconds PERIOD{60};
+
+TEST(EchoFilterTests, DetectsDuplicates)
+{
+  EchoFilter filter{PERIOD};
+
+  for (std::size_t id = 0; id < 10000; ++id)
+  {
+    EXPECT_FALSE(filter.Contains(id * 7919));
+    EXPECT_TRUE(filter.Add(id * 7919));
+  }
+
+  for (std::size_t id = 0; id < 10000; ++id)
+  {
+    EXPECT_TRUE(filter.Contains(id * 7919));
+    EXPECT_FALSE(filter.Add(id * 7919));
+  }
+
+  EXPECT_EQ(filter.size(), 10000u);
+  EXPECT_EQ(filter.GetSnapshot().size(), 10000u);
+}
+
+TEST(EchoFilterTests, EntriesExpireAfterAllGenerations)
+{
+  auto       now = EchoFilter::Clock::now();
+  EchoFilter filter{PERIOD, now};
+
+  EXPECT_TRUE(filter.Add(42));
+
+  // the entry is retained while the generations rotate
+  for (std::size_t i = 1; i < EchoFilter::NUM_GENERATIONS; ++i)
+  {
+    now += PERIOD;
+    EXPECT_EQ(filter.Trim(now), 0u);
+    EXPECT_TRUE(filter.Contains(42));
+
+    // ids which are seen again are not moved into the newer generation
+    EXPECT_FALSE(filter.Add(42));
+  }
+
+  // until its generation is reused
+  now += PERIOD;
+  EXPECT_EQ(filter.Trim(now), 1u);
+  EXPECT_FALSE(filter.Contains(42));
+  EXPECT_EQ(filter.size(), 0u);
+}
+
+TEST(EchoFilterTests, TrimBeforePeriodDoesNothing)
+{
+  auto       now = EchoFilter::Clock::now();
+  EchoFilter filter{PERIOD, now};
+
+  EXPECT_TRUE(filter.Add(1));
+  EXPECT_EQ(filter.Trim(now + (PERIOD / 2)), 0u);
+  EXPECT_TRUE(filter.Contains(1));
+}
+
+TEST(EchoFilterTests, LongGapClearsEverything)
+{
+  auto       now = EchoFilter::Clock::now();
+  EchoFilter filter{PERIOD, now};
+
+  for (std::size_t id = 1; id <= 100; ++id)
+  {
+    filter.Add(id);
+  }
+
+  EXPECT_EQ(filter.Trim(now + (PERIOD * 1000)), 100u);
+  EXPECT_EQ(filter.size(), 0u);
+}
+
+TEST(EchoFilterTests, ConcurrentAddsAreOnlyAcceptedOnce)
+{
+  static constexpr std::size_t NUM_THREADS = 4;
+  static constexpr std::size_t NUM_IDS     = 20000;
+
+  EchoFilter               filter{PERIOD};
+  std::atomic<std::size_t> accepted{0};
+
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < NUM_THREADS; ++t)
+  {
+    threads.emplace_back([&filter, &accepted] {
+      for (std::size_t id = 0; id < NUM_IDS; ++id)
+      {
+        if (filter.Add(id))
+        {
+          ++accepted;
+        }
+      }
+    });
+  }
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_EQ(accepted, NUM_IDS);
+  EXPECT_EQ(filter.size(), NUM_IDS);
+}
+
+}  // namespace
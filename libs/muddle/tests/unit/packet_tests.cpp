@@ -145,3 +145,25 @@ TEST_F(PacketTests, CheckIndifference)
   EXPECT_TRUE(packet_->IsStamped());
   EXPECT_TRUE(packet_->Verify());
 }
+
+TEST_F(PacketTests, CheckZeroCopyDeserialisation)
+{
+  packet_->Sign(*prover_);
+
+  fetch::byte_array::ByteArray buffer;
+  buffer.Resize(packet_->GetPacketSize());
+  ASSERT_TRUE(Packet::ToBuffer(*packet_, buffer.pointer(), buffer.size()));
+
+  Packet packet{};
+  ASSERT_TRUE(Packet::FromBuffer(packet, buffer));
+
+  EXPECT_EQ(packet.GetPayload(), response_);
+  EXPECT_EQ(packet.GetStamp(), packet_->GetStamp());
+  EXPECT_TRUE(packet.Verify());
+
+  // the payload references the input buffer rather than a copy of it
+  auto const payload_offset = buffer.size() - response_.size() - packet.GetStamp().size();
+  EXPECT_EQ(packet.GetPayload().pointer(), buffer.pointer() + payload_offset);
+
+  EXPECT_FALSE(Packet::FromBuffer(packet, buffer.SubArray(0, 4)));
+}
@@ -0,0 +1,299 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "packet_verifier.hpp"
+
+#include "crypto/ecdsa.hpp"
+#include "muddle/packet.hpp"
+
+#include "gmock/gmock.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+using fetch::muddle::Packet;
+using fetch::muddle::PacketVerifier;
+
+using PacketPtr = PacketVerifier::PacketPtr;
+using Handle    = PacketVerifier::Handle;
+using Prover    = fetch::crypto::ECDSASigner;
+using ProverPtr = std::unique_ptr<Prover>;
+
+struct Result
+{
+  Handle    handle;
+  PacketPtr packet;
+  bool      genuine;
+};
+
+class PacketVerifierTests : public ::testing::Test
+{
+protected:
+  static constexpr std::size_t NUM_WORKERS = 4;
+
+  void SetUp() override
+  {
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+      provers_.emplace_back(std::make_unique<Prover>());
+      provers_.back()->GenerateKeys();
+    }
+
+    verifier_ = std::make_unique<PacketVerifier>("Test", NUM_WORKERS, RecordResult());
+  }
+
+  PacketVerifier::Handler RecordResult()
+  {
+    return [this](Handle handle, PacketPtr const &packet, bool genuine) {
+      std::lock_guard<std::mutex> lock(lock_);
+      results_.push_back({handle, packet, genuine});
+      condition_.notify_all();
+    };
+  }
+
+  void TearDown() override
+  {
+    verifier_.reset();
+  }
+
+  PacketPtr CreatePacket(Prover const &prover, uint16_t counter, bool sign = true,
+                         bool broadcast = false)
+  {
+    auto packet = std::make_shared<Packet>(prover.identity().identifier(), 0);
+    packet->SetService(1);
+    packet->SetChannel(2);
+    packet->SetMessageNum(counter);
+    packet->SetBroadcast(broadcast);
+    packet->SetPayload("payload");
+
+    if (sign)
+    {
+      packet->Sign(prover);
+    }
+
+    return packet;
+  }
+
+  static PacketPtr Tamper(Packet const &original)
+  {
+    // modify the last byte of the payload, leaving the signature intact
+    std::vector<uint8_t> buffer(original.GetPacketSize());
+    EXPECT_TRUE(Packet::ToBuffer(original, buffer.data(), buffer.size()));
+    buffer[buffer.size() - Packet::SIGNATURE_SIZE - 1] ^= 0xFFu;
+
+    auto packet = std::make_shared<Packet>();
+    EXPECT_TRUE(Packet::FromBuffer(*packet, buffer.data(), buffer.size()));
+    EXPECT_TRUE(packet->IsStamped());
+
+    return packet;
+  }
+
+  bool WaitForResults(std::size_t count)
+  {
+    std::unique_lock<std::mutex> lock(lock_);
+    return condition_.wait_for(lock, std::chrono::seconds{10},
+                               [this, count]() { return results_.size() >= count; });
+  }
+
+  std::vector<ProverPtr>          provers_;
+  std::unique_ptr<PacketVerifier> verifier_;
+  std::mutex                      lock_;
+  std::condition_variable         condition_;
+  std::vector<Result>             results_;
+};
+
+TEST_F(PacketVerifierTests, CheckSubmitWhenNotRunning)
+{
+  EXPECT_FALSE(verifier_->IsRunning());
+  EXPECT_FALSE(verifier_->Submit(1, CreatePacket(*provers_[0], 0)));
+
+  verifier_->Start();
+  EXPECT_TRUE(verifier_->IsRunning());
+  EXPECT_TRUE(verifier_->Submit(1, CreatePacket(*provers_[0], 0)));
+  ASSERT_TRUE(WaitForResults(1));
+
+  verifier_->Stop();
+  EXPECT_FALSE(verifier_->IsRunning());
+  EXPECT_FALSE(verifier_->Submit(1, CreatePacket(*provers_[0], 0)));
+}
+
+TEST_F(PacketVerifierTests, CheckVerificationResults)
+{
+  auto const genuine    = CreatePacket(*provers_[0], 0);
+  auto const unsigned_  = CreatePacket(*provers_[0], 1, false);
+  auto const unsigned_b = CreatePacket(*provers_[0], 2, false, true);
+  auto const tampered   = Tamper(*CreatePacket(*provers_[0], 3));
+
+  // the signature of a packet claiming to be from another sender
+  auto const forged = CreatePacket(*provers_[1], 4, false);
+  forged->Sign(*provers_[2]);
+
+  verifier_->Start();
+  EXPECT_TRUE(verifier_->Submit(1, genuine));
+  EXPECT_TRUE(verifier_->Submit(2, unsigned_));
+  EXPECT_TRUE(verifier_->Submit(3, unsigned_b));
+  EXPECT_TRUE(verifier_->Submit(4, tampered));
+  EXPECT_TRUE(verifier_->Submit(5, forged));
+  ASSERT_TRUE(WaitForResults(5));
+
+  std::lock_guard<std::mutex> lock(lock_);
+  for (auto const &result : results_)
+  {
+    switch (result.handle)
+    {
+    case 1:
+      EXPECT_EQ(result.packet, genuine);
+      EXPECT_TRUE(result.genuine);
+      break;
+    case 2:
+      EXPECT_EQ(result.packet, unsigned_);
+      EXPECT_TRUE(result.genuine);
+      break;
+    case 3:
+      EXPECT_EQ(result.packet, unsigned_b);
+      EXPECT_FALSE(result.genuine);
+      break;
+    case 4:
+      EXPECT_EQ(result.packet, tampered);
+      EXPECT_FALSE(result.genuine);
+      break;
+    case 5:
+      EXPECT_EQ(result.packet, forged);
+      EXPECT_FALSE(result.genuine);
+      break;
+    default:
+      ADD_FAILURE() << "Unexpected handle: " << result.handle;
+      break;
+    }
+  }
+}
+
+TEST_F(PacketVerifierTests, CheckPerSenderOrdering)
+{
+  static constexpr std::size_t PACKETS_PER_SENDER = 200;
+
+  std::vector<std::vector<PacketPtr>> packets(provers_.size());
+  for (std::size_t sender = 0; sender < provers_.size(); ++sender)
+  {
+    for (std::size_t i = 0; i < PACKETS_PER_SENDER; ++i)
+    {
+      packets[sender].emplace_back(CreatePacket(*provers_[sender], static_cast<uint16_t>(i)));
+    }
+  }
+
+  // submit the packets from all of the senders interleaved
+  verifier_->Start();
+  for (std::size_t i = 0; i < PACKETS_PER_SENDER; ++i)
+  {
+    for (std::size_t sender = 0; sender < provers_.size(); ++sender)
+    {
+      EXPECT_TRUE(verifier_->Submit(sender, packets[sender][i]));
+    }
+  }
+  ASSERT_TRUE(WaitForResults(PACKETS_PER_SENDER * provers_.size()));
+
+  std::lock_guard<std::mutex> lock(lock_);
+  std::vector<std::size_t>    next(provers_.size(), 0);
+  for (auto const &result : results_)
+  {
+    ASSERT_LT(result.handle, provers_.size());
+    EXPECT_TRUE(result.genuine);
+
+    auto &expected = next[result.handle];
+    ASSERT_LT(expected, PACKETS_PER_SENDER);
+    EXPECT_EQ(result.packet, packets[result.handle][expected]);
+    ++expected;
+  }
+}
+
+TEST_F(PacketVerifierTests, CheckMalformedSenderDoesNotAffectBatch)
+{
+  static constexpr std::size_t NUM_PACKETS     = 64;
+  static constexpr std::size_t MALFORMED_INDEX = NUM_PACKETS / 2;
+
+  // a single worker so that the malformed packet is batched with the others
+  verifier_ = std::make_unique<PacketVerifier>("Test", 1, RecordResult());
+
+  // a stamped packet whose sender is not a valid public key
+  Packet::Address const malformed_sender{std::string(Packet::ADDRESS_SIZE, '\x01')};
+
+  auto malformed = std::make_shared<Packet>(malformed_sender, 0);
+  malformed->SetPayload("payload");
+  malformed->Sign(*provers_[0]);
+
+  verifier_->Start();
+  for (std::size_t i = 0; i < NUM_PACKETS; ++i)
+  {
+    auto const &prover = *provers_[i % provers_.size()];
+    auto const  packet =
+        (i == MALFORMED_INDEX) ? malformed : CreatePacket(prover, static_cast<uint16_t>(i));
+    EXPECT_TRUE(verifier_->Submit(i, packet));
+  }
+  ASSERT_TRUE(WaitForResults(NUM_PACKETS));
+
+  std::lock_guard<std::mutex> lock(lock_);
+  ASSERT_EQ(results_.size(), NUM_PACKETS);
+  for (std::size_t i = 0; i < NUM_PACKETS; ++i)
+  {
+    EXPECT_EQ(results_[i].handle, i);
+    EXPECT_EQ(results_[i].genuine, i != MALFORMED_INDEX);
+  }
+}
+
+TEST_F(PacketVerifierTests, CheckThrowingHandlerDoesNotAffectBatch)
+{
+  static constexpr std::size_t NUM_PACKETS = 64;
+
+  auto record = RecordResult();
+  verifier_   = std::make_unique<PacketVerifier>(
+      "Test", 1, [&record](Handle handle, PacketPtr const &packet, bool genuine) {
+        record(handle, packet, genuine);
+        if ((handle % 2) == 0)
+        {
+          throw std::runtime_error("handler failure");
+        }
+      });
+
+  verifier_->Start();
+  for (std::size_t i = 0; i < NUM_PACKETS; ++i)
+  {
+    EXPECT_TRUE(verifier_->Submit(i, CreatePacket(*provers_[0], static_cast<uint16_t>(i))));
+  }
+  ASSERT_TRUE(WaitForResults(NUM_PACKETS));
+
+  // stop the workers before the handler goes out of scope
+  verifier_->Stop();
+
+  std::lock_guard<std::mutex> lock(lock_);
+  ASSERT_EQ(results_.size(), NUM_PACKETS);
+  for (auto const &result : results_)
+  {
+    EXPECT_TRUE(result.genuine);
+  }
+}
+
+}  // namespace
@@ -0,0 +1,188 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+#include "network/management/network_manager.hpp"
+#include "network/tcp/tcp_client.hpp"
+#include "network/tcp/tcp_server.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+using fetch::network::MessageBuffer;
+using fetch::network::NetworkManager;
+using fetch::network::TCPClient;
+using fetch::network::TCPServer;
+
+namespace {
+
+constexpr std::size_t MESSAGES_PER_ITERATION = 10000;
+constexpr auto        RECEIVE_TIMEOUT        = std::chrono::seconds{30};
+
+class MessageCounter
+{
+public:
+  void Increment()
+  {
+    FETCH_LOCK(lock_);
+    ++received_;
+    if (received_ >= expected_)
+    {
+      cv_.notify_all();
+    }
+  }
+
+  void Expect(std::size_t count)
+  {
+    FETCH_LOCK(lock_);
+    received_ = 0;
+    expected_ = count;
+  }
+
+  bool Wait()
+  {
+    std::unique_lock<std::mutex> lock(lock_);
+    return cv_.wait_for(lock, RECEIVE_TIMEOUT, [this] { return received_ >= expected_; });
+  }
+
+private:
+  std::mutex              lock_;
+  std::condition_variable cv_;
+  std::size_t             received_{0};
+  std::size_t             expected_{0};
+};
+
+class Server : public TCPServer
+{
+public:
+  Server(uint16_t port, NetworkManager const &network_manager)
+    : TCPServer(port, network_manager)
+  {}
+
+  ~Server() override = default;
+
+  void PushRequest(ConnectionHandleType /*client*/, MessageBuffer const & /*msg*/) override
+  {
+    counter.Increment();
+  }
+
+  MessageCounter counter;
+};
+
+class Client : public TCPClient
+{
+public:
+  explicit Client(NetworkManager const &network_manager)
+    : TCPClient(network_manager)
+  {
+    OnMessage([this](MessageBuffer const & /*msg*/) { counter.Increment(); });
+  }
+
+  ~Client()
+  {
+    TCPClient::Cleanup();
+  }
+
+  MessageCounter counter;
+};
+
+enum class Direction
+{
+  CLIENT_TO_SERVER,
+  SERVER_TO_CLIENT,
+};
+
+/**
+ * Measures the throughput of messages sent between a client and a server over the loopback
+ * interface
+ */
+template <Direction DIRECTION>
+void TCP_LoopbackThroughput(benchmark::State &state)
+{
+  auto const message_size = static_cast<std::size_t>(state.range(0));
+
+  NetworkManager network_manager{"NetMgr", 2};
+  network_manager.Start();
+
+  Server server{0, network_manager};
+  server.Start();
+
+  Client client{network_manager};
+  client.Connect("127.0.0.1", server.GetListeningPort());
+
+  if (!client.WaitForAlive(5000))
+  {
+    state.SkipWithError("Unable to connect to the loopback server");
+    network_manager.Stop();
+    return;
+  }
+
+  MessageBuffer message;
+  message.Resize(message_size);
+
+  auto &counter = (DIRECTION == Direction::CLIENT_TO_SERVER) ? server.counter : client.counter;
+
+  for (auto _ : state)
+  {
+    counter.Expect(MESSAGES_PER_ITERATION);
+
+    for (std::size_t i = 0; i < MESSAGES_PER_ITERATION; ++i)
+    {
+      if (DIRECTION == Direction::CLIENT_TO_SERVER)
+      {
+        client.Send(message);
+      }
+      else
+      {
+        server.Broadcast(message);
+      }
+    }
+
+    if (!counter.Wait())
+    {
+      state.SkipWithError("Timed out waiting for messages");
+      break;
+    }
+  }
+
+  auto const messages = static_cast<int64_t>(state.iterations() * MESSAGES_PER_ITERATION);
+  state.SetItemsProcessed(messages);
+  state.SetBytesProcessed(messages * static_cast<int64_t>(message_size));
+
+  client.Close();
+  server.Stop();
+  network_manager.Stop();
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(TCP_LoopbackThroughput, Direction::CLIENT_TO_SERVER)
+    ->RangeMultiplier(8)
+    ->Range(64, 64 * 1024)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(TCP_LoopbackThroughput, Direction::SERVER_TO_CLIENT)
+    ->RangeMultiplier(8)
+    ->Range(64, 64 * 1024)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
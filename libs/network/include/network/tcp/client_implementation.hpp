@@ -27,6 +27,8 @@
 #include "network/management/abstract_connection.hpp"
 #include "network/management/network_manager.hpp"
 #include "network/message.hpp"
+#include "network/tcp/receive_buffer.hpp"
+#include "network/tcp/write_batch.hpp"
 
 #include <atomic>
 #include <memory>
@@ -90,11 +92,17 @@ private:
   bool              can_write_{true};
   bool              posted_close_ = false;
 
+  // Only accessed by the writer which currently holds the can_write_ flag
+  WriteBatch write_batch_{NETWORK_MAGIC};
+
+  // Only accessed from within the strand
+  ReceiveBuffer receive_buffer_{NETWORK_MAGIC};
+
   mutable MutexType callback_mutex_;
   std::atomic<bool> connected_{false};
 
-  void ReadHeader() noexcept;
-  void ReadBody(byte_array::ByteArray const &header) noexcept;
+  // Always executed in a run(), in a strand
+  void ReadNext() noexcept;
 
   // Always executed in a run(), in a strand
   void WriteNext(SharedSelfType const &selfLock);
@@ -0,0 +1,259 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/common.hpp"
+#include "network/fetch_asio.hpp"
+#include "network/message.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace fetch {
+namespace network {
+
+/**
+ * Slab backed buffer for the receive side of a stream connection
+ *
+ * Data is read from the socket directly into a large slab of memory, as many bytes as are
+ * available at a time, and the complete frames (a header followed by a payload) are handed out as
+ * views which reference the slab. No per frame allocations or copies are made.
+ *
+ * A slab is only reused once all the views into it have been released. Otherwise the unconsumed
+ * tail of the data is moved to a new slab, leaving the old one to be freed by its last user.
+ * Frames larger than the slab size are read into a dedicated slab of the required size. Frames
+ * which claim a payload larger than the maximum payload size are rejected as corrupt, before any
+ * space is reserved for them.
+ *
+ * Not thread safe, the owner is expected to serialise access (typically with a strand).
+ */
+class ReceiveBuffer
+{
+public:
+  static constexpr std::size_t HEADER_SIZE              = 2 * sizeof(uint64_t);
+  static constexpr std::size_t DEFAULT_SLAB_SIZE        = 64 * 1024;
+  static constexpr std::size_t DEFAULT_MAX_PAYLOAD_SIZE = 256 * 1024 * 1024;
+
+  // Construction / Destruction
+  explicit ReceiveBuffer(uint64_t magic, std::size_t slab_size = DEFAULT_SLAB_SIZE,
+                         std::size_t max_payload_size = DEFAULT_MAX_PAYLOAD_SIZE);
+  ReceiveBuffer(ReceiveBuffer const &) = delete;
+  ReceiveBuffer(ReceiveBuffer &&)      = delete;
+  ~ReceiveBuffer()                     = default;
+
+  /// @name Receive Operations
+  /// @{
+  asio::mutable_buffer Prepare();
+  void                 Commit(std::size_t length);
+
+  template <typename Handler>
+  bool Extract(Handler &&handler);
+  /// @}
+
+  std::size_t pending() const;
+
+  // Operators
+  ReceiveBuffer &operator=(ReceiveBuffer const &) = delete;
+  ReceiveBuffer &operator=(ReceiveBuffer &&) = delete;
+
+private:
+  std::size_t RequiredSpace() const;
+  uint64_t    ReadWord(std::size_t offset) const;
+  void        Reallocate(std::size_t capacity);
+
+  uint64_t const    magic_;
+  std::size_t const slab_size_;
+  std::size_t const max_payload_size_;
+
+  MessageBuffer slab_;
+  std::size_t   read_offset_{0};   ///< The start of the data which has not yet been consumed
+  std::size_t   write_offset_{0};  ///< The end of the data received so far
+};
+
+/**
+ * Construct a receive buffer
+ *
+ * @param magic The network magic which is expected to prefix each frame header
+ * @param slab_size The size of the slabs to allocate
+ * @param max_payload_size The largest payload which will be accepted in a frame
+ */
+inline ReceiveBuffer::ReceiveBuffer(uint64_t magic, std::size_t slab_size,
+                                    std::size_t max_payload_size)
+  : magic_{magic}
+  , slab_size_{std::max(slab_size, std::size_t{HEADER_SIZE})}
+  , max_payload_size_{max_payload_size}
+{}
+
+/**
+ * Get the region of the slab into which the next read should be made, allocating a new slab if
+ * required
+ *
+ * @return The buffer to be read into
+ */
+inline asio::mutable_buffer ReceiveBuffer::Prepare()
+{
+  bool const unique = slab_.empty() || (slab_.UseCount() == 1);
+
+  // when all the data has been consumed and nothing references the slab simply start again
+  if (unique && (read_offset_ == write_offset_))
+  {
+    read_offset_  = 0;
+    write_offset_ = 0;
+  }
+
+  // the whole of the current (partial) frame must fit in the slab
+  if ((slab_.size() - read_offset_) < RequiredSpace())
+  {
+    Reallocate(std::max(slab_size_, RequiredSpace()));
+  }
+
+  assert(write_offset_ < slab_.size());
+  return asio::buffer(slab_.pointer() + write_offset_, slab_.size() - write_offset_);
+}
+
+/**
+ * Signal that data has been read into the region returned by Prepare
+ *
+ * @param length The number of bytes read
+ */
+inline void ReceiveBuffer::Commit(std::size_t length)
+{
+  assert((write_offset_ + length) <= slab_.size());
+  write_offset_ += length;
+}
+
+/**
+ * Extract all the complete frames which have been received, each of the payloads is passed to the
+ * handler in turn
+ *
+ * @tparam Handler The type of the handler, invocable with a MessageBuffer const &
+ * @param handler The handler to be called for each payload
+ * @return true if successful, false if a corrupt header was received, i.e. one with the wrong
+ * magic or a payload size larger than the maximum. The connection should then be closed
+ */
+template <typename Handler>
+bool ReceiveBuffer::Extract(Handler &&handler)
+{
+  while (pending() >= HEADER_SIZE)
+  {
+    if (ReadWord(read_offset_) != magic_)
+    {
+      return false;
+    }
+
+    // the size is checked before it is used, so that it can not overflow the offsets below
+    uint64_t const size = ReadWord(read_offset_ + sizeof(uint64_t));
+    if (size > max_payload_size_)
+    {
+      return false;
+    }
+
+    auto const payload_size = static_cast<std::size_t>(size);
+    if (pending() < (HEADER_SIZE + payload_size))
+    {
+      break;
+    }
+
+    auto const payload = slab_.SubArray(read_offset_ + HEADER_SIZE, payload_size);
+    read_offset_ += HEADER_SIZE + payload_size;
+
+    handler(payload);
+  }
+
+  return true;
+}
+
+/**
+ * @return The number of bytes which have been received but not yet extracted
+ */
+inline std::size_t ReceiveBuffer::pending() const
+{
+  return write_offset_ - read_offset_;
+}
+
+/**
+ * Determine the amount of contiguous space required for the frame which is currently being read
+ *
+ * @return The required space in bytes
+ */
+inline std::size_t ReceiveBuffer::RequiredSpace() const
+{
+  std::size_t required = HEADER_SIZE;
+
+  if (pending() >= HEADER_SIZE)
+  {
+    // an oversized frame is rejected by Extract, never reserve space for one
+    uint64_t const size = ReadWord(read_offset_ + sizeof(uint64_t));
+    if (size <= max_payload_size_)
+    {
+      required += static_cast<std::size_t>(size);
+    }
+  }
+
+  return required;
+}
+
+inline uint64_t ReceiveBuffer::ReadWord(std::size_t offset) const
+{
+  uint64_t value{0};
+  for (std::size_t i = 0; i < sizeof(uint64_t); ++i)
+  {
+    value |= uint64_t{slab_[offset + i]} << (i * 8);
+  }
+
+  return value;
+}
+
+/**
+ * Move the unconsumed data to the start of a slab of (at least) the specified capacity
+ *
+ * @param capacity The required capacity
+ */
+inline void ReceiveBuffer::Reallocate(std::size_t capacity)
+{
+  std::size_t const length = pending();
+  bool const        unique = !slab_.empty() && (slab_.UseCount() == 1);
+
+  if (unique && (slab_.size() >= capacity))
+  {
+    std::memmove(slab_.pointer(), slab_.pointer() + read_offset_, length);
+  }
+  else
+  {
+    // the contents of the slab are always written before they are read, no need to zero it
+    MessageBuffer slab;
+    slab.Resize(capacity, ResizeParadigm::ABSOLUTE, false);
+
+    if (length != 0)
+    {
+      std::memcpy(slab.pointer(), slab_.pointer() + read_offset_, length);
+    }
+
+    slab_ = std::move(slab);
+  }
+
+  read_offset_  = 0;
+  write_offset_ = length;
+}
+
+}  // namespace network
+}  // namespace fetch
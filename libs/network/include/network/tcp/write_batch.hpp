@@ -0,0 +1,227 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network/fetch_asio.hpp"
+#include "network/message.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace network {
+
+/**
+ * A batch of queued messages which are written to a socket with a single vectored write
+ *
+ * Rather than issuing one write (and one system call) per message, the writer drains as many
+ * messages from the queue as the configured limits allow and gathers them, along with their
+ * framing headers, into a single scatter/gather buffer sequence. The header storage and the buffer
+ * sequence are retained between batches so that steady state writes do not allocate.
+ *
+ * Only one batch may be in flight at a time, the owner is responsible for serialising access.
+ */
+class WriteBatch
+{
+public:
+  static constexpr std::size_t HEADER_SIZE = 2 * sizeof(uint64_t);
+
+  // asio gathers at most 64 buffers per system call, each message needs a header and a body
+  static constexpr std::size_t DEFAULT_MAX_MESSAGES = 32;
+  static constexpr std::size_t DEFAULT_MAX_BYTES    = 256 * 1024;
+
+  using Header         = std::array<uint8_t, HEADER_SIZE>;
+  using Messages       = std::vector<MessageType>;
+  using Headers        = std::vector<Header>;
+  using BufferSequence = std::vector<asio::const_buffer>;
+
+  // Construction / Destruction
+  explicit WriteBatch(uint64_t magic, std::size_t max_messages = DEFAULT_MAX_MESSAGES,
+                      std::size_t max_bytes = DEFAULT_MAX_BYTES);
+  WriteBatch(WriteBatch const &) = delete;
+  WriteBatch(WriteBatch &&)      = delete;
+  ~WriteBatch()                  = default;
+
+  /// @name Batch Operations
+  /// @{
+  std::size_t Fill(MessageQueueType &queue);
+  void        Complete(bool success);
+  void        Clear();
+  /// @}
+
+  /// @name Accessors
+  /// @{
+  bool                  empty() const;
+  std::size_t           size() const;
+  std::size_t           size_in_bytes() const;
+  BufferSequence const &buffers() const;
+  /// @}
+
+  static void EncodeHeader(uint8_t *header, uint64_t magic, uint64_t size);
+
+  // Operators
+  WriteBatch &operator=(WriteBatch const &) = delete;
+  WriteBatch &operator=(WriteBatch &&) = delete;
+
+private:
+  uint64_t const    magic_;
+  std::size_t const max_messages_;
+  std::size_t const max_bytes_;
+
+  Messages       messages_;
+  Headers        headers_;
+  BufferSequence buffers_;
+  std::size_t    size_in_bytes_{0};
+};
+
+/**
+ * Construct a write batch
+ *
+ * @param magic The network magic which prefixes each message header
+ * @param max_messages The maximum number of messages to be gathered into a single write
+ * @param max_bytes The (soft) maximum number of payload bytes in a single write
+ */
+inline WriteBatch::WriteBatch(uint64_t magic, std::size_t max_messages, std::size_t max_bytes)
+  : magic_{magic}
+  , max_messages_{std::max<std::size_t>(max_messages, 1)}
+  , max_bytes_{max_bytes}
+{
+  messages_.reserve(max_messages_);
+  headers_.reserve(max_messages_);
+  buffers_.reserve(max_messages_ * 2);
+}
+
+/**
+ * Move messages from the front of the queue into the (empty) batch until either of the limits is
+ * reached. At least one message is always taken, regardless of its size.
+ *
+ * Must be called with the queue lock held.
+ *
+ * @param queue The queue to take messages from
+ * @return The number of messages in the batch
+ */
+inline std::size_t WriteBatch::Fill(MessageQueueType &queue)
+{
+  assert(empty());
+
+  while (!queue.empty() && (messages_.size() < max_messages_))
+  {
+    std::size_t const message_size = queue.front().buffer.size();
+
+    if (!messages_.empty() && ((size_in_bytes_ + message_size) > max_bytes_))
+    {
+      break;
+    }
+
+    messages_.emplace_back(std::move(queue.front()));
+    queue.pop_front();
+
+    headers_.emplace_back();
+    EncodeHeader(headers_.back().data(), magic_, message_size);
+    size_in_bytes_ += message_size;
+  }
+
+  // the buffers are only formed once the header storage is stable
+  for (std::size_t i = 0; i < messages_.size(); ++i)
+  {
+    auto const &buffer = messages_[i].buffer;
+
+    buffers_.emplace_back(asio::buffer(headers_[i].data(), headers_[i].size()));
+    buffers_.emplace_back(asio::buffer(buffer.pointer(), buffer.size()));
+  }
+
+  return messages_.size();
+}
+
+/**
+ * Signal the outcome of the write to each of the messages in the batch and then clear it
+ *
+ * @param success Whether the write was successful
+ */
+inline void WriteBatch::Complete(bool success)
+{
+  for (auto const &message : messages_)
+  {
+    auto const &callback = success ? message.success : message.failure;
+
+    if (callback)
+    {
+      callback();
+    }
+  }
+
+  Clear();
+}
+
+/**
+ * Clear the contents of the batch, retaining the allocated storage
+ */
+inline void WriteBatch::Clear()
+{
+  messages_.clear();
+  headers_.clear();
+  buffers_.clear();
+  size_in_bytes_ = 0;
+}
+
+inline bool WriteBatch::empty() const
+{
+  return messages_.empty();
+}
+
+inline std::size_t WriteBatch::size() const
+{
+  return messages_.size();
+}
+
+/**
+ * @return The number of payload bytes in the batch (excluding the headers)
+ */
+inline std::size_t WriteBatch::size_in_bytes() const
+{
+  return size_in_bytes_;
+}
+
+inline WriteBatch::BufferSequence const &WriteBatch::buffers() const
+{
+  return buffers_;
+}
+
+/**
+ * Encode a message header, the (little endian) magic followed by the payload size
+ *
+ * @param header The output buffer (HEADER_SIZE bytes)
+ * @param magic The network magic
+ * @param size The size of the payload
+ */
+inline void WriteBatch::EncodeHeader(uint8_t *header, uint64_t magic, uint64_t size)
+{
+  for (std::size_t i = 0; i < sizeof(uint64_t); ++i)
+  {
+    header[i]                    = uint8_t((magic >> (i * 8)) & 0xff);
+    header[i + sizeof(uint64_t)] = uint8_t((size >> (i * 8)) & 0xff);
+  }
+}
+
+}  // namespace network
+}  // namespace fetch
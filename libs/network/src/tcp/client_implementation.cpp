@@ -104,7 +104,7 @@ void TCPClientImplementation::Connect(byte_array::ConstByteArray const &host,
           {
             this->SetAddress(endpoint.address().to_string());
             this->SetPort(uint16_t(port.AsInt()));
-            ReadHeader();
+            ReadNext();
           }
           else
           {
@@ -217,7 +217,7 @@ bool TCPClientImplementation::Closed() const
   return socket_.expired();
 }
 
-void TCPClientImplementation::ReadHeader() noexcept
+void TCPClientImplementation::ReadNext() noexcept
 {
   auto strand = strand_.lock();
   if (!strand)
@@ -226,35 +226,50 @@ void TCPClientImplementation::ReadHeader() noexcept
   }
   assert(strand->running_in_this_thread());
 
-  SelfType              self   = shared_from_this();
-  auto                  socket = socket_.lock();
-  byte_array::ByteArray header;
-  header.Resize(2 * sizeof(uint64_t));
+  SelfType self   = shared_from_this();
+  auto     socket = socket_.lock();
 
-  auto cb = [this, self, socket, header, strand](std::error_code ec, std::size_t) {
+  auto cb = [this, self, socket, strand](std::error_code ec, std::size_t len) {
     SharedSelfType selfLock = self.lock();
     if (!selfLock)
     {
       return;
     }
 
-    if (!ec)
+    if (ec)
     {
-      FETCH_LOG_DEBUG(LOGGING_NAME, "Read message header.");
-      ReadBody(header);
+      if (!posted_close_)
+      {
+        // We expect to get an ec here when the socked is closed via a post
+        FETCH_LOG_INFO(LOGGING_NAME, "Socket closed inside ReadNext: ", ec.message());
+        SignalLeave();
+      }
+
+      return;
     }
-    else if (!posted_close_)
+
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Read ", len, " bytes from socket.");
+    receive_buffer_.Commit(len);
+
+    // dispatch all the complete messages, these reference the receive buffer directly
+    bool const valid =
+        receive_buffer_.Extract([this](MessageBuffer const &message) { SignalMessage(message); });
+
+    if (!valid)
     {
-      // We expect to get an ec here when the socked is closed via a post
-      FETCH_LOG_INFO(LOGGING_NAME, "Socket closed inside ReadHeader: ", ec.message());
+      FETCH_LOG_ERROR(LOGGING_NAME, "Corrupt frame header during network read, closing connection");
+      Close();
       SignalLeave();
+      return;
     }
+
+    ReadNext();
   };
 
   if (socket)
   {
     assert(strand->running_in_this_thread());
-    asio::async_read(*socket, asio::buffer(header.pointer(), header.size()), strand->wrap(cb));
+    socket->async_read_some(receive_buffer_.Prepare(), strand->wrap(cb));
 
     bool const previously_connected = connected_.exchange(true);
 
@@ -265,83 +280,16 @@ void TCPClientImplementation::ReadHeader() noexcept
   }
   else
   {
-    FETCH_LOG_INFO(LOGGING_NAME, "Socket no longer valid in ReadHeader");
+    FETCH_LOG_INFO(LOGGING_NAME, "Socket no longer valid in ReadNext");
     connected_ = false;
     SignalLeave();
   }
 }
 
-void TCPClientImplementation::ReadBody(byte_array::ByteArray const &header) noexcept
-{
-  auto strand = strand_.lock();
-  assert(strand->running_in_this_thread());
-
-  assert(header.size() >= sizeof(NETWORK_MAGIC));
-  uint64_t magic = *reinterpret_cast<const uint64_t *>(header.pointer());
-  uint64_t size  = *reinterpret_cast<const uint64_t *>(header.pointer() + sizeof(uint64_t));
-
-  if (magic != NETWORK_MAGIC)
-  {
-    byte_array::ByteArray dummy;
-    SetHeader(dummy, 0);
-    dummy.Resize(16);
-
-    FETCH_LOG_ERROR(LOGGING_NAME, "Magic incorrect during network read:\ngot:      ", ToHex(header),
-                    "\nExpected: ", ToHex(byte_array::ByteArray(dummy)));
-    return;
-  }
-
-  byte_array::ByteArray message;
-  message.Resize(size);
-
-  SelfType self   = shared_from_this();
-  auto     socket = socket_.lock();
-  auto     cb     = [this, self, message, socket, strand](std::error_code ec, std::size_t len) {
-    FETCH_UNUSED(len);
-
-    SharedSelfType selfLock = self.lock();
-    if (!selfLock)
-    {
-      return;
-    }
-
-    if (!ec)
-    {
-      SignalMessage(message);
-      ReadHeader();
-    }
-    else
-    {
-      FETCH_LOG_ERROR(LOGGING_NAME, "Reading body failed, dying: ", ec, ec.message());
-      SignalLeave();
-    }
-  };
-
-  if (socket)
-  {
-    assert(strand->running_in_this_thread());
-    asio::async_read(*socket, asio::buffer(message.pointer(), message.size()), strand->wrap(cb));
-  }
-  else
-  {
-    FETCH_LOG_ERROR(LOGGING_NAME, "Invalid socket when attempting to read body");
-    SignalLeave();
-  }
-}
-
 void TCPClientImplementation::SetHeader(byte_array::ByteArray &header, uint64_t bufSize)
 {
-  header.Resize(16);
-
-  for (std::size_t i = 0; i < 8; ++i)
-  {
-    header[i] = uint8_t((NETWORK_MAGIC >> i * 8) & 0xff);
-  }
-
-  for (std::size_t i = 0; i < 8; ++i)
-  {
-    header[i + 8] = uint8_t((bufSize >> i * 8) & 0xff);
-  }
+  header.Resize(WriteBatch::HEADER_SIZE);
+  WriteBatch::EncodeHeader(header.pointer(), NETWORK_MAGIC, bufSize);
 }
 
 // Always executed in a run(), in a strand
@@ -361,7 +309,7 @@ void TCPClientImplementation::WriteNext(SharedSelfType const &selfLock)
     }
   }
 
-  MessageType message;
+  // gather as many of the queued messages as possible into a single write
   {
     FETCH_LOCK(queue_mutex_);
     if (write_queue_.empty())
@@ -370,50 +318,40 @@ void TCPClientImplementation::WriteNext(SharedSelfType const &selfLock)
       can_write_ = true;
       return;
     }
-    message = write_queue_.front();
-    write_queue_.pop_front();
+    write_batch_.Fill(write_queue_);
   }
 
-  byte_array::ByteArray header;
-  SetHeader(header, message.buffer.size());
-
-  std::vector<asio::const_buffer> buffers{
-      asio::buffer(header.pointer(), header.size()),
-      asio::buffer(message.buffer.pointer(), message.buffer.size())};
-
   auto socket = socket_.lock();
 
-  auto cb = [this, selfLock, socket, message, header](std::error_code ec, std::size_t len) {
+  auto cb = [this, selfLock, socket](std::error_code ec, std::size_t len) {
     FETCH_UNUSED(len);
 
-    {
-      FETCH_LOCK(can_write_mutex_);
-      can_write_ = true;
-    }
+    // TODO(issue 16): this strand should be unnecessary
+    bool const strand_alive = static_cast<bool>(strand_.lock());
 
     if (ec)
     {
       FETCH_LOG_ERROR(LOGGING_NAME, "Error writing to socket, closing.");
       SignalLeave();
-
-      if (message.failure)
-      {
-        message.failure();
-      }
+      write_batch_.Complete(false);
+    }
+    else if (strand_alive)
+    {
+      write_batch_.Complete(true);
     }
     else
     {
+      write_batch_.Clear();
+    }
 
-      // TODO(issue 16): this strand should be unnecessary
-      auto strandLock = strand_.lock();
-      if (strandLock)
-      {
-        if (message.success)
-        {
-          message.success();
-        }
-        WriteNext(selfLock);
-      }
+    {
+      FETCH_LOCK(can_write_mutex_);
+      can_write_ = true;
+    }
+
+    if (!ec && strand_alive)
+    {
+      WriteNext(selfLock);
     }
   };
 
@@ -422,7 +360,7 @@ void TCPClientImplementation::WriteNext(SharedSelfType const &selfLock)
   if (socket && strand)
   {
     assert(strand->running_in_this_thread());
-    asio::async_write(*socket, buffers, strand->wrap(cb));
+    asio::async_write(*socket, write_batch_.buffers(), strand->wrap(cb));
   }
   else
   {
@@ -432,11 +370,7 @@ void TCPClientImplementation::WriteNext(SharedSelfType const &selfLock)
     }
 
     SignalLeave();
-
-    if (message.failure)
-    {
-      message.failure();
-    }
+    write_batch_.Complete(false);
   }
 }
 
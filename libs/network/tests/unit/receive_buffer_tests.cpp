@@ -0,0 +1,186 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network/tcp/receive_buffer.hpp"
+#include "network/tcp/write_batch.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using fetch::network::MessageBuffer;
+using fetch::network::ReceiveBuffer;
+using fetch::network::WriteBatch;
+
+constexpr uint64_t MAGIC = 0xFE7C80A1FE7C80A1;
+
+using Messages = std::vector<MessageBuffer>;
+
+MessageBuffer CreateMessage(std::size_t size, uint8_t fill)
+{
+  MessageBuffer message;
+  message.Resize(size);
+  std::fill(message.pointer(), message.pointer() + size, fill);
+  return message;
+}
+
+// generate the wire format of a series of messages
+std::vector<uint8_t> Frame(Messages const &messages)
+{
+  std::vector<uint8_t> stream;
+  for (auto const &message : messages)
+  {
+    uint8_t header[WriteBatch::HEADER_SIZE];
+    WriteBatch::EncodeHeader(header, MAGIC, message.size());
+
+    stream.insert(stream.end(), header, header + sizeof(header));
+    stream.insert(stream.end(), message.pointer(), message.pointer() + message.size());
+  }
+
+  return stream;
+}
+
+// simulate the socket delivering the stream in chunks of (at most) the specified size
+Messages Receive(ReceiveBuffer &buffer, std::vector<uint8_t> const &stream, std::size_t chunk)
+{
+  Messages received;
+
+  std::size_t offset = 0;
+  while (offset < stream.size())
+  {
+    auto const region = buffer.Prepare();
+    auto const length = std::min({chunk, region.size(), stream.size() - offset});
+
+    std::copy(stream.data() + offset, stream.data() + offset + length,
+              static_cast<uint8_t *>(region.data()));
+    buffer.Commit(length);
+    offset += length;
+
+    EXPECT_TRUE(buffer.Extract([&received](MessageBuffer const &msg) { received.push_back(msg); }));
+  }
+
+  return received;
+}
+
+TEST(ReceiveBufferTests, ExtractsFramesAcrossArbitraryReads)
+{
+  Messages const messages = {CreateMessage(10, 1), CreateMessage(0, 2), CreateMessage(1000, 3),
+                             CreateMessage(100, 4), CreateMessage(5000, 5)};
+  auto const     stream   = Frame(messages);
+
+  for (std::size_t chunk : {1u, 7u, 100u, 4096u, 100000u})
+  {
+    ReceiveBuffer buffer{MAGIC, 256};
+    EXPECT_EQ(Receive(buffer, stream, chunk), messages) << "chunk: " << chunk;
+    EXPECT_EQ(buffer.pending(), 0u);
+  }
+}
+
+TEST(ReceiveBufferTests, MessagesReferenceTheSlab)
+{
+  Messages const messages = {CreateMessage(10, 1), CreateMessage(20, 2), CreateMessage(30, 3)};
+
+  ReceiveBuffer buffer{MAGIC};
+  auto const    received = Receive(buffer, Frame(messages), 1024);
+
+  ASSERT_EQ(received, messages);
+
+  // all the messages are views into the same slab of memory
+  EXPECT_EQ(received[1].pointer(), received[0].pointer() + 10 + ReceiveBuffer::HEADER_SIZE);
+  EXPECT_EQ(received[2].pointer(), received[1].pointer() + 20 + ReceiveBuffer::HEADER_SIZE);
+}
+
+TEST(ReceiveBufferTests, SlabIsNotReusedWhileReferenced)
+{
+  ReceiveBuffer buffer{MAGIC, 64};
+
+  auto const first = Receive(buffer, Frame({CreateMessage(40, 1)}), 1024);
+  auto const later = Receive(buffer, Frame({CreateMessage(40, 2)}), 1024);
+
+  ASSERT_EQ(first.size(), 1u);
+  ASSERT_EQ(later.size(), 1u);
+  EXPECT_EQ(first[0], CreateMessage(40, 1));
+  EXPECT_EQ(later[0], CreateMessage(40, 2));
+}
+
+TEST(ReceiveBufferTests, InvalidMagicIsRejected)
+{
+  auto stream = Frame({CreateMessage(10, 1)});
+  stream[0] ^= 0xFF;
+
+  ReceiveBuffer buffer{MAGIC};
+  auto const    region = buffer.Prepare();
+  std::copy(stream.begin(), stream.end(), static_cast<uint8_t *>(region.data()));
+  buffer.Commit(stream.size());
+
+  EXPECT_FALSE(buffer.Extract([](MessageBuffer const &) { FAIL(); }));
+}
+
+// a stream containing only the header of a frame which claims the specified payload size
+std::vector<uint8_t> Header(uint64_t payload_size)
+{
+  std::vector<uint8_t> stream(WriteBatch::HEADER_SIZE);
+  WriteBatch::EncodeHeader(stream.data(), MAGIC, payload_size);
+  return stream;
+}
+
+TEST(ReceiveBufferTests, OversizedPayloadIsRejected)
+{
+  ReceiveBuffer buffer{MAGIC, 64, 1024};
+
+  auto const stream = Header(1025);
+  auto const region = buffer.Prepare();
+  std::copy(stream.begin(), stream.end(), static_cast<uint8_t *>(region.data()));
+  buffer.Commit(stream.size());
+
+  EXPECT_FALSE(buffer.Extract([](MessageBuffer const &) { FAIL(); }));
+
+  // no space is reserved for the oversized frame
+  EXPECT_LE(buffer.Prepare().size(), 64u);
+}
+
+TEST(ReceiveBufferTests, OverflowingPayloadSizeIsRejected)
+{
+  for (uint64_t size : {~uint64_t{0}, ~uint64_t{0} - ReceiveBuffer::HEADER_SIZE + 1,
+                        ~uint64_t{0} - ReceiveBuffer::HEADER_SIZE})
+  {
+    ReceiveBuffer buffer{MAGIC};
+
+    auto const stream = Header(size);
+    auto const region = buffer.Prepare();
+    std::copy(stream.begin(), stream.end(), static_cast<uint8_t *>(region.data()));
+    buffer.Commit(stream.size());
+
+    EXPECT_FALSE(buffer.Extract([](MessageBuffer const &) { FAIL(); })) << "size: " << size;
+  }
+}
+
+TEST(ReceiveBufferTests, MaximumPayloadIsAccepted)
+{
+  Messages const messages = {CreateMessage(1024, 1)};
+
+  ReceiveBuffer buffer{MAGIC, 64, 1024};
+  EXPECT_EQ(Receive(buffer, Frame(messages), 100), messages);
+}
+
+}  // namespace
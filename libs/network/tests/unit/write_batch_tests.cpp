@@ -0,0 +1,132 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network/tcp/write_batch.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace {
+
+using fetch::network::MessageBuffer;
+using fetch::network::MessageQueueType;
+using fetch::network::WriteBatch;
+
+constexpr uint64_t    MAGIC       = 0xFE7C80A1FE7C80A1;
+constexpr std::size_t HEADER_SIZE = WriteBatch::HEADER_SIZE;
+
+MessageQueueType CreateQueue(std::size_t count, std::size_t message_size, std::size_t &successes,
+                             std::size_t &failures)
+{
+  MessageQueueType queue;
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    MessageBuffer buffer;
+    buffer.Resize(message_size);
+
+    queue.push_back({buffer, [&successes] { ++successes; }, [&failures] { ++failures; }});
+  }
+
+  return queue;
+}
+
+TEST(WriteBatchTests, FillIsLimitedByMessageCount)
+{
+  std::size_t successes{0};
+  std::size_t failures{0};
+  auto        queue = CreateQueue(10, 8, successes, failures);
+
+  WriteBatch batch{MAGIC, 4};
+
+  EXPECT_EQ(batch.Fill(queue), 4u);
+  EXPECT_EQ(queue.size(), 6u);
+  EXPECT_EQ(batch.size_in_bytes(), 32u);
+  EXPECT_EQ(batch.buffers().size(), 8u);
+
+  batch.Complete(true);
+  EXPECT_TRUE(batch.empty());
+  EXPECT_EQ(successes, 4u);
+  EXPECT_EQ(failures, 0u);
+
+  EXPECT_EQ(batch.Fill(queue), 4u);
+  batch.Complete(false);
+  EXPECT_EQ(successes, 4u);
+  EXPECT_EQ(failures, 4u);
+}
+
+TEST(WriteBatchTests, FillIsLimitedByBytes)
+{
+  std::size_t successes{0};
+  std::size_t failures{0};
+  auto        queue = CreateQueue(10, 100, successes, failures);
+
+  WriteBatch batch{MAGIC, 32, 250};
+
+  EXPECT_EQ(batch.Fill(queue), 2u);
+  EXPECT_EQ(batch.size_in_bytes(), 200u);
+}
+
+TEST(WriteBatchTests, OversizedMessageIsAlwaysTaken)
+{
+  std::size_t successes{0};
+  std::size_t failures{0};
+  auto        queue = CreateQueue(2, 1000, successes, failures);
+
+  WriteBatch batch{MAGIC, 32, 100};
+
+  EXPECT_EQ(batch.Fill(queue), 1u);
+  EXPECT_EQ(queue.size(), 1u);
+}
+
+TEST(WriteBatchTests, BuffersAreFramedWithHeaders)
+{
+  std::size_t successes{0};
+  std::size_t failures{0};
+  auto        queue = CreateQueue(3, 5, successes, failures);
+
+  WriteBatch batch{MAGIC};
+  ASSERT_EQ(batch.Fill(queue), 3u);
+
+  auto const &buffers = batch.buffers();
+  ASSERT_EQ(buffers.size(), 6u);
+
+  for (std::size_t i = 0; i < buffers.size(); i += 2)
+  {
+    ASSERT_EQ(asio::buffer_size(buffers[i]), HEADER_SIZE);
+    EXPECT_EQ(asio::buffer_size(buffers[i + 1]), 5u);
+
+    auto const *header = static_cast<uint8_t const *>(buffers[i].data());
+
+    uint64_t magic{0};
+    uint64_t size{0};
+    for (std::size_t j = 0; j < sizeof(uint64_t); ++j)
+    {
+      magic |= uint64_t{header[j]} << (j * 8);
+      size |= uint64_t{header[j + sizeof(uint64_t)]} << (j * 8);
+    }
+
+    EXPECT_EQ(magic, MAGIC);
+    EXPECT_EQ(size, 5u);
+  }
+}
+
+}  // namespace
@@ -99,6 +99,12 @@ public:
     key_index_.New(index_file);
   }
 
+  void SetIndexHashMode(typename KeyValueIndexType::HashMode mode)
+  {
+    FETCH_LOCK(mutex_);
+    key_index_.SetHashMode(mode);
+  }
+
   Document GetOrCreate(ResourceID const &rid, bool create = true)
   {
     byte_array::ConstByteArray const &address = rid.id();
@@ -56,6 +56,7 @@
 // Representation of a possible configuration of the key value trie. When the split is maximal
 // (256), this represents that the node is a leaf. The nodes can contain additional information
 
+#include "crypto/batch_sha256.hpp"
 #include "crypto/sha256.hpp"
 #include "storage/cached_random_access_stack.hpp"
 #include "storage/key.hpp"
@@ -64,10 +65,14 @@
 #include "storage/storage_exception.hpp"
 #include "storage/versioned_random_access_stack.hpp"
 
+#include <algorithm>
 #include <cstring>
 #include <deque>
 #include <queue>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace fetch {
 namespace storage {
@@ -185,6 +190,19 @@ public:
   using IndexType      = key_value_pair::IndexType;
   using key_type       = typename key_value_pair::KeyType;
 
+  /**
+   * Controls when the merkle hashes of the internal nodes of the tree are recalculated.
+   *
+   * IMMEDIATE: Every update rehashes the path from the modified leaf to the root
+   * DEFERRED:  Updates only mark nodes as dirty. The affected nodes are rehashed once, level by
+   *            level, when the hash is requested, the index is committed or the stack is flushed
+   */
+  enum class HashMode
+  {
+    IMMEDIATE,
+    DEFERRED
+  };
+
   KeyValueIndex()
   {
     stack_.OnFileLoaded([this]() { root_ = stack_.header_extra(); });
@@ -202,12 +220,35 @@ public:
   {
     stack_.New(std::forward<Args>(args)...);
     root_ = 0;
+    dirty_.clear();
   }
 
   template <typename... Args>
   void Load(Args &&... args)
   {
     stack_.Load(std::forward<Args>(args)...);
+    dirty_.clear();
+  }
+
+  /**
+   * Change the hashing mode of the index. Switching back to immediate mode will rehash any nodes
+   * which are currently marked as dirty
+   *
+   * @param mode The new hashing mode
+   */
+  void SetHashMode(HashMode mode)
+  {
+    if ((hash_mode_ == HashMode::DEFERRED) && (mode == HashMode::IMMEDIATE))
+    {
+      RehashDirtyNodes();
+    }
+
+    hash_mode_ = mode;
+  }
+
+  HashMode hash_mode() const
+  {
+    return hash_mode_;
   }
 
   void BeforeFlushHandler()
@@ -217,6 +258,8 @@ public:
       return;
     }
 
+    RehashDirtyNodes();
+
     stack_.SetExtraHeader(root_);
 
     std::unordered_map<uint64_t, uint64_t> depths;
@@ -457,7 +500,11 @@ public:
     // to it by scheduling updates until the next flush
     if ((kv.parent != IndexType(-1)) && (update_parent))
     {
-      if (stack_.DirectWrite())
+      if (hash_mode_ == HashMode::DEFERRED)
+      {
+        dirty_.insert(kv.parent);
+      }
+      else if (stack_.DirectWrite())
       {
         UpdateParents(kv.parent, index, kv);
       }
@@ -470,6 +517,7 @@ public:
 
   byte_array::ByteArray Hash()
   {
+    RehashDirtyNodes();
     stack_.Flush();
     key_value_pair kv;
     if (stack_.size() > 0)
@@ -514,11 +562,13 @@ public:
   using BookmarkType = uint64_t;
   BookmarkType Commit()
   {
+    RehashDirtyNodes();
     return stack_.Commit();
   }
 
   BookmarkType Commit(BookmarkType const &b)
   {
+    RehashDirtyNodes();
     return stack_.Commit(b);
   }
 
@@ -527,6 +577,7 @@ public:
     stack_.Revert(b);
 
     root_ = stack_.header_extra();
+    dirty_.clear();
   }
 
   //*/
@@ -598,6 +649,9 @@ public:
       return end();
     }
 
+    // tree traversal compares the hashes of internal nodes
+    RehashDirtyNodes();
+
     key_value_pair kv;
     stack_.Get(root_, kv);
 
@@ -615,6 +669,8 @@ public:
 
   SelfType::Iterator Find(byte_array::ConstByteArray const &key_str)
   {
+    // tree traversal compares the hashes of internal nodes
+    RehashDirtyNodes();
 
     key_type       key(key_str);
     bool           split      = true;
@@ -639,6 +695,9 @@ public:
       return end();
     }
 
+    // tree traversal compares the hashes of internal nodes
+    RehashDirtyNodes();
+
     key_type       key(key_str);
     bool           split      = true;
     int            pos        = 0;
@@ -710,6 +769,7 @@ public:
       stack_.Pop();
       root_ = 0;
       stack_.SetExtraHeader(root_);
+      dirty_.clear();
       return;
     }
 
@@ -770,7 +830,18 @@ public:
     }
 
     stack_.Set(sibling_index, sibling);
-    UpdateParents(sibling.parent, sibling_index, sibling);
+
+    if (hash_mode_ == HashMode::DEFERRED)
+    {
+      if (sibling.parent != IndexType(-1))
+      {
+        dirty_.insert(sibling.parent);
+      }
+    }
+    else
+    {
+      UpdateParents(sibling.parent, sibling_index, sibling);
+    }
 
     //// Erase our node and its parent, important to do this at the end since it might shuffle
     /// indexes
@@ -791,13 +862,170 @@ public:
   void UpdateVariables()
   {
     root_ = stack_.header_extra();
+    dirty_.clear();
   }
 
 private:
+  using DirtySet = std::unordered_set<IndexType>;
+
+  /**
+   * A node which needs to be rehashed along with the number of its children that are still
+   * waiting to be rehashed
+   */
+  struct DirtyNode
+  {
+    key_value_pair kv;
+    uint32_t       pending_children{0};
+  };
+
+  using DirtyNodes = std::unordered_map<IndexType, DirtyNode>;
+
+  static constexpr std::size_t HASH_SIZE = sizeof(key_value_pair::hash);
+
   StackType stack_;
 
   uint64_t                                     root_ = 0;
   std::unordered_map<uint64_t, key_value_pair> schedule_update_;
+  HashMode                                     hash_mode_{HashMode::IMMEDIATE};
+  DirtySet                                     dirty_;
+
+  /**
+   * Recalculate the hashes of all the nodes marked as dirty along with their ancestors.
+   *
+   * Every node is hashed exactly once. The nodes are processed in waves, starting with those whose
+   * children are all up to date and moving towards the root, so that the hashes of each wave can
+   * be computed independently of one another.
+   */
+  void RehashDirtyNodes()
+  {
+    if (dirty_.empty())
+    {
+      return;
+    }
+
+    // build the set of nodes which need rehashing, counting the children which also need rehashing
+    DirtyNodes nodes;
+    nodes.reserve(dirty_.size() * 2);
+
+    for (IndexType const id : dirty_)
+    {
+      IndexType child   = key_value_pair::TREE_ROOT_VALUE;
+      IndexType current = id;
+
+      while (current != key_value_pair::TREE_ROOT_VALUE)
+      {
+        auto       it   = nodes.find(current);
+        bool const seen = (it != nodes.end());
+
+        if (!seen)
+        {
+          DirtyNode node;
+          stack_.Get(current, node.kv);
+          it = nodes.emplace(current, node).first;
+        }
+
+        if (child != key_value_pair::TREE_ROOT_VALUE)
+        {
+          ++it->second.pending_children;
+        }
+
+        // the ancestors of this node have already been accounted for
+        if (seen)
+        {
+          break;
+        }
+
+        child   = current;
+        current = it->second.kv.parent;
+      }
+    }
+
+    dirty_.clear();
+
+    std::vector<IndexType> wave;
+    std::vector<IndexType> next_wave;
+    std::vector<uint8_t>   input;
+    std::vector<uint8_t>   output;
+
+    for (auto const &entry : nodes)
+    {
+      if (entry.second.pending_children == 0)
+      {
+        wave.push_back(entry.first);
+      }
+    }
+
+    while (!wave.empty())
+    {
+      input.resize(wave.size() * HASH_SIZE * 2);
+      output.resize(wave.size() * HASH_SIZE);
+
+      // collect the hashes of the children, consistent with KeyValuePair::UpdateNode
+      for (std::size_t i = 0; i < wave.size(); ++i)
+      {
+        auto const &kv = nodes[wave[i]].kv;
+        assert(!kv.is_leaf());
+
+        CopyChildHash(nodes, kv.right, &input[(i * 2) * HASH_SIZE]);
+        CopyChildHash(nodes, kv.left, &input[((i * 2) + 1) * HASH_SIZE]);
+      }
+
+      HashNodes(input.data(), output.data(), wave.size());
+
+      // write back the updated nodes and determine the next wave of nodes
+      next_wave.clear();
+      for (std::size_t i = 0; i < wave.size(); ++i)
+      {
+        auto &kv = nodes[wave[i]].kv;
+        std::memcpy(kv.hash, &output[i * HASH_SIZE], HASH_SIZE);
+        stack_.Set(wave[i], kv);
+
+        if (kv.parent != key_value_pair::TREE_ROOT_VALUE)
+        {
+          auto &parent = nodes[kv.parent];
+          assert(parent.pending_children > 0);
+
+          if (--parent.pending_children == 0)
+          {
+            next_wave.push_back(kv.parent);
+          }
+        }
+      }
+
+      std::swap(wave, next_wave);
+    }
+  }
+
+  void CopyChildHash(DirtyNodes const &nodes, IndexType index, uint8_t *output)
+  {
+    auto const it = nodes.find(index);
+    if (it != nodes.end())
+    {
+      std::memcpy(output, it->second.kv.hash, HASH_SIZE);
+    }
+    else
+    {
+      key_value_pair child;
+      stack_.Get(index, child);
+      std::memcpy(output, child.hash, HASH_SIZE);
+    }
+  }
+
+  /**
+   * Hash a series of concatenated child hash pairs, splitting the work across multiple threads for
+   * large numbers of nodes
+   *
+   * @param input The concatenated pairs of child hashes (2 * HASH_SIZE bytes per node)
+   * @param output The output buffer for the node hashes (HASH_SIZE bytes per node)
+   * @param count The number of nodes to be hashed
+   */
+  static void HashNodes(uint8_t const *input, uint8_t *output, std::size_t count)
+  {
+    static_assert(HASH_SIZE == crypto::BatchSHA256::DIGEST_SIZE_IN_BYTES,
+                  "Node hashes must be SHA-256 digests");
+
+    crypto::BatchSHA256::ParallelHash(input, output, count);
+  }
 
   /**
    * Update the parents of a changed node, since this changes the merkle tree
@@ -1026,12 +1254,21 @@ private:
 
     assert(index <= stack_end);
 
+    // the erased node no longer needs rehashing, and the moved node keeps its dirty state
+    dirty_.erase(index);
+    bool const last_element_dirty = (dirty_.erase(stack_end) != 0);
+
     if (index == stack_end)
     {
       stack_.Pop();
       return;
     }
 
+    if (last_element_dirty)
+    {
+      dirty_.insert(index);
+    }
+
     // Get last element on stack
     key_value_pair last_element;
     stack_.Get(stack_end, last_element);
@@ -1211,6 +1448,8 @@ private:
       return;
     }
 
+    RehashDirtyNodes();
+
     if (root_ >= stack_.size())
     {
       throw StorageException("Root out of bounds of stack");
@@ -52,6 +52,12 @@ bool IsAllZeros(Hash const &hash)
 }
 }  // namespace
 
+NewRevertibleDocumentStore::NewRevertibleDocumentStore()
+{
+  // the state root is only required on commit, so batch up the merkle tree updates until then
+  storage_.SetIndexHashMode(Storage::KeyValueIndexType::HashMode::DEFERRED);
+}
+
 bool NewRevertibleDocumentStore::Load(std::string const &state, std::string const &state_history,
                                       std::string const &index, std::string const &index_history,
                                       bool create = true)
@@ -438,4 +438,84 @@ TEST_F(KeyValueIndexTests, batched_vs_bulk_load_save_consistency)
   ASSERT_TRUE(bulk_size == random_batched_size);
 }
 
+TEST_F(KeyValueIndexTests, deferred_hashing_consistency)
+{
+  std::vector<TestData> values;
+  for (std::size_t i = 0; i < 5000; ++i)
+  {
+    byte_array::ByteArray key;
+    key.Resize(256 / 8);
+    for (std::size_t j = 0; j < key.size(); ++j)
+    {
+      key[j] = uint8_t(rng() >> 9u);
+    }
+
+    if (reference.find(key) != reference.end())
+    {
+      continue;
+    }
+
+    reference[key] = rng();
+    values.push_back({key, reference[key]});
+  }
+
+  KVIndex deferred;
+  deferred.SetHashMode(KVIndex::HashMode::DEFERRED);
+
+  kv_index.New("test1.db");
+  deferred.New("test2.db");
+
+  // insert all the values, periodically checking the intermediate hashes
+  for (std::size_t i = 0; i < values.size(); ++i)
+  {
+    auto const &val = values[i];
+    kv_index.Set(val.key, val.value, val.key);
+    deferred.Set(val.key, val.value, val.key);
+
+    if ((i % 1000) == 0)
+    {
+      ASSERT_EQ(kv_index.Hash(), deferred.Hash());
+    }
+  }
+
+  ASSERT_EQ(kv_index.Hash(), deferred.Hash());
+
+  // overwrite a subset of the leaves with new data
+  for (std::size_t i = 0; i < values.size(); i += 7)
+  {
+    auto const &val = values[i];
+    auto const  data{values[(i + 1) % values.size()].key};
+
+    kv_index.Set(val.key, val.value, data);
+    deferred.Set(val.key, val.value, data);
+  }
+
+  ASSERT_EQ(kv_index.Hash(), deferred.Hash());
+
+  // erase elements interleaved with updates
+  for (std::size_t i = 0; i < values.size(); i += 5)
+  {
+    kv_index.Erase(values[i].key);
+    deferred.Erase(values[i].key);
+
+    auto const &val = values[(i + 3) % values.size()];
+    kv_index.Set(val.key, val.value, values[i].key);
+    deferred.Set(val.key, val.value, values[i].key);
+  }
+
+  ASSERT_EQ(kv_index.size(), deferred.size());
+  ASSERT_EQ(kv_index.Hash(), deferred.Hash());
+
+  // switching back to immediate mode should leave the tree consistent
+  deferred.SetHashMode(KVIndex::HashMode::IMMEDIATE);
+  for (std::size_t i = 1; i < values.size(); i += 11)
+  {
+    auto const &val = values[i];
+    kv_index.Set(val.key, val.value, val.key);
+    deferred.Set(val.key, val.value, val.key);
+  }
+
+  ASSERT_EQ(kv_index.Hash(), deferred.Hash());
+}
+
 }  // namespace
@@ -18,8 +18,9 @@
 //------------------------------------------------------------------------------
 
 #include "telemetry/measurement.hpp"
+#include "telemetry/utils/sharded_counters.hpp"
 
-#include <atomic>
+#include <cstdint>
 #include <string>
 
 namespace fetch {
@@ -53,7 +54,7 @@ public:
   Counter &operator=(Counter &&) = delete;
 
 private:
-  std::atomic<uint64_t> counter_{0};
+  details::ShardedCounters counter_{1};
 };
 
 }  // namespace telemetry
@@ -18,11 +18,9 @@
 //------------------------------------------------------------------------------
 
 #include "telemetry/measurement.hpp"
+#include "telemetry/utils/sharded_counters.hpp"
 
-#include <functional>
 #include <initializer_list>
-#include <map>
-#include <mutex>
 #include <string>
 #include <vector>
 
@@ -56,16 +54,19 @@ public:
   Histogram &operator=(Histogram &&) = delete;
 
 private:
-  using BucketMap = std::map<double, uint64_t>;
+  using Bounds = std::vector<double>;
 
   template <typename Iterator>
   Histogram(Iterator const &begin, Iterator const &end, std::string const &name,
             std::string const &description, Labels const &labels = Labels{});
 
-  mutable std::mutex lock_;
-  BucketMap          buckets_;
-  uint64_t           count_{0};
-  double             sum_{0.0};
+  static Bounds SortedBounds(Bounds bounds);
+
+  // counters per shard: one per bucket bound, one for values above them all and one for the sum
+  Bounds const             bounds_;
+  std::size_t const        overflow_index_;
+  std::size_t const        sum_index_;
+  details::ShardedCounters counters_;
 };
 
 }  // namespace telemetry
@@ -0,0 +1,77 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace fetch {
+namespace telemetry {
+namespace details {
+
+/**
+ * A set of relaxed atomic counters that is replicated once per shard. Each thread updates the
+ * counters of its own shard, each shard starting on its own cache line, so that threads recording
+ * measurements concurrently do not contend with each other. Totals are only formed on read.
+ */
+class ShardedCounters
+{
+public:
+  static constexpr std::size_t CACHE_LINE_SIZE = 64;
+  static constexpr std::size_t MAX_SHARDS      = 32;
+
+  // Construction / Destruction
+  explicit ShardedCounters(std::size_t num_counters);
+  ShardedCounters(ShardedCounters const &) = delete;
+  ShardedCounters(ShardedCounters &&)      = delete;
+  ~ShardedCounters()                       = default;
+
+  /// @name Updates (from the calling thread's shard)
+  /// @{
+  void Add(std::size_t index, uint64_t value);
+  void AddDouble(std::size_t index, double value);
+  /// @}
+
+  /// @name Totals (across all shards)
+  /// @{
+  uint64_t Total(std::size_t index) const;
+  double   TotalDouble(std::size_t index) const;
+  /// @}
+
+  // Operators
+  ShardedCounters &operator=(ShardedCounters const &) = delete;
+  ShardedCounters &operator=(ShardedCounters &&) = delete;
+
+  static std::size_t NumShards();
+  static std::size_t ThisThreadShard();
+
+private:
+  using Counter = std::atomic<uint64_t>;
+
+  Counter *Local(std::size_t index);
+
+  std::size_t                stride_;
+  std::unique_ptr<Counter[]> storage_;
+  Counter *                  counters_{nullptr};  // first cache line aligned counter of storage_
+};
+
+}  // namespace details
+}  // namespace telemetry
+}  // namespace fetch
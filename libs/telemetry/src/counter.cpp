@@ -53,33 +53,33 @@ Counter::Counter(std::string name, std::string description, Labels labels)
 void Counter::ToStream(OutputStream &stream) const
 {
   WriteHeader(stream, "counter");
-  WriteValuePrefix(stream) << counter_ << '\n';
+  WriteValuePrefix(stream) << counter_.Total(0) << '\n';
 }
 
 uint64_t Counter::count() const
 {
-  return counter_;
+  return counter_.Total(0);
 }
 
 void Counter::increment()
 {
-  ++counter_;
+  counter_.Add(0, 1u);
 }
 
 void Counter::add(uint64_t value)
 {
-  counter_ += value;
+  counter_.Add(0, value);
 }
 
 Counter &Counter::operator++()
 {
-  ++counter_;
+  counter_.Add(0, 1u);
   return *this;
 }
 
 Counter &Counter::operator+=(uint64_t value)
 {
-  counter_ += value;
+  counter_.Add(0, value);
   return *this;
 }
 
@@ -18,7 +18,9 @@
 
 #include "telemetry/histogram.hpp"
 
+#include <algorithm>
 #include <ostream>
+#include <utility>
 
 namespace fetch {
 namespace telemetry {
@@ -63,34 +65,39 @@ template <typename Iterator>
 Histogram::Histogram(Iterator const &begin, Iterator const &end, std::string const &name,
                      std::string const &description, Labels const &labels)
   : Measurement{name, description, labels}
+  , bounds_{SortedBounds(Bounds(begin, end))}
+  , overflow_index_{bounds_.size()}
+  , sum_index_{bounds_.size() + 1}
+  , counters_{bounds_.size() + 2}
+{}
+
+/**
+ * Internal: Sort the bucket bounds and remove any duplicates
+ *
+ * @param bounds The bucket bounds
+ * @return The sorted, unique bucket bounds
+ */
+Histogram::Bounds Histogram::SortedBounds(Bounds bounds)
 {
-  std::lock_guard<std::mutex> guard(lock_);
+  std::sort(bounds.begin(), bounds.end());
+  bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
 
-  // build up the initial bucket values
-  for (auto it = begin; it != end; ++it)
-  {
-    buckets_.emplace(*it, 0u);
-  }
+  return bounds;
 }
 
 /**
- * Add a value to the histogram
+ * Add a value to the histogram. Only the smallest bucket containing the value is updated, the
+ * cumulative bucket counts are formed when the histogram is written out.
  *
  * @param value The value to be added
  */
 void Histogram::Add(double const &value)
 {
-  std::lock_guard<std::mutex> guard(lock_);
-
-  // update all of the buckets
-  for (auto it = buckets_.lower_bound(value), end = buckets_.end(); it != end; ++it)
-  {
-    ++(it->second);
-  }
+  auto const bucket = static_cast<std::size_t>(
+      std::lower_bound(bounds_.begin(), bounds_.end(), value) - bounds_.begin());
 
-  // update the aggregates
-  ++count_;
-  sum_ += value;
+  counters_.Add(bucket, 1u);
+  counters_.AddDouble(sum_index_, value);
 }
 
 /**
@@ -101,18 +108,19 @@ void Histogram::Add(double const &value)
  */
 void Histogram::ToStream(OutputStream &stream) const
 {
-  std::lock_guard<std::mutex> guard(lock_);
-
   WriteHeader(stream, "histogram");
-  for (auto const &element : buckets_)
+
+  uint64_t count{0};
+  for (std::size_t i = 0; i < bounds_.size(); ++i)
   {
-    WriteValuePrefix(stream, "bucket", {{"le", std::to_string(element.first)}})
-        << element.second << '\n';
+    count += counters_.Total(i);
+    WriteValuePrefix(stream, "bucket", {{"le", std::to_string(bounds_[i])}}) << count << '\n';
   }
-  WriteValuePrefix(stream, "bucket", {{"le", "+Inf"}}) << count_ << '\n';
+  count += counters_.Total(overflow_index_);
+  WriteValuePrefix(stream, "bucket", {{"le", "+Inf"}}) << count << '\n';
 
-  WriteValuePrefix(stream, "sum") << sum_ << '\n';
-  WriteValuePrefix(stream, "count") << count_ << '\n';
+  WriteValuePrefix(stream, "sum") << counters_.TotalDouble(sum_index_) << '\n';
+  WriteValuePrefix(stream, "count") << count << '\n';
 }
 
 }  // namespace telemetry
@@ -0,0 +1,174 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "telemetry/utils/sharded_counters.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+namespace fetch {
+namespace telemetry {
+namespace details {
+namespace {
+
+constexpr std::size_t COUNTERS_PER_CACHE_LINE =
+    ShardedCounters::CACHE_LINE_SIZE / sizeof(std::atomic<uint64_t>);
+
+uint64_t ToBits(double value)
+{
+  uint64_t bits{0};
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+double FromBits(uint64_t bits)
+{
+  double value{0.0};
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+}  // namespace
+
+constexpr std::size_t ShardedCounters::CACHE_LINE_SIZE;
+constexpr std::size_t ShardedCounters::MAX_SHARDS;
+
+/**
+ * Create a zeroed set of counters for every shard
+ *
+ * @param num_counters The number of counters in each shard
+ */
+ShardedCounters::ShardedCounters(std::size_t num_counters)
+  : stride_{((num_counters + COUNTERS_PER_CACHE_LINE - 1) / COUNTERS_PER_CACHE_LINE) *
+            COUNTERS_PER_CACHE_LINE}
+  , storage_{new Counter[stride_ * NumShards() + COUNTERS_PER_CACHE_LINE]()}
+{
+  // align the first shard to the start of a cache line, the stride keeps the others aligned
+  auto const address = reinterpret_cast<std::uintptr_t>(storage_.get());
+  auto const offset  = (CACHE_LINE_SIZE - (address % CACHE_LINE_SIZE)) % CACHE_LINE_SIZE;
+  counters_          = storage_.get() + (offset / sizeof(Counter));
+}
+
+/**
+ * Add a value to a counter of the calling thread's shard
+ *
+ * @param index The index of the counter
+ * @param value The value to be added
+ */
+void ShardedCounters::Add(std::size_t index, uint64_t value)
+{
+  Local(index)->fetch_add(value, std::memory_order_relaxed);
+}
+
+/**
+ * Add a value to a counter, of the calling thread's shard, that holds a floating point total
+ *
+ * @param index The index of the counter
+ * @param value The value to be added
+ */
+void ShardedCounters::AddDouble(std::size_t index, double value)
+{
+  Counter &counter = *Local(index);
+
+  // the shard is (almost always) only updated by a single thread, so this rarely retries
+  uint64_t current = counter.load(std::memory_order_relaxed);
+  while (!counter.compare_exchange_weak(current, ToBits(FromBits(current) + value),
+                                        std::memory_order_relaxed))
+  {
+  }
+}
+
+/**
+ * Total a counter across all of the shards
+ *
+ * @param index The index of the counter
+ * @return The total
+ */
+uint64_t ShardedCounters::Total(std::size_t index) const
+{
+  uint64_t total{0};
+  for (std::size_t shard = 0, num_shards = NumShards(); shard < num_shards; ++shard)
+  {
+    total += counters_[(shard * stride_) + index].load(std::memory_order_relaxed);
+  }
+
+  return total;
+}
+
+/**
+ * Total a floating point counter across all of the shards
+ *
+ * @param index The index of the counter
+ * @return The total
+ */
+double ShardedCounters::TotalDouble(std::size_t index) const
+{
+  double total{0.0};
+  for (std::size_t shard = 0, num_shards = NumShards(); shard < num_shards; ++shard)
+  {
+    total += FromBits(counters_[(shard * stride_) + index].load(std::memory_order_relaxed));
+  }
+
+  return total;
+}
+
+/**
+ * Get the number of shards, a power of two that covers the number of hardware threads
+ *
+ * @return The number of shards
+ */
+std::size_t ShardedCounters::NumShards()
+{
+  static std::size_t const num_shards = [] {
+    std::size_t const concurrency = std::max(1u, std::thread::hardware_concurrency());
+
+    std::size_t shards{1};
+    while ((shards < concurrency) && (shards < MAX_SHARDS))
+    {
+      shards <<= 1u;
+    }
+
+    return shards;
+  }();
+
+  return num_shards;
+}
+
+/**
+ * Get the shard of the calling thread. Threads are assigned shards in a round robin fashion.
+ *
+ * @return The index of the shard
+ */
+std::size_t ShardedCounters::ThisThreadShard()
+{
+  static std::atomic<std::size_t> next_shard{0};
+  thread_local std::size_t const  shard =
+      next_shard.fetch_add(1, std::memory_order_relaxed) & (NumShards() - 1);
+
+  return shard;
+}
+
+ShardedCounters::Counter *ShardedCounters::Local(std::size_t index)
+{
+  return counters_ + (ThisThreadShard() * stride_) + index;
+}
+
+}  // namespace details
+}  // namespace telemetry
+}  // namespace fetch
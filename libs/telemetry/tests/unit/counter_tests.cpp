@@ -20,7 +20,10 @@
 
 #include "gtest/gtest.h"
 
+#include <cstddef>
 #include <memory>
+#include <thread>
+#include <vector>
 
 namespace {
 
@@ -85,4 +88,29 @@ test_counter_total{foo="bar"} 500
   EXPECT_EQ(oss.str(), std::string{EXPECTED_TEXT});
 }
 
+TEST_F(CounterTests, ConcurrentIncrements)
+{
+  static constexpr std::size_t NUM_THREADS = 16;
+  static constexpr std::size_t NUM_ADDS    = 10000;
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < NUM_THREADS; ++i)
+  {
+    threads.emplace_back([this]() {
+      for (std::size_t j = 0; j < NUM_ADDS; ++j)
+      {
+        ++(*counter_);
+        counter_->add(2);
+      }
+    });
+  }
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_EQ(NUM_THREADS * NUM_ADDS * 3, counter_->count());
+}
+
 }  // namespace
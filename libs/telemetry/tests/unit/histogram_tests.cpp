@@ -20,8 +20,11 @@
 
 #include "gtest/gtest.h"
 
+#include <cstddef>
 #include <memory>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 namespace {
 
@@ -75,4 +78,69 @@ request_time_count 7
   EXPECT_EQ(oss.str(), std::string{EXPECTED_TEXT});
 }
 
+TEST_F(HistogramTests, UnsortedBuckets)
+{
+  Histogram histogram{std::vector<double>{0.8, 0.2, 0.6, 0.2, 0.4}, "request_time", "Test Metric"};
+
+  histogram.Add(0.1);
+  histogram.Add(0.2);
+  histogram.Add(0.7);
+  histogram.Add(1.0);
+
+  std::ostringstream oss;
+  OutputStream       stream{oss};
+  histogram.ToStream(stream);
+
+  static char const *EXPECTED_TEXT = R"(# HELP request_time Test Metric
+# TYPE request_time histogram
+request_time_bucket{le="0.200000"} 2
+request_time_bucket{le="0.400000"} 2
+request_time_bucket{le="0.600000"} 2
+request_time_bucket{le="0.800000"} 3
+request_time_bucket{le="+Inf"} 4
+request_time_sum 2
+request_time_count 4
+)";
+  EXPECT_EQ(oss.str(), std::string{EXPECTED_TEXT});
+}
+
+TEST_F(HistogramTests, ConcurrentAdds)
+{
+  static constexpr std::size_t NUM_THREADS = 16;
+  static constexpr std::size_t NUM_ADDS    = 10000;
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < NUM_THREADS; ++i)
+  {
+    threads.emplace_back([this]() {
+      for (std::size_t j = 0; j < NUM_ADDS; ++j)
+      {
+        histogram_->Add(0.5);
+        histogram_->Add(1.0);
+      }
+    });
+  }
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  std::ostringstream oss;
+  OutputStream       stream{oss};
+  histogram_->ToStream(stream);
+
+  static char const *EXPECTED_TEXT = R"(# HELP request_time Test Metric
+# TYPE request_time histogram
+request_time_bucket{le="0.200000"} 0
+request_time_bucket{le="0.400000"} 0
+request_time_bucket{le="0.600000"} 160000
+request_time_bucket{le="0.800000"} 160000
+request_time_bucket{le="+Inf"} 320000
+request_time_sum 240000
+request_time_count 320000
+)";
+  EXPECT_EQ(oss.str(), std::string{EXPECTED_TEXT});
+}
+
 }  // namespace
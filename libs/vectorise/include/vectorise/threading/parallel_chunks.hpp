@@ -0,0 +1,94 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/threading/pool.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <vector>
+
+namespace fetch {
+namespace threading {
+
+/**
+ * Split the range [0, extent) into chunks and run task(start, end) on each of them. The calling
+ * thread computes the final chunk while the pool computes the others.
+ *
+ * All of the chunks are always waited for before returning, even if one of them throws, since the
+ * dispatched tasks refer to the task (and usually its captures) on the caller's stack. The first
+ * exception is then rethrown.
+ *
+ * @param pool The pool to dispatch the chunks to
+ * @param extent The size of the range
+ * @param chunk The size of each chunk, the final chunk may be smaller
+ * @param task Callable with the start and end of a chunk
+ */
+template <typename Task>
+void ParallelChunks(Pool &pool, std::size_t extent, std::size_t chunk, Task const &task)
+{
+  assert(chunk > 0);
+
+  auto const run = [&task, extent, chunk](std::size_t start) {
+    task(start, std::min(start + chunk, extent));
+  };
+
+  std::vector<std::future<void>> pending;
+  std::exception_ptr             error;
+
+  try
+  {
+    std::size_t start = 0;
+    for (; (start + chunk) < extent; start += chunk)
+    {
+      pending.emplace_back(pool.Dispatch(run, start));
+    }
+
+    run(start);
+  }
+  catch (...)
+  {
+    error = std::current_exception();
+  }
+
+  for (auto &result : pending)
+  {
+    try
+    {
+      result.get();
+    }
+    catch (...)
+    {
+      if (!error)
+      {
+        error = std::current_exception();
+      }
+    }
+  }
+
+  if (error)
+  {
+    std::rethrow_exception(error);
+  }
+}
+
+}  // namespace threading
+}  // namespace fetch
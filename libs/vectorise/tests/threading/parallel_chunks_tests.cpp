@@ -0,0 +1,104 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/threading/parallel_chunks.hpp"
+#include "vectorise/threading/pool.hpp"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::threading::ParallelChunks;
+using fetch::threading::Pool;
+
+TEST(ParallelChunksTests, EveryIndexIsVisitedOnce)
+{
+  Pool pool{4};
+
+  std::size_t const             extent = 1000;
+  std::vector<std::atomic<int>> visits(extent);
+  for (auto &count : visits)
+  {
+    count = 0;
+  }
+
+  ParallelChunks(pool, extent, 7, [&visits](std::size_t start, std::size_t end) {
+    for (std::size_t i = start; i < end; ++i)
+    {
+      ++visits[i];
+    }
+  });
+
+  for (std::size_t i = 0; i < extent; ++i)
+  {
+    EXPECT_EQ(1, visits[i]) << "index " << i;
+  }
+}
+
+TEST(ParallelChunksTests, CallerExceptionWaitsForPoolChunks)
+{
+  Pool pool{4};
+
+  std::size_t const extent = 40;
+  std::size_t const chunk  = 10;
+  std::atomic<int>  completed{0};
+
+  // the calling thread runs the final chunk and throws straight away, the pool chunks must all
+  // have finished by the time the exception reaches us
+  auto const task = [&completed, extent, chunk](std::size_t start, std::size_t /*end*/) {
+    if ((start + chunk) >= extent)
+    {
+      throw std::runtime_error("caller chunk failed");
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ++completed;
+  };
+
+  EXPECT_THROW(ParallelChunks(pool, extent, chunk, task), std::runtime_error);
+  EXPECT_EQ(3, completed);
+}
+
+TEST(ParallelChunksTests, PoolExceptionIsRethrownAfterAllChunks)
+{
+  Pool pool{4};
+
+  std::atomic<int> completed{0};
+
+  auto const task = [&completed](std::size_t start, std::size_t /*end*/) {
+    if (start == 0)
+    {
+      throw std::runtime_error("pool chunk failed");
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ++completed;
+  };
+
+  EXPECT_THROW(ParallelChunks(pool, 40, 10, task), std::runtime_error);
+  EXPECT_EQ(3, completed);
+}
+
+}  // namespace
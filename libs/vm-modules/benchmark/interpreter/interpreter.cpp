@@ -0,0 +1,167 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/compiler.hpp"
+#include "vm/ir.hpp"
+#include "vm/module.hpp"
+#include "vm/vm.hpp"
+#include "vm_modules/vm_factory.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace fetch::vm;
+
+namespace vm_modules {
+namespace benchmark {
+namespace interpreter {
+
+using VMFactory = fetch::vm_modules::VMFactory;
+
+// Tight integer arithmetic and branching, typical of compute heavy contracts
+constexpr char const *ARITHMETIC_TEXT = R"(
+  function main() : Int64
+    var total = 0i64;
+    var i = 0i64;
+    while (i < 100000i64)
+      if (i % 3i64 == 0i64)
+        total = total + i * 2i64;
+      else
+        total -= 1i64;
+      endif
+      i = i + 1i64;
+    endwhile
+    return total;
+  endfunction
+)";
+
+// Deeply nested user defined function calls
+constexpr char const *RECURSION_TEXT = R"(
+  function fib(n : Int64) : Int64
+    if (n < 2i64)
+      return n;
+    endif
+    return fib(n - 1i64) + fib(n - 2i64);
+  endfunction
+
+  function main() : Int64
+    return fib(20i64);
+  endfunction
+)";
+
+// Array accesses inside range loops, typical of synergetic work and objective functions
+constexpr char const *ARRAY_TEXT = R"(
+  function main() : Int64
+    var n = 10000;
+    var values = Array<Int64>(n);
+    for (i in 0:n)
+      values[i] = toInt64((i * 7919) % 10007);
+    endfor
+    var total = 0i64;
+    for (k in 0:10)
+      for (i in 0:n)
+        if (values[i] > 5000i64)
+          total += values[i];
+        else
+          total -= 1i64;
+        endif
+      endfor
+    endfor
+    return total;
+  endfunction
+)";
+
+// Floating point arithmetic
+constexpr char const *FLOATING_POINT_TEXT = R"(
+  function main() : Float64
+    var x = 0.0;
+    var i = 0;
+    while (i < 50000)
+      x = x * 0.5 + toFloat64(i) / 3.0;
+      i = i + 1;
+    endwhile
+    return x;
+  endfunction
+)";
+
+void Run(::benchmark::State &state, char const *text)
+{
+  auto module = VMFactory::GetModule(VMFactory::USE_SMART_CONTRACTS);
+
+  Executable executable;
+  auto       errors = VMFactory::Compile(module, {{"default.etch", text}}, executable);
+  if (!errors.empty())
+  {
+    state.SkipWithError(errors.front().c_str());
+    return;
+  }
+
+  // with the default static charges every opcode costs one unit, so the charge total is the
+  // number of instructions executed
+  ChargeAmount instructions{0};
+  for (auto _ : state)
+  {
+    VM          vm{module.get()};
+    std::string error;
+    Variant     output;
+
+    if (!vm.Execute(executable, "main", error, output))
+    {
+      state.SkipWithError(error.c_str());
+      return;
+    }
+
+    instructions += vm.GetChargeTotal();
+  }
+
+  state.counters["instructions/s"] =
+      ::benchmark::Counter(static_cast<double>(instructions), ::benchmark::Counter::kIsRate);
+}
+
+void BM_Arithmetic(::benchmark::State &state)
+{
+  Run(state, ARITHMETIC_TEXT);
+}
+
+void BM_Recursion(::benchmark::State &state)
+{
+  Run(state, RECURSION_TEXT);
+}
+
+void BM_Arrays(::benchmark::State &state)
+{
+  Run(state, ARRAY_TEXT);
+}
+
+void BM_FloatingPoint(::benchmark::State &state)
+{
+  Run(state, FLOATING_POINT_TEXT);
+}
+
+BENCHMARK(BM_Arithmetic)->Unit(::benchmark::kMillisecond);
+BENCHMARK(BM_Recursion)->Unit(::benchmark::kMillisecond);
+BENCHMARK(BM_Arrays)->Unit(::benchmark::kMillisecond);
+BENCHMARK(BM_FloatingPoint)->Unit(::benchmark::kMillisecond);
+
+}  // namespace interpreter
+}  // namespace benchmark
+}  // namespace vm_modules
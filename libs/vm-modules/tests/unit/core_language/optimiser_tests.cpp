@@ -0,0 +1,180 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm_test_toolkit.hpp"
+
+#include "gmock/gmock.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+
+namespace {
+
+using namespace testing;
+
+class OptimiserTests : public Test
+{
+public:
+  OptimiserTests()
+  {
+    optimised.module().EnableOptimisation();
+  }
+
+  static std::size_t CountInstructions(Executable const &executable)
+  {
+    std::size_t count{0};
+    for (auto const &function : executable.functions)
+    {
+      count += function.instructions.size();
+    }
+    return count;
+  }
+
+  // compiles the text with and without optimisation, and checks that both are charged the same
+  void CompileAndRun(char const *text, int64_t expected)
+  {
+    ASSERT_TRUE(unoptimised.Compile(text));
+    ASSERT_TRUE(optimised.Compile(text));
+
+    Variant unoptimised_output;
+    ASSERT_TRUE(unoptimised.Run(&unoptimised_output));
+    EXPECT_EQ(unoptimised_output.Get<int64_t>(), expected);
+
+    Variant optimised_output;
+    ASSERT_TRUE(optimised.Run(&optimised_output));
+    EXPECT_EQ(optimised_output.Get<int64_t>(), expected);
+
+    EXPECT_EQ(optimised.vm().GetChargeTotal(), unoptimised.vm().GetChargeTotal());
+  }
+
+  std::stringstream stdout;
+  VmTestToolkit     unoptimised{&stdout};
+  VmTestToolkit     optimised{&stdout};
+};
+
+TEST_F(OptimiserTests, constant_expressions_are_folded)
+{
+  static char const *TEXT = R"(
+    function main() : Int64
+      var a = 2i64 + 3i64 * 4i64;
+      var b = -(7i64);
+      var c = 10i64 / 3i64 + 10i64 % 4i64;
+      if (3i64 < 4i64)
+        a = a + 1i64;
+      else
+        a = a - 1i64;
+      endif
+      return a + b + c;
+    endfunction
+  )";
+
+  CompileAndRun(TEXT, 15 - 7 + 5);
+  EXPECT_LT(CountInstructions(optimised.executable()),
+            CountInstructions(unoptimised.executable()));
+}
+
+TEST_F(OptimiserTests, dead_stores_and_copies_are_eliminated)
+{
+  static char const *TEXT = R"(
+    function add(a : Int64, b : Int64) : Int64
+      var unused = 42i64;
+      var c = a;
+      var d = c;
+      return d + b;
+    endfunction
+
+    function main() : Int64
+      var total = 0i64;
+      var i = 0i64;
+      while (i < 100i64)
+        total = total + add(i, 3i64);
+        i = i + 1i64;
+      endwhile
+      return total;
+    endfunction
+  )";
+
+  CompileAndRun(TEXT, 4950 + 300);
+  EXPECT_LT(CountInstructions(optimised.executable()),
+            CountInstructions(unoptimised.executable()));
+}
+
+TEST_F(OptimiserTests, loop_invariant_arithmetic_is_hoisted)
+{
+  static char const *TEXT = R"(
+    function main() : Int64
+      var total = 0i64;
+      var limit = 20i64;
+      var step = 2i64;
+      var i = 0i64;
+      while (i < limit * step)
+        for (j in 0:10)
+          total = total + limit * step + toInt64(j);
+        endfor
+        i = i + 1i64;
+      endwhile
+      return total;
+    endfunction
+  )";
+
+  CompileAndRun(TEXT, 40 * (10 * 40 + 45));
+}
+
+TEST_F(OptimiserTests, runtime_errors_are_not_folded_away)
+{
+  static char const *TEXT = R"(
+    function main() : Int64
+      var a = 1i64 / 0i64;
+      return a;
+    endfunction
+  )";
+
+  ASSERT_TRUE(optimised.Compile(TEXT));
+  EXPECT_FALSE(optimised.Run());
+  EXPECT_THAT(stdout.str(), HasSubstr("division by zero"));
+}
+
+TEST_F(OptimiserTests, charge_limit_is_enforced_as_for_unoptimised_code)
+{
+  static char const *TEXT = R"(
+    function main() : Int64
+      var total = 0i64;
+      var k = 5i64;
+      var i = 0i64;
+      while (i < 1000i64)
+        total = total + k * 2i64 + i;
+        i = i + 1i64;
+      endwhile
+      return total;
+    endfunction
+  )";
+
+  ASSERT_TRUE(unoptimised.Compile(TEXT));
+  ASSERT_TRUE(unoptimised.Run());
+  auto const charge = unoptimised.vm().GetChargeTotal();
+
+  ASSERT_TRUE(optimised.Compile(TEXT));
+  EXPECT_FALSE(optimised.Run(nullptr, charge));
+
+  ASSERT_TRUE(optimised.Compile(TEXT));
+  EXPECT_TRUE(optimised.Run(nullptr, charge + 1));
+  EXPECT_EQ(optimised.vm().GetChargeTotal(), charge);
+}
+
+}  // namespace
@@ -0,0 +1,164 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm_test_toolkit.hpp"
+
+#include "gmock/gmock.h"
+
+#include <cstdint>
+#include <sstream>
+
+namespace {
+
+using namespace testing;
+
+class ThreadedCodeTests : public Test
+{
+public:
+  std::stringstream stdout;
+  VmTestToolkit     toolkit{&stdout};
+};
+
+static char const *LOOP_TEXT = R"(
+  function main() : Int64
+    var total = 0i64;
+    var i = 0i64;
+    while (i < 1000i64)
+      if (i % 3i64 == 0i64)
+        total = total + i * 2i64;
+      else
+        total -= 1i64;
+      endif
+      i = i + 1i64;
+    endwhile
+    return total;
+  endfunction
+)";
+
+TEST_F(ThreadedCodeTests, loops_with_fused_instructions_compute_the_correct_result)
+{
+  int64_t expected{0};
+  for (int64_t i = 0; i < 1000; ++i)
+  {
+    if (i % 3 == 0)
+    {
+      expected = expected + i * 2;
+    }
+    else
+    {
+      expected -= 1;
+    }
+  }
+
+  ASSERT_TRUE(toolkit.Compile(LOOP_TEXT));
+
+  Variant output;
+  ASSERT_TRUE(toolkit.Run(&output));
+  EXPECT_EQ(output.Get<int64_t>(), expected);
+}
+
+TEST_F(ThreadedCodeTests, recursive_calls_compute_the_correct_result)
+{
+  static char const *TEXT = R"(
+    function fib(n : Int32) : Int32
+      if (n < 2)
+        return n;
+      endif
+      return fib(n - 1) + fib(n - 2);
+    endfunction
+
+    function main() : Int32
+      return fib(15);
+    endfunction
+  )";
+
+  ASSERT_TRUE(toolkit.Compile(TEXT));
+
+  Variant output;
+  ASSERT_TRUE(toolkit.Run(&output));
+  EXPECT_EQ(output.Get<int32_t>(), 610);
+}
+
+TEST_F(ThreadedCodeTests, updated_static_charges_are_applied_to_decoded_functions)
+{
+  static char const *TEXT = R"(
+    function main()
+      var i = 0;
+      while (i < 10)
+        i = i + 1;
+      endwhile
+    endfunction
+  )";
+
+  ASSERT_TRUE(toolkit.Compile(TEXT));
+
+  ASSERT_TRUE(toolkit.Run());
+  auto const default_charge = toolkit.vm().GetChargeTotal();
+
+  ASSERT_TRUE(toolkit.Run());
+  EXPECT_EQ(toolkit.vm().GetChargeTotal(), 2 * default_charge);
+
+  // each of the ten additions now costs 100 instead of 1
+  toolkit.vm().UpdateCharges({{"PrimitiveAdd", 100}});
+
+  ASSERT_TRUE(toolkit.Run());
+  EXPECT_EQ(toolkit.vm().GetChargeTotal(), 3 * default_charge + 10 * 99);
+}
+
+TEST_F(ThreadedCodeTests, instructions_with_a_zero_static_charge_cost_one_unit)
+{
+  static char const *TEXT = R"(
+    function main()
+      var i = 0;
+      while (i < 10)
+        i = i + 1;
+      endwhile
+    endfunction
+  )";
+
+  ASSERT_TRUE(toolkit.Compile(TEXT));
+
+  ASSERT_TRUE(toolkit.Run());
+  auto const default_charge = toolkit.vm().GetChargeTotal();
+
+  // a zero charge is billed as one unit, the same as the default
+  toolkit.vm().UpdateCharges({{"PrimitiveAdd", 0}});
+
+  ASSERT_TRUE(toolkit.Run());
+  EXPECT_EQ(toolkit.vm().GetChargeTotal(), 2 * default_charge);
+}
+
+TEST_F(ThreadedCodeTests, charge_limit_is_enforced_for_basic_blocks)
+{
+  ASSERT_TRUE(toolkit.Compile(LOOP_TEXT));
+  ASSERT_TRUE(toolkit.Run());
+  auto const charge = toolkit.vm().GetChargeTotal();
+
+  // the limit is exceeded once the charge total reaches it
+  ASSERT_TRUE(toolkit.Compile(LOOP_TEXT));
+  EXPECT_FALSE(toolkit.Run(nullptr, charge));
+
+  ASSERT_TRUE(toolkit.Compile(LOOP_TEXT));
+  EXPECT_FALSE(toolkit.Run(nullptr, charge / 2));
+
+  ASSERT_TRUE(toolkit.Compile(LOOP_TEXT));
+  EXPECT_TRUE(toolkit.Run(nullptr, charge + 1));
+  EXPECT_EQ(toolkit.vm().GetChargeTotal(), charge);
+}
+
+}  // namespace
@@ -147,6 +147,11 @@ public:
     return *vm_;
   }
 
+  Executable &executable() const
+  {
+    return *executable_;
+  }
+
   MockIoObserver &observer() const
   {
     return *observer_;
@@ -139,6 +139,25 @@ struct Executable
 
   using PcToLineMap = std::map<uint16_t, uint16_t>;
 
+  /**
+   * The optimiser removes and rewrites instructions, but optimised code must be charged exactly as
+   * the unoptimised code would have been. Each adjustment bills (or refunds) the static charge of
+   * an opcode as part of the basic block containing the given instruction.
+   */
+  struct ChargeAdjustment
+  {
+    ChargeAdjustment(uint16_t pc__, uint16_t opcode__, bool refund__)
+      : pc{pc__}
+      , opcode{opcode__}
+      , refund{refund__}
+    {}
+
+    uint16_t pc{};
+    uint16_t opcode{};
+    bool     refund{};
+  };
+  using ChargeAdjustmentArray = std::vector<ChargeAdjustment>;
+
   struct Function
   {
     Function() = default;
@@ -172,16 +191,17 @@ struct Executable
       auto it = pc_to_line_map.lower_bound(static_cast<uint16_t>(pc + 1));
       return (--it)->second;
     }
-    FunctionKind     kind{FunctionKind::Unknown};
-    std::string      name;
-    AnnotationArray  annotations;
-    TypeId           return_type_id{TypeIds::Unknown};
-    int              num_parameters{};
-    ParameterArray   parameters;
-    int              num_variables{};  // parameters + locals
-    VariableArray    variables;        // parameters + locals
-    InstructionArray instructions;
-    PcToLineMap      pc_to_line_map;
+    FunctionKind          kind{FunctionKind::Unknown};
+    std::string           name;
+    AnnotationArray       annotations;
+    TypeId                return_type_id{TypeIds::Unknown};
+    int                   num_parameters{};
+    ParameterArray        parameters;
+    int                   num_variables{};  // parameters + locals
+    VariableArray         variables;        // parameters + locals
+    InstructionArray      instructions;
+    PcToLineMap           pc_to_line_map;
+    ChargeAdjustmentArray charge_adjustments;
   };
   using FunctionArray = std::vector<Function>;
 
@@ -398,6 +418,7 @@ private:
 
   VM *                     vm_{};
   uint16_t                 num_system_types_{};
+  bool                     optimise_{false};
   Executable               executable_;
   std::vector<Scope>       scopes_;
   std::vector<Loop>        loops_;
@@ -409,7 +430,7 @@ private:
   LineToPcMap              line_to_pc_map_;
   std::vector<std::string> errors_;
 
-  void          Initialise(VM *vm, uint16_t num_system_types);
+  void          Initialise(VM *vm, uint16_t num_system_types, bool optimise);
   uint16_t      AddInstruction(Executable::Instruction const &instruction, uint16_t line);
   void          AddLineNumber(uint16_t line, uint16_t pc);
   void          ResolveTypes(IR const &ir);
@@ -485,6 +485,20 @@ public:
     return test_annotations_;
   }
 
+  /**
+   * Runs the optimisation passes over executables generated for this module. Optimised code is
+   * charged exactly as the unoptimised code would have been.
+   */
+  void EnableOptimisation()
+  {
+    optimisation_ = true;
+  }
+
+  bool IsUsingOptimisation() const
+  {
+    return optimisation_;
+  }
+
 private:
   template <typename Estimator, typename Callable>
   void InternalCreateFreeFunction(std::string const &name, Callable callable,
@@ -556,6 +570,7 @@ private:
   CPPCopyConstructorMap cpp_copy_constructors_;
 
   bool test_annotations_{false};
+  bool optimisation_{false};
   friend class Compiler;
   friend class VM;
 };
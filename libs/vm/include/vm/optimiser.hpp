@@ -0,0 +1,101 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/generator.hpp"
+#include "vm/opcodes.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fetch {
+namespace vm {
+
+class VM;
+
+/**
+ * Optional optimisation passes that run over the instructions of a generated executable:
+ * constant and branch folding, jump threading, copy propagation, dead store and unreachable code
+ * elimination and the hoisting of loop invariant arithmetic.
+ *
+ * Optimised code is charged exactly as the unoptimised code would have been. The static charge of
+ * every instruction that is removed or rewritten is billed to an instruction that executes under
+ * the same conditions, and recorded in the function's charge adjustments.
+ */
+class Optimiser
+{
+public:
+  explicit Optimiser(VM *vm);
+  ~Optimiser() = default;
+
+  void Optimise(Executable &executable);
+
+private:
+  struct Node
+  {
+    Executable::Instruction instruction{Opcodes::Unknown};
+    uint16_t                line{};
+    bool                    removed{false};
+    bool                    charged{true};  // false if the instruction's own charge is refunded
+    std::vector<uint16_t>   billed;         // opcodes charged on behalf of other instructions
+    std::vector<Node>       preheader;      // instructions hoisted in front of a loop header
+    std::size_t             loop_end{};     // last node of the loop owning the preheader
+  };
+  using NodeArray = std::vector<Node>;
+
+  static std::size_t const NONE             = static_cast<std::size_t>(-1);
+  static std::size_t const MAX_ROUNDS       = 16;
+  static std::size_t const MAX_INSTRUCTIONS = 0xFFFF;
+  static std::size_t const MAX_VARIABLES    = 0xFFFF;
+  static std::size_t const MAX_CONSTANTS    = 2048;
+
+  VM *                  vm_;
+  Executable *          executable_{};
+  Executable::Function *function_{};
+  NodeArray             nodes_;
+  std::vector<bool>     targets_;
+
+  void OptimiseFunction(Executable::Function &function);
+  void Emit();
+
+  bool FoldConstants();
+  bool FoldBranches();
+  bool ThreadJumps();
+  bool PropagateCopies();
+  bool EliminateDeadStores();
+  bool EliminateUnreachableCode();
+  void HoistLoopInvariants();
+
+  bool HoistLoopInvariants(std::size_t header, std::size_t back_edge);
+
+  void        Evaluate(uint16_t opcode, Variant &lhsv, Variant &rhsv);
+  void        FindJumpTargets();
+  std::size_t Next(std::size_t index) const;
+  std::size_t Previous(std::size_t index) const;
+  std::size_t Resolve(std::size_t index) const;
+  std::size_t FindHost(std::size_t index) const;
+  bool        Remove(std::size_t index);
+  void        Absorb(std::size_t host, std::size_t index);
+  void        Rewrite(std::size_t index, Executable::Instruction const &instruction);
+  bool        IsPrimitiveVariable(uint16_t index) const;
+  bool        FindConstant(Variant const &value, uint16_t &index);
+};
+
+}  // namespace vm
+}  // namespace fetch
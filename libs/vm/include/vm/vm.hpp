@@ -479,6 +479,8 @@ public:
       TypeInfo const &type_info = executable_->types[i];
       type_info_array_.push_back(type_info);
     }
+
+    ResetDecodedFunctions();
   }
 
   void UnloadExecutable()
@@ -492,6 +494,7 @@ public:
     }
 
     executable_ = nullptr;
+    ResetDecodedFunctions();
   }
 
   TypeInfo const &GetTypeInfo(TypeId type_id) const
@@ -570,18 +573,23 @@ public:
     return it->second(this, static_cast<void const *>(&val));
   }
 
+  using Routine = void (*)(VM *);
+
   struct OpcodeInfo
   {
     OpcodeInfo() = default;
-    OpcodeInfo(std::string unique_name__, Handler handler__, ChargeAmount static_charge__)
+    OpcodeInfo(std::string unique_name__, Handler handler__, ChargeAmount static_charge__,
+               Routine routine__ = nullptr)
       : unique_name(std::move(unique_name__))
       , handler(std::move(handler__))
       , static_charge{static_charge__}
+      , routine{routine__}
     {}
 
     std::string  unique_name;
     Handler      handler;
     ChargeAmount static_charge{};
+    Routine      routine{};  ///< Direct entry point, only available for the built in opcodes
   };
 
   ChargeAmount GetChargeTotal() const;
@@ -600,6 +608,21 @@ private:
   using OpcodeInfoArray = std::vector<OpcodeInfo>;
   using OpcodeMap       = std::unordered_map<std::string, uint16_t>;
 
+  /**
+   * The pre-decoded (threaded) form of a single instruction. The routine is resolved once when the
+   * function is decoded, so the dispatch loop makes a single direct call per instruction. Sequences
+   * of common opcodes are fused into one superinstruction, in which case the routine executes all
+   * of them. The static charge of a basic block is paid in full on entry to the block.
+   */
+  struct DecodedInstruction
+  {
+    Routine      routine{};
+    OpcodeInfo * info{};
+    ChargeAmount block_charge{};  ///< Zero for all but the first instruction of a basic block
+  };
+  using DecodedFunction    = std::vector<DecodedInstruction>;
+  using DecodedFunctionMap = std::unordered_map<Executable::Function const *, DecodedFunction>;
+
   struct Frame
   {
     Executable::Function const *function{};
@@ -672,6 +695,9 @@ private:
   DeserializeConstructorMap      deserialization_constructors_;
   CPPCopyConstructorMap          cpp_copy_constructors_;
   OpcodeInfo *                   current_op_{};
+  DecodedFunctionMap             decoded_functions_;
+  Executable::Function const *   decoded_function_{};
+  DecodedInstruction const *     decoded_{};
 
   /// @name Charges
   /// @{
@@ -679,13 +705,18 @@ private:
   ChargeAmount charge_total_{0};
   /// @}
 
-  void AddOpcodeInfo(uint16_t opcode, std::string unique_name, Handler handler,
+  void AddOpcodeInfo(uint16_t opcode, std::string unique_name, Routine routine,
                      ChargeAmount static_charge = 1)
   {
     opcode_info_array_[opcode] =
-        OpcodeInfo(std::move(unique_name), std::move(handler), static_charge);
+        OpcodeInfo(std::move(unique_name), routine, static_charge, routine);
   }
 
+  class Decoder;
+
+  DecodedInstruction const *Decode(Executable::Function const &function);
+  void                      ResetDecodedFunctions();
+
   bool Execute(std::string &error, Variant &output);
   void Destruct(uint16_t scope_number);
 
@@ -1987,6 +2018,7 @@ private:
   friend class Object;
   friend class Module;
   friend class Generator;
+  friend class Optimiser;
 };
 
 template <typename T>
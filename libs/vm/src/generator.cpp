@@ -17,6 +17,7 @@
 //------------------------------------------------------------------------------
 
 #include "vm/generator.hpp"
+#include "vm/optimiser.hpp"
 #include "vm/vm.hpp"
 
 #include <cstddef>
@@ -30,10 +31,11 @@
 namespace fetch {
 namespace vm {
 
-void Generator::Initialise(VM *vm, uint16_t num_system_types)
+void Generator::Initialise(VM *vm, uint16_t num_system_types, bool optimise)
 {
   vm_               = vm;
   num_system_types_ = num_system_types;
+  optimise_         = optimise;
 }
 
 bool Generator::GenerateExecutable(IR const &ir, std::string const &executable_name,
@@ -103,6 +105,12 @@ bool Generator::GenerateExecutable(IR const &ir, std::string const &executable_n
     return false;
   }
 
+  if (optimise_)
+  {
+    Optimiser optimiser(vm_);
+    optimiser.Optimise(executable_);
+  }
+
   executable = executable_;
   return true;
 }
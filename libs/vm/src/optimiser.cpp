@@ -0,0 +1,1080 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/opcodes.hpp"
+#include "vm/optimiser.hpp"
+#include "vm/vm.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace fetch {
+namespace vm {
+
+namespace {
+
+bool IsJump(uint16_t opcode)
+{
+  switch (opcode)
+  {
+  case Opcodes::Break:
+  case Opcodes::Continue:
+  case Opcodes::Jump:
+  case Opcodes::JumpIfFalse:
+  case Opcodes::JumpIfTrue:
+  case Opcodes::JumpIfFalseOrPop:
+  case Opcodes::JumpIfTrueOrPop:
+  case Opcodes::ForRangeIterate:
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool FallsThrough(uint16_t opcode)
+{
+  switch (opcode)
+  {
+  case Opcodes::Break:
+  case Opcodes::Continue:
+  case Opcodes::Jump:
+  case Opcodes::Return:
+  case Opcodes::ReturnValue:
+    return false;
+  default:
+    return true;
+  }
+}
+
+// must agree with the basic blocks that the VM charges for (see vm_decoder.cpp)
+bool EndsBasicBlock(uint16_t opcode)
+{
+  switch (opcode)
+  {
+  case Opcodes::Return:
+  case Opcodes::ReturnValue:
+  case Opcodes::InvokeUserDefinedFreeFunction:
+  case Opcodes::InvokeUserDefinedConstructor:
+  case Opcodes::InvokeUserDefinedMemberFunction:
+    return true;
+  default:
+    return IsJump(opcode);
+  }
+}
+
+bool IsPurePush(uint16_t opcode)
+{
+  switch (opcode)
+  {
+  case Opcodes::PushFalse:
+  case Opcodes::PushTrue:
+  case Opcodes::PushConstant:
+  case Opcodes::PushLocalVariable:
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool IsIntegral(TypeId type_id)
+{
+  return (type_id >= TypeIds::Int8) && (type_id <= TypeIds::UInt64);
+}
+
+// opcodes that both read and write the local variable given by their index
+bool IsLocalVariableUpdate(uint16_t opcode)
+{
+  switch (opcode)
+  {
+  case Opcodes::LocalVariablePrefixInc:
+  case Opcodes::LocalVariablePrefixDec:
+  case Opcodes::LocalVariablePostfixInc:
+  case Opcodes::LocalVariablePostfixDec:
+  case Opcodes::LocalVariablePrimitiveInplaceAdd:
+  case Opcodes::LocalVariableObjectInplaceAdd:
+  case Opcodes::LocalVariableObjectInplaceRightAdd:
+  case Opcodes::LocalVariablePrimitiveInplaceSubtract:
+  case Opcodes::LocalVariableObjectInplaceSubtract:
+  case Opcodes::LocalVariableObjectInplaceRightSubtract:
+  case Opcodes::LocalVariablePrimitiveInplaceMultiply:
+  case Opcodes::LocalVariableObjectInplaceMultiply:
+  case Opcodes::LocalVariableObjectInplaceRightMultiply:
+  case Opcodes::LocalVariablePrimitiveInplaceDivide:
+  case Opcodes::LocalVariableObjectInplaceDivide:
+  case Opcodes::LocalVariableObjectInplaceRightDivide:
+  case Opcodes::LocalVariablePrimitiveInplaceModulo:
+  case Opcodes::ForRangeInit:
+  case Opcodes::ContractVariableDeclareAssign:
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool ReadsLocalVariable(uint16_t opcode)
+{
+  return (opcode == Opcodes::PushLocalVariable) || IsLocalVariableUpdate(opcode);
+}
+
+bool WritesLocalVariable(uint16_t opcode)
+{
+  switch (opcode)
+  {
+  case Opcodes::LocalVariableDeclare:
+  case Opcodes::LocalVariableDeclareAssign:
+  case Opcodes::PopToLocalVariable:
+    return true;
+  default:
+    return IsLocalVariableUpdate(opcode);
+  }
+}
+
+bool IsFoldableBinaryOp(uint16_t opcode)
+{
+  switch (opcode)
+  {
+  case Opcodes::PrimitiveEqual:
+  case Opcodes::PrimitiveNotEqual:
+  case Opcodes::PrimitiveLessThan:
+  case Opcodes::PrimitiveLessThanOrEqual:
+  case Opcodes::PrimitiveGreaterThan:
+  case Opcodes::PrimitiveGreaterThanOrEqual:
+  case Opcodes::PrimitiveAdd:
+  case Opcodes::PrimitiveSubtract:
+  case Opcodes::PrimitiveMultiply:
+  case Opcodes::PrimitiveDivide:
+  case Opcodes::PrimitiveModulo:
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool IsSafeDivisor(Variant const &divisor)
+{
+  // zero fails at runtime and -1 overflows the most negative dividend
+  switch (divisor.type_id)
+  {
+  case TypeIds::Int8:
+    return (divisor.primitive.i8 != 0) && (divisor.primitive.i8 != -1);
+  case TypeIds::Int16:
+    return (divisor.primitive.i16 != 0) && (divisor.primitive.i16 != -1);
+  case TypeIds::Int32:
+    return (divisor.primitive.i32 != 0) && (divisor.primitive.i32 != -1);
+  case TypeIds::Int64:
+    return (divisor.primitive.i64 != 0) && (divisor.primitive.i64 != -1);
+  case TypeIds::UInt8:
+    return divisor.primitive.ui8 != 0;
+  case TypeIds::UInt16:
+    return divisor.primitive.ui16 != 0;
+  case TypeIds::UInt32:
+    return divisor.primitive.ui32 != 0;
+  case TypeIds::UInt64:
+    return divisor.primitive.ui64 != 0;
+  default:
+    return false;
+  }
+}
+
+bool IsHoistableOp(uint16_t opcode)
+{
+  // none of these can fail, so they are safe to execute even if the loop body never runs
+  switch (opcode)
+  {
+  case Opcodes::PrimitiveAdd:
+  case Opcodes::PrimitiveSubtract:
+  case Opcodes::PrimitiveMultiply:
+    return true;
+  default:
+    return false;
+  }
+}
+
+}  // namespace
+
+std::size_t const Optimiser::NONE;
+std::size_t const Optimiser::MAX_ROUNDS;
+std::size_t const Optimiser::MAX_INSTRUCTIONS;
+std::size_t const Optimiser::MAX_VARIABLES;
+std::size_t const Optimiser::MAX_CONSTANTS;
+
+Optimiser::Optimiser(VM *vm)
+  : vm_{vm}
+{}
+
+void Optimiser::Optimise(Executable &executable)
+{
+  executable_ = &executable;
+
+  for (auto &function : executable.functions)
+  {
+    OptimiseFunction(function);
+  }
+
+  for (auto &contract : executable.contracts)
+  {
+    for (auto &function : contract.functions)
+    {
+      OptimiseFunction(function);
+    }
+  }
+
+  for (auto &type : executable.user_defined_types)
+  {
+    for (auto &function : type.functions)
+    {
+      OptimiseFunction(function);
+    }
+  }
+
+  executable_ = nullptr;
+}
+
+void Optimiser::OptimiseFunction(Executable::Function &function)
+{
+  if (function.instructions.empty())
+  {
+    return;
+  }
+
+  function_ = &function;
+  nodes_.clear();
+  nodes_.reserve(function.instructions.size());
+  for (std::size_t pc = 0; pc < function.instructions.size(); ++pc)
+  {
+    Node node;
+    node.instruction = function.instructions[pc];
+    node.line        = function.FindLineNumber(static_cast<uint16_t>(pc));
+    nodes_.push_back(std::move(node));
+  }
+
+  // every pass keeps the jump targets up to date, so they can be run in any order
+  FindJumpTargets();
+
+  bool changed = true;
+  for (std::size_t round = 0; changed && (round < MAX_ROUNDS); ++round)
+  {
+    changed = false;
+    changed |= FoldConstants();
+    changed |= FoldBranches();
+    changed |= ThreadJumps();
+    changed |= EliminateUnreachableCode();
+    changed |= PropagateCopies();
+    changed |= EliminateDeadStores();
+  }
+
+  HoistLoopInvariants();
+
+  Emit();
+
+  nodes_.clear();
+  targets_.clear();
+  function_ = nullptr;
+}
+
+/**
+ * Replaces the instructions of the function with the surviving nodes, hoisted instructions being
+ * placed in front of their loop header. Jumps into a loop header from outside of the loop enter
+ * through its preheader.
+ */
+void Optimiser::Emit()
+{
+  std::size_t const            num_nodes = nodes_.size();
+  std::vector<std::size_t>     pcs(num_nodes + 1);
+  std::vector<std::size_t>     entry_pcs(num_nodes + 1);
+  Executable::InstructionArray instructions;
+  std::vector<uint16_t>        lines;
+  std::vector<Node const *>    emitted;
+
+  for (std::size_t i = 0; i < num_nodes; ++i)
+  {
+    Node const &node = nodes_[i];
+    entry_pcs[i]     = instructions.size();
+    if (!node.removed)
+    {
+      for (auto const &hoisted : node.preheader)
+      {
+        instructions.push_back(hoisted.instruction);
+        lines.push_back(hoisted.line);
+        emitted.push_back(&hoisted);
+      }
+    }
+    pcs[i] = instructions.size();
+    if (!node.removed)
+    {
+      instructions.push_back(node.instruction);
+      lines.push_back(node.line);
+      emitted.push_back(&node);
+    }
+  }
+  pcs[num_nodes]       = instructions.size();
+  entry_pcs[num_nodes] = instructions.size();
+
+  // remap the jumps, a removed target continues at the next surviving instruction
+  for (std::size_t i = 0; i < num_nodes; ++i)
+  {
+    Node const &node = nodes_[i];
+    if (node.removed || !IsJump(node.instruction.opcode))
+    {
+      continue;
+    }
+
+    std::size_t target = Resolve(node.instruction.index);
+    if (target == NONE)
+    {
+      target = num_nodes;
+    }
+
+    bool const inside_loop = (target < num_nodes) && !nodes_[target].preheader.empty() &&
+                             (target <= i) && (i <= nodes_[target].loop_end);
+    instructions[pcs[i]].index =
+        static_cast<uint16_t>(inside_loop ? pcs[target] : entry_pcs[target]);
+  }
+
+  function_->instructions = std::move(instructions);
+
+  function_->pc_to_line_map.clear();
+  for (std::size_t i = 0; i < lines.size(); ++i)
+  {
+    if ((i == 0) || (lines[i] != lines[i - 1]))
+    {
+      function_->pc_to_line_map[static_cast<uint16_t>(i)] = lines[i];
+    }
+  }
+
+  function_->charge_adjustments.clear();
+  for (std::size_t i = 0; i < emitted.size(); ++i)
+  {
+    auto const  emitted_pc = static_cast<uint16_t>(i);
+    Node const &node       = *emitted[i];
+    if (!node.charged)
+    {
+      function_->charge_adjustments.emplace_back(emitted_pc, node.instruction.opcode, true);
+    }
+    for (auto const opcode : node.billed)
+    {
+      function_->charge_adjustments.emplace_back(emitted_pc, opcode, false);
+    }
+  }
+}
+
+/**
+ * Folds arithmetic and comparisons of integral constants, using the VM's own implementation of
+ * the operations. Divisions that would fail or overflow at runtime are left alone.
+ */
+bool Optimiser::FoldConstants()
+{
+  FindJumpTargets();
+
+  bool changed = false;
+  for (std::size_t a = 0; a < nodes_.size(); ++a)
+  {
+    if (nodes_[a].removed || (nodes_[a].instruction.opcode != Opcodes::PushConstant))
+    {
+      continue;
+    }
+
+    std::size_t const b = Next(a);
+    if ((b == NONE) || targets_[b])
+    {
+      continue;
+    }
+
+    Variant lhsv = executable_->constants[nodes_[a].instruction.index];
+    if (!IsIntegral(lhsv.type_id))
+    {
+      continue;
+    }
+
+    Executable::Instruction const &second = nodes_[b].instruction;
+    if ((second.opcode == Opcodes::PrimitiveNegate) && (second.type_id == lhsv.type_id))
+    {
+      Evaluate(second.opcode, lhsv, lhsv);
+
+      uint16_t index{};
+      if (FindConstant(lhsv, index))
+      {
+        Executable::Instruction instruction(Opcodes::PushConstant);
+        instruction.index = index;
+        Rewrite(a, instruction);
+        Absorb(a, b);
+        changed = true;
+      }
+      continue;
+    }
+
+    std::size_t const c = Next(b);
+    if ((second.opcode != Opcodes::PushConstant) || (c == NONE) || targets_[c])
+    {
+      continue;
+    }
+
+    Variant                        rhsv = executable_->constants[second.index];
+    Executable::Instruction const &op   = nodes_[c].instruction;
+    if (!IsFoldableBinaryOp(op.opcode) || (op.type_id != lhsv.type_id) ||
+        (rhsv.type_id != lhsv.type_id))
+    {
+      continue;
+    }
+
+    if (((op.opcode == Opcodes::PrimitiveDivide) || (op.opcode == Opcodes::PrimitiveModulo)) &&
+        !IsSafeDivisor(rhsv))
+    {
+      continue;
+    }
+
+    Evaluate(op.opcode, lhsv, rhsv);
+
+    Executable::Instruction instruction(Opcodes::PushConstant);
+    if (lhsv.type_id == TypeIds::Bool)
+    {
+      instruction.opcode = (lhsv.primitive.ui8 != 0) ? Opcodes::PushTrue : Opcodes::PushFalse;
+    }
+    else if (!FindConstant(lhsv, instruction.index))
+    {
+      continue;
+    }
+
+    Rewrite(a, instruction);
+    Absorb(a, b);
+    Absorb(a, c);
+    changed = true;
+  }
+
+  return changed;
+}
+
+/**
+ * Resolves conditional jumps on a constant condition, either into an unconditional jump or by
+ * removing the jump altogether.
+ */
+bool Optimiser::FoldBranches()
+{
+  FindJumpTargets();
+
+  bool changed = false;
+  for (std::size_t a = 0; a < nodes_.size(); ++a)
+  {
+    uint16_t const opcode = nodes_[a].instruction.opcode;
+    if (nodes_[a].removed || ((opcode != Opcodes::PushTrue) && (opcode != Opcodes::PushFalse)))
+    {
+      continue;
+    }
+
+    std::size_t const b = Next(a);
+    if ((b == NONE) || targets_[b] ||
+        ((nodes_[b].instruction.opcode != Opcodes::JumpIfTrue) &&
+         (nodes_[b].instruction.opcode != Opcodes::JumpIfFalse)))
+    {
+      continue;
+    }
+
+    bool const taken =
+        (opcode == Opcodes::PushTrue) == (nodes_[b].instruction.opcode == Opcodes::JumpIfTrue);
+
+    Absorb(b, a);
+
+    Executable::Instruction jump(Opcodes::Jump);
+    if (taken)
+    {
+      jump.index = nodes_[b].instruction.index;
+      Rewrite(b, jump);
+    }
+    else if (!Remove(b))
+    {
+      // the charges have nowhere else to go, so continue with a jump to the next instruction
+      std::size_t const next = Next(b);
+      jump.index             = static_cast<uint16_t>(next == NONE ? nodes_.size() : next);
+      Rewrite(b, jump);
+    }
+    changed = true;
+  }
+
+  return changed;
+}
+
+/**
+ * Retargets unconditional jumps that land on another unconditional jump.
+ */
+bool Optimiser::ThreadJumps()
+{
+  bool changed = false;
+  for (std::size_t x = 0; x < nodes_.size(); ++x)
+  {
+    Node &node = nodes_[x];
+    if (node.removed || (node.instruction.opcode != Opcodes::Jump))
+    {
+      continue;
+    }
+
+    // the length of the chain is bounded to stop at loops made of jumps only
+    std::size_t target = Resolve(node.instruction.index);
+    for (std::size_t length = 0; length < nodes_.size(); ++length)
+    {
+      if ((target == NONE) || (target == x) ||
+          (nodes_[target].instruction.opcode != Opcodes::Jump) ||
+          (Resolve(nodes_[target].instruction.index) == target))
+      {
+        break;
+      }
+
+      // the skipped jump is still charged, as are any charges it carries
+      Node const &skipped = nodes_[target];
+      if (skipped.charged)
+      {
+        node.billed.push_back(skipped.instruction.opcode);
+      }
+      node.billed.insert(node.billed.end(), skipped.billed.begin(), skipped.billed.end());
+
+      node.instruction.index = skipped.instruction.index;
+      target                 = Resolve(node.instruction.index);
+      changed                = true;
+    }
+  }
+
+  return changed;
+}
+
+/**
+ * Removes the instructions that can not be reached from the start of the function.
+ */
+bool Optimiser::EliminateUnreachableCode()
+{
+  std::vector<bool>        reachable(nodes_.size(), false);
+  std::vector<std::size_t> pending{Resolve(0)};
+
+  while (!pending.empty())
+  {
+    std::size_t const x = pending.back();
+    pending.pop_back();
+    if ((x == NONE) || reachable[x])
+    {
+      continue;
+    }
+    reachable[x] = true;
+
+    Executable::Instruction const &instruction = nodes_[x].instruction;
+    if (FallsThrough(instruction.opcode))
+    {
+      pending.push_back(Next(x));
+    }
+    if (IsJump(instruction.opcode))
+    {
+      pending.push_back(Resolve(instruction.index));
+    }
+  }
+
+  bool changed = false;
+  for (std::size_t x = 0; x < nodes_.size(); ++x)
+  {
+    if (!nodes_[x].removed && !reachable[x])
+    {
+      nodes_[x].removed = true;
+      changed           = true;
+    }
+  }
+
+  return changed;
+}
+
+/**
+ * Within a basic block, replaces reads of a primitive variable that holds a copy of another
+ * variable by reads of the original.
+ */
+bool Optimiser::PropagateCopies()
+{
+  FindJumpTargets();
+
+  bool                                   changed = false;
+  std::unordered_map<uint16_t, uint16_t> copies;  // copy -> original
+  for (std::size_t x = 0; x < nodes_.size(); ++x)
+  {
+    if (nodes_[x].removed)
+    {
+      continue;
+    }
+
+    if (targets_[x])
+    {
+      copies.clear();
+    }
+
+    Executable::Instruction &instruction = nodes_[x].instruction;
+    if (instruction.opcode == Opcodes::PushLocalVariable)
+    {
+      auto const it = copies.find(instruction.index);
+      if (it != copies.end())
+      {
+        instruction.index = it->second;
+        changed           = true;
+      }
+    }
+    else if (WritesLocalVariable(instruction.opcode))
+    {
+      uint16_t const variable = instruction.index;
+      copies.erase(variable);
+      for (auto it = copies.begin(); it != copies.end();)
+      {
+        it = (it->second == variable) ? copies.erase(it) : std::next(it);
+      }
+
+      std::size_t const previous = Previous(x);
+      if (((instruction.opcode == Opcodes::PopToLocalVariable) ||
+           (instruction.opcode == Opcodes::LocalVariableDeclareAssign)) &&
+          (previous != NONE) && !targets_[x] &&
+          (nodes_[previous].instruction.opcode == Opcodes::PushLocalVariable))
+      {
+        uint16_t const original = nodes_[previous].instruction.index;
+        if ((original != variable) && IsPrimitiveVariable(original) &&
+            IsPrimitiveVariable(variable) &&
+            (function_->variables[original].type_id == function_->variables[variable].type_id))
+        {
+          copies[variable] = original;
+        }
+      }
+    }
+
+    if (EndsBasicBlock(instruction.opcode))
+    {
+      copies.clear();
+    }
+  }
+
+  return changed;
+}
+
+/**
+ * Removes the declarations of, and stores of side effect free values to, primitive local
+ * variables that are never read.
+ */
+bool Optimiser::EliminateDeadStores()
+{
+  FindJumpTargets();
+
+  std::vector<bool> read(function_->variables.size(), false);
+  for (auto const &node : nodes_)
+  {
+    if (!node.removed && ReadsLocalVariable(node.instruction.opcode) &&
+        (node.instruction.index < read.size()))
+    {
+      read[node.instruction.index] = true;
+    }
+  }
+
+  bool changed = false;
+  for (std::size_t x = 0; x < nodes_.size(); ++x)
+  {
+    Executable::Instruction const &instruction = nodes_[x].instruction;
+    uint16_t const                 variable    = instruction.index;
+    if (nodes_[x].removed ||
+        ((instruction.opcode != Opcodes::LocalVariableDeclare) &&
+         (instruction.opcode != Opcodes::LocalVariableDeclareAssign) &&
+         (instruction.opcode != Opcodes::PopToLocalVariable)) ||
+        (variable >= read.size()) || read[variable] ||
+        (function_->variables[variable].kind != VariableKind::Local) ||
+        !IsPrimitiveVariable(variable))
+    {
+      continue;
+    }
+
+    if (instruction.opcode == Opcodes::LocalVariableDeclare)
+    {
+      changed |= Remove(x);
+      continue;
+    }
+
+    // the store is removed together with the push of the value that it stores
+    std::size_t const push = Previous(x);
+    if ((push == NONE) || targets_[x] || !IsPurePush(nodes_[push].instruction.opcode))
+    {
+      continue;
+    }
+
+    Node const saved_push  = nodes_[push];
+    Node const saved_store = nodes_[x];
+    Absorb(x, push);
+    if (Remove(x))
+    {
+      changed = true;
+    }
+    else
+    {
+      nodes_[push] = saved_push;
+      nodes_[x]    = saved_store;
+    }
+  }
+
+  return changed;
+}
+
+void Optimiser::HoistLoopInvariants()
+{
+  FindJumpTargets();
+
+  for (std::size_t back_edge = 0; back_edge < nodes_.size(); ++back_edge)
+  {
+    Node const &node = nodes_[back_edge];
+    if (node.removed || (node.instruction.opcode != Opcodes::Jump))
+    {
+      continue;
+    }
+
+    std::size_t const header = Resolve(node.instruction.index);
+    if ((header != NONE) && (header <= back_edge) && nodes_[header].preheader.empty())
+    {
+      HoistLoopInvariants(header, back_edge);
+    }
+  }
+}
+
+/**
+ * Moves integral arithmetic on loop invariant operands in front of the loop formed by the
+ * instructions from the header to the back edge. The result is kept in a new local variable that
+ * the loop reads instead. Hoisted instructions are not charged, the loop is still charged for
+ * the instructions that they replace on every iteration.
+ */
+bool Optimiser::HoistLoopInvariants(std::size_t header, std::size_t back_edge)
+{
+  std::size_t num_instructions{0};
+  for (std::size_t x = 0; x < nodes_.size(); ++x)
+  {
+    Node const &node = nodes_[x];
+    if (node.removed)
+    {
+      continue;
+    }
+    num_instructions += 1 + node.preheader.size();
+
+    // the loop must only be entered through its header
+    if (IsJump(node.instruction.opcode) && ((x < header) || (x > back_edge)))
+    {
+      std::size_t const target = Resolve(node.instruction.index);
+      if ((target != NONE) && (target > header) && (target <= back_edge))
+      {
+        return false;
+      }
+    }
+  }
+
+  std::vector<bool> varies(function_->variables.size(), false);
+  auto const        record_write = [&varies](Executable::Instruction const &instruction) {
+    if (WritesLocalVariable(instruction.opcode) && (instruction.index < varies.size()))
+    {
+      varies[instruction.index] = true;
+    }
+  };
+
+  for (std::size_t x = 0; x < nodes_.size(); ++x)
+  {
+    Node const &node = nodes_[x];
+    if (node.removed)
+    {
+      continue;
+    }
+
+    // range loop variables are also written by every iteration of their loop
+    if (((header <= x) && (x <= back_edge)) || (node.instruction.opcode == Opcodes::ForRangeInit))
+    {
+      record_write(node.instruction);
+    }
+    for (auto const &hoisted : node.preheader)
+    {
+      record_write(hoisted.instruction);
+    }
+  }
+
+  auto const is_invariant = [this, &varies](Executable::Instruction const &instruction,
+                                            TypeId                         type_id) {
+    if (instruction.opcode == Opcodes::PushConstant)
+    {
+      return executable_->constants[instruction.index].type_id == type_id;
+    }
+    return (instruction.opcode == Opcodes::PushLocalVariable) &&
+           (instruction.type_id == type_id) && (instruction.index < varies.size()) &&
+           !varies[instruction.index] && IsPrimitiveVariable(instruction.index);
+  };
+
+  bool hoisted = false;
+  for (std::size_t a = header; a <= back_edge; ++a)
+  {
+    if (nodes_[a].removed)
+    {
+      continue;
+    }
+
+    std::size_t const b = Next(a);
+    std::size_t const c = (b == NONE) ? NONE : Next(b);
+    if ((c == NONE) || (c > back_edge) || targets_[b] || targets_[c])
+    {
+      continue;
+    }
+
+    Executable::Instruction const &lhs = nodes_[a].instruction;
+    Executable::Instruction const &rhs = nodes_[b].instruction;
+    Executable::Instruction const &op  = nodes_[c].instruction;
+    if (!IsHoistableOp(op.opcode) || !IsIntegral(op.type_id) || !is_invariant(lhs, op.type_id) ||
+        !is_invariant(rhs, op.type_id) ||
+        ((lhs.opcode != Opcodes::PushLocalVariable) && (rhs.opcode != Opcodes::PushLocalVariable)))
+    {
+      continue;
+    }
+
+    if ((num_instructions + 4 >= MAX_INSTRUCTIONS) ||
+        (function_->variables.size() >= MAX_VARIABLES))
+    {
+      break;
+    }
+
+    auto const variable = static_cast<uint16_t>(function_->variables.size());
+    function_->variables.emplace_back(VariableKind::Local,
+                                      "__invariant_" + std::to_string(variable), op.type_id, 0);
+    ++function_->num_variables;
+
+    Executable::Instruction store(Opcodes::LocalVariableDeclareAssign);
+    store.type_id = op.type_id;
+    store.index   = variable;
+
+    Node &loop_header = nodes_[header];
+    for (auto const &instruction : {lhs, rhs, op, store})
+    {
+      Node node;
+      node.instruction = instruction;
+      node.line        = loop_header.line;
+      node.charged     = false;
+      loop_header.preheader.push_back(std::move(node));
+    }
+    loop_header.loop_end = back_edge;
+    num_instructions += 4;
+
+    Executable::Instruction load(Opcodes::PushLocalVariable);
+    load.type_id = op.type_id;
+    load.index   = variable;
+    Rewrite(a, load);
+    Absorb(a, b);
+    Absorb(a, c);
+
+    hoisted = true;
+    a       = c;
+  }
+
+  return hoisted;
+}
+
+void Optimiser::Evaluate(uint16_t opcode, Variant &lhsv, Variant &rhsv)
+{
+  TypeId const type_id = lhsv.type_id;
+  switch (opcode)
+  {
+  case Opcodes::PrimitiveEqual:
+    vm_->ExecutePrimitiveRelationalOp<VM::PrimitiveEqual>(type_id, lhsv, rhsv);
+    break;
+  case Opcodes::PrimitiveNotEqual:
+    vm_->ExecutePrimitiveRelationalOp<VM::PrimitiveNotEqual>(type_id, lhsv, rhsv);
+    break;
+  case Opcodes::PrimitiveLessThan:
+    vm_->ExecutePrimitiveRelationalOp<VM::PrimitiveLessThan>(type_id, lhsv, rhsv);
+    break;
+  case Opcodes::PrimitiveLessThanOrEqual:
+    vm_->ExecutePrimitiveRelationalOp<VM::PrimitiveLessThanOrEqual>(type_id, lhsv, rhsv);
+    break;
+  case Opcodes::PrimitiveGreaterThan:
+    vm_->ExecutePrimitiveRelationalOp<VM::PrimitiveGreaterThan>(type_id, lhsv, rhsv);
+    break;
+  case Opcodes::PrimitiveGreaterThanOrEqual:
+    vm_->ExecutePrimitiveRelationalOp<VM::PrimitiveGreaterThanOrEqual>(type_id, lhsv, rhsv);
+    break;
+  case Opcodes::PrimitiveNegate:
+    vm_->ExecuteNumericOp<VM::PrimitiveNegate>(type_id, lhsv, rhsv);
+    break;
+  case Opcodes::PrimitiveAdd:
+    vm_->ExecuteNumericOp<VM::PrimitiveAdd>(type_id, lhsv, rhsv);
+    break;
+  case Opcodes::PrimitiveSubtract:
+    vm_->ExecuteNumericOp<VM::PrimitiveSubtract>(type_id, lhsv, rhsv);
+    break;
+  case Opcodes::PrimitiveMultiply:
+    vm_->ExecuteNumericOp<VM::PrimitiveMultiply>(type_id, lhsv, rhsv);
+    break;
+  case Opcodes::PrimitiveDivide:
+    vm_->ExecuteNumericOp<VM::PrimitiveDivide>(type_id, lhsv, rhsv);
+    break;
+  case Opcodes::PrimitiveModulo:
+    vm_->ExecuteIntegralOp<VM::PrimitiveModulo>(type_id, lhsv, rhsv);
+    break;
+  default:
+    break;
+  }
+}
+
+void Optimiser::FindJumpTargets()
+{
+  targets_.assign(nodes_.size(), false);
+  for (auto const &node : nodes_)
+  {
+    if (!node.removed && IsJump(node.instruction.opcode))
+    {
+      std::size_t const target = Resolve(node.instruction.index);
+      if (target != NONE)
+      {
+        targets_[target] = true;
+      }
+    }
+  }
+}
+
+std::size_t Optimiser::Next(std::size_t index) const
+{
+  return Resolve(index + 1);
+}
+
+std::size_t Optimiser::Previous(std::size_t index) const
+{
+  while (index-- > 0)
+  {
+    if (!nodes_[index].removed)
+    {
+      return index;
+    }
+  }
+  return NONE;
+}
+
+std::size_t Optimiser::Resolve(std::size_t index) const
+{
+  for (; index < nodes_.size(); ++index)
+  {
+    if (!nodes_[index].removed)
+    {
+      return index;
+    }
+  }
+  return NONE;
+}
+
+/**
+ * Finds a surviving instruction in the same basic block that executes exactly when the
+ * instruction at the given index does, and so can be charged on its behalf. Jump targets are
+ * checked on removed instructions too, since jumps to them continue at the next survivor.
+ */
+std::size_t Optimiser::FindHost(std::size_t index) const
+{
+  for (std::size_t next = index + 1; (next < nodes_.size()) && !targets_[next]; ++next)
+  {
+    if (!nodes_[next].removed)
+    {
+      return next;
+    }
+  }
+
+  for (std::size_t previous = index; !targets_[previous] && (previous-- > 0);)
+  {
+    if (!nodes_[previous].removed)
+    {
+      return EndsBasicBlock(nodes_[previous].instruction.opcode) ? NONE : previous;
+    }
+  }
+
+  return NONE;
+}
+
+bool Optimiser::Remove(std::size_t index)
+{
+  std::size_t const host = FindHost(index);
+  if (host == NONE)
+  {
+    return false;
+  }
+
+  Absorb(host, index);
+  return true;
+}
+
+void Optimiser::Absorb(std::size_t host, std::size_t index)
+{
+  Node &node = nodes_[index];
+  Node &to   = nodes_[host];
+  if (node.charged)
+  {
+    to.billed.push_back(node.instruction.opcode);
+  }
+  to.billed.insert(to.billed.end(), node.billed.begin(), node.billed.end());
+  node.billed.clear();
+  node.removed = true;
+}
+
+void Optimiser::Rewrite(std::size_t index, Executable::Instruction const &instruction)
+{
+  Node &node = nodes_[index];
+  if (node.charged && (node.instruction.opcode != instruction.opcode))
+  {
+    node.billed.push_back(node.instruction.opcode);
+    node.charged = false;
+  }
+  node.instruction = instruction;
+}
+
+bool Optimiser::IsPrimitiveVariable(uint16_t index) const
+{
+  if (index >= function_->variables.size())
+  {
+    return false;
+  }
+  TypeId const type_id = function_->variables[index].type_id;
+  return (type_id >= TypeIds::Bool) && (type_id <= TypeIds::PrimitiveMaxId);
+}
+
+/**
+ * Finds the index of a constant with the given value, adding one if there is none yet.
+ */
+bool Optimiser::FindConstant(Variant const &value, uint16_t &index)
+{
+  VariantArray &constants = executable_->constants;
+  for (std::size_t i = 0; i < constants.size(); ++i)
+  {
+    if (constants[i].type_id != value.type_id)
+    {
+      continue;
+    }
+
+    Variant lhsv(constants[i]);
+    Variant rhsv(value);
+    vm_->ExecutePrimitiveRelationalOp<VM::PrimitiveEqual>(value.type_id, lhsv, rhsv);
+    if (lhsv.primitive.ui8 != 0)
+    {
+      index = static_cast<uint16_t>(i);
+      return true;
+    }
+  }
+
+  if (constants.size() >= MAX_CONSTANTS)
+  {
+    return false;
+  }
+
+  index = static_cast<uint16_t>(constants.size());
+  constants.push_back(value);
+  return true;
+}
+
+}  // namespace vm
+}  // namespace fetch
@@ -240,11 +240,11 @@ VM::VM(Module *module)
   {
     auto        opcode = static_cast<uint16_t>(Opcodes::NumReserved + i);
     auto const &info   = function_info_array[i];
-    AddOpcodeInfo(opcode, info.unique_name, info.handler, info.static_charge);
+    opcode_info_array_[opcode] = OpcodeInfo(info.unique_name, info.handler, info.static_charge);
     opcode_map_[info.unique_name] = opcode;
   }
 
-  generator_.Initialise(this, num_types);
+  generator_.Initialise(this, num_types, module->IsUsingOptimisation());
 }
 
 bool VM::GenerateExecutable(IR const &ir, std::string const &name, Executable &executable,
@@ -274,28 +274,32 @@ bool VM::Execute(std::string &error, Variant &output)
     {
       do
       {
-        instruction_pc_ = pc_;
-        instruction_    = &function_->instructions[pc_++];
-
-        assert(instruction_->opcode < opcode_info_array_.size());
-
-        current_op_ = &opcode_info_array_[instruction_->opcode];
-
-        if (!current_op_->handler)
+        // the current function changes on calls and returns, both of which end a basic block
+        if (function_ != decoded_function_)
         {
-          RuntimeError("unknown opcode");
-          break;
+          decoded_          = Decode(*function_);
+          decoded_function_ = function_;
         }
 
-        IncreaseChargeTotal(current_op_->static_charge);
+        DecodedInstruction const &decoded = decoded_[pc_];
 
-        if (ChargeLimitExceeded())
+        instruction_pc_ = pc_;
+        instruction_    = &function_->instructions[pc_++];
+
+        // the static charge of the whole basic block is paid on entry to it
+        if (decoded.block_charge != 0)
         {
-          break;
+          IncreaseChargeTotal(decoded.block_charge);
+
+          if (ChargeLimitExceeded())
+          {
+            break;
+          }
         }
 
-        // execute the handler for the op code
-        current_op_->handler(this);
+        // execute the (super)instruction
+        current_op_ = decoded.info;
+        decoded.routine(this);
 
       } while (!stop_);
     }
@@ -426,6 +430,9 @@ void VM::UpdateCharges(std::unordered_map<std::string, ChargeAmount> const &opco
       it->static_charge = entry.second;
     }
   }
+
+  // the block charges of the decoded functions are now stale
+  ResetDecodedFunctions();
 }
 
 }  // namespace vm
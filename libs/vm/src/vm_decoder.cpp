@@ -0,0 +1,357 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/opcodes.hpp"
+#include "vm/vm.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace fetch {
+namespace vm {
+
+/**
+ * Converts the instructions of a function into their threaded form. This is a nested class of the
+ * VM so that the superinstructions can be composed directly from the (private) opcode handlers.
+ */
+class VM::Decoder
+{
+public:
+  static void Decode(VM &vm, Executable::Function const &function, DecodedFunction &decoded);
+
+private:
+  using SuperinstructionMap = std::unordered_map<uint64_t, Routine>;
+
+  static constexpr std::size_t MAX_SUPERINSTRUCTION_LENGTH = 3;
+
+  static uint64_t Key(uint16_t first, uint16_t second, uint16_t third = Opcodes::Unknown)
+  {
+    return (uint64_t{first} << 32u) | (uint64_t{second} << 16u) | uint64_t{third};
+  }
+
+  template <void (VM::*First)()>
+  static void RunSequence(VM *vm)
+  {
+    (vm->*First)();
+  }
+
+  /**
+   * Executes a sequence of opcode handlers as a single superinstruction. The first instruction of
+   * the sequence has already been fetched by the dispatch loop, the others are fetched here.
+   */
+  template <void (VM::*First)(), void (VM::*Next)(), void (VM::*... Rest)()>
+  static void RunSequence(VM *vm)
+  {
+    (vm->*First)();
+
+    if (vm->stop_)
+    {
+      return;
+    }
+
+    vm->instruction_pc_ = vm->pc_;
+    vm->instruction_    = &vm->function_->instructions[vm->pc_++];
+
+    RunSequence<Next, Rest...>(vm);
+  }
+
+  template <void (VM::*Op)()>
+  static void AddArithmeticOp(SuperinstructionMap &map, uint16_t opcode)
+  {
+    // e.g. x + 1, x + y
+    map[Key(Opcodes::PushLocalVariable, Opcodes::PushConstant, opcode)] =
+        &RunSequence<&VM::Handler__PushLocalVariable, &VM::Handler__PushConstant, Op>;
+    map[Key(Opcodes::PushLocalVariable, Opcodes::PushLocalVariable, opcode)] =
+        &RunSequence<&VM::Handler__PushLocalVariable, &VM::Handler__PushLocalVariable, Op>;
+
+    // e.g. x = y * z
+    map[Key(opcode, Opcodes::PopToLocalVariable)] =
+        &RunSequence<Op, &VM::Handler__PopToLocalVariable>;
+  }
+
+  template <void (VM::*Op)()>
+  static void AddRelationalOp(SuperinstructionMap &map, uint16_t opcode)
+  {
+    // e.g. while (i < 10), if (x == y)
+    map[Key(Opcodes::PushLocalVariable, Opcodes::PushConstant, opcode)] =
+        &RunSequence<&VM::Handler__PushLocalVariable, &VM::Handler__PushConstant, Op>;
+    map[Key(Opcodes::PushLocalVariable, Opcodes::PushLocalVariable, opcode)] =
+        &RunSequence<&VM::Handler__PushLocalVariable, &VM::Handler__PushLocalVariable, Op>;
+    map[Key(opcode, Opcodes::JumpIfFalse)] = &RunSequence<Op, &VM::Handler__JumpIfFalse>;
+    map[Key(opcode, Opcodes::JumpIfTrue)]  = &RunSequence<Op, &VM::Handler__JumpIfTrue>;
+  }
+
+  template <void (VM::*Op)()>
+  static void AddInplaceOp(SuperinstructionMap &map, uint16_t opcode)
+  {
+    // e.g. x += 1
+    map[Key(Opcodes::PushConstant, opcode)] = &RunSequence<&VM::Handler__PushConstant, Op>;
+    map[Key(Opcodes::PushLocalVariable, opcode)] =
+        &RunSequence<&VM::Handler__PushLocalVariable, Op>;
+  }
+
+  static SuperinstructionMap CreateSuperinstructions()
+  {
+    SuperinstructionMap map;
+
+    AddArithmeticOp<&VM::Handler__PrimitiveAdd>(map, Opcodes::PrimitiveAdd);
+    AddArithmeticOp<&VM::Handler__PrimitiveSubtract>(map, Opcodes::PrimitiveSubtract);
+    AddArithmeticOp<&VM::Handler__PrimitiveMultiply>(map, Opcodes::PrimitiveMultiply);
+    AddArithmeticOp<&VM::Handler__PrimitiveDivide>(map, Opcodes::PrimitiveDivide);
+    AddArithmeticOp<&VM::Handler__PrimitiveModulo>(map, Opcodes::PrimitiveModulo);
+
+    AddRelationalOp<&VM::Handler__PrimitiveEqual>(map, Opcodes::PrimitiveEqual);
+    AddRelationalOp<&VM::Handler__PrimitiveNotEqual>(map, Opcodes::PrimitiveNotEqual);
+    AddRelationalOp<&VM::Handler__PrimitiveLessThan>(map, Opcodes::PrimitiveLessThan);
+    AddRelationalOp<&VM::Handler__PrimitiveLessThanOrEqual>(map,
+                                                            Opcodes::PrimitiveLessThanOrEqual);
+    AddRelationalOp<&VM::Handler__PrimitiveGreaterThan>(map, Opcodes::PrimitiveGreaterThan);
+    AddRelationalOp<&VM::Handler__PrimitiveGreaterThanOrEqual>(
+        map, Opcodes::PrimitiveGreaterThanOrEqual);
+
+    AddInplaceOp<&VM::Handler__LocalVariablePrimitiveInplaceAdd>(
+        map, Opcodes::LocalVariablePrimitiveInplaceAdd);
+    AddInplaceOp<&VM::Handler__LocalVariablePrimitiveInplaceSubtract>(
+        map, Opcodes::LocalVariablePrimitiveInplaceSubtract);
+    AddInplaceOp<&VM::Handler__LocalVariablePrimitiveInplaceMultiply>(
+        map, Opcodes::LocalVariablePrimitiveInplaceMultiply);
+    AddInplaceOp<&VM::Handler__LocalVariablePrimitiveInplaceDivide>(
+        map, Opcodes::LocalVariablePrimitiveInplaceDivide);
+    AddInplaceOp<&VM::Handler__LocalVariablePrimitiveInplaceModulo>(
+        map, Opcodes::LocalVariablePrimitiveInplaceModulo);
+
+    // operand pairs that are not followed by one of the operations above
+    map[Key(Opcodes::PushLocalVariable, Opcodes::PushConstant)] =
+        &RunSequence<&VM::Handler__PushLocalVariable, &VM::Handler__PushConstant>;
+    map[Key(Opcodes::PushLocalVariable, Opcodes::PushLocalVariable)] =
+        &RunSequence<&VM::Handler__PushLocalVariable, &VM::Handler__PushLocalVariable>;
+
+    return map;
+  }
+
+  static void InvokeHandler(VM *vm)
+  {
+    vm->current_op_->handler(vm);
+  }
+
+  static void UnknownOpcode(VM *vm)
+  {
+    vm->RuntimeError("unknown opcode");
+  }
+
+  static ChargeAmount StaticCharge(VM const &vm, uint16_t opcode)
+  {
+    if ((opcode < vm.opcode_info_array_.size()) &&
+        (vm.opcode_info_array_[opcode].static_charge != 0))
+    {
+      return vm.opcode_info_array_[opcode].static_charge;
+    }
+
+    // an instruction with no static charge still costs one unit, as IncreaseChargeTotal has always
+    // charged it when the instructions were paid for one at a time
+    return 1;
+  }
+
+  static void AddCharge(ChargeAmount &total, ChargeAmount charge)
+  {
+    if ((std::numeric_limits<ChargeAmount>::max() - total) < charge)
+    {
+      total = std::numeric_limits<ChargeAmount>::max();
+    }
+    else
+    {
+      total += charge;
+    }
+  }
+
+  static bool IsJump(uint16_t opcode)
+  {
+    switch (opcode)
+    {
+    case Opcodes::Break:
+    case Opcodes::Continue:
+    case Opcodes::Jump:
+    case Opcodes::JumpIfFalse:
+    case Opcodes::JumpIfTrue:
+    case Opcodes::JumpIfFalseOrPop:
+    case Opcodes::JumpIfTrueOrPop:
+    case Opcodes::ForRangeIterate:
+      return true;
+    default:
+      return false;
+    }
+  }
+
+  static bool EndsBasicBlock(uint16_t opcode)
+  {
+    switch (opcode)
+    {
+    case Opcodes::Return:
+    case Opcodes::ReturnValue:
+    case Opcodes::InvokeUserDefinedFreeFunction:
+    case Opcodes::InvokeUserDefinedConstructor:
+    case Opcodes::InvokeUserDefinedMemberFunction:
+      return true;
+    default:
+      return IsJump(opcode);
+    }
+  }
+};
+
+constexpr std::size_t VM::Decoder::MAX_SUPERINSTRUCTION_LENGTH;
+
+void VM::Decoder::Decode(VM &vm, Executable::Function const &function, DecodedFunction &decoded)
+{
+  static SuperinstructionMap const superinstructions = CreateSuperinstructions();
+
+  auto const &      instructions     = function.instructions;
+  std::size_t const num_instructions = instructions.size();
+
+  // find the first instruction of each basic block
+  std::vector<bool> leaders(num_instructions + 1, false);
+  leaders[0] = true;
+  for (std::size_t pc = 0; pc < num_instructions; ++pc)
+  {
+    uint16_t const opcode = instructions[pc].opcode;
+
+    if (IsJump(opcode) && (instructions[pc].index < num_instructions))
+    {
+      leaders[instructions[pc].index] = true;
+    }
+
+    if (EndsBasicBlock(opcode))
+    {
+      leaders[pc + 1] = true;
+    }
+  }
+
+  // resolve the routine of every instruction and total the static charge of each block
+  decoded = DecodedFunction(num_instructions);
+
+  std::vector<std::size_t> block_starts(num_instructions);
+  std::size_t              block_start{0};
+  for (std::size_t pc = 0; pc < num_instructions; ++pc)
+  {
+    uint16_t const      opcode = instructions[pc].opcode;
+    DecodedInstruction &entry  = decoded[pc];
+
+    if (leaders[pc])
+    {
+      block_start = pc;
+    }
+    block_starts[pc] = block_start;
+
+    if ((opcode < vm.opcode_info_array_.size()) && vm.opcode_info_array_[opcode].handler)
+    {
+      entry.info    = &vm.opcode_info_array_[opcode];
+      entry.routine = entry.info->routine ? entry.info->routine : &InvokeHandler;
+    }
+    else
+    {
+      entry.routine = &UnknownOpcode;
+    }
+
+    AddCharge(decoded[block_start].block_charge, StaticCharge(vm, opcode));
+  }
+
+  // optimised functions are charged as their unoptimised form would have been
+  for (auto const &adjustment : function.charge_adjustments)
+  {
+    if (adjustment.pc >= num_instructions)
+    {
+      continue;
+    }
+
+    ChargeAmount &     block_charge  = decoded[block_starts[adjustment.pc]].block_charge;
+    ChargeAmount const static_charge = StaticCharge(vm, adjustment.opcode);
+    if (adjustment.refund)
+    {
+      block_charge -= std::min(block_charge, static_charge);
+    }
+    else
+    {
+      AddCharge(block_charge, static_charge);
+    }
+  }
+
+  // fuse common sequences of instructions that lie within a single basic block
+  for (std::size_t pc = 0; pc < num_instructions; ++pc)
+  {
+    for (std::size_t length = MAX_SUPERINSTRUCTION_LENGTH; length > 1; --length)
+    {
+      if ((pc + length > num_instructions) || EndsBasicBlock(instructions[pc].opcode))
+      {
+        continue;
+      }
+
+      bool     fusable = true;
+      uint16_t ops[MAX_SUPERINSTRUCTION_LENGTH]{};
+      for (std::size_t i = 0; i < length; ++i)
+      {
+        ops[i] = instructions[pc + i].opcode;
+
+        // only the last instruction of the sequence may leave the basic block
+        bool const is_last = (i + 1) == length;
+        if ((i > 0 && leaders[pc + i]) || (!is_last && EndsBasicBlock(ops[i])))
+        {
+          fusable = false;
+          break;
+        }
+      }
+
+      if (!fusable)
+      {
+        continue;
+      }
+
+      auto const it = superinstructions.find(Key(ops[0], ops[1], ops[2]));
+      if (it != superinstructions.end())
+      {
+        decoded[pc].routine = it->second;
+        pc += length - 1;
+        break;
+      }
+    }
+  }
+}
+
+VM::DecodedInstruction const *VM::Decode(Executable::Function const &function)
+{
+  auto it = decoded_functions_.find(&function);
+  if (it == decoded_functions_.end())
+  {
+    it = decoded_functions_.emplace(&function, DecodedFunction{}).first;
+    Decoder::Decode(*this, function, it->second);
+  }
+
+  return it->second.data();
+}
+
+void VM::ResetDecodedFunctions()
+{
+  decoded_functions_.clear();
+  decoded_function_ = nullptr;
+  decoded_          = nullptr;
+}
+
+}  // namespace vm
+}  // namespace fetch